@@ -9,12 +9,16 @@
 
 #include <cstdlib>
 
+#include <algorithm>
+#include <chrono>
 #include <format>
 #include <fstream>
 #include <iostream>
 #include <string>
 
+#include <LHVM.h>
 #include <LHVMFile.h>
+#include <LHVMNativeSignatures.h>
 #include <cxxopts.hpp>
 
 using namespace openblack::lhvm;
@@ -34,7 +38,8 @@ struct Arguments
 		Stack,
 		VarValues,
 		Tasks,
-		RuntimeInfo
+		RuntimeInfo,
+		Bench
 	};
 	Mode mode {Mode::Header};
 	struct Read
@@ -42,6 +47,12 @@ struct Arguments
 		std::filesystem::path filename;
 		std::string objName;
 	} read;
+	struct Bench
+	{
+		std::filesystem::path filename;
+		uint32_t ticks;
+		std::string scriptName;
+	} bench;
 };
 
 int PrintInfo(const LHVMFile& file)
@@ -421,8 +432,9 @@ int PrintTasks(const LHVMFile& file)
 			std::printf("Task number: %u\n", task.id);
 			std::printf("Type: %s\n", k_ScriptTypeNames.at(task.type).c_str());
 			std::printf("Script ID: %u\n", task.scriptId);
-			std::printf("Script name: %s\n", task.name.c_str());
-			std::printf("Filename: %s\n", task.filename.c_str());
+			const auto& script = file.GetScripts().at(task.scriptId - 1);
+			std::printf("Script name: %s\n", script.name.c_str());
+			std::printf("Filename: %s\n", script.filename.c_str());
 			std::printf("Instruction address: 0x%04x\n", task.instructionAddress);
 			std::printf("Prev instruction address: 0x%04x\n", task.pevInstructionAddress);
 			std::printf("Ticks: %u\n", task.ticks);
@@ -441,11 +453,15 @@ int PrintTasks(const LHVMFile& file)
 			std::printf("Local variables offset: 0x%04x\n", task.variablesOffset);
 			std::printf("Variables:\n");
 			const auto& vars = task.localVars;
+			const auto& scripts = file.GetScripts();
+			const auto* const script =
+			    task.scriptId > 0 && task.scriptId <= scripts.size() ? &scripts[task.scriptId - 1] : nullptr;
 			for (unsigned int i = 0; i < vars.size(); i++)
 			{
 				const auto& var = vars[i];
 				const int id = task.variablesOffset + 1 + i;
-				std::printf("0x%04x, %s = %s\n", id, var.name.c_str(), DataToString(var.value, var.type).c_str());
+				const auto* const name = script != nullptr && i < script->variables.size() ? script->variables[i].c_str() : "?";
+				std::printf("0x%04x, %s = %s\n", id, name, DataToString(var.value, var.type).c_str());
 			}
 			std::printf("\n");
 			PrintStack(task.stack);
@@ -479,6 +495,76 @@ int PrintRuntimeInfo(const LHVMFile& file)
 	return EXIT_SUCCESS;
 }
 
+int RunBenchmark(const std::filesystem::path& filename, uint32_t ticks, const std::string& scriptName)
+{
+	LHVMFile file;
+	file.Open(filename);
+	if (!file.IsLoaded())
+	{
+		std::printf("Failed to open %s\n", filename.string().c_str());
+		return EXIT_FAILURE;
+	}
+
+	// Native functions live in the game, stand-ins with their stack effect keep the scripts running
+	auto functionCount = static_cast<uint32_t>(k_NativeFunctionSignatures.size());
+	for (const auto& instruction : file.GetInstructions())
+	{
+		if (instruction.code == Opcode::Sys)
+		{
+			functionCount = std::max(functionCount, instruction.data.uintVal + 1);
+		}
+	}
+	std::vector<NativeFunction> functions;
+	functions.reserve(functionCount);
+	for (const auto& signature : k_NativeFunctionSignatures)
+	{
+		functions.emplace_back(nullptr, signature.stackIn, signature.stackOut, std::string(signature.name));
+	}
+	for (auto i = functions.size(); i < functionCount; i++)
+	{
+		functions.emplace_back(nullptr, 0, 0, "unknown");
+	}
+
+	uint32_t errorCount = 0;
+	LHVM vm;
+	vm.Initialise(&functions, nullptr, nullptr, nullptr,
+	              [&errorCount](ErrorCode /*code*/, const std::string& /*v0*/, uint32_t /*v1*/) { errorCount++; }, nullptr,
+	              nullptr);
+	if (vm.LoadBinary(file) != EXIT_SUCCESS)
+	{
+		std::printf("Failed to load %s\n", filename.string().c_str());
+		return EXIT_FAILURE;
+	}
+	if (!scriptName.empty() && vm.StartScript(scriptName, ScriptType::All) == 0)
+	{
+		std::printf("Script not found\n");
+		return EXIT_FAILURE;
+	}
+
+	size_t peakTasks = vm.GetTasks().size();
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < ticks; i++)
+	{
+		vm.LookIn(ScriptType::All);
+		peakTasks = std::max(peakTasks, vm.GetTasks().size());
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	const auto instructions = vm.GetExecutedInstructions();
+	std::printf("Ticks: %u\n", ticks);
+	std::printf("Peak tasks count: %zu\n", peakTasks);
+	std::printf("Executed instructions: %u\n", instructions);
+	std::printf("Errors: %u\n", errorCount);
+	std::printf("Elapsed time: %.3f ms\n", elapsed.count() * 1000.0);
+	if (elapsed.count() > 0.0)
+	{
+		std::printf("Instructions per second: %.0f\n", instructions / elapsed.count());
+		std::printf("Ticks per second: %.1f\n", ticks / elapsed.count());
+	}
+	std::printf("\n");
+	return EXIT_SUCCESS;
+}
+
 bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexcept
 {
 	cxxopts::Options options("lhvmtool", "Inspect and extract files from LionHead Virtual Machine files.");
@@ -487,7 +573,7 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 	    ("h,help", "Display this help message.")                     //
 	    ("subcommand", "Subcommand.", cxxopts::value<std::string>()) //
 	    ;
-	options.positional_help("[read] [OPTION...]");
+	options.positional_help("[read|bench] [OPTION...]");
 	options.add_options("read")                                                     //
 	    ("I,info", "Print info.", cxxopts::value<std::string>())                    //
 	    ("A,all", "Print all relevant data.", cxxopts::value<std::string>())        //
@@ -503,6 +589,11 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 	    ("R,rtinfo", "Print runtime info.", cxxopts::value<std::string>())          //
 	    ("n,name", "Object name", cxxopts::value<std::string>()->default_value("")) //
 	    ;
+	options.add_options("bench")                                                                                      //
+	    ("f,file", "Run the scripts of a challenge file.", cxxopts::value<std::string>())                               //
+	    ("t,ticks", "Number of ticks to run.", cxxopts::value<uint32_t>()->default_value("1000"))                       //
+	    ("r,run", "Script to start on top of the autostart ones.", cxxopts::value<std::string>()->default_value("")) //
+	    ;
 
 	options.parse_positional({"subcommand"});
 	auto result = options.parse(argc, argv);
@@ -595,6 +686,17 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 			return true;
 		}
 	}
+	if (result["subcommand"].as<std::string>() == "bench")
+	{
+		if (result["file"].count() > 0)
+		{
+			args.mode = Arguments::Mode::Bench;
+			args.bench.filename = result["file"].as<std::string>();
+			args.bench.ticks = result["ticks"].as<uint32_t>();
+			args.bench.scriptName = result["run"].as<std::string>();
+			return true;
+		}
+	}
 	std::cerr << options.help() << '\n';
 	returnCode = EXIT_FAILURE;
 	return false;
@@ -609,6 +711,12 @@ int main(int argc, char* argv[]) noexcept
 		return returnCode;
 	}
 
+	if (args.mode == Arguments::Mode::Bench)
+	{
+		std::printf("Filename: %s\n", args.bench.filename.string().c_str());
+		return RunBenchmark(args.bench.filename, args.bench.ticks, args.bench.scriptName);
+	}
+
 	LHVMFile file;
 	std::printf("Filename: %s\n", args.read.filename.string().c_str());
 
@@ -0,0 +1,321 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ANMFile.h>
+#include <L3DFile.h>
+#include <LNDFile.h>
+#include <MorphFile.h>
+#include <PackFile.h>
+#include <cxxopts.hpp>
+
+struct Arguments
+{
+	std::vector<std::filesystem::path> filenames;
+	std::filesystem::path specDirectory;
+	uint32_t iterations;
+};
+
+namespace
+{
+// Adapted from https://stackoverflow.com/a/13059195/10604387
+//          and https://stackoverflow.com/a/46069245/10604387
+struct membuf: std::streambuf
+{
+	membuf(char const* base, size_t size)
+	{
+		char* p(const_cast<char*>(base));
+		this->setg(p, p, p + size);
+	}
+	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
+	{
+		if (way == std::ios_base::cur)
+		{
+			gbump(static_cast<int>(off));
+		}
+		else if (way == std::ios_base::end)
+		{
+			setg(eback(), egptr() + off, egptr());
+		}
+		else if (way == std::ios_base::beg)
+		{
+			setg(eback(), eback() + off, egptr());
+		}
+		return gptr() - eback();
+	}
+
+	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
+	{
+		return seekoff(pos - static_cast<off_type>(0), std::ios_base::beg, which);
+	}
+};
+struct imemstream: virtual membuf, std::istream
+{
+	imemstream(char const* base, size_t size)
+	    : membuf(base, size)
+	    , std::istream(dynamic_cast<std::streambuf*>(this))
+	{
+	}
+};
+
+using Clock = std::chrono::steady_clock;
+using Duration = std::chrono::duration<double, std::milli>;
+
+constexpr std::string_view k_PackMagic = "LiOnHeAd";
+
+/// Parse every buffer with both entry points and print the fastest pass of each
+template <typename StreamParse, typename SpanParse>
+bool Compare(std::string_view name, const std::vector<std::span<const uint8_t>>& buffers, uint32_t iterations,
+             StreamParse streamParse, SpanParse spanParse)
+{
+	if (buffers.empty())
+	{
+		return true;
+	}
+
+	size_t bytes = 0;
+	for (const auto& buffer : buffers)
+	{
+		bytes += buffer.size();
+	}
+
+	const auto measure = [&buffers, iterations](auto parse, bool& succeeded) {
+		Duration best = Duration::max();
+		for (uint32_t i = 0; i < iterations; ++i)
+		{
+			const auto start = Clock::now();
+			for (const auto& buffer : buffers)
+			{
+				succeeded = parse(buffer) && succeeded;
+			}
+			best = std::min<Duration>(best, Clock::now() - start);
+		}
+		return best;
+	};
+
+	bool streamSucceeded = true;
+	bool spanSucceeded = true;
+	const auto streamDuration = measure(streamParse, streamSucceeded);
+	const auto spanDuration = measure(spanParse, spanSucceeded);
+
+	std::printf("%-40.40s %6zu %10zu %12.3f %12.3f %8.2fx\n", std::string(name).c_str(), buffers.size(), bytes,
+	            streamDuration.count(), spanDuration.count(), streamDuration / spanDuration);
+	if (!streamSucceeded || !spanSucceeded)
+	{
+		std::fprintf(stderr, "%s: failed to parse with the %s entry point\n", std::string(name).c_str(),
+		             streamSucceeded ? "span" : "stream");
+	}
+	return streamSucceeded && spanSucceeded;
+}
+
+bool CompareL3D(std::string_view name, const std::vector<std::span<const uint8_t>>& buffers, uint32_t iterations)
+{
+	return Compare(
+	    name, buffers, iterations,
+	    [](std::span<const uint8_t> buffer) {
+		    imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+		    openblack::l3d::L3DFile l3d;
+		    return l3d.ReadFile(stream) == openblack::l3d::L3DResult::Success;
+	    },
+	    [](std::span<const uint8_t> buffer) {
+		    openblack::l3d::L3DFile l3d;
+		    return l3d.ReadFile(std::as_bytes(buffer)) == openblack::l3d::L3DResult::Success;
+	    });
+}
+
+bool CompareANM(std::string_view name, const std::vector<std::span<const uint8_t>>& buffers, uint32_t iterations)
+{
+	return Compare(
+	    name, buffers, iterations,
+	    [](std::span<const uint8_t> buffer) {
+		    imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+		    openblack::anm::ANMFile anm;
+		    return anm.ReadFile(stream) == openblack::anm::ANMResult::Success;
+	    },
+	    [](std::span<const uint8_t> buffer) {
+		    openblack::anm::ANMFile anm;
+		    return anm.ReadFile(std::as_bytes(buffer)) == openblack::anm::ANMResult::Success;
+	    });
+}
+
+bool CompareLND(std::string_view name, const std::vector<std::span<const uint8_t>>& buffers, uint32_t iterations)
+{
+	return Compare(
+	    name, buffers, iterations,
+	    [](std::span<const uint8_t> buffer) {
+		    imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+		    openblack::lnd::LNDFile lnd;
+		    return lnd.ReadFile(stream) == openblack::lnd::LNDResult::Success;
+	    },
+	    [](std::span<const uint8_t> buffer) {
+		    openblack::lnd::LNDFile lnd;
+		    return lnd.ReadFile(std::as_bytes(buffer)) == openblack::lnd::LNDResult::Success;
+	    });
+}
+
+bool CompareMorph(std::string_view name, const std::vector<std::span<const uint8_t>>& buffers, uint32_t iterations,
+                  const std::filesystem::path& specDirectory)
+{
+	return Compare(
+	    name, buffers, iterations,
+	    [&specDirectory](std::span<const uint8_t> buffer) {
+		    imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+		    openblack::morph::MorphFile morph;
+		    return morph.ReadFile(stream, specDirectory) == openblack::morph::MorphResult::Success;
+	    },
+	    [&specDirectory](std::span<const uint8_t> buffer) {
+		    openblack::morph::MorphFile morph;
+		    return morph.ReadFile(std::as_bytes(buffer), specDirectory) == openblack::morph::MorphResult::Success;
+	    });
+}
+
+bool ComparePack(const std::filesystem::path& filename, uint32_t iterations)
+{
+	// Mapped like the game does so the meshes are parsed in place
+	openblack::pack::PackFile pack;
+	const auto result = pack.Open(filename, openblack::pack::PackOpenMode::MemoryMap);
+	if (result != openblack::pack::PackResult::Success)
+	{
+		std::fprintf(stderr, "%s: %s\n", filename.string().c_str(), std::string(openblack::pack::ResultToStr(result)).c_str());
+		return false;
+	}
+
+	const auto& meshes = pack.GetMeshes();
+	const std::vector<std::span<const uint8_t>> meshBuffers(meshes.begin(), meshes.end());
+	const auto& animations = pack.GetAnimations();
+	const std::vector<std::span<const uint8_t>> animationBuffers(animations.begin(), animations.end());
+
+	const auto name = filename.filename().string();
+	const bool meshesSucceeded = CompareL3D(name + " meshes", meshBuffers, iterations);
+	const bool animationsSucceeded = CompareANM(name + " animations", animationBuffers, iterations);
+	return meshesSucceeded && animationsSucceeded;
+}
+
+std::vector<uint8_t> ReadAll(const std::filesystem::path& filename)
+{
+	std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+	if (!stream.is_open())
+	{
+		return {};
+	}
+	std::vector<uint8_t> buffer(static_cast<size_t>(stream.tellg()));
+	stream.seekg(0);
+	stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+	return buffer;
+}
+
+bool CompareFile(const std::filesystem::path& filename, const Arguments& args)
+{
+	const auto buffer = ReadAll(filename);
+	if (buffer.empty())
+	{
+		std::fprintf(stderr, "%s: could not read file\n", filename.string().c_str());
+		return false;
+	}
+	if (buffer.size() >= k_PackMagic.size() && std::memcmp(buffer.data(), k_PackMagic.data(), k_PackMagic.size()) == 0)
+	{
+		return ComparePack(filename, args.iterations);
+	}
+
+	const std::vector<std::span<const uint8_t>> buffers {buffer};
+	const auto name = filename.filename().string();
+	const auto extension = filename.extension().string();
+	if (extension == ".l3d")
+	{
+		return CompareL3D(name, buffers, args.iterations);
+	}
+	if (extension == ".anm")
+	{
+		return CompareANM(name, buffers, args.iterations);
+	}
+	if (extension == ".lnd")
+	{
+		return CompareLND(name, buffers, args.iterations);
+	}
+	if (!args.specDirectory.empty())
+	{
+		return CompareMorph(name, buffers, args.iterations, args.specDirectory);
+	}
+
+	std::fprintf(stderr, "%s: unknown file type, morph files need --spec-directory\n", filename.string().c_str());
+	return false;
+}
+} // namespace
+
+bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexcept
+{
+	cxxopts::Options options("parserbench", "Compare parsing game files from streams and from memory.");
+
+	options.add_options()                                                                                  //
+	    ("h,help", "Display this help message.")                                                           //
+	    ("n,iterations", "Times each file is parsed, the fastest is kept.",                                //
+	     cxxopts::value<uint32_t>()->default_value("20"))                                                  //
+	    ("s,spec-directory", "Directory with the morph spec files, needed for morph files.",               //
+	     cxxopts::value<std::filesystem::path>()->default_value(""))                                       //
+	    ("files", "l3d, anm, lnd and morph files or mesh and animation packs such as Data/AllMeshes.g3d.", //
+	     cxxopts::value<std::vector<std::filesystem::path>>())                                             //
+	    ;
+
+	options.parse_positional({"files"});
+	options.positional_help("files...");
+
+	auto result = options.parse(argc, argv);
+	if (result["help"].as<bool>())
+	{
+		std::cout << options.help() << '\n';
+		returnCode = EXIT_SUCCESS;
+		return false;
+	}
+	if (result["files"].count() == 0)
+	{
+		std::cerr << options.help() << '\n';
+		returnCode = EXIT_FAILURE;
+		return false;
+	}
+
+	args.filenames = result["files"].as<std::vector<std::filesystem::path>>();
+	args.specDirectory = result["spec-directory"].as<std::filesystem::path>();
+	args.iterations = std::max(result["iterations"].as<uint32_t>(), 1u);
+	return true;
+}
+
+int main(int argc, char* argv[]) noexcept
+{
+	Arguments args;
+	int returnCode = EXIT_SUCCESS;
+	if (!parseOptions(argc, argv, args, returnCode))
+	{
+		return returnCode;
+	}
+
+	std::printf("%-40s %6s %10s %12s %12s %9s\n", "file", "count", "bytes", "stream (ms)", "span (ms)", "speedup");
+	for (const auto& filename : args.filenames)
+	{
+		if (!CompareFile(filename, args))
+		{
+			returnCode = EXIT_FAILURE;
+		}
+	}
+
+	return returnCode;
+}
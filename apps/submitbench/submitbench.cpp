@@ -0,0 +1,229 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <bgfx/bgfx.h>
+#include <cxxopts.hpp>
+#include <entt/core/hashed_string.hpp>
+#include <glm/vec4.hpp>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include "Graphics/ShaderProgram.h"
+
+using openblack::graphics::ShaderProgram;
+
+struct Arguments
+{
+	uint32_t primitives;
+	uint32_t iterations;
+};
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+using Duration = std::chrono::duration<double, std::milli>;
+
+/// Version of the shader binaries written below, the uniforms carry their texture info and format since version 10
+constexpr uint8_t k_ShaderBinVersion = 10;
+
+struct UniformDesc
+{
+	std::string_view name;
+	bgfx::UniformType::Enum type;
+};
+
+/// The per-draw uniforms and samplers of the object shaders, bound by Renderer::DrawSubMesh
+constexpr std::array<UniformDesc, 3> k_VertexUniforms = {{
+    {"s_heightmap", bgfx::UniformType::Sampler},
+    {"u_islandExtent", bgfx::UniformType::Vec4},
+    {"s_bones", bgfx::UniformType::Sampler},
+}};
+constexpr std::array<UniformDesc, 3> k_FragmentUniforms = {{
+    {"u_boneTextureSize", bgfx::UniformType::Vec4},
+    {"s_diffuse", bgfx::UniformType::Sampler},
+    {"u_skyAlphaThreshold", bgfx::UniformType::Vec4},
+}};
+
+template <typename T>
+void Write(std::vector<uint8_t>& blob, T value)
+{
+	const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+	blob.insert(blob.end(), bytes, bytes + sizeof(T));
+}
+
+/// The Noop renderer has no shader compiler, only the uniform table of the binary is read and it is enough to create the
+/// uniforms ShaderProgram looks up
+bgfx::ShaderHandle CreateShader(char stage, std::span<const UniformDesc> uniforms)
+{
+	std::vector<uint8_t> blob;
+	Write<uint32_t>(blob, static_cast<uint32_t>(stage) | ('S' << 8) | ('H' << 16) | (k_ShaderBinVersion << 24));
+	Write<uint32_t>(blob, 0); // hash in
+	Write<uint32_t>(blob, 0); // hash out
+	Write<uint16_t>(blob, static_cast<uint16_t>(uniforms.size()));
+	for (const auto& uniform : uniforms)
+	{
+		Write<uint8_t>(blob, static_cast<uint8_t>(uniform.name.size()));
+		blob.insert(blob.end(), uniform.name.begin(), uniform.name.end());
+		Write<uint8_t>(blob, static_cast<uint8_t>(uniform.type));
+		Write<uint8_t>(blob, 1);  // num
+		Write<uint16_t>(blob, 0); // register index
+		Write<uint16_t>(blob, 1); // register count
+		Write<uint16_t>(blob, 0); // texture info
+		Write<uint16_t>(blob, 0); // texture format
+	}
+	Write<uint32_t>(blob, 0); // code size
+	return bgfx::createShader(bgfx::copy(blob.data(), static_cast<uint32_t>(blob.size())));
+}
+
+/// Submit the draws of every iteration in their own frame and return the fastest
+template <typename Bind>
+Duration Measure(const Arguments& args, bgfx::ProgramHandle program, bgfx::VertexBufferHandle vertexBuffer, Bind bind)
+{
+	Duration best = Duration::max();
+	for (uint32_t i = 0; i < args.iterations; ++i)
+	{
+		const auto start = Clock::now();
+		for (uint32_t primitive = 0; primitive < args.primitives; ++primitive)
+		{
+			bind(primitive);
+			bgfx::setVertexBuffer(0, vertexBuffer);
+			bgfx::setState(BGFX_STATE_DEFAULT);
+			bgfx::submit(0, program);
+		}
+		best = std::min<Duration>(best, Clock::now() - start);
+		bgfx::frame();
+	}
+	return best;
+}
+} // namespace
+
+bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexcept
+{
+	cxxopts::Options options("submitbench",
+	                         "Compare binding per-draw uniforms by name and by resolved handle on the Noop renderer.");
+
+	options.add_options()                                                        //
+	    ("h,help", "Display this help message.")                                 //
+	    ("p,primitives", "Primitives submitted per frame.",                      //
+	     cxxopts::value<uint32_t>()->default_value("4096"))                      //
+	    ("n,iterations", "Frames submitted with each API, the fastest is kept.", //
+	     cxxopts::value<uint32_t>()->default_value("50"))                        //
+	    ;
+
+	auto result = options.parse(argc, argv);
+	if (result["help"].as<bool>())
+	{
+		std::cout << options.help() << '\n';
+		returnCode = EXIT_SUCCESS;
+		return false;
+	}
+
+	// bgfx can't take more draws in a frame
+	args.primitives = std::clamp<uint32_t>(result["primitives"].as<uint32_t>(), 1u, 60000u);
+	args.iterations = std::max(result["iterations"].as<uint32_t>(), 1u);
+	return true;
+}
+
+int main(int argc, char* argv[]) noexcept
+{
+	Arguments args;
+	int returnCode = EXIT_SUCCESS;
+	if (!parseOptions(argc, argv, args, returnCode))
+	{
+		return returnCode;
+	}
+
+	// ShaderProgram warns through it
+	spdlog::stdout_color_mt("graphics");
+
+	// Render on this thread so that the frames don't overlap the measures
+	bgfx::renderFrame();
+	bgfx::Init init;
+	init.type = bgfx::RendererType::Noop;
+	init.resolution.width = 1;
+	init.resolution.height = 1;
+	if (!bgfx::init(init))
+	{
+		std::fprintf(stderr, "Could not initialize the Noop renderer\n");
+		return EXIT_FAILURE;
+	}
+
+	{
+		const ShaderProgram program("submitbench", CreateShader('V', k_VertexUniforms),
+		                            CreateShader('F', k_FragmentUniforms));
+
+		bgfx::VertexLayout layout;
+		layout.begin().add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float).end();
+		constexpr std::array<float, 9> k_Triangle = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+		const auto vertexBuffer = bgfx::createVertexBuffer(bgfx::copy(k_Triangle.data(), sizeof(k_Triangle)), layout);
+		const auto texture = bgfx::createTexture2D(1, 1, false, 1, bgfx::TextureFormat::RGBA8);
+		const auto islandExtent = glm::vec4(0.0f, 0.0f, 5120.0f, 5120.0f);
+		const auto boneTextureSize = glm::vec4(1024.0f, 1.0f, 0.0f, 0.0f);
+
+		// Resolved once like Renderer::MeshUniforms
+		const auto heightMapSampler = program.GetUniform(entt::hashed_string::value("s_heightmap"));
+		const auto islandExtentUniform = program.GetUniform(entt::hashed_string::value("u_islandExtent"));
+		const auto bonesSampler = program.GetUniform(entt::hashed_string::value("s_bones"));
+		const auto boneTextureSizeUniform = program.GetUniform(entt::hashed_string::value("u_boneTextureSize"));
+		const auto diffuseSampler = program.GetUniform(entt::hashed_string::value("s_diffuse"));
+		const auto skyAlphaThresholdUniform = program.GetUniform(entt::hashed_string::value("u_skyAlphaThreshold"));
+		const bool resolved = bgfx::isValid(heightMapSampler) && bgfx::isValid(islandExtentUniform) &&
+		                      bgfx::isValid(bonesSampler) && bgfx::isValid(boneTextureSizeUniform) &&
+		                      bgfx::isValid(diffuseSampler) && bgfx::isValid(skyAlphaThresholdUniform);
+		if (!resolved)
+		{
+			// Looking them up by name would warn for every draw
+			std::fprintf(stderr, "The uniforms of the shader binaries were not created\n");
+			returnCode = EXIT_FAILURE;
+		}
+		else
+		{
+			const auto byName = Measure(args, program.GetRawHandle(), vertexBuffer, [&](uint32_t primitive) {
+				const auto skyAlphaThreshold = glm::vec4(0.0f, static_cast<float>(primitive % 2) * 0.5f, 0.0f, 0.0f);
+				program.SetTextureSampler("s_heightmap", 1, texture);
+				program.SetUniformValue("u_islandExtent", &islandExtent);
+				program.SetTextureSampler("s_bones", 2, texture);
+				program.SetUniformValue("u_boneTextureSize", &boneTextureSize);
+				program.SetTextureSampler("s_diffuse", 0, texture);
+				program.SetUniformValue("u_skyAlphaThreshold", &skyAlphaThreshold);
+			});
+
+			const auto byHandle = Measure(args, program.GetRawHandle(), vertexBuffer, [&](uint32_t primitive) {
+				const auto skyAlphaThreshold = glm::vec4(0.0f, static_cast<float>(primitive % 2) * 0.5f, 0.0f, 0.0f);
+				ShaderProgram::SetTextureSampler(heightMapSampler, 1, texture);
+				ShaderProgram::SetUniformValue(islandExtentUniform, &islandExtent);
+				ShaderProgram::SetTextureSampler(bonesSampler, 2, texture);
+				ShaderProgram::SetUniformValue(boneTextureSizeUniform, &boneTextureSize);
+				ShaderProgram::SetTextureSampler(diffuseSampler, 0, texture);
+				ShaderProgram::SetUniformValue(skyAlphaThresholdUniform, &skyAlphaThreshold);
+			});
+
+			std::printf("%10s %12s %12s %9s\n", "primitives", "name (ms)", "handle (ms)", "speedup");
+			std::printf("%10u %12.3f %12.3f %8.2fx\n", args.primitives, byName.count(), byHandle.count(), byName / byHandle);
+		}
+
+		bgfx::destroy(texture);
+		bgfx::destroy(vertexBuffer);
+	}
+	bgfx::shutdown();
+
+	return returnCode;
+}
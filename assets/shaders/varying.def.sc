@@ -12,6 +12,7 @@ vec4 i_data0             : TEXCOORD7;
 vec4 i_data1             : TEXCOORD6;
 vec4 i_data2             : TEXCOORD5;
 vec4 i_data3             : TEXCOORD4;
+vec4 i_data4             : TEXCOORD3;
 
 vec4 v_position          : TEXCOORD1 = vec4(0.0, 0.0, 0.0, 0.0);
 vec4 v_color0            : COLOR0    = vec4(1.0, 0.0, 0.0, 1.0);
@@ -18,6 +18,25 @@ SAMPLER2D(s_heightmap, 1);
 uniform vec4 u_islandExtent;
 #endif // USE_HEIGHT_MAP
 
+#ifdef USE_INSTANCING
+SAMPLER2D(s_bones, 2);
+uniform vec4 u_boneTextureSize; // width, height, 1 / width, 1 / height
+
+// Each matrix of the bone texture is stored as its 4 columns in consecutive texels of a row
+mat4 getBone(float index)
+{
+	float texel = index * 4.0;
+	float row = floor(texel * u_boneTextureSize.z);
+	vec2 uv = (vec2(texel - row * u_boneTextureSize.x, row) + 0.5) * u_boneTextureSize.zw;
+	vec2 next = vec2(u_boneTextureSize.z, 0.0);
+	return mtxFromCols(
+		texture2DLod(s_bones, uv, 0.0),
+		texture2DLod(s_bones, uv + next, 0.0),
+		texture2DLod(s_bones, uv + 2.0 * next, 0.0),
+		texture2DLod(s_bones, uv + 3.0 * next, 0.0));
+}
+#endif // USE_INSTANCING
+
 void main()
 {
 	// Unpack
@@ -32,7 +51,15 @@ void main()
 	uint modelIndex = uint(max(0, a_indices.x));
 #endif
 
-	v_position = mul(u_model[modelIndex], vec4(a_position.xyz, 1.0f));
+	mat4 bone = u_model[modelIndex];
+#ifdef USE_INSTANCING
+	// Animated instances have their own bone palette, the others use the bind pose
+	if (i_data4.x >= 0.0)
+	{
+		bone = getBone(i_data4.x + float(modelIndex));
+	}
+#endif // USE_INSTANCING
+	v_position = mul(bone, vec4(a_position.xyz, 1.0f));
 
 #ifdef USE_INSTANCING
 	mat4 model;
@@ -1,21 +1,21 @@
-$input a_position
-$output v_texcoord0
+$input a_position, i_data0, i_data1, i_data2, i_data3, i_data4
+$output v_texcoord0, v_color0
 
 #include <bgfx_shader.sh>
 
-uniform vec4 u_sampleRect;
-
 void main()
 {
 	// Plane position to UV
 	v_texcoord0.xy = vec2(a_position.x * 0.5f + 0.5f, 0.5f - a_position.y * 0.5f);
 	// Zoom on section of sprite to render
-	v_texcoord0.xy = v_texcoord0.xy * u_sampleRect.xy + u_sampleRect.zw;
+	v_texcoord0.xy = v_texcoord0.xy * i_data3.xy + i_data3.zw;
+	v_color0 = i_data4;
 
-	vec3 translation = mul(u_model[0], vec4(0.0f, 0.0f, 0.0f, 1.0f)).xyz;
+	// The first three instance vectors hold the rotated and scaled axes with the translation in w
+	vec3 translation = vec3(i_data0.w, i_data1.w, i_data2.w);
 	vec4 position = a_position;
 	// Apply scaling
-	position.xyz = mul(u_model[0], vec4(position.xyz, 0.0)).xyz;
+	position.xyz = i_data0.xyz * position.x + i_data1.xyz * position.y + i_data2.xyz * position.z;
 	// Undo camera rotation so sprite faces camera
 	position.xyz = mul(u_invView, vec4(position.xyz, 0.0)).xyz;
 	// Apply translation
@@ -14,7 +14,6 @@
 #include <array>
 #include <filesystem>
 #include <functional>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -37,12 +36,18 @@ class LHVM
 	VMTask* _currentTask {nullptr};
 	VMStack* _currentStack {nullptr};
 	std::vector<VMVar> _variables;
-	std::map<uint32_t, VMTask> _tasks;
+	/// Running tasks ordered by id, stopped ones are kept in \ref _freeTasks to reuse their allocations
+	std::vector<VMTask> _tasks;
+	/// Started while the tasks are running, added to \ref _tasks once the running task has returned
+	std::vector<VMTask> _startedTasks;
+	std::vector<VMTask> _freeTasks;
+	bool _lookingIn {false};
 	uint32_t _ticks {0};
 	uint32_t _currentLineNumber {0};
 	uint32_t _highestTaskId {0};
 	uint32_t _highestScriptId {0};
 	uint32_t _executedInstructions {0};
+	bool _threadedDispatch {true};
 
 	const std::vector<NativeFunction>* _functions {nullptr};
 	std::function<void(const uint32_t func)> _nativeCallEnterCallback;
@@ -52,39 +57,24 @@ class LHVM
 	std::function<void(const uint32_t objId)> _addReference;
 	std::function<void(const uint32_t objId)> _removeReference;
 
-	std::array<void (LHVM::*)(VMTask& task, const VMInstruction& instruction), static_cast<size_t>(Opcode::_Count)>
-	    _opcodesImpl {};
-	void Opcode00End(VMTask& task, const VMInstruction& instruction);
-	void Opcode01Jz(VMTask& task, const VMInstruction& instruction);
-	void Opcode02Push(VMTask& task, const VMInstruction& instruction);
-	void Opcode03Pop(VMTask& task, const VMInstruction& instruction);
-	void Opcode04Add(VMTask& task, const VMInstruction& instruction);
-	void Opcode05Sys(VMTask& task, const VMInstruction& instruction);
-	void Opcode06Sub(VMTask& task, const VMInstruction& instruction);
-	void Opcode07Neg(VMTask& task, const VMInstruction& instruction);
-	void Opcode08Mul(VMTask& task, const VMInstruction& instruction);
-	void Opcode09Div(VMTask& task, const VMInstruction& instruction);
-	void Opcode10Mod(VMTask& task, const VMInstruction& instruction);
-	void Opcode11Not(VMTask& task, const VMInstruction& instruction);
-	void Opcode12And(VMTask& task, const VMInstruction& instruction);
-	void Opcode13Or(VMTask& task, const VMInstruction& instruction);
-	void Opcode14Eq(VMTask& task, const VMInstruction& instruction);
-	void Opcode15Neq(VMTask& task, const VMInstruction& instruction);
-	void Opcode16Geq(VMTask& task, const VMInstruction& instruction);
-	void Opcode17Leq(VMTask& task, const VMInstruction& instruction);
-	void Opcode18Gt(VMTask& task, const VMInstruction& instruction);
-	void Opcode19Lt(VMTask& task, const VMInstruction& instruction);
-	void Opcode20Jmp(VMTask& task, const VMInstruction& instruction);
-	void Opcode21Sleep(VMTask& task, const VMInstruction& instruction);
-	void Opcode22Except(VMTask& task, const VMInstruction& instruction);
-	void Opcode23Cast(VMTask& task, const VMInstruction& instruction);
-	void Opcode24Call(VMTask& task, const VMInstruction& instruction);
-	void Opcode25EndExcept(VMTask& task, const VMInstruction& instruction);
-	void Opcode26RetExcept(VMTask& task, const VMInstruction& instruction);
-	void Opcode27IterExcept(VMTask& task, const VMInstruction& instruction);
-	void Opcode28BrkExcept(VMTask& task, const VMInstruction& instruction);
-	void Opcode29Swap(VMTask& task, const VMInstruction& instruction);
-	void Opcode30Line(VMTask& task, const VMInstruction& instruction);
+	/// Implementation of an instruction, picked once at load time for its opcode, data type and mode
+	enum class Handler : uint8_t;
+	/// Handlers with access to the VM internals, see \ref CpuLoop
+	struct Handlers;
+
+	/// Instruction with its operand validated and resolved by \ref Decode
+	struct DecodedInstruction
+	{
+		Handler handler;
+		DataType type;
+		/// Immediate value, jump target, resolved variable index, native function or script id
+		VMValue data;
+	};
+	/// One entry per instruction plus a trailing one catching tasks running past the end of the code
+	std::vector<DecodedInstruction> _code;
+
+	void Decode();
+	[[nodiscard]] DecodedInstruction Decode(const VMInstruction& instruction, const VMScript& script, uint32_t scriptEnd) const;
 
 	void InvokeNativeCallEnterCallback(uint32_t funcId);
 	void InvokeNativeCallExitCallback(uint32_t funcId);
@@ -99,17 +89,27 @@ class LHVM
 	uint32_t StartScript(uint32_t id);
 	uint32_t StartScript(const VMScript& script);
 	const VMScript* GetScript(const std::string& name);
-	bool TaskExists(uint32_t taskId);
+	VMTask* FindTask(uint32_t taskId);
+	/// Call the stop callback and release the references of a task, which is removed by \ref RemoveReleasedTasks
+	void ReleaseTask(VMTask& task);
+	/// Does nothing while the tasks are running, \ref LookIn removes them at the end of the tick
+	void RemoveReleasedTasks();
+	void AddStartedTasks();
+	static bool IsRunning(std::vector<VMTask>::const_iterator first, std::vector<VMTask>::const_iterator last,
+	                      uint32_t taskId);
 	uint32_t GetTicksCount();
 	void PushElaspedTime();
-	VMVar& GetVar(VMTask& task, uint32_t id);
 	uint32_t GetExceptionHandlersCount();
 	uint32_t GetCurrentExceptionHandlerIp(uint32_t index);
 
 	void PrintInstruction(const VMTask& task, const VMInstruction& instruction);
 	void CpuLoop(VMTask& task);
-
-	static float Fmod(float a, float b);
+	/// True when a handler changed the control state of the task so that the loop must return
+	static bool MustReturn(const VMTask& task, bool wasExceptionHandler);
+#if defined(__GNUC__)
+	void RunThreaded(VMTask& task);
+#endif
+	void RunSwitch(VMTask& task);
 
 public:
 	LHVM();
@@ -153,6 +153,9 @@ class LHVM
 
 	void LookIn(ScriptType allowedScriptTypesMask);
 
+	/// Dispatch with a switch even where threaded code is supported, to compare both
+	void SetThreadedDispatch(bool threaded) { _threadedDispatch = threaded; }
+
 	uint32_t StartScript(const std::string& name, ScriptType allowedScriptTypesMask);
 
 	void StopAllTasks();
@@ -169,8 +172,10 @@ class LHVM
 	[[nodiscard]] const std::vector<VMVar>& GetVariables() const { return _variables; }
 	[[nodiscard]] const std::vector<VMInstruction>& GetInstructions() const { return _instructions; }
 	[[nodiscard]] const std::vector<VMScript>& GetScripts() const { return _scripts; }
-	[[nodiscard]] const std::map<uint32_t, VMTask>& GetTasks() const { return _tasks; }
+	[[nodiscard]] const std::vector<VMTask>& GetTasks() const { return _tasks; }
+	[[nodiscard]] const VMTask* GetTask(uint32_t taskId) const;
 	[[nodiscard]] const std::vector<char>& GetData() const { return _data; }
+	[[nodiscard]] uint32_t GetExecutedInstructions() const { return _executedInstructions; }
 };
 
 } // namespace openblack::lhvm
@@ -0,0 +1,496 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <string_view>
+
+namespace openblack::lhvm
+{
+
+struct NativeFunctionSignature
+{
+	std::string_view name;
+	int32_t stackIn; ///< -1 if the function pops a variable number of arguments itself
+	uint32_t stackOut;
+};
+
+/// Stack effect of the native functions of the game indexed by their id, for tools running scripts without the game.
+/// Must match the functions table of CHLApi.
+constexpr std::array<NativeFunctionSignature, 464> k_NativeFunctionSignatures {{
+    {"NONE", 0, 0},
+    {"SET_CAMERA_POSITION", 3, 0},
+    {"SET_CAMERA_FOCUS", 3, 0},
+    {"MOVE_CAMERA_POSITION", 4, 0},
+    {"MOVE_CAMERA_FOCUS", 4, 0},
+    {"GET_CAMERA_POSITION", 0, 3},
+    {"GET_CAMERA_FOCUS", 0, 3},
+    {"SPIRIT_EJECT", 1, 0},
+    {"SPIRIT_HOME", 1, 0},
+    {"SPIRIT_POINT_POS", 5, 0},
+    {"SPIRIT_POINT_GAME_THING", 3, 0},
+    {"GAME_THING_FIELD_OF_VIEW", 1, 1},
+    {"POS_FIELD_OF_VIEW", 3, 1},
+    {"RUN_TEXT", 3, 0},
+    {"TEMP_TEXT", 3, 0},
+    {"TEXT_READ", 0, 1},
+    {"GAME_THING_CLICKED", 1, 1},
+    {"SET_SCRIPT_STATE", 2, 0},
+    {"SET_SCRIPT_STATE_POS", 4, 0},
+    {"SET_SCRIPT_FLOAT", 2, 0},
+    {"SET_SCRIPT_ULONG", 3, 0},
+    {"GET_PROPERTY", 2, 1},
+    {"SET_PROPERTY", 3, 0},
+    {"GET_POSITION", 1, 3},
+    {"SET_POSITION", 4, 0},
+    {"GET_DISTANCE", 6, 1},
+    {"CALL", 6, 1},
+    {"CREATE", 5, 1},
+    {"RANDOM", 2, 1},
+    {"DLL_GETTIME", 0, 1},
+    {"START_CAMERA_CONTROL", 0, 1},
+    {"END_CAMERA_CONTROL", 0, 0},
+    {"SET_WIDESCREEN", 1, 0},
+    {"MOVE_GAME_THING", 5, 0},
+    {"SET_FOCUS", 4, 0},
+    {"HAS_CAMERA_ARRIVED", 0, 1},
+    {"FLOCK_CREATE", 3, 1},
+    {"FLOCK_ATTACH", 3, 1},
+    {"FLOCK_DETACH", 2, 1},
+    {"FLOCK_DISBAND", 1, 0},
+    {"ID_SIZE", 1, 1},
+    {"FLOCK_MEMBER", 2, 1},
+    {"GET_HAND_POSITION", 0, 3},
+    {"PLAY_SOUND_EFFECT", 6, 0},
+    {"START_MUSIC", 1, 0},
+    {"STOP_MUSIC", 0, 0},
+    {"ATTACH_MUSIC", 2, 0},
+    {"DETACH_MUSIC", 1, 0},
+    {"OBJECT_DELETE", 2, 0},
+    {"FOCUS_FOLLOW", 1, 0},
+    {"POSITION_FOLLOW", 1, 0},
+    {"CALL_NEAR", 7, 1},
+    {"SPECIAL_EFFECT_POSITION", 5, 1},
+    {"SPECIAL_EFFECT_OBJECT", 3, 1},
+    {"DANCE_CREATE", 6, 1},
+    {"CALL_IN", 4, 1},
+    {"CHANGE_INNER_OUTER_PROPERTIES", 4, 0},
+    {"SNAPSHOT", -1, 0},
+    {"GET_ALIGNMENT", 1, 1},
+    {"SET_ALIGNMENT", 2, 0},
+    {"INFLUENCE_OBJECT", 4, 1},
+    {"INFLUENCE_POSITION", 6, 1},
+    {"GET_INFLUENCE", 5, 1},
+    {"SET_INTERFACE_INTERACTION", 1, 0},
+    {"PLAYED", 1, 1},
+    {"RANDOM_ULONG", 2, 1},
+    {"SET_GAMESPEED", 1, 0},
+    {"CALL_IN_NEAR", 8, 1},
+    {"OVERRIDE_STATE_ANIMATION", 2, 0},
+    {"CREATURE_CREATE_RELATIVE_TO_CREATURE", 6, 1},
+    {"CREATURE_LEARN_EVERYTHING", 1, 0},
+    {"CREATURE_SET_KNOWS_ACTION", 4, 0},
+    {"CREATURE_SET_AGENDA_PRIORITY", 2, 0},
+    {"CREATURE_TURN_OFF_ALL_DESIRES", 1, 0},
+    {"CREATURE_LEARN_DISTINCTION_ABOUT_ACTIVITY_OBJECT", 4, 0},
+    {"CREATURE_DO_ACTION", 4, 0},
+    {"IN_CREATURE_HAND", 2, 1},
+    {"CREATURE_SET_DESIRE_VALUE", 3, 0},
+    {"CREATURE_SET_DESIRE_ACTIVATED", 3, 0},
+    {"CREATURE_SET_DESIRE_ACTIVATED", 2, 0},
+    {"CREATURE_SET_DESIRE_MAXIMUM", 3, 0},
+    {"CONVERT_CAMERA_POSITION", 1, 3},
+    {"CONVERT_CAMERA_FOCUS", 1, 3},
+    {"CREATURE_SET_PLAYER", 1, 0},
+    {"START_COUNTDOWN_TIMER", 1, 0},
+    {"CREATURE_INITIALISE_NUM_TIMES_PERFORMED_ACTION", 2, 0},
+    {"CREATURE_GET_NUM_TIMES_ACTION_PERFORMED", 2, 1},
+    {"REMOVE_COUNTDOWN_TIMER", 0, 0},
+    {"GET_OBJECT_DROPPED", 1, 1},
+    {"CLEAR_DROPPED_BY_OBJECT", 1, 0},
+    {"CREATE_REACTION", 2, 0},
+    {"REMOVE_REACTION", 1, 0},
+    {"GET_COUNTDOWN_TIMER", 0, 1},
+    {"START_DUAL_CAMERA", 2, 0},
+    {"UPDATE_DUAL_CAMERA", 2, 0},
+    {"RELEASE_DUAL_CAMERA", 0, 0},
+    {"SET_CREATURE_HELP", 1, 0},
+    {"GET_TARGET_OBJECT", 1, 1},
+    {"CREATURE_DESIRE_IS", 2, 1},
+    {"COUNTDOWN_TIMER_EXISTS", 0, 1},
+    {"LOOK_GAME_THING", 2, 0},
+    {"GET_OBJECT_DESTINATION", 1, 3},
+    {"CREATURE_FORCE_FINISH", 1, 0},
+    {"HIDE_COUNTDOWN_TIMER", 0, 0},
+    {"GET_ACTION_TEXT_FOR_OBJECT", 1, 1},
+    {"CREATE_DUAL_CAMERA_WITH_POINT", 4, 0},
+    {"SET_CAMERA_TO_FACE_OBJECT", 2, 0},
+    {"MOVE_CAMERA_TO_FACE_OBJECT", 3, 0},
+    {"GET_MOON_PERCENTAGE", 0, 1},
+    {"POPULATE_CONTAINER", 4, 0},
+    {"ADD_REFERENCE", 1, 1},
+    {"REMOVE_REFERENCE", 1, 1},
+    {"SET_GAME_TIME", 1, 0},
+    {"GET_GAME_TIME", 0, 1},
+    {"GET_REAL_TIME", 0, 1},
+    {"GET_REAL_DAY", 0, 1},
+    {"GET_REAL_DAY", 0, 1},
+    {"GET_REAL_MONTH", 0, 1},
+    {"GET_REAL_YEAR", 0, 1},
+    {"RUN_CAMERA_PATH", 1, 0},
+    {"START_DIALOGUE", 0, 1},
+    {"END_DIALOGUE", 0, 0},
+    {"IS_DIALOGUE_READY", 0, 1},
+    {"CHANGE_WEATHER_PROPERTIES", 6, 0},
+    {"CHANGE_LIGHTNING_PROPERTIES", 5, 0},
+    {"CHANGE_TIME_FADE_PROPERTIES", 3, 0},
+    {"CHANGE_CLOUD_PROPERTIES", 4, 0},
+    {"SET_HEADING_AND_SPEED", 5, 0},
+    {"START_GAME_SPEED", 0, 0},
+    {"END_GAME_SPEED", 0, 0},
+    {"BUILD_BUILDING", 4, 0},
+    {"SET_AFFECTED_BY_WIND", 2, 0},
+    {"WIDESCREEN_TRANSISTION_FINISHED", 0, 1},
+    {"GET_RESOURCE", 2, 1},
+    {"ADD_RESOURCE", 3, 1},
+    {"REMOVE_RESOURCE", 3, 1},
+    {"GET_TARGET_RELATIVE_POS", 8, 3},
+    {"STOP_POINTING", 1, 0},
+    {"STOP_LOOKING", 1, 0},
+    {"LOOK_AT_POSITION", 4, 0},
+    {"PLAY_SPIRIT_ANIM", 5, 0},
+    {"CALL_IN_NOT_NEAR", 8, 1},
+    {"SET_CAMERA_ZONE", 1, 0},
+    {"GET_OBJECT_STATE", 1, 1},
+    {"REVEAL_COUNTDOWN_TIMER", 0, 0},
+    {"SET_TIMER_TIME", 2, 0},
+    {"CREATE_TIMER", 1, 1},
+    {"GET_TIMER_TIME_REMAINING", 1, 1},
+    {"GET_TIMER_TIME_SINCE_SET", 1, 1},
+    {"MOVE_MUSIC", 2, 0},
+    {"GET_INCLUSION_DISTANCE", 0, 1},
+    {"GET_LAND_HEIGHT", 3, 1},
+    {"LOAD_MAP", 1, 0},
+    {"STOP_ALL_SCRIPTS_EXCLUDING", 1, 0},
+    {"STOP_ALL_SCRIPTS_IN_FILES_EXCLUDING", 1, 0},
+    {"STOP_SCRIPT", 1, 0},
+    {"CLEAR_CLICKED_OBJECT", 0, 0},
+    {"CLEAR_CLICKED_POSITION", 0, 0},
+    {"POSITION_CLICKED", 4, 1},
+    {"RELEASE_FROM_SCRIPT", 1, 0},
+    {"GET_OBJECT_HAND_IS_OVER", 0, 1},
+    {"ID_POISONED_SIZE", 1, 1},
+    {"IS_POISONED", 1, 1},
+    {"CALL_POISONED_IN", 4, 1},
+    {"CALL_NOT_POISONED_IN", 4, 1},
+    {"SPIRIT_PLAYED", 1, 1},
+    {"CLING_SPIRIT", 3, 0},
+    {"FLY_SPIRIT", 3, 0},
+    {"SET_ID_MOVEABLE", 2, 0},
+    {"SET_ID_PICKUPABLE", 2, 0},
+    {"IS_ON_FIRE", 1, 1},
+    {"IS_FIRE_NEAR", 4, 1},
+    {"STOP_SCRIPTS_IN_FILES", 1, 0},
+    {"SET_POISONED", 2, 0},
+    {"SET_TEMPERATURE", 2, 0},
+    {"SET_ON_FIRE", 3, 0},
+    {"SET_TARGET", 5, 0},
+    {"WALK_PATH", 5, 0},
+    {"FOCUS_AND_POSITION_FOLLOW", 2, 0},
+    {"GET_WALK_PATH_PERCENTAGE", 1, 1},
+    {"CAMERA_PROPERTIES", 4, 0},
+    {"ENABLE_DISABLE_MUSIC", 2, 0},
+    {"GET_MUSIC_OBJ_DISTANCE", 1, 1},
+    {"GET_MUSIC_ENUM_DISTANCE", 1, 1},
+    {"SET_MUSIC_PLAY_POSITION", 4, 0},
+    {"ATTACH_OBJECT_LEASH_TO_OBJECT", 2, 0},
+    {"ATTACH_OBJECT_LEASH_TO_HAND", 1, 0},
+    {"DETACH_OBJECT_LEASH", 1, 0},
+    {"SET_CREATURE_ONLY_DESIRE", 3, 0},
+    {"SET_CREATURE_ONLY_DESIRE_OFF", 1, 0},
+    {"RESTART_MUSIC", 1, 0},
+    {"MUSIC_PLAYED", 1, 1},
+    {"IS_OF_TYPE", 3, 1},
+    {"CLEAR_HIT_OBJECT", 0, 0},
+    {"GAME_THING_HIT", 1, 1},
+    {"SPELL_AT_THING", 8, 1},
+    {"SPELL_AT_POS", 10, 1},
+    {"CALL_PLAYER_CREATURE", 1, 1},
+    {"GET_SLOWEST_SPEED", 1, 1},
+    {"GET_OBJECT_HELD", 0, 1},
+    {"HELP_SYSTEM_ON", 0, 1},
+    {"SHAKE_CAMERA", 6, 0},
+    {"SET_ANIMATION_MODIFY", 2, 0},
+    {"SET_AVI_SEQUENCE", 2, 0},
+    {"PLAY_GESTURE", 5, 0},
+    {"DEV_FUNCTION", 1, 0},
+    {"HAS_MOUSE_WHEEL", 0, 1},
+    {"NUM_MOUSE_BUTTONS", 0, 1},
+    {"SET_CREATURE_DEV_STAGE", 2, 0},
+    {"SET_FIXED_CAM_ROTATION", 4, 0},
+    {"SWAP_CREATURE", 2, 0},
+    {"GET_ARENA", 5, 1},
+    {"GET_FOOTBALL_PITCH", 1, 1},
+    {"STOP_ALL_GAMES", 1, 0},
+    {"ATTACH_TO_GAME", 3, 0},
+    {"DETACH_FROM_GAME", 3, 0},
+    {"DETACH_UNDEFINED_FROM_GAME", 2, 0},
+    {"SET_ONLY_FOR_SCRIPTS", 2, 0},
+    {"START_MATCH_WITH_REFEREE", 2, 0},
+    {"GAME_TEAM_SIZE", 2, 0},
+    {"GAME_TYPE", 1, 1},
+    {"GAME_SUB_TYPE", 1, 1},
+    {"IS_LEASHED", 1, 1},
+    {"SET_CREATURE_HOME", 4, 0},
+    {"GET_HIT_OBJECT", 0, 1},
+    {"GET_OBJECT_WHICH_HIT", 0, 1},
+    {"GET_NEAREST_TOWN_OF_PLAYER", 5, 1},
+    {"SPELL_AT_POINT", 5, 1},
+    {"SET_ATTACK_OWN_TOWN", 2, 0},
+    {"IS_FIGHTING", 1, 1},
+    {"SET_MAGIC_RADIUS", 2, 0},
+    {"TEMP_TEXT_WITH_NUMBER", 4, 0},
+    {"RUN_TEXT_WITH_NUMBER", 4, 0},
+    {"CREATURE_SPELL_REVERSION", 2, 0},
+    {"GET_DESIRE", 2, 1},
+    {"GET_EVENTS_PER_SECOND", 1, 1},
+    {"GET_TIME_SINCE", 1, 1},
+    {"GET_TOTAL_EVENTS", 1, 1},
+    {"UPDATE_SNAPSHOT", -1, 0},
+    {"CREATE_REWARD", 5, 1},
+    {"CREATE_REWARD_IN_TOWN", 6, 1},
+    {"SET_FADE", 4, 0},
+    {"SET_FADE_IN", 1, 0},
+    {"FADE_FINISHED", 0, 1},
+    {"SET_PLAYER_MAGIC", 3, 0},
+    {"HAS_PLAYER_MAGIC", 2, 1},
+    {"SPIRIT_SPEAKS", 2, 1},
+    {"BELIEF_FOR_PLAYER", 2, 1},
+    {"GET_HELP", 1, 1},
+    {"SET_LEASH_WORKS", 2, 0},
+    {"LOAD_MY_CREATURE", 3, 0},
+    {"OBJECT_RELATIVE_BELIEF", 3, 0},
+    {"CREATE_WITH_ANGLE_AND_SCALE", 7, 1},
+    {"SET_HELP_SYSTEM", 1, 0},
+    {"SET_VIRTUAL_INFLUENCE", 2, 0},
+    {"SET_ACTIVE", 2, 0},
+    {"THING_VALID", 1, 1},
+    {"VORTEX_FADE_OUT", 1, 0},
+    {"REMOVE_REACTION_OF_TYPE", 2, 0},
+    {"CREATURE_LEARN_EVERYTHING_EXCLUDING", 2, 0},
+    {"PLAYED_PERCENTAGE", 1, 1},
+    {"OBJECT_CAST_BY_OBJECT", 2, 1},
+    {"IS_WIND_MAGIC_AT_POS", 1, 1},
+    {"CREATE_MIST", 9, 1},
+    {"SET_MIST_FADE", 6, 0},
+    {"GET_OBJECT_FADE", 1, 1},
+    {"PLAY_HAND_DEMO", 3, 0},
+    {"IS_PLAYING_HAND_DEMO", 0, 1},
+    {"GET_ARSE_POSITION", 1, 3},
+    {"IS_LEASHED_TO_OBJECT", 2, 1},
+    {"GET_INTERACTION_MAGNITUDE", 1, 1},
+    {"IS_CREATURE_AVAILABLE", 1, 1},
+    {"CREATE_HIGHLIGHT", 5, 1},
+    {"GET_OBJECT_HELD", 1, 1},
+    {"GET_ACTION_COUNT", 2, 1},
+    {"GET_OBJECT_LEASH_TYPE", 1, 1},
+    {"SET_FOCUS_FOLLOW", 1, 0},
+    {"SET_POSITION_FOLLOW", 1, 0},
+    {"SET_FOCUS_AND_POSITION_FOLLOW", 2, 0},
+    {"SET_CAMERA_LENS", 1, 0},
+    {"MOVE_CAMERA_LENS", 2, 0},
+    {"CREATURE_REACTION", 2, 0},
+    {"CREATURE_IN_DEV_SCRIPT", 2, 0},
+    {"STORE_CAMERA_DETAILS", 0, 0},
+    {"RESTORE_CAMERA_DETAILS", 0, 0},
+    {"START_ANGLE_SOUND", 1, 0},
+    {"SET_CAMERA_POS_FOC_LENS", 7, 0},
+    {"MOVE_CAMERA_POS_FOC_LENS", 8, 0},
+    {"GAME_TIME_ON_OFF", 1, 0},
+    {"MOVE_GAME_TIME", 2, 0},
+    {"SET_HIGH_GRAPHICS_DETAIL", 2, 0},
+    {"SET_SKELETON", 2, 0},
+    {"IS_SKELETON", 1, 1},
+    {"PLAYER_SPELL_CAST_TIME", 1, 1},
+    {"PLAYER_SPELL_LAST_CAST", 1, 1},
+    {"GET_LAST_SPELL_CAST_POS", 1, 3},
+    {"ADD_SPOT_VISUAL_TARGET_POS", 4, 0},
+    {"ADD_SPOT_VISUAL_TARGET_OBJECT", 2, 0},
+    {"SET_INDESTRUCTABLE", 2, 0},
+    {"SET_GRAPHICS_CLIPPING", 2, 0},
+    {"SPIRIT_APPEAR", 1, 0},
+    {"SPIRIT_DISAPPEAR", 1, 0},
+    {"SET_FOCUS_ON_OBJECT", 2, 0},
+    {"RELEASE_OBJECT_FOCUS", 1, 0},
+    {"IMMERSION_EXISTS", 0, 1},
+    {"SET_DRAW_LEASH", 1, 0},
+    {"SET_DRAW_HIGHLIGHT", 1, 0},
+    {"SET_OPEN_CLOSE", 2, 0},
+    {"SET_INTRO_BUILDING", 1, 0},
+    {"CREATURE_FORCE_FRIENDS", 3, 0},
+    {"MOVE_COMPUTER_PLAYER_POSITION", 6, 0},
+    {"ENABLE_DISABLE_COMPUTER_PLAYER", 2, 0},
+    {"GET_COMPUTER_PLAYER_POSITION", 1, 3},
+    {"SET_COMPUTER_PLAYER_POSITION", 5, 0},
+    {"GET_STORED_CAMERA_POSITION", 0, 3},
+    {"GET_STORED_CAMERA_FOCUS", 0, 3},
+    {"CALL_NEAR_IN_STATE", 8, 1},
+    {"SET_CREATURE_SOUND", 1, 0},
+    {"CREATURE_INTERACTING_WITH", 2, 1},
+    {"SET_SUN_DRAW", 1, 0},
+    {"OBJECT_INFO_BITS", 1, 1},
+    {"SET_HURT_BY_FIRE", 2, 0},
+    {"CONFINED_OBJECT", 5, 0},
+    {"CLEAR_CONFINED_OBJECT", 1, 0},
+    {"GET_OBJECT_FLOCK", 1, 1},
+    {"SET_PLAYER_BELIEF", 3, 0},
+    {"PLAY_JC_SPECIAL", 1, 0},
+    {"IS_PLAYING_JC_SPECIAL", 1, 1},
+    {"VORTEX_PARAMETERS", 8, 0},
+    {"LOAD_CREATURE", 6, 0},
+    {"IS_SPELL_CHARGING", 1, 1},
+    {"IS_THAT_SPELL_CHARGING", 2, 1},
+    {"OPPOSING_CREATURE", 1, 1},
+    {"FLOCK_WITHIN_LIMITS", 1, 1},
+    {"HIGHLIGHT_PROPERTIES", 3, 0},
+    {"LAST_MUSIC_LINE", 1, 1},
+    {"HAND_DEMO_TRIGGER", 0, 1},
+    {"GET_BELLY_POSITION", 1, 3},
+    {"SET_CREATURE_CREED_PROPERTIES", 5, 0},
+    {"GAME_THING_CAN_VIEW_CAMERA", 2, 1},
+    {"GAME_PLAY_SAY_SOUND_EFFECT", 6, 0},
+    {"SET_TOWN_DESIRE_BOOST", 3, 0},
+    {"IS_LOCKED_INTERACTION", 1, 1},
+    {"SET_CREATURE_NAME", 2, 0},
+    {"COMPUTER_PLAYER_READY", 1, 1},
+    {"ENABLE_DISABLE_COMPUTER_PLAYER", 2, 0},
+    {"CLEAR_ACTOR_MIND", 1, 0},
+    {"ENTER_EXIT_CITADEL", 1, 0},
+    {"START_ANGLE_SOUND", 1, 0},
+    {"THING_JC_SPECIAL", 3, 0},
+    {"MUSIC_PLAYED", 1, 1},
+    {"UPDATE_SNAPSHOT_PICTURE", 11, 0},
+    {"STOP_SCRIPTS_IN_FILES_EXCLUDING", 2, 0},
+    {"CREATE_RANDOM_VILLAGER_OF_TRIBE", 4, 1},
+    {"TOGGLE_LEASH", 1, 0},
+    {"GAME_SET_MANA", 2, 0},
+    {"SET_MAGIC_PROPERTIES", 3, 0},
+    {"SET_GAME_SOUND", 1, 0},
+    {"SEX_IS_MALE", 1, 1},
+    {"GET_FIRST_HELP", 1, 1},
+    {"GET_LAST_HELP", 1, 1},
+    {"IS_ACTIVE", 1, 1},
+    {"SET_BOOKMARK_POSITION", 4, 0},
+    {"SET_SCAFFOLD_PROPERTIES", 4, 0},
+    {"SET_COMPUTER_PLAYER_PERSONALITY", 3, 0},
+    {"SET_COMPUTER_PLAYER_SUPPRESSION", 3, 0},
+    {"FORCE_COMPUTER_PLAYER_ACTION", 4, 0},
+    {"QUEUE_COMPUTER_PLAYER_ACTION", 4, 0},
+    {"GET_TOWN_WITH_ID", 1, 1},
+    {"SET_DISCIPLE", 3, 0},
+    {"RELEASE_COMPUTER_PLAYER", 1, 0},
+    {"SET_COMPUTER_PLAYER_SPEED", 2, 0},
+    {"SET_FOCUS_FOLLOW_COMPUTER_PLAYER", 1, 0},
+    {"SET_POSITION_FOLLOW_COMPUTER_PLAYER", 1, 0},
+    {"CALL_COMPUTER_PLAYER", 1, 1},
+    {"CALL_BUILDING_IN_TOWN", 4, 1},
+    {"SET_CAN_BUILD_WORSHIPSITE", 2, 0},
+    {"GET_FACING_CAMERA_POSITION", 1, 3},
+    {"SET_COMPUTER_PLAYER_ATTITUDE", 3, 0},
+    {"GET_COMPUTER_PLAYER_ATTITUDE", 2, 1},
+    {"LOAD_COMPUTER_PLAYER_PERSONALITY", 2, 0},
+    {"SAVE_COMPUTER_PLAYER_PERSONALITY", 2, 0},
+    {"SET_PLAYER_ALLY", 3, 0},
+    {"CALL_FLYING", 7, 1},
+    {"SET_OBJECT_FADE_IN", 2, 0},
+    {"IS_AFFECTED_BY_SPELL", 1, 1},
+    {"SET_MAGIC_IN_OBJECT", 3, 0},
+    {"ID_ADULT_SIZE", 1, 1},
+    {"OBJECT_CAPACITY", 1, 1},
+    {"OBJECT_ADULT_CAPACITY", 1, 1},
+    {"SET_CREATURE_AUTO_FIGHTING", 2, 0},
+    {"IS_AUTO_FIGHTING", 1, 1},
+    {"SET_CREATURE_QUEUE_FIGHT_MOVE", 2, 0},
+    {"SET_CREATURE_QUEUE_FIGHT_SPELL", 2, 0},
+    {"SET_CREATURE_QUEUE_FIGHT_STEP", 2, 0},
+    {"GET_CREATURE_FIGHT_ACTION", 1, 1},
+    {"CREATURE_FIGHT_QUEUE_HITS", 1, 1},
+    {"SQUARE_ROOT", 1, 1},
+    {"GET_PLAYER_ALLY", 2, 1},
+    {"SET_PLAYER_WIND_RESISTANCE", 2, 1},
+    {"GET_PLAYER_WIND_RESISTANCE", 2, 1},
+    {"PAUSE_UNPAUSE_CLIMATE_SYSTEM", 1, 0},
+    {"PAUSE_UNPAUSE_STORM_CREATION_IN_CLIMATE_SYSTEM", 1, 0},
+    {"GET_MANA_FOR_SPELL", 1, 1},
+    {"KILL_STORMS_IN_AREA", 4, 0},
+    {"INSIDE_TEMPLE", 0, 1},
+    {"RESTART_OBJECT", 1, 0},
+    {"SET_GAME_TIME_PROPERTIES", 3, 0},
+    {"RESET_GAME_TIME_PROPERTIES", 0, 0},
+    {"SOUND_EXISTS", 0, 1},
+    {"GET_TOWN_WORSHIP_DEATHS", 1, 1},
+    {"GAME_CLEAR_DIALOGUE", 0, 0},
+    {"GAME_CLOSE_DIALOGUE", 0, 0},
+    {"GET_HAND_STATE", 0, 1},
+    {"SET_INTERFACE_CITADEL", 1, 0},
+    {"MAP_SCRIPT_FUNCTION", 1, 0},
+    {"WITHIN_ROTATION", 0, 1},
+    {"GET_PLAYER_TOWN_TOTAL", 1, 1},
+    {"SPIRIT_SCREEN_POINT", 3, 0},
+    {"KEY_DOWN", 1, 1},
+    {"SET_FIGHT_EXIT", 1, 0},
+    {"GET_OBJECT_CLICKED", 0, 1},
+    {"GET_MANA", 1, 1},
+    {"CLEAR_PLAYER_SPELL_CHARGING", 1, 0},
+    {"STOP_SOUND_EFFECT", 3, 0},
+    {"GET_TOTEM_STATUE", 1, 1},
+    {"SET_SET_ON_FIRE", 2, 0},
+    {"SET_LAND_BALANCE", 2, 0},
+    {"SET_OBJECT_BELIEF_SCALE", 2, 0},
+    {"START_IMMERSION", 1, 0},
+    {"STOP_IMMERSION", 1, 0},
+    {"STOP_ALL_IMMERSION", 0, 0},
+    {"SET_CREATURE_IN_TEMPLE", 1, 0},
+    {"GAME_DRAW_TEXT", 7, 0},
+    {"GAME_DRAW_TEMP_TEXT", 7, 0},
+    {"FADE_ALL_DRAW_TEXT", 1, 0},
+    {"SET_DRAW_TEXT_COLOUR", 3, 0},
+    {"SET_CLIPPING_WINDOW", 5, 0},
+    {"CLEAR_CLIPPING_WINDOW", 1, 0},
+    {"SAVE_GAME_IN_SLOT", 1, 0},
+    {"SET_OBJECT_CARRYING", 2, 0},
+    {"POS_VALID_FOR_CREATURE", 3, 1},
+    {"GET_TIME_SINCE_OBJECT_ATTACKED", 2, 1},
+    {"GET_TOWN_AND_VILLAGER_HEALTH_TOTAL", 1, 1},
+    {"GAME_ADD_FOR_BUILDING", 2, 0},
+    {"ENABLE_DISABLE_ALIGNMENT_MUSIC", 1, 0},
+    {"GET_DEAD_LIVING", 4, 1},
+    {"ATTACH_SOUND_TAG", 4, 0},
+    {"DETACH_SOUND_TAG", 3, 0},
+    {"GET_SACRIFICE_TOTAL", 1, 1},
+    {"GAME_SOUND_PLAYING", 2, 1},
+    {"GET_TEMPLE_POSITION", 1, 3},
+    {"CREATURE_AUTOSCALE", 3, 0},
+    {"GET_SPELL_ICON_IN_TEMPLE", 2, 1},
+    {"GAME_CLEAR_COMPUTER_PLAYER_ACTIONS", 1, 0},
+    {"GET_FIRST_IN_CONTAINER", 1, 1},
+    {"GET_NEXT_IN_CONTAINER", 2, 1},
+    {"GET_TEMPLE_ENTRANCE_POSITION", 3, 3},
+    {"SAY_SOUND_EFFECT_PLAYING", 2, 1},
+    {"SET_HAND_DEMO_KEYS", 1, 0},
+    {"CAN_SKIP_TUTORIAL", 0, 1},
+    {"CAN_SKIP_CREATURE_TRAINING", 0, 1},
+    {"IS_KEEPING_OLD_CREATURE", 0, 1},
+    {"CURRENT_PROFILE_HAS_CREATURE", 0, 1},
+}};
+
+} // namespace openblack::lhvm
@@ -93,6 +93,14 @@ class VMVar
 	std::string name;
 };
 
+/// Variable named by its declaration elsewhere, task locals are named by \ref VMScript::variables
+class VMLocalVar
+{
+public:
+	DataType type {DataType::Float};
+	VMValue value;
+};
+
 class VMStack
 {
 public:
@@ -267,21 +275,19 @@ class VMTask
 public:
 	VMTask() = default;
 
-	VMTask(std::vector<VMVar> localVars, uint32_t scriptId, uint32_t id, uint32_t instructionAddress, uint32_t variablesOffset,
-	       VMStack stack, std::string name, std::string filename, ScriptType type)
+	VMTask(std::vector<VMLocalVar> localVars, uint32_t scriptId, uint32_t id, uint32_t instructionAddress,
+	       uint32_t variablesOffset, VMStack stack, ScriptType type)
 	    : localVars(std::move(localVars))
 	    , scriptId(scriptId)
 	    , id(id)
 	    , instructionAddress(instructionAddress)
 	    , variablesOffset(variablesOffset)
 	    , stack(stack)
-	    , name(std::move(name))
-	    , filename(std::move(filename))
 	    , type(type)
 	{
 	}
 
-	std::vector<VMVar> localVars;
+	std::vector<VMLocalVar> localVars;
 	uint32_t scriptId {0};
 	uint32_t id {0};
 	uint32_t instructionAddress {0};
@@ -296,8 +302,8 @@ class VMTask
 	bool stop {false};
 	bool iield {false};
 	bool sleeping {false};
-	std::string name;
-	std::string filename;
+	/// Stopped by \ref LHVM::StopTask while the VM was running, removed at the end of the tick
+	bool removed {false};
 	ScriptType type {ScriptType::Script};
 };
 
@@ -9,6 +9,7 @@
 
 #include "LHVM.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
@@ -61,42 +62,36 @@ struct imemstream: virtual membuf, std::istream
 	}
 };
 
+// One handler per opcode, data type and mode combination, see LHVM::Decode and LHVM::Handlers
+#define LHVM_HANDLERS(X)                                                                                       \
+	X(End) X(JzForward) X(JzBackward) X(PushImmediate) X(PushGlobal) X(PushLocal) X(PopGlobal) X(PopLocal)     \
+	X(PopDiscard) X(AddInt) X(AddFloat) X(AddVector) X(BinaryInvalid) X(SysNative) X(SysStub) X(SysNotFound)   \
+	X(SubInt) X(SubFloat) X(SubVector) X(NegInt) X(NegFloat) X(NegVector) X(NegInvalid) X(MulInt) X(MulFloat)  \
+	X(MulVector) X(DivInt) X(DivFloat) X(DivVector) X(ModInt) X(ModFloat) X(ModVector) X(Not) X(And) X(Or)     \
+	X(EqInt) X(EqFloat) X(EqVector) X(NeqInt) X(NeqFloat) X(NeqVector) X(EqualityInvalid) X(GeqInt)            \
+	X(GeqFloat) X(LeqInt) X(LeqFloat) X(GtInt) X(GtFloat) X(LtInt) X(LtFloat) X(CompareInvalid) X(JmpForward)  \
+	X(JmpBackward) X(Sleep) X(Except) X(ZeroGlobal) X(ZeroLocal) X(Cast) X(RunSync) X(RunAsync)                \
+	X(RunNotFound) X(EndExcept) X(Yield) X(RetExcept) X(IterExcept) X(BrkExcept) X(Swap) X(CopyFrom)           \
+	X(CopyTo) X(SwapInvalid) X(Line) X(Invalid)
+
+enum class LHVM::Handler : uint8_t
+{
+#define LHVM_HANDLER_ENUM(name) name,
+	LHVM_HANDLERS(LHVM_HANDLER_ENUM)
+#undef LHVM_HANDLER_ENUM
+};
+
+namespace
+{
+float Fmod(float a, float b)
+{
+	return a - b * static_cast<int64_t>(a / b);
+}
+} // namespace
+
 LHVM::LHVM()
 {
 	_currentStack = &_mainStack;
-
-	_opcodesImpl[0] = &LHVM::Opcode00End;
-	_opcodesImpl[1] = &LHVM::Opcode01Jz;
-	_opcodesImpl[2] = &LHVM::Opcode02Push;
-	_opcodesImpl[3] = &LHVM::Opcode03Pop;
-	_opcodesImpl[4] = &LHVM::Opcode04Add;
-	_opcodesImpl[5] = &LHVM::Opcode05Sys;
-	_opcodesImpl[6] = &LHVM::Opcode06Sub;
-	_opcodesImpl[7] = &LHVM::Opcode07Neg;
-	_opcodesImpl[8] = &LHVM::Opcode08Mul;
-	_opcodesImpl[9] = &LHVM::Opcode09Div;
-
-	_opcodesImpl[10] = &LHVM::Opcode10Mod;
-	_opcodesImpl[11] = &LHVM::Opcode11Not;
-	_opcodesImpl[12] = &LHVM::Opcode12And;
-	_opcodesImpl[13] = &LHVM::Opcode13Or;
-	_opcodesImpl[14] = &LHVM::Opcode14Eq;
-	_opcodesImpl[15] = &LHVM::Opcode15Neq;
-	_opcodesImpl[16] = &LHVM::Opcode16Geq;
-	_opcodesImpl[17] = &LHVM::Opcode17Leq;
-	_opcodesImpl[18] = &LHVM::Opcode18Gt;
-	_opcodesImpl[19] = &LHVM::Opcode19Lt;
-	_opcodesImpl[20] = &LHVM::Opcode20Jmp;
-	_opcodesImpl[21] = &LHVM::Opcode21Sleep;
-	_opcodesImpl[22] = &LHVM::Opcode22Except;
-	_opcodesImpl[23] = &LHVM::Opcode23Cast;
-	_opcodesImpl[24] = &LHVM::Opcode24Call;
-	_opcodesImpl[25] = &LHVM::Opcode25EndExcept;
-	_opcodesImpl[26] = &LHVM::Opcode26RetExcept;
-	_opcodesImpl[27] = &LHVM::Opcode27IterExcept;
-	_opcodesImpl[28] = &LHVM::Opcode28BrkExcept;
-	_opcodesImpl[29] = &LHVM::Opcode29Swap;
-	_opcodesImpl[30] = &LHVM::Opcode30Line;
 }
 
 LHVM::~LHVM() = default;
@@ -156,6 +151,7 @@ int LHVM::LoadBinary(const LHVMFile& file)
 	{
 		_variables.emplace_back(DataType::Float, VMValue(0.0f), name);
 	}
+	Decode();
 
 	_tasks.clear();
 	_ticks = 0;
@@ -199,13 +195,20 @@ int LHVM::RestoreState(const std::filesystem::path& filepath)
 	_currentStack = &_mainStack;
 	_variablesNames = file.GetVariablesNames();
 	_variables = file.GetVariablesValues();
+	Decode();
 
 	_auto = file.GetAutostart();
 
-	_tasks.clear();
-	for (const auto& task : file.GetTasks())
+	_tasks = file.GetTasks();
+	std::ranges::sort(_tasks, {}, &VMTask::id);
+	for (auto& task : _tasks)
 	{
-		_tasks.emplace(task.id, task);
+		// Decoded local variable indices are only checked against the script
+		if (task.scriptId > 0 && task.scriptId <= _scripts.size())
+		{
+			const auto count = _scripts[task.scriptId - 1].variables.size();
+			task.localVars.resize(std::max(task.localVars.size(), count));
+		}
 	}
 
 	_ticks = file.GetTicks();
@@ -220,11 +223,11 @@ int LHVM::RestoreState(const std::filesystem::path& filepath)
 VMValue LHVM::Pop(DataType& type)
 {
 	_currentStack->popCount++;
-	if (_currentStack->count > 0)
+	if (_currentStack->count > 0) [[likely]]
 	{
 		_currentStack->count--;
-		type = _currentStack->types.at(_currentStack->count);
-		return _currentStack->values.at(_currentStack->count);
+		type = _currentStack->types[_currentStack->count];
+		return _currentStack->values[_currentStack->count];
 	}
 	type = DataType::None;
 	SignalError(ErrorCode::ErrStackEmpty);
@@ -246,10 +249,10 @@ float LHVM::Popf()
 void LHVM::Push(VMValue value, DataType type)
 {
 	_currentStack->pushCount++;
-	if (_currentStack->count < VMStack::k_Size)
+	if (_currentStack->count < VMStack::k_Size) [[likely]]
 	{
-		_currentStack->values.at(_currentStack->count) = value;
-		_currentStack->types.at(_currentStack->count) = type;
+		_currentStack->values[_currentStack->count] = value;
+		_currentStack->types[_currentStack->count] = type;
 		_currentStack->count++;
 	}
 	else
@@ -291,6 +294,7 @@ void LHVM::Reboot()
 	_scripts.clear();
 	_auto.clear();
 	_instructions.clear();
+	_code.clear();
 	_data.clear();
 
 	_ticks = 0;
@@ -315,25 +319,23 @@ int LHVM::SaveBinary(const std::filesystem::path& filepath)
 
 int LHVM::SaveState(const std::filesystem::path& filepath)
 {
-	std::vector<VMTask> tasks;
-	tasks.reserve(_tasks.size());
-	for (const auto& [id, task] : _tasks)
-	{
-		tasks.emplace_back(task);
-	}
-
 	LHVMFile file(LHVMVersion::BlackAndWhite, _variablesNames, _instructions, _auto, _scripts, _data, _mainStack, _variables,
-	              tasks, _ticks, _currentLineNumber, _highestTaskId, _highestScriptId, _executedInstructions);
+	              _tasks, _ticks, _currentLineNumber, _highestTaskId, _highestScriptId, _executedInstructions);
 	file.Write(filepath);
 	return EXIT_SUCCESS;
 }
 
 void LHVM::LookIn(const ScriptType allowedScriptTypesMask)
 {
+	// Tasks started or stopped while running are only added or removed once the task has returned, see StartScript and
+	// StopTask. Indexing keeps the order of the tasks by id, new ones are appended and run later in the same sweep.
+	_lookingIn = true;
+
 	// execute exception handlers first
-	for (auto& [id, task] : _tasks)
+	for (size_t i = 0; i < _tasks.size(); ++i)
 	{
-		if (task.type & allowedScriptTypesMask)
+		auto& task = _tasks[i];
+		if (!task.removed && task.type & allowedScriptTypesMask)
 		{
 			_currentStack = &task.stack;
 			if (task.inExceptionHandler)
@@ -351,48 +353,63 @@ void LHVM::LookIn(const ScriptType allowedScriptTypesMask)
 					CpuLoop(task);
 				}
 			}
+			AddStartedTasks();
 		}
 	}
 
 	// execute normal code
-	for (auto& [id, task] : _tasks)
+	for (size_t i = 0; i < _tasks.size(); ++i)
 	{
-		if (task.type & allowedScriptTypesMask)
+		auto& task = _tasks[i];
+		if (!task.removed && task.type & allowedScriptTypesMask && !task.inExceptionHandler)
 		{
 			_currentStack = &task.stack;
-			if (!task.inExceptionHandler)
-			{
-				CpuLoop(task);
-			}
+			CpuLoop(task);
+			AddStartedTasks();
 		}
 	}
+	_currentStack = &_mainStack;
 
-	// handle tasks termination
-	for (auto iter = _tasks.begin(); iter != _tasks.end();)
+	// handle tasks termination and unlock waiting tasks while compacting the array
+	size_t kept = 0;
+	for (size_t i = 0; i < _tasks.size(); ++i)
 	{
-		auto& task = (*iter++).second;
-		if (task.stop)
+		auto& task = _tasks[i];
+		if (task.stop && !task.removed)
 		{
-			StopTask(task.id);
+			ReleaseTask(task);
+		}
+		if (task.removed)
+		{
+			_freeTasks.emplace_back(std::move(task));
+			continue;
 		}
-	}
 
-	// unlock waiting tasks
-	for (auto& [id, task] : _tasks)
-	{
 		if (task.type & allowedScriptTypesMask)
 		{
 			task.ticks++;
-			if (task.waitingTaskId != 0 && !TaskExists(task.waitingTaskId))
+			// Only the compacted and the unvisited ranges are intact. Waited tasks are started after the waiting one, so
+			// they are ahead unless the state was restored from an unusual save
+			const auto waitingTaskId = task.waitingTaskId;
+			if (waitingTaskId != 0 && !IsRunning(_tasks.begin() + i + 1, _tasks.end(), waitingTaskId) &&
+			    !IsRunning(_tasks.begin(), _tasks.begin() + kept, waitingTaskId))
 			{
 				task.waitingTaskId = 0;
 				task.instructionAddress++;
 			}
 		}
+		if (kept != i)
+		{
+			_tasks[kept] = std::move(task);
+		}
+		++kept;
 	}
+	_tasks.resize(kept);
+	_lookingIn = false;
+	// Tasks started by the stop callbacks
+	AddStartedTasks();
 
 	_ticks++;
-	_currentStack = &_mainStack;
 }
 
 uint32_t LHVM::StartScript(const std::string& name, const ScriptType allowedScriptTypesMask)
@@ -427,85 +444,131 @@ uint32_t LHVM::StartScript(const VMScript& script)
 {
 	const auto taskNumber = ++_highestTaskId;
 
+	// reuse the allocations of a stopped task
+	VMTask task;
+	if (!_freeTasks.empty())
+	{
+		task = std::move(_freeTasks.back());
+		_freeTasks.pop_back();
+	}
+
 	// copy values from current stack to new stack
-	VMStack stack {};
+	task.stack = {};
 	for (unsigned int i = 0; i < script.parameterCount; i++)
 	{
 		DataType type;
 		const auto& value = Pop(type);
 
-		stack.pushCount++;
-		if (stack.count < 31)
+		task.stack.pushCount++;
+		if (task.stack.count < 31)
 		{
-			stack.values.at(stack.count) = value;
-			stack.types.at(stack.count) = type;
-			stack.count++;
+			task.stack.values[task.stack.count] = value;
+			task.stack.types[task.stack.count] = type;
+			task.stack.count++;
 		}
 	}
 
-	// allocate local variables with default values
-	const auto& scriptVariables = script.variables;
-	std::vector<VMVar> taskVariables;
-	taskVariables.reserve(scriptVariables.size());
-	for (const auto& name : scriptVariables)
-	{
-		taskVariables.emplace_back(DataType::Float, VMValue(0.0f), name);
-	}
+	// allocate local variables with default values, their names are the ones of the script
+	task.localVars.assign(script.variables.size(), {});
 
-	const auto& task = VMTask(taskVariables, script.scriptId, taskNumber, script.instructionAddress, script.variablesOffset,
-	                          stack, script.name, script.filename, script.type);
+	task.scriptId = script.scriptId;
+	task.id = taskNumber;
+	task.instructionAddress = script.instructionAddress;
+	task.pevInstructionAddress = 0;
+	task.waitingTaskId = 0;
+	task.variablesOffset = script.variablesOffset;
+	task.currentExceptionHandlerIndex = 0;
+	task.exceptionHandlerIps.clear();
+	task.ticks = 1;
+	task.inExceptionHandler = false;
+	task.stop = false;
+	task.iield = false;
+	task.sleeping = false;
+	task.removed = false;
+	task.type = script.type;
 
-	_tasks.emplace(taskNumber, task);
+	// don't move the running tasks around
+	(_lookingIn ? _startedTasks : _tasks).emplace_back(std::move(task));
 
 	return taskNumber;
 }
 
-void LHVM::StopAllTasks()
+void LHVM::AddStartedTasks()
 {
-	while (!_tasks.empty())
+	for (auto& task : _startedTasks)
 	{
-		auto iter = _tasks.begin();
-		StopTask((*iter).first);
+		_tasks.emplace_back(std::move(task));
 	}
+	_startedTasks.clear();
 }
 
-void LHVM::StopScripts(std::function<bool(const std::string& name, const std::string& filename)> filter)
+void LHVM::ReleaseTask(VMTask& task)
 {
-	std::vector<uint32_t> ids;
-	for (const auto& [id, task] : _tasks)
+	for (const auto& var : task.localVars)
 	{
-		if (filter(task.name, task.filename))
+		if (var.type == DataType::Object)
 		{
-			ids.emplace_back(id);
+			RemoveReference(var.value.uintVal);
 		}
 	}
 
-	for (const auto id : ids)
+	if (_currentTask == &task)
 	{
-		StopTask(id);
+		_currentStack = &_mainStack;
 	}
+
+	task.stop = true;
+	task.removed = true;
+	// last as the callback may start new tasks
+	InvokeStopTaskCallback(task.id);
 }
 
-void LHVM::StopTask(uint32_t taskNumber)
+void LHVM::RemoveReleasedTasks()
 {
-	if (TaskExists(taskNumber))
+	if (_lookingIn)
 	{
-		InvokeStopTaskCallback(taskNumber);
-		auto& task = _tasks.at(taskNumber);
-		for (auto& var : task.localVars)
+		return;
+	}
+	const auto removed = std::ranges::remove_if(_tasks, &VMTask::removed);
+	for (auto& task : removed)
+	{
+		_freeTasks.emplace_back(std::move(task));
+	}
+	_tasks.erase(removed.begin(), removed.end());
+}
+
+void LHVM::StopAllTasks()
+{
+	for (size_t i = 0; i < _tasks.size(); ++i)
+	{
+		if (!_tasks[i].removed)
 		{
-			if (var.type == DataType::Object)
-			{
-				RemoveReference(var.value.uintVal);
-			}
+			ReleaseTask(_tasks[i]);
 		}
+	}
+	RemoveReleasedTasks();
+}
 
-		if (_currentTask == &task)
+void LHVM::StopScripts(std::function<bool(const std::string& name, const std::string& filename)> filter)
+{
+	for (size_t i = 0; i < _tasks.size(); ++i)
+	{
+		const auto& script = _scripts[_tasks[i].scriptId - 1];
+		if (!_tasks[i].removed && filter(script.name, script.filename))
 		{
-			_currentStack = &_mainStack;
+			ReleaseTask(_tasks[i]);
 		}
+	}
+	RemoveReleasedTasks();
+}
 
-		_tasks.erase(taskNumber);
+void LHVM::StopTask(uint32_t taskNumber)
+{
+	auto* task = FindTask(taskNumber);
+	if (task != nullptr && !task->removed)
+	{
+		ReleaseTask(*task);
+		RemoveReleasedTasks();
 	}
 	else
 	{
@@ -515,19 +578,14 @@ void LHVM::StopTask(uint32_t taskNumber)
 
 void LHVM::StopTasksOfType(const ScriptType typesMask)
 {
-	std::vector<uint32_t> ids;
-	for (const auto& [id, task] : _tasks)
+	for (size_t i = 0; i < _tasks.size(); ++i)
 	{
-		if (task.type & typesMask)
+		if (!_tasks[i].removed && _tasks[i].type & typesMask)
 		{
-			ids.emplace_back(task.id);
+			ReleaseTask(_tasks[i]);
 		}
 	}
-
-	for (const auto id : ids)
-	{
-		StopTask(id);
-	}
+	RemoveReleasedTasks();
 }
 
 std::string LHVM::GetString(uint32_t offset)
@@ -615,9 +673,27 @@ const VMScript* LHVM::GetScript(const std::string& name)
 	return nullptr;
 }
 
-bool LHVM::TaskExists(const uint32_t taskId)
+bool LHVM::IsRunning(std::vector<VMTask>::const_iterator first, std::vector<VMTask>::const_iterator last, uint32_t taskId)
 {
-	return _tasks.contains(taskId);
+	const auto task = std::ranges::lower_bound(first, last, taskId, {}, &VMTask::id);
+	return task != last && task->id == taskId && !task->stop;
+}
+
+VMTask* LHVM::FindTask(uint32_t taskId)
+{
+	const auto task = std::ranges::lower_bound(_tasks, taskId, {}, &VMTask::id);
+	if (task != _tasks.end() && task->id == taskId)
+	{
+		return &*task;
+	}
+	const auto started = std::ranges::find(_startedTasks, taskId, &VMTask::id);
+	return started != _startedTasks.end() ? &*started : nullptr;
+}
+
+const VMTask* LHVM::GetTask(uint32_t taskId) const
+{
+	const auto task = std::ranges::lower_bound(_tasks, taskId, {}, &VMTask::id);
+	return task != _tasks.end() && task->id == taskId && !task->removed ? &*task : nullptr;
 }
 
 uint32_t LHVM::GetTicksCount()
@@ -631,12 +707,6 @@ void LHVM::PushElaspedTime()
 	Pushf(time);
 }
 
-VMVar& LHVM::GetVar(VMTask& task, const uint32_t id)
-{
-	const auto offset = task.variablesOffset;
-	return (id > offset) ? task.localVars.at(id - offset - 1) : _variables.at(id);
-}
-
 uint32_t LHVM::GetExceptionHandlersCount()
 {
 	if (_currentTask != nullptr)
@@ -684,7 +754,7 @@ void LHVM::PrintInstruction(const VMTask& task, const VMInstruction& instruction
 		{
 			if (instruction.data.intVal > task.variablesOffset)
 			{
-				arg = task.localVars[instruction.data.intVal - task.variablesOffset - 1].name;
+				arg = _scripts.at(task.scriptId - 1).variables.at(instruction.data.intVal - task.variablesOffset - 1);
 			}
 			else
 			{
@@ -712,775 +782,964 @@ void LHVM::PrintInstruction(const VMTask& task, const VMInstruction& instruction
 			arg += val ? " [true] -> continue" : " [false] -> JUMP";
 		}
 	}
-	printf("%s:%d %s[%d] %s %s\n", task.filename.c_str(), instruction.line, task.name.c_str(), task.id, opcode.c_str(),
+	const auto& script = _scripts.at(task.scriptId - 1);
+	printf("%s:%d %s[%d] %s %s\n", script.filename.c_str(), instruction.line, script.name.c_str(), task.id, opcode.c_str(),
 	       arg.c_str());
 }
 
-void LHVM::CpuLoop(VMTask& task)
-{
-	const auto wasExceptionHandler = task.inExceptionHandler;
-	task.iield = false;
-	while (task.waitingTaskId == 0)
-	{
-		_currentTask = &task;
-		_executedInstructions++;
-		const auto& instruction = _instructions.at(task.instructionAddress);
-
-		// PrintInstruction(task, instruction); // just for debug purposes
-
-		(this->*_opcodesImpl.at(static_cast<int>(instruction.code)))(task, instruction);
-
-		if (task.stop || task.iield || task.waitingTaskId != 0 || task.inExceptionHandler != wasExceptionHandler)
+LHVM::DecodedInstruction LHVM::Decode(const VMInstruction& instruction, const VMScript& script, uint32_t scriptEnd) const
+{
+	const auto invalid = DecodedInstruction {Handler::Invalid, instruction.type, instruction.data};
+	const auto withHandler = [&instruction](Handler handler) {
+		return DecodedInstruction {handler, instruction.type, instruction.data};
+	};
+	const auto withData = [&instruction](Handler handler, uint32_t data) {
+		return DecodedInstruction {handler, instruction.type, VMValue(data)};
+	};
+	// Jumps and exception handlers never leave the script, this keeps local variable indices valid
+	const auto isInScript = [&script, scriptEnd](uint32_t address) {
+		return address >= script.instructionAddress && address <= scriptEnd;
+	};
+	const auto byType = [&instruction](Handler ints, Handler floats, Handler vectors, Handler others) {
+		switch (instruction.type)
 		{
-			break;
+		case DataType::Int:
+			return ints;
+		case DataType::Float:
+			return floats;
+		case DataType::Vector:
+			return vectors;
+		default:
+			return others;
 		}
-		task.instructionAddress++;
+	};
+	const auto variable = [this, &script, &instruction](Handler globalHandler, Handler localHandler, Handler invalidHandler,
+	                                                    uint32_t& index) {
+		const auto id = instruction.data.uintVal;
+		if (id > script.variablesOffset)
+		{
+			index = id - script.variablesOffset - 1;
+			return index < script.variables.size() ? localHandler : invalidHandler;
+		}
+		index = id;
+		return index < _variables.size() ? globalHandler : invalidHandler;
+	};
+
+	uint32_t index = 0;
+	Handler handler;
+	switch (instruction.code)
+	{
+	case Opcode::End:
+		return withHandler(Handler::End);
+	case Opcode::Wait:
+		if (!isInScript(instruction.data.uintVal))
+		{
+			return invalid;
+		}
+		return withHandler(instruction.mode == VMMode::Forward ? Handler::JzForward : Handler::JzBackward);
+	case Opcode::Push:
+		if (instruction.mode == VMMode::Immediate)
+		{
+			return withHandler(Handler::PushImmediate);
+		}
+		handler = variable(Handler::PushGlobal, Handler::PushLocal, Handler::Invalid, index);
+		return withData(handler, index);
+	case Opcode::Pop:
+		if (instruction.mode != VMMode::Reference)
+		{
+			return withHandler(Handler::PopDiscard);
+		}
+		handler = variable(Handler::PopGlobal, Handler::PopLocal, Handler::Invalid, index);
+		return withData(handler, index);
+	case Opcode::Add:
+		return withHandler(byType(Handler::AddInt, Handler::AddFloat, Handler::AddVector, Handler::BinaryInvalid));
+	case Opcode::Sys:
+	{
+		const auto id = instruction.data.uintVal;
+		if (_functions == nullptr || id == 0 || id >= _functions->size())
+		{
+			return withHandler(Handler::SysNotFound);
+		}
+		return withHandler((*_functions)[id].impl != nullptr ? Handler::SysNative : Handler::SysStub);
+	}
+	case Opcode::Sub:
+		return withHandler(byType(Handler::SubInt, Handler::SubFloat, Handler::SubVector, Handler::BinaryInvalid));
+	case Opcode::Neg:
+		return withHandler(byType(Handler::NegInt, Handler::NegFloat, Handler::NegVector, Handler::NegInvalid));
+	case Opcode::Mul:
+		return withHandler(byType(Handler::MulInt, Handler::MulFloat, Handler::MulVector, Handler::BinaryInvalid));
+	case Opcode::Div:
+		return withHandler(byType(Handler::DivInt, Handler::DivFloat, Handler::DivVector, Handler::BinaryInvalid));
+	case Opcode::Mod:
+		return withHandler(byType(Handler::ModInt, Handler::ModFloat, Handler::ModVector, Handler::BinaryInvalid));
+	case Opcode::Not:
+		return withHandler(Handler::Not);
+	case Opcode::And:
+		return withHandler(Handler::And);
+	case Opcode::Or:
+		return withHandler(Handler::Or);
+	case Opcode::Eq:
+		if (instruction.type == DataType::Boolean || instruction.type == DataType::Object)
+		{
+			// Compared on their integer representation
+			return withHandler(Handler::EqInt);
+		}
+		return withHandler(byType(Handler::EqInt, Handler::EqFloat, Handler::EqVector, Handler::EqualityInvalid));
+	case Opcode::Ne:
+		if (instruction.type == DataType::Boolean || instruction.type == DataType::Object)
+		{
+			return withHandler(Handler::NeqInt);
+		}
+		return withHandler(byType(Handler::NeqInt, Handler::NeqFloat, Handler::NeqVector, Handler::EqualityInvalid));
+	case Opcode::Ge:
+		return withHandler(byType(Handler::GeqInt, Handler::GeqFloat, Handler::CompareInvalid, Handler::CompareInvalid));
+	case Opcode::Le:
+		return withHandler(byType(Handler::LeqInt, Handler::LeqFloat, Handler::CompareInvalid, Handler::CompareInvalid));
+	case Opcode::Gt:
+		return withHandler(byType(Handler::GtInt, Handler::GtFloat, Handler::CompareInvalid, Handler::CompareInvalid));
+	case Opcode::Lt:
+		return withHandler(byType(Handler::LtInt, Handler::LtFloat, Handler::CompareInvalid, Handler::CompareInvalid));
+	case Opcode::Jmp:
+		if (!isInScript(instruction.data.uintVal))
+		{
+			return invalid;
+		}
+		return withHandler(instruction.mode == VMMode::Forward ? Handler::JmpForward : Handler::JmpBackward);
+	case Opcode::Sleep:
+		return withHandler(Handler::Sleep);
+	case Opcode::Except:
+		return isInScript(instruction.data.uintVal) ? withHandler(Handler::Except) : invalid;
+	case Opcode::Cast:
+		if (instruction.mode != VMMode::Zero)
+		{
+			return withHandler(Handler::Cast);
+		}
+		handler = variable(Handler::ZeroGlobal, Handler::ZeroLocal, Handler::Invalid, index);
+		return withData(handler, index);
+	case Opcode::Run:
+		if (instruction.data.uintVal == 0 || instruction.data.uintVal > _scripts.size())
+		{
+			return withHandler(Handler::RunNotFound);
+		}
+		return withHandler(instruction.mode == VMMode::Sync ? Handler::RunSync : Handler::RunAsync);
+	case Opcode::EndExcept:
+		return withHandler(instruction.mode == VMMode::EndExcept ? Handler::EndExcept : Handler::Yield);
+	case Opcode::RetExcept:
+		return withHandler(Handler::RetExcept);
+	case Opcode::FailExcept:
+		return withHandler(Handler::IterExcept);
+	case Opcode::BrkExcept:
+		return withHandler(Handler::BrkExcept);
+	case Opcode::Swap:
+		if (instruction.type == DataType::Int)
+		{
+			return withHandler(Handler::Swap);
+		}
+		if (instruction.data.uintVal == 0 || instruction.data.uintVal >= VMStack::k_Size - 1)
+		{
+			return withHandler(Handler::SwapInvalid);
+		}
+		return withHandler(instruction.mode == VMMode::CopyFrom ? Handler::CopyFrom : Handler::CopyTo);
+	case Opcode::Line:
+		return withHandler(Handler::Line);
+	default:
+		return invalid;
 	}
-	_currentTask = nullptr;
 }
 
-float LHVM::Fmod(float a, float b)
+void LHVM::Decode()
 {
-	return a - b * static_cast<int64_t>(a / b);
+	// Code outside of any script can't be reached by a valid jump
+	_code.assign(_instructions.size() + 1, {Handler::Invalid, DataType::None, VMValue(0u)});
+	for (const auto& script : _scripts)
+	{
+		auto scriptEnd = script.instructionAddress;
+		while (scriptEnd < _instructions.size() && _instructions[scriptEnd].code != Opcode::End)
+		{
+			++scriptEnd;
+		}
+		for (auto address = script.instructionAddress; address <= scriptEnd && address < _instructions.size(); ++address)
+		{
+			_code[address] = Decode(_instructions[address], script, scriptEnd);
+		}
+	}
 }
 
-void LHVM::Opcode00End(VMTask& task, const VMInstruction& /*instruction*/)
+struct LHVM::Handlers
 {
-	task.stop = true;
-}
+	using Instruction = LHVM::DecodedInstruction;
 
-void LHVM::Opcode01Jz(VMTask& task, const VMInstruction& instruction)
-{
-	const bool val = Pop().intVal != 0;
-	if (val)
+	// Each handler returns false when it may have changed the control state of the task (stop, yield, wait or
+	// exception handling), in which case the loop checks whether it has to return
+
+	static bool End(LHVM& /*vm*/, VMTask& task, const Instruction& /*instruction*/)
 	{
-		task.ticks = 1;
+		task.stop = true;
+		return false;
 	}
-	else // jump if popped value isn't zero
+
+	static bool JzForward(LHVM& vm, VMTask& task, const Instruction& instruction)
 	{
-		if (instruction.mode == VMMode::Forward)
+		if (vm.Pop().intVal != 0)
 		{
-			task.instructionAddress = instruction.data.intVal - 1;
+			task.ticks = 1;
 		}
-		else // Mode::BACKWARD
+		else
 		{
-			task.instructionAddress = instruction.data.intVal;
-			task.iield = true;
+			task.instructionAddress = instruction.data.uintVal - 1;
 		}
+		return true;
 	}
-}
 
-void LHVM::Opcode02Push(VMTask& task, const VMInstruction& instruction)
-{
-	if (instruction.mode == VMMode::Immediate)
+	static bool JzBackward(LHVM& vm, VMTask& task, const Instruction& instruction)
 	{
-		Push(instruction.data, instruction.type);
+		if (vm.Pop().intVal != 0)
+		{
+			task.ticks = 1;
+			return true;
+		}
+		task.instructionAddress = instruction.data.uintVal;
+		task.iield = true;
+		return false;
 	}
-	else // Mode::REFERENCE
+
+	static bool PushImmediate(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
 	{
-		const auto& var = GetVar(task, instruction.data.uintVal);
-		Push(var.value, var.type);
+		vm.Push(instruction.data, instruction.type);
+		return true;
 	}
-}
 
-void LHVM::Opcode03Pop(VMTask& task, const VMInstruction& instruction)
-{
-	if (instruction.mode == VMMode::Reference)
+	static bool PushGlobal(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
+	{
+		const auto& var = vm._variables[instruction.data.uintVal];
+		vm.Push(var.value, var.type);
+		return true;
+	}
+
+	static bool PushLocal(LHVM& vm, VMTask& task, const Instruction& instruction)
+	{
+		const auto& var = task.localVars[instruction.data.uintVal];
+		vm.Push(var.value, var.type);
+		return true;
+	}
+
+	template <typename Var>
+	static void PopInto(LHVM& vm, Var& var)
 	{
-		auto& var = GetVar(task, instruction.data.uintVal);
 		DataType type;
-		const auto newVal = Pop(type);
+		const auto newVal = vm.Pop(type);
 		if (type == DataType::Object)
 		{
-			AddReference(newVal.uintVal);
+			vm.AddReference(newVal.uintVal);
 		}
 		if (var.type == DataType::Object)
 		{
-			RemoveReference(newVal.uintVal);
+			vm.RemoveReference(newVal.uintVal);
 		}
 		var.value = newVal;
 		var.type = type;
 	}
-	else // Mode::IMMEDIATE
+
+	static bool PopGlobal(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
 	{
-		Pop(); // cannot POP to immediate value, just discard the value
+		PopInto(vm, vm._variables[instruction.data.uintVal]);
+		return true;
 	}
-}
 
-void LHVM::Opcode04Add(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue a1;
-	VMValue a2;
-	VMValue b0;
-	VMValue b1;
-	VMValue b2;
-	switch (instruction.type)
-	{
-	case DataType::Int:
-		a0 = Pop();
-		b0 = Pop();
-		Pushi(a0.intVal + b0.intVal);
-		break;
-	case DataType::Float:
-		a0 = Pop();
-		b0 = Pop();
-		Pushf(a0.floatVal + b0.floatVal);
-		break;
-	case DataType::Vector:
-		a0 = Pop();
-		a1 = Pop();
-		a2 = Pop();
-		b0 = Pop();
-		b1 = Pop();
-		b2 = Pop();
-		Pushv(a2.floatVal + b2.floatVal);
-		Pushv(a1.floatVal + b1.floatVal);
-		Pushv(a0.floatVal + b0.floatVal);
-		break;
-	default:
-		Pop();
-		Pop();
-		Pushf(0.0f);
-		SignalError(ErrorCode::ErrInvalidType);
+	static bool PopLocal(LHVM& vm, VMTask& task, const Instruction& instruction)
+	{
+		PopInto(vm, task.localVars[instruction.data.uintVal]);
+		return true;
 	}
-}
 
-void LHVM::Opcode05Sys(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	const auto id = instruction.data.intVal;
-	if (id > 0 && id < _functions->size())
+	static bool PopDiscard(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		vm.Pop(); // cannot POP to immediate value, just discard the value
+		return true;
+	}
+
+	template <typename Op>
+	static bool BinaryInt(LHVM& vm, Op op)
+	{
+		const auto a = vm.Pop();
+		const auto b = vm.Pop();
+		vm.Pushi(op(b.intVal, a.intVal));
+		return true;
+	}
+
+	template <typename Op>
+	static bool BinaryFloat(LHVM& vm, Op op)
+	{
+		const auto a = vm.Pop();
+		const auto b = vm.Pop();
+		vm.Pushf(op(b.floatVal, a.floatVal));
+		return true;
+	}
+
+	template <typename Op>
+	static bool BinaryVector(LHVM& vm, Op op)
+	{
+		const auto a0 = vm.Pop();
+		const auto a1 = vm.Pop();
+		const auto a2 = vm.Pop();
+		const auto b0 = vm.Pop();
+		const auto b1 = vm.Pop();
+		const auto b2 = vm.Pop();
+		vm.Pushv(op(b2.floatVal, a2.floatVal));
+		vm.Pushv(op(b1.floatVal, a1.floatVal));
+		vm.Pushv(op(b0.floatVal, a0.floatVal));
+		return true;
+	}
+
+	static bool AddInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return BinaryInt(vm, [](int32_t b, int32_t a) { return a + b; });
+	}
+
+	static bool AddFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return BinaryFloat(vm, [](float b, float a) { return a + b; });
+	}
+
+	static bool AddVector(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
 	{
-		const auto& func = _functions->at(id);
-		if (func.impl != nullptr)
+		return BinaryVector(vm, [](float b, float a) { return a + b; });
+	}
+
+	static bool BinaryInvalid(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		vm.Pop();
+		vm.Pop();
+		vm.Pushf(0.0f);
+		vm.SignalError(ErrorCode::ErrInvalidType);
+		return true;
+	}
+
+	static bool SysNative(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
+	{
+		const auto id = instruction.data.uintVal;
+		vm._currentStack->pushCount = 0;
+		vm._currentStack->popCount = 0;
+		vm.InvokeNativeCallEnterCallback(id);
+		(*vm._functions)[id].impl();
+		vm.InvokeNativeCallExitCallback(id);
+		return false;
+	}
+
+	static bool SysStub(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
+	{
+		// if impl not provided, then just adjust the stack
+		const auto& func = (*vm._functions)[instruction.data.uintVal];
+		for (int i = 0; i < func.stackIn; i++)
 		{
-			_currentStack->pushCount = 0;
-			_currentStack->popCount = 0;
-			InvokeNativeCallEnterCallback(id);
-			func.impl();
-			InvokeNativeCallExitCallback(id);
+			vm.Pop();
 		}
-		else // if impl not provided, then just adjust the stack
+		for (unsigned int i = 0; i < func.stackOut; i++)
 		{
-			for (int i = 0; i < func.stackIn; i++)
-			{
-				Pop();
-			}
-			for (unsigned int i = 0; i < func.stackOut; i++)
-			{
-				Pushf(0.0f);
-			}
+			vm.Pushf(0.0f);
 		}
+		return true;
 	}
-	else
+
+	static bool SysNotFound(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
 	{
-		SignalError(ErrorCode::ErrNativeFuncNotFound, id);
+		vm.SignalError(ErrorCode::ErrNativeFuncNotFound, instruction.data.uintVal);
+		return true;
 	}
-}
 
-void LHVM::Opcode06Sub(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue a1;
-	VMValue a2;
-	VMValue b0;
-	VMValue b1;
-	VMValue b2;
-	switch (instruction.type)
-	{
-	case DataType::Int:
-		a0 = Pop();
-		b0 = Pop();
-		Pushi(b0.intVal - a0.intVal);
-		break;
-	case DataType::Float:
-		a0 = Pop();
-		b0 = Pop();
-		Pushf(b0.floatVal - a0.floatVal);
-		break;
-	case DataType::Vector:
-		a0 = Pop();
-		a1 = Pop();
-		a2 = Pop();
-		b0 = Pop();
-		b1 = Pop();
-		b2 = Pop();
-		Pushv(b2.floatVal - a2.floatVal);
-		Pushv(b1.floatVal - a1.floatVal);
-		Pushv(b0.floatVal - a0.floatVal);
-		break;
-	default:
-		Pop();
-		Pop();
-		Pushf(0.0f);
-		SignalError(ErrorCode::ErrInvalidType);
+	static bool SubInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return BinaryInt(vm, [](int32_t b, int32_t a) { return b - a; });
 	}
-}
 
-void LHVM::Opcode07Neg(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue a1;
-	VMValue a2;
-	switch (instruction.type)
-	{
-	case DataType::Int:
-		a0 = Pop();
-		Pushi(-a0.intVal);
-		break;
-	case DataType::Float:
-		a0 = Pop();
-		Pushf(-a0.floatVal);
-		break;
-	case DataType::Vector:
-		a0 = Pop();
-		a1 = Pop();
-		a2 = Pop();
-		Pushv(-a2.floatVal);
-		Pushv(-a1.floatVal);
-		Pushv(-a0.floatVal);
-		break;
-	default:
-		Pop();
-		Pushf(0.0f);
-		SignalError(ErrorCode::ErrInvalidType);
+	static bool SubFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return BinaryFloat(vm, [](float b, float a) { return b - a; });
 	}
-}
 
-void LHVM::Opcode08Mul(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue a1;
-	VMValue a2;
-	VMValue b0;
-	switch (instruction.type)
-	{
-	case DataType::Int:
-		a0 = Pop();
-		b0 = Pop();
-		Pushi(a0.intVal * b0.intVal);
-		break;
-	case DataType::Float:
-		a0 = Pop();
-		b0 = Pop();
-		Pushf(a0.floatVal * b0.floatVal);
-		break;
-	case DataType::Vector:
-		a0 = Pop();
-		a1 = Pop();
-		a2 = Pop();
-		b0 = Pop();
-		Pushv(a2.floatVal * b0.floatVal);
-		Pushv(a1.floatVal * b0.floatVal);
-		Pushv(a0.floatVal * b0.floatVal);
-		break;
-	default:
-		Pop();
-		Pop();
-		Pushf(0.0f);
-		SignalError(ErrorCode::ErrInvalidType);
+	static bool SubVector(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return BinaryVector(vm, [](float b, float a) { return b - a; });
 	}
-}
 
-void LHVM::Opcode09Div(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue b0;
-	VMValue b1;
-	VMValue b2;
-	switch (instruction.type)
+	static bool NegInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		vm.Pushi(-vm.Pop().intVal);
+		return true;
+	}
+
+	static bool NegFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		vm.Pushf(-vm.Popf());
+		return true;
+	}
+
+	static bool NegVector(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		const auto a0 = vm.Popf();
+		const auto a1 = vm.Popf();
+		const auto a2 = vm.Popf();
+		vm.Pushv(-a2);
+		vm.Pushv(-a1);
+		vm.Pushv(-a0);
+		return true;
+	}
+
+	static bool NegInvalid(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		vm.Pop();
+		vm.Pushf(0.0f);
+		vm.SignalError(ErrorCode::ErrInvalidType);
+		return true;
+	}
+
+	static bool MulInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
 	{
-	case DataType::Int:
-		a0 = Pop();
-		b0 = Pop();
-		if (a0.intVal != 0)
+		return BinaryInt(vm, [](int32_t b, int32_t a) { return a * b; });
+	}
+
+	static bool MulFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return BinaryFloat(vm, [](float b, float a) { return a * b; });
+	}
+
+	/// Vector times scalar
+	static bool MulVector(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		const auto a0 = vm.Popf();
+		const auto a1 = vm.Popf();
+		const auto a2 = vm.Popf();
+		const auto b0 = vm.Popf();
+		vm.Pushv(a2 * b0);
+		vm.Pushv(a1 * b0);
+		vm.Pushv(a0 * b0);
+		return true;
+	}
+
+	static bool DivInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		const auto a0 = vm.Pop().intVal;
+		const auto b0 = vm.Pop().intVal;
+		if (a0 != 0)
 		{
-			Pushi(b0.intVal / a0.intVal);
+			vm.Pushi(b0 / a0);
 		}
 		else
 		{
-			Pushi(0);
-			SignalError(ErrorCode::ErrDivByZero);
+			vm.Pushi(0);
+			vm.SignalError(ErrorCode::ErrDivByZero);
 		}
-		break;
-	case DataType::Float:
-		a0 = Pop();
-		b0 = Pop();
-		if (a0.floatVal != 0.0f)
+		return true;
+	}
+
+	static bool DivFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		const auto a0 = vm.Popf();
+		const auto b0 = vm.Popf();
+		if (a0 != 0.0f)
 		{
-			Pushf(b0.floatVal / a0.floatVal);
+			vm.Pushf(b0 / a0);
 		}
 		else
 		{
-			Pushf(0.0f);
-			SignalError(ErrorCode::ErrDivByZero);
+			vm.Pushf(0.0f);
+			vm.SignalError(ErrorCode::ErrDivByZero);
 		}
-		break;
-	case DataType::Vector:
-		a0 = Pop();
-		b0 = Pop();
-		b1 = Pop();
-		b2 = Pop();
-		if (a0.floatVal != 0.0f)
+		return true;
+	}
+
+	/// Vector divided by scalar
+	static bool DivVector(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		const auto a0 = vm.Popf();
+		const auto b0 = vm.Popf();
+		const auto b1 = vm.Popf();
+		const auto b2 = vm.Popf();
+		if (a0 != 0.0f)
 		{
-			Pushv(b2.floatVal / a0.floatVal);
-			Pushv(b1.floatVal / a0.floatVal);
-			Pushv(b0.floatVal / a0.floatVal);
+			vm.Pushv(b2 / a0);
+			vm.Pushv(b1 / a0);
+			vm.Pushv(b0 / a0);
 		}
 		else
 		{
-			Pushv(0.0f);
-			Pushv(0.0f);
-			Pushv(0.0f);
-			SignalError(ErrorCode::ErrDivByZero);
+			vm.Pushv(0.0f);
+			vm.Pushv(0.0f);
+			vm.Pushv(0.0f);
+			vm.SignalError(ErrorCode::ErrDivByZero);
 		}
-		break;
-	default:
-		Pop();
-		Pop();
-		Pushf(0.0f);
-		SignalError(ErrorCode::ErrInvalidType);
+		return true;
 	}
-}
 
-void LHVM::Opcode10Mod(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue b0;
-	VMValue b1;
-	VMValue b2;
-	switch (instruction.type)
+	static bool ModInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
 	{
-	case DataType::Int:
-		a0 = Pop();
-		b0 = Pop();
-		if (a0.intVal != 0)
+		const auto a0 = vm.Pop().intVal;
+		const auto b0 = vm.Pop().intVal;
+		if (a0 != 0)
 		{
-			Pushi(b0.intVal % a0.intVal);
+			vm.Pushi(b0 % a0);
 		}
 		else
 		{
-			Pushi(0);
-			SignalError(ErrorCode::ErrDivByZero);
+			vm.Pushi(0);
+			vm.SignalError(ErrorCode::ErrDivByZero);
 		}
-		break;
-	case DataType::Float:
-		a0 = Pop();
-		b0 = Pop();
-		if (a0.floatVal != 0.0f)
+		return true;
+	}
+
+	static bool ModFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		const auto a0 = vm.Popf();
+		const auto b0 = vm.Popf();
+		if (a0 != 0.0f)
 		{
-			Pushf(Fmod(b0.floatVal, a0.floatVal));
+			vm.Pushf(Fmod(b0, a0));
 		}
 		else
 		{
-			Pushf(0.0f);
-			SignalError(ErrorCode::ErrDivByZero);
+			vm.Pushf(0.0f);
+			vm.SignalError(ErrorCode::ErrDivByZero);
 		}
-		break;
-	case DataType::Vector:
-		a0 = Pop();
-		b0 = Pop();
-		b1 = Pop();
-		b2 = Pop();
-		if (a0.floatVal != 0.0f)
+		return true;
+	}
+
+	static bool ModVector(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		const auto a0 = vm.Popf();
+		const auto b0 = vm.Popf();
+		const auto b1 = vm.Popf();
+		const auto b2 = vm.Popf();
+		if (a0 != 0.0f)
 		{
-			Pushv(Fmod(b2.floatVal, a0.floatVal));
-			Pushv(Fmod(b1.floatVal, a0.floatVal));
-			Pushv(Fmod(b0.floatVal, a0.floatVal));
+			vm.Pushv(Fmod(b2, a0));
+			vm.Pushv(Fmod(b1, a0));
+			vm.Pushv(Fmod(b0, a0));
 		}
 		else
 		{
-			Pushv(0.0f);
-			Pushv(0.0f);
-			Pushv(0.0f);
-			SignalError(ErrorCode::ErrDivByZero);
+			vm.Pushv(0.0f);
+			vm.Pushv(0.0f);
+			vm.Pushv(0.0f);
+			vm.SignalError(ErrorCode::ErrDivByZero);
 		}
-		break;
-	default:
-		Pop();
-		Pop();
-		Pushf(0.0f);
-		SignalError(ErrorCode::ErrInvalidType);
+		return true;
 	}
-}
 
-void LHVM::Opcode11Not(VMTask& /*task*/, const VMInstruction& /*instruction*/)
-{
-	const bool a = Pop().intVal != 0;
-	Pushb(!a);
-}
+	static bool Not(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		vm.Pushb(vm.Pop().intVal == 0);
+		return true;
+	}
 
-void LHVM::Opcode12And(VMTask& /*task*/, const VMInstruction& /*instruction*/)
-{
-	const bool b = Pop().intVal != 0;
-	const bool a = Pop().intVal != 0;
-	Pushb(a && b);
-}
+	static bool And(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		const bool b = vm.Pop().intVal != 0;
+		const bool a = vm.Pop().intVal != 0;
+		vm.Pushb(a && b);
+		return true;
+	}
 
-void LHVM::Opcode13Or(VMTask& /*task*/, const VMInstruction& /*instruction*/)
-{
-	const bool b = Pop().intVal != 0;
-	const bool a = Pop().intVal != 0;
-	Pushb(a || b);
-}
+	static bool Or(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		const bool b = vm.Pop().intVal != 0;
+		const bool a = vm.Pop().intVal != 0;
+		vm.Pushb(a || b);
+		return true;
+	}
 
-void LHVM::Opcode14Eq(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue a1;
-	VMValue a2;
-	VMValue b0;
-	VMValue b1;
-	VMValue b2;
-	switch (instruction.type)
-	{
-	case DataType::Int:
-	case DataType::Boolean:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.intVal == b0.intVal);
-		break;
-	case DataType::Float:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.floatVal == b0.floatVal);
-		break;
-	case DataType::Vector:
-		b0 = Pop();
-		b1 = Pop();
-		b2 = Pop();
-		a0 = Pop();
-		a1 = Pop();
-		a2 = Pop();
-		Pushb(a0.floatVal == b0.floatVal && a1.floatVal == b1.floatVal && a2.floatVal == b2.floatVal);
-		break;
-	case DataType::Object:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.uintVal == b0.uintVal);
-		break;
-	default:
-		Pop();
-		Pop();
-		Pushb(false);
-		SignalError(ErrorCode::ErrInvalidType);
+	template <typename Op>
+	static bool CompareInt(LHVM& vm, Op op)
+	{
+		const auto b = vm.Pop();
+		const auto a = vm.Pop();
+		vm.Pushb(op(a.intVal, b.intVal));
+		return true;
 	}
-}
 
-void LHVM::Opcode15Neq(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue a1;
-	VMValue a2;
-	VMValue b0;
-	VMValue b1;
-	VMValue b2;
-	switch (instruction.type)
-	{
-	case DataType::Int:
-	case DataType::Boolean:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.intVal != b0.intVal);
-		break;
-	case DataType::Float:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.floatVal != b0.floatVal);
-		break;
-	case DataType::Vector:
-		b0 = Pop();
-		b1 = Pop();
-		b2 = Pop();
-		a0 = Pop();
-		a1 = Pop();
-		a2 = Pop();
-		Pushb(a0.floatVal != b0.floatVal || a1.floatVal != b1.floatVal || a2.floatVal != b2.floatVal);
-		break;
-	case DataType::Object:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.uintVal != b0.uintVal);
-		break;
-	default:
-		Pop();
-		Pop();
-		Pushb(false);
-		SignalError(ErrorCode::ErrInvalidType);
+	template <typename Op>
+	static bool CompareFloat(LHVM& vm, Op op)
+	{
+		const auto b = vm.Popf();
+		const auto a = vm.Popf();
+		vm.Pushb(op(a, b));
+		return true;
 	}
-}
 
-void LHVM::Opcode16Geq(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue b0;
-	switch (instruction.type)
-	{
-	case DataType::Int:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.intVal >= b0.intVal);
-		break;
-	case DataType::Float:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.floatVal >= b0.floatVal);
-		break;
-	default:
-		Pushb(false);
-		SignalError(ErrorCode::ErrInvalidType);
+	static bool EqualVectors(LHVM& vm)
+	{
+		const auto b0 = vm.Popf();
+		const auto b1 = vm.Popf();
+		const auto b2 = vm.Popf();
+		const auto a0 = vm.Popf();
+		const auto a1 = vm.Popf();
+		const auto a2 = vm.Popf();
+		return a0 == b0 && a1 == b1 && a2 == b2;
 	}
-}
 
-void LHVM::Opcode17Leq(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue b0;
-	switch (instruction.type)
-	{
-	case DataType::Int:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.intVal <= b0.intVal);
-		break;
-	case DataType::Float:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.floatVal <= b0.floatVal);
-		break;
-	default:
-		Pushb(false);
-		SignalError(ErrorCode::ErrInvalidType);
+	static bool EqInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return CompareInt(vm, std::equal_to<> {});
 	}
-}
 
-void LHVM::Opcode18Gt(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue b0;
-	switch (instruction.type)
-	{
-	case DataType::Int:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.intVal > b0.intVal);
-		break;
-	case DataType::Float:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.floatVal > b0.floatVal);
-		break;
-	default:
-		Pushb(false);
-		SignalError(ErrorCode::ErrInvalidType);
+	static bool EqFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return CompareFloat(vm, std::equal_to<> {});
 	}
-}
 
-void LHVM::Opcode19Lt(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	VMValue a0;
-	VMValue b0;
-	switch (instruction.type)
-	{
-	case DataType::Int:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.intVal < b0.intVal);
-		break;
-	case DataType::Float:
-		b0 = Pop();
-		a0 = Pop();
-		Pushb(a0.floatVal < b0.floatVal);
-		break;
-	default:
-		Pushb(false);
-		SignalError(ErrorCode::ErrInvalidType);
+	static bool EqVector(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		vm.Pushb(EqualVectors(vm));
+		return true;
 	}
-}
 
-void LHVM::Opcode20Jmp(VMTask& task, const VMInstruction& instruction)
-{
-	if (instruction.mode == VMMode::Forward)
+	static bool NeqInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
 	{
-		task.instructionAddress = instruction.data.intVal - 1;
+		return CompareInt(vm, std::not_equal_to<> {});
 	}
-	else // Mode::BACKWARD
+
+	static bool NeqFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
 	{
-		task.instructionAddress = instruction.data.intVal;
-		task.iield = true;
+		return CompareFloat(vm, std::not_equal_to<> {});
 	}
-}
 
-void LHVM::Opcode21Sleep(VMTask& task, const VMInstruction& /*instruction*/)
-{
-	const auto seconds = Pop().floatVal;
-	if (static_cast<uint32_t>(seconds * 10.0f) < task.ticks)
+	static bool NeqVector(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
 	{
-		task.sleeping = false;
-		Pushb(true);
+		vm.Pushb(!EqualVectors(vm));
+		return true;
 	}
-	else
+
+	static bool EqualityInvalid(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
 	{
-		task.sleeping = true;
-		Pushb(false);
+		vm.Pop();
+		vm.Pop();
+		vm.Pushb(false);
+		vm.SignalError(ErrorCode::ErrInvalidType);
+		return true;
 	}
-}
 
-void LHVM::Opcode22Except(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	if (_currentTask != nullptr)
+	static bool GeqInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
 	{
-		_currentTask->exceptionHandlerIps.emplace_back(instruction.data.uintVal);
+		return CompareInt(vm, std::greater_equal<> {});
 	}
-}
 
-void LHVM::Opcode23Cast(VMTask& task, const VMInstruction& instruction)
-{
-	if (instruction.mode == VMMode::Zero)
+	static bool GeqFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return CompareFloat(vm, std::greater_equal<> {});
+	}
+
+	static bool LeqInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return CompareInt(vm, std::less_equal<> {});
+	}
+
+	static bool LeqFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return CompareFloat(vm, std::less_equal<> {});
+	}
+
+	static bool GtInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return CompareInt(vm, std::greater<> {});
+	}
+
+	static bool GtFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return CompareFloat(vm, std::greater<> {});
+	}
+
+	static bool LtInt(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return CompareInt(vm, std::less<> {});
+	}
+
+	static bool LtFloat(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		return CompareFloat(vm, std::less<> {});
+	}
+
+	static bool CompareInvalid(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		vm.Pushb(false);
+		vm.SignalError(ErrorCode::ErrInvalidType);
+		return true;
+	}
+
+	static bool JmpForward(LHVM& /*vm*/, VMTask& task, const Instruction& instruction)
+	{
+		task.instructionAddress = instruction.data.uintVal - 1;
+		return true;
+	}
+
+	static bool JmpBackward(LHVM& /*vm*/, VMTask& task, const Instruction& instruction)
+	{
+		task.instructionAddress = instruction.data.uintVal;
+		task.iield = true;
+		return false;
+	}
+
+	static bool Sleep(LHVM& vm, VMTask& task, const Instruction& /*instruction*/)
+	{
+		const auto seconds = vm.Popf();
+		task.sleeping = static_cast<uint32_t>(seconds * 10.0f) >= task.ticks;
+		vm.Pushb(!task.sleeping);
+		return true;
+	}
+
+	static bool Except(LHVM& /*vm*/, VMTask& task, const Instruction& instruction)
+	{
+		task.exceptionHandlerIps.emplace_back(instruction.data.uintVal);
+		return true;
+	}
+
+	template <typename Var>
+	static void Zero(LHVM& vm, Var& var)
 	{
-		auto& var = GetVar(task, instruction.data.uintVal);
 		if (var.type == DataType::Object)
 		{
-			RemoveReference(var.value.uintVal);
+			vm.RemoveReference(var.value.uintVal);
 		}
 		var.value.floatVal = 0.0f;
 		var.type = DataType::Float;
 	}
-	else // Mode::CAST
+
+	static bool ZeroGlobal(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
 	{
-		Push(Pop(), instruction.type);
+		Zero(vm, vm._variables[instruction.data.uintVal]);
+		return true;
 	}
-}
 
-void LHVM::Opcode24Call(VMTask& task, const VMInstruction& instruction)
-{
-	const auto newTaskId = StartScript(instruction.data.uintVal);
-	if (instruction.mode == VMMode::Sync)
+	static bool ZeroLocal(LHVM& vm, VMTask& task, const Instruction& instruction)
 	{
-		task.waitingTaskId = newTaskId;
+		Zero(vm, task.localVars[instruction.data.uintVal]);
+		return true;
 	}
-}
 
-void LHVM::Opcode25EndExcept(VMTask& task, const VMInstruction& instruction)
-{
-	if (instruction.mode == VMMode::EndExcept)
+	static bool Cast(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
+	{
+		vm.Push(vm.Pop(), instruction.type);
+		return true;
+	}
+
+	static bool RunSync(LHVM& vm, VMTask& task, const Instruction& instruction)
+	{
+		task.waitingTaskId = vm.StartScript(vm._scripts[instruction.data.uintVal - 1]);
+		return false;
+	}
+
+	static bool RunAsync(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
 	{
-		if (_currentTask != nullptr && !_currentTask->exceptionHandlerIps.empty())
+		vm.StartScript(vm._scripts[instruction.data.uintVal - 1]);
+		return true;
+	}
+
+	static bool RunNotFound(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
+	{
+		vm.SignalError(ErrorCode::ErrScriptIdNotFound, instruction.data.uintVal);
+		return true;
+	}
+
+	static bool EndExcept(LHVM& /*vm*/, VMTask& task, const Instruction& /*instruction*/)
+	{
+		if (!task.exceptionHandlerIps.empty())
 		{
-			_currentTask->exceptionHandlerIps.pop_back();
+			task.exceptionHandlerIps.pop_back();
 		}
+		return true;
 	}
-	else // Mode::Yield
+
+	static bool Yield(LHVM& /*vm*/, VMTask& task, const Instruction& /*instruction*/)
 	{
 		task.iield = true;
 		task.instructionAddress++;
+		return false;
 	}
-}
-
-void LHVM::Opcode26RetExcept(VMTask& task, const VMInstruction& /*instruction*/)
-{
-	task.instructionAddress = task.pevInstructionAddress;
-	task.pevInstructionAddress = 0;
-	task.inExceptionHandler = false;
-}
 
-void LHVM::Opcode27IterExcept(VMTask& task, const VMInstruction& /*instruction*/)
-{
-	task.currentExceptionHandlerIndex++;
-	if (task.currentExceptionHandlerIndex < task.exceptionHandlerIps.size())
+	static bool RetExcept(LHVM& /*vm*/, VMTask& task, const Instruction& /*instruction*/)
 	{
-		task.instructionAddress = GetCurrentExceptionHandlerIp(task.currentExceptionHandlerIndex) - 1;
+		task.instructionAddress = task.pevInstructionAddress;
+		task.pevInstructionAddress = 0;
+		task.inExceptionHandler = false;
+		return false;
 	}
-	else
+
+	static bool IterExcept(LHVM& vm, VMTask& task, const Instruction& /*instruction*/)
 	{
+		task.currentExceptionHandlerIndex++;
+		if (task.currentExceptionHandlerIndex < task.exceptionHandlerIps.size())
+		{
+			task.instructionAddress = vm.GetCurrentExceptionHandlerIp(task.currentExceptionHandlerIndex) - 1;
+			return true;
+		}
 		task.instructionAddress = task.pevInstructionAddress;
 		task.pevInstructionAddress = 0;
 		task.inExceptionHandler = false;
+		return false;
 	}
-}
 
-void LHVM::Opcode28BrkExcept(VMTask& task, const VMInstruction& /*instruction*/)
-{
-	if (_currentTask != nullptr)
+	static bool BrkExcept(LHVM& /*vm*/, VMTask& task, const Instruction& /*instruction*/)
 	{
-		_currentTask->exceptionHandlerIps.clear();
+		task.exceptionHandlerIps.clear();
+		task.pevInstructionAddress = 0;
+		task.instructionAddress++;
+		task.inExceptionHandler = false;
+		return false;
 	}
 
-	task.pevInstructionAddress = 0;
-	task.instructionAddress++;
-	task.inExceptionHandler = false;
-}
-
-void LHVM::Opcode29Swap(VMTask& /*task*/, const VMInstruction& instruction)
-{
-	if (instruction.type == DataType::Int) // swap the 2 topmost values on the stack
+	/// Swap the 2 topmost values on the stack
+	static bool Swap(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
 	{
 		DataType t0;
 		DataType t1;
-		const VMValue v0 = Pop(t0);
-		const VMValue v1 = Pop(t1);
-		Push(v0, t0);
-		Push(v1, t1);
-		return;
+		const VMValue v0 = vm.Pop(t0);
+		const VMValue v1 = vm.Pop(t1);
+		vm.Push(v0, t0);
+		vm.Push(v1, t1);
+		return true;
 	}
-	const auto offset = static_cast<size_t>(instruction.data.intVal);
-	if (offset == 0 || offset >= VMStack::k_Size - 1)
+
+	/// Push a copy of the Nth value from top of the stack
+	static bool CopyFrom(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
 	{
-		SignalError(ErrorCode::ErrInvalidOperand);
-		return;
+		const auto offset = instruction.data.uintVal;
+		std::array<DataType, VMStack::k_Size> tmpTypes {};
+		std::array<VMValue, VMStack::k_Size> tmpVals {};
+		for (uint32_t i = 0; i < offset; i++)
+		{
+			tmpVals[i] = vm.Pop(tmpTypes[i]);
+		}
+		for (auto i = offset; i-- > 0;)
+		{
+			vm.Push(tmpVals[i], tmpTypes[i]);
+		}
+		vm.Push(tmpVals[offset - 1], tmpTypes[offset - 1]);
+		return true;
 	}
-	DataType copyType = DataType::Float;
-	VMValue copyVal(0.0f);
-	std::array<DataType, VMStack::k_Size> tmpTypes;
-	std::array<VMValue, VMStack::k_Size> tmpVals;
-	if (instruction.mode == VMMode::CopyFrom) // push a copy of the Nth value from top of the stack
+
+	/// Insert a copy of the topmost value on the stack N places below
+	static bool CopyTo(LHVM& vm, VMTask& /*task*/, const Instruction& instruction)
 	{
-		for (size_t i = 0; i < offset; i++)
+		const auto offset = instruction.data.uintVal;
+		std::array<DataType, VMStack::k_Size> tmpTypes {};
+		std::array<VMValue, VMStack::k_Size> tmpVals {};
+		for (uint32_t i = 0; i < offset; i++)
 		{
-			DataType ti;
-			const VMValue vi = Pop(ti);
-			if (i == offset - 1)
-			{
-				copyType = ti;
-				copyVal = vi;
-			}
-			if (i < tmpTypes.size())
-			{
-				tmpTypes.at(i) = ti;
-				tmpVals.at(i) = vi;
-			}
+			tmpVals[i] = vm.Pop(tmpTypes[i]);
 		}
-		for (int i = static_cast<int>(std::min(offset, VMStack::k_Size)) - 1; i >= 0; i--)
+		vm.Push(tmpVals[0], tmpTypes[0]);
+		for (auto i = offset; i-- > 0;)
 		{
-			Push(tmpVals.at(i), tmpTypes.at(i));
+			vm.Push(tmpVals[i], tmpTypes[i]);
 		}
-		Push(copyVal, copyType);
+		return true;
+	}
+
+	static bool SwapInvalid(LHVM& vm, VMTask& /*task*/, const Instruction& /*instruction*/)
+	{
+		vm.SignalError(ErrorCode::ErrInvalidOperand);
+		return true;
+	}
+
+	static bool Line(LHVM& /*vm*/, VMTask& /*task*/, const Instruction& /*instruction*/) { return true; }
+
+	/// Rejected by \ref Decode: unknown opcode, operand out of range or running past the end of the script
+	static bool Invalid(LHVM& vm, VMTask& task, const Instruction& /*instruction*/)
+	{
+		vm.SignalError(ErrorCode::ErrInvalidOperand, task.instructionAddress);
+		task.stop = true;
+		return false;
+	}
+};
+
+void LHVM::CpuLoop(VMTask& task)
+{
+	task.iield = false;
+	if (task.waitingTaskId != 0)
+	{
+		return;
+	}
+	if (task.instructionAddress >= _code.size())
+	{
+		SignalError(ErrorCode::ErrInvalidOperand, task.instructionAddress);
+		task.stop = true;
+		return;
+	}
+
+	_currentTask = &task;
+#if defined(__GNUC__)
+	if (_threadedDispatch)
+	{
+		RunThreaded(task);
+	}
+	else
+#endif
+	{
+		RunSwitch(task);
 	}
-	else // Mode::CopyTo insert a copy of the topmost value on the stack N places below
+	_currentTask = nullptr;
+}
+
+bool LHVM::MustReturn(const VMTask& task, bool wasExceptionHandler)
+{
+	return task.stop || task.iield || task.waitingTaskId != 0 || task.inExceptionHandler != wasExceptionHandler;
+}
+
+#if defined(__GNUC__)
+void LHVM::RunThreaded(VMTask& task)
+{
+	const auto wasExceptionHandler = task.inExceptionHandler;
+	const auto* const code = _code.data();
+
+	// Threaded code: every handler ends with its own indirect jump, which is easier on the branch predictor than a switch
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic" // labels as values
+#define LHVM_HANDLER_LABEL(name) &&handler##name,
+	static void* const k_Labels[] = {LHVM_HANDLERS(LHVM_HANDLER_LABEL)};
+#undef LHVM_HANDLER_LABEL
+
+#define LHVM_DISPATCH() goto* k_Labels[static_cast<size_t>(code[task.instructionAddress].handler)]
+#define LHVM_HANDLER_BODY(name)                                                                           \
+	handler##name:                                                                                        \
+	_executedInstructions++;                                                                              \
+	if (!Handlers::name(*this, task, code[task.instructionAddress]) && MustReturn(task, wasExceptionHandler)) \
+	{                                                                                                     \
+		return;                                                                                           \
+	}                                                                                                     \
+	task.instructionAddress++;                                                                            \
+	LHVM_DISPATCH();
+
+	LHVM_DISPATCH();
+	LHVM_HANDLERS(LHVM_HANDLER_BODY)
+#undef LHVM_HANDLER_BODY
+#undef LHVM_DISPATCH
+#pragma GCC diagnostic pop
+}
+#endif
+
+void LHVM::RunSwitch(VMTask& task)
+{
+	const auto wasExceptionHandler = task.inExceptionHandler;
+	const auto* const code = _code.data();
+
+#define LHVM_HANDLER_CASE(name)                                               \
+	case Handler::name:                                                       \
+		proceed = Handlers::name(*this, task, code[task.instructionAddress]); \
+		break;
+
+	while (true)
 	{
-		for (int i = 0; i < offset; i++)
+		_executedInstructions++;
+		bool proceed = true;
+		switch (code[task.instructionAddress].handler)
 		{
-			DataType ti;
-			const VMValue vi = Pop(ti);
-			if (i == 0)
-			{
-				copyType = ti;
-				copyVal = vi;
-			}
-			if (i < tmpTypes.size())
-			{
-				tmpTypes.at(i) = ti;
-				tmpVals.at(i) = vi;
-			}
+			LHVM_HANDLERS(LHVM_HANDLER_CASE)
 		}
-		Push(copyVal, copyType);
-		for (int i = static_cast<int>(std::min(offset, VMStack::k_Size)) - 1; i >= 0; i--)
+		if (!proceed && MustReturn(task, wasExceptionHandler))
 		{
-			Push(tmpVals.at(i), tmpTypes.at(i));
+			break;
 		}
+		task.instructionAddress++;
 	}
+#undef LHVM_HANDLER_CASE
 }
 
-void LHVM::Opcode30Line(VMTask& /*task*/, const VMInstruction& /*instruction*/) {}
-
 } // namespace openblack::lhvm
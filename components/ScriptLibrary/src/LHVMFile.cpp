@@ -615,10 +615,17 @@ int LHVMFile::LoadTasks(std::istream& stream)
 
 int LHVMFile::LoadTask(std::istream& stream, VMTask& task)
 {
-	if (LoadVariableValues(stream, task.localVars) != EXIT_SUCCESS)
+	// Names of local variables are the ones of the script
+	std::vector<VMVar> localVars;
+	if (LoadVariableValues(stream, localVars) != EXIT_SUCCESS)
 	{
 		return EXIT_FAILURE;
 	}
+	task.localVars.reserve(localVars.size());
+	for (const auto& var : localVars)
+	{
+		task.localVars.push_back({var.type, var.value});
+	}
 
 	if (!stream.read(reinterpret_cast<char*>(&task.id), sizeof(task.id)))
 	{
@@ -705,9 +712,6 @@ int LHVMFile::LoadTask(std::istream& stream, VMTask& task)
 	{
 		return EXIT_FAILURE; // Script not found
 	}
-	auto& script = _scripts[task.scriptId - 1];
-	task.name = script.name;
-	task.filename = script.filename;
 
 	return EXIT_SUCCESS;
 }
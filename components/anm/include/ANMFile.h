@@ -9,9 +9,13 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 #include <array>
 #include <filesystem>
 #include <iosfwd>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -23,6 +27,7 @@ enum class ANMResult : uint8_t
 	Success = 0,
 	ErrCantOpen,
 	ErrFileTooSmall,
+	ErrBadKeyframeOffset,
 };
 
 std::string_view ResultToStr(ANMResult result);
@@ -79,11 +84,14 @@ class ANMFile
 	/// Read file from the input source
 	ANMResult ReadFile(std::istream& stream) noexcept;
 
+	/// Read file from memory, bounds are checked before anything is copied
+	ANMResult ReadFile(std::span<const std::byte> data) noexcept;
+
 	/// Read anm file from the filesystem
 	ANMResult Open(const std::filesystem::path& filepath) noexcept;
 
 	/// Read anm file from a buffer
-	ANMResult Open(const std::vector<uint8_t>& buffer) noexcept;
+	ANMResult Open(std::span<const uint8_t> buffer) noexcept;
 
 	/// Write anm file to path on the filesystem
 	ANMResult Write(const std::filesystem::path& filepath) noexcept;
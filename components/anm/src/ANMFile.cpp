@@ -58,45 +58,20 @@ using namespace openblack::anm;
 
 namespace
 {
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
+/// Copies count items at offset out of data, returns false when they go beyond the end of data
+template <typename T>
+bool ReadAt(std::span<const std::byte> data, size_t offset, T* out, size_t count = 1) noexcept
 {
-	membuf(char const* base, size_t size)
+	if (offset > data.size() || (data.size() - offset) / sizeof(T) < count)
 	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
+		return false;
 	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
+	if (count > 0)
 	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
-		{
-			setg(eback(), egptr() + off, egptr());
-		}
-		else if (way == std::ios_base::beg)
-		{
-			setg(eback(), eback() + off, egptr());
-		}
-		return gptr() - eback();
+		std::memcpy(out, data.data() + offset, count * sizeof(T));
 	}
-
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		return seekoff(pos - static_cast<off_type>(0), std::ios_base::beg, which);
-	}
-};
-struct imemstream: virtual membuf, std::istream
-{
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
-	{
-	}
-};
+	return true;
+}
 } // namespace
 
 std::string_view openblack::anm::ResultToStr(ANMResult result)
@@ -109,6 +84,8 @@ std::string_view openblack::anm::ResultToStr(ANMResult result)
 		return "Could not open file.";
 	case ANMResult::ErrFileTooSmall:
 		return "File too small to be a valid ANM file.";
+	case ANMResult::ErrBadKeyframeOffset:
+		return "Keyframe data is beyond the end of the file.";
 	}
 	std::unreachable();
 }
@@ -170,6 +147,49 @@ ANMResult ANMFile::ReadFile(std::istream& stream) noexcept
 	return ANMResult::Success;
 }
 
+ANMResult ANMFile::ReadFile(std::span<const std::byte> data) noexcept
+{
+	assert(!_isLoaded);
+
+	if (!ReadAt(data, 0, &_header))
+	{
+		return ANMResult::ErrFileTooSmall;
+	}
+
+	if (_header.framesBase > data.size() || (data.size() - _header.framesBase) / sizeof(uint32_t) < _header.frameCount)
+	{
+		return ANMResult::ErrBadKeyframeOffset;
+	}
+	_keyframes.resize(_header.frameCount);
+	for (uint32_t i = 0; i < _header.frameCount; ++i)
+	{
+		// Keyframe offset block, keyframe pointer then bone offset block lead to the bone block
+		uint32_t offset = 0;
+		if (!ReadAt(data, _header.framesBase + i * sizeof(uint32_t), &offset) || !ReadAt(data, offset, &offset) ||
+		    !ReadAt(data, offset, &offset))
+		{
+			return ANMResult::ErrBadKeyframeOffset;
+		}
+
+		uint32_t boneCount = 0;
+		if (!ReadAt(data, offset, &boneCount) || !ReadAt(data, offset + sizeof(boneCount), &_keyframes[i].time))
+		{
+			return ANMResult::ErrBadKeyframeOffset;
+		}
+		const size_t bonesOffset = offset + sizeof(boneCount) + sizeof(_keyframes[i].time);
+		if ((data.size() - bonesOffset) / sizeof(ANMBone) < boneCount)
+		{
+			return ANMResult::ErrBadKeyframeOffset;
+		}
+		_keyframes[i].bones.resize(boneCount);
+		ReadAt(data, bonesOffset, _keyframes[i].bones.data(), _keyframes[i].bones.size());
+	}
+
+	_isLoaded = true;
+
+	return ANMResult::Success;
+}
+
 ANMResult ANMFile::WriteFile([[maybe_unused]] std::ostream& stream) const noexcept
 {
 	assert(!_isLoaded);
@@ -192,13 +212,11 @@ ANMResult ANMFile::Open(const std::filesystem::path& filepath) noexcept
 	return ReadFile(stream);
 }
 
-ANMResult ANMFile::Open(const std::vector<uint8_t>& buffer) noexcept
+ANMResult ANMFile::Open(std::span<const uint8_t> buffer) noexcept
 {
 	assert(!_isLoaded);
 
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
-
-	return ReadFile(stream);
+	return ReadFile(std::as_bytes(buffer));
 }
 
 ANMResult ANMFile::Write(const std::filesystem::path& filepath) noexcept
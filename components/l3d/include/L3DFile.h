@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <array>
 #include <filesystem>
 #include <iosfwd>
@@ -317,16 +319,25 @@ class L3DFile
 	/// If the flag HasDoorPosition is on the first extra point is the door
 	std::vector<L3DPoint> _extraPoints;
 	std::vector<L3DPrimitiveHeader> _primitiveHeaders;
-	std::vector<L3DVertex> _vertices;
-	std::vector<uint16_t> _indices;
-	std::vector<L3DVertexGroup> _vertexGroups;
-	std::vector<L3DBlend> _blends;
-	std::vector<L3DBone> _bones;
-	std::vector<std::span<L3DPrimitiveHeader>> _primitiveSpans;
-	std::vector<std::span<L3DVertex>> _vertexSpans;
-	std::vector<std::span<uint16_t>> _indexSpans;
-	std::vector<std::span<L3DVertexGroup>> _vertexGroupSpans;
-	std::vector<std::span<L3DBone>> _boneSpans;
+	/// Point into the buffer given to \ref ReadFile when the arrays are stored contiguously and aligned in it, otherwise
+	/// into the owned arrays below
+	std::span<const L3DVertex> _vertices;
+	std::span<const uint16_t> _indices;
+	std::span<const L3DVertexGroup> _vertexGroups;
+	std::span<const L3DBlend> _blends;
+	std::span<const L3DBone> _bones;
+	std::vector<L3DVertex> _ownedVertices;
+	std::vector<uint16_t> _ownedIndices;
+	std::vector<L3DVertexGroup> _ownedVertexGroups;
+	std::vector<L3DBlend> _ownedBlends;
+	std::vector<L3DBone> _ownedBones;
+	/// File contents when opened from a path or given an owned buffer
+	std::vector<uint8_t> _data;
+	std::vector<std::span<const L3DPrimitiveHeader>> _primitiveSpans;
+	std::vector<std::span<const L3DVertex>> _vertexSpans;
+	std::vector<std::span<const uint16_t>> _indexSpans;
+	std::vector<std::span<const L3DVertexGroup>> _vertexGroupSpans;
+	std::vector<std::span<const L3DBone>> _boneSpans;
 	std::optional<L3DFootprint> _footprint;
 	std::vector<uint8_t> _uv2Data;
 	std::string _nameData;
@@ -335,18 +346,32 @@ class L3DFile
 	/// Write file to the input source
 	L3DResult WriteFile(std::ostream& stream) const noexcept;
 
+	/// Split the arrays in submeshes once they are read
+	void CreateSpans() noexcept;
+
 public:
 	L3DFile() noexcept;
+	L3DFile(const L3DFile&) = delete;
+	L3DFile& operator=(const L3DFile&) = delete;
+	L3DFile(L3DFile&&) noexcept;
+	L3DFile& operator=(L3DFile&&) noexcept;
 	virtual ~L3DFile() noexcept;
 
-	/// Read file from the input source
+	/// Read file from the input source, everything is copied out of the stream
 	L3DResult ReadFile(std::istream& stream) noexcept;
 
+	/// Read file from memory. Bounds are checked before anything is read and the vertices, indices, vertex groups, blends
+	/// and bones are used in place when they are contiguous and aligned, so data has to outlive this file.
+	L3DResult ReadFile(std::span<const std::byte> data) noexcept;
+
 	/// Read l3d file from the filesystem
 	L3DResult Open(const std::filesystem::path& filepath) noexcept;
 
-	/// Read l3d file from a buffer
-	L3DResult Open(const std::vector<uint8_t>& buffer) noexcept;
+	/// Read l3d file from a buffer which has to outlive this file, see \ref ReadFile
+	L3DResult Open(std::span<const uint8_t> buffer) noexcept;
+
+	/// Read l3d file from a buffer which this file keeps
+	L3DResult Open(std::vector<uint8_t>&& buffer) noexcept;
 
 	/// Write l3d file to path on the filesystem
 	L3DResult Write(const std::filesystem::path& filepath) noexcept;
@@ -356,11 +381,11 @@ class L3DFile
 	[[nodiscard]] const std::vector<L3DTexture>& GetSkins() const noexcept { return _skins; }
 	[[nodiscard]] const std::vector<L3DPoint>& GetExtraPoints() const noexcept { return _extraPoints; }
 	[[nodiscard]] const std::vector<L3DPrimitiveHeader>& GetPrimitiveHeaders() const noexcept { return _primitiveHeaders; }
-	[[nodiscard]] const std::vector<L3DVertex>& GetVertices() const noexcept { return _vertices; }
-	[[nodiscard]] const std::vector<uint16_t>& GetIndices() const noexcept { return _indices; }
-	[[nodiscard]] const std::vector<L3DVertexGroup>& GetLookUpTableData() const noexcept { return _vertexGroups; }
-	[[nodiscard]] const std::vector<L3DBlend>& GetBlends() const noexcept { return _blends; }
-	[[nodiscard]] const std::vector<L3DBone>& GetBones() const noexcept { return _bones; }
+	[[nodiscard]] std::span<const L3DVertex> GetVertices() const noexcept { return _vertices; }
+	[[nodiscard]] std::span<const uint16_t> GetIndices() const noexcept { return _indices; }
+	[[nodiscard]] std::span<const L3DVertexGroup> GetLookUpTableData() const noexcept { return _vertexGroups; }
+	[[nodiscard]] std::span<const L3DBlend> GetBlends() const noexcept { return _blends; }
+	[[nodiscard]] std::span<const L3DBone> GetBones() const noexcept { return _bones; }
 	[[nodiscard]] const std::optional<L3DFootprint>& GetFootprint() const noexcept { return _footprint; }
 	[[nodiscard]] const std::vector<std::array<float, 3 * 4>>& GetExtraMetrics() const noexcept { return _extraMetrics; }
 	[[nodiscard]] const std::vector<uint8_t>& GetUv2Data() const noexcept { return _uv2Data; }
@@ -369,23 +394,23 @@ class L3DFile
 	void SetUv2Data(std::vector<uint8_t>& uv2Data) noexcept { _uv2Data = uv2Data; }
 	void SetNameData(std::string& nameData) noexcept { _nameData = nameData; }
 	[[nodiscard]] const std::string& GetNameData() const noexcept { return _nameData; }
-	[[nodiscard]] const std::span<L3DPrimitiveHeader>& GetPrimitiveSpan(uint32_t submeshIndex) const noexcept
+	[[nodiscard]] const std::span<const L3DPrimitiveHeader>& GetPrimitiveSpan(uint32_t submeshIndex) const noexcept
 	{
 		return _primitiveSpans[submeshIndex];
 	}
-	[[nodiscard]] const std::span<L3DBone>& GetBoneSpan(uint32_t submeshIndex) const noexcept
+	[[nodiscard]] const std::span<const L3DBone>& GetBoneSpan(uint32_t submeshIndex) const noexcept
 	{
 		return _boneSpans[submeshIndex];
 	}
-	[[nodiscard]] const std::span<L3DVertex>& GetVertexSpan(uint32_t submeshIndex) const noexcept
+	[[nodiscard]] const std::span<const L3DVertex>& GetVertexSpan(uint32_t submeshIndex) const noexcept
 	{
 		return _vertexSpans[submeshIndex];
 	}
-	[[nodiscard]] const std::span<uint16_t>& GetIndexSpan(uint32_t submeshIndex) const noexcept
+	[[nodiscard]] const std::span<const uint16_t>& GetIndexSpan(uint32_t submeshIndex) const noexcept
 	{
 		return _indexSpans[submeshIndex];
 	}
-	[[nodiscard]] const std::span<L3DVertexGroup>& GetVertexGroupSpan(uint32_t submeshIndex) const noexcept
+	[[nodiscard]] const std::span<const L3DVertexGroup>& GetVertexGroupSpan(uint32_t submeshIndex) const noexcept
 	{
 		return _vertexGroupSpans[submeshIndex];
 	}
@@ -168,10 +168,12 @@
 #include "L3DFile.h"
 
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 
 #include <fstream>
 #include <limits>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -179,53 +181,93 @@ using namespace openblack::l3d;
 
 namespace
 {
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
+/// Copies count items at offset out of data, returns false when they go beyond the end of data
+template <typename T>
+bool ReadAt(std::span<const std::byte> data, size_t offset, T* out, size_t count = 1) noexcept
 {
-	membuf(char const* base, size_t size)
+	if (offset > data.size() || (data.size() - offset) / sizeof(T) < count)
 	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
+		return false;
 	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
+	if (count > 0)
 	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
+		std::memcpy(out, data.data() + offset, count * sizeof(T));
+	}
+	return true;
+}
+
+enum class GatherResult : uint8_t
+{
+	Success,
+	BadOffset,
+	BadCount,
+};
+
+/// Gathers the arrays described by each header as one array. When they follow each other in data and are aligned, the
+/// result points into data, otherwise they are copied into storage.
+template <typename T, typename Header, typename GetChunk>
+GatherResult GatherArray(std::span<const std::byte> data, const std::vector<Header>& headers, GetChunk getChunk,
+                         std::vector<T>& storage, std::span<const T>& result) noexcept
+{
+	size_t total = 0;
+	size_t counter = 0;
+	const std::byte* first = nullptr;
+	const std::byte* next = nullptr;
+	bool contiguous = true;
+	for (const auto& header : headers)
+	{
+		const auto [offset, count] = getChunk(header);
+		total += count;
+		if (count == 0 || offset == std::numeric_limits<uint32_t>::max())
 		{
-			setg(eback(), egptr() + off, egptr());
+			continue;
 		}
-		else if (way == std::ios_base::beg)
+		if (offset > data.size() || (data.size() - offset) / sizeof(T) < count)
 		{
-			setg(eback(), eback() + off, egptr());
+			return GatherResult::BadOffset;
 		}
-		return gptr() - eback();
+		const auto* start = data.data() + offset;
+		contiguous = contiguous && (first == nullptr || start == next);
+		first = first == nullptr ? start : first;
+		next = start + count * sizeof(T);
+		counter += count;
+	}
+	if (counter != total)
+	{
+		return GatherResult::BadCount;
 	}
 
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
+	if (contiguous && reinterpret_cast<uintptr_t>(first) % alignof(T) == 0)
 	{
-		return seekoff(pos - static_cast<off_type>(0), std::ios_base::beg, which);
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): the formats are trivially copyable
+		result = {reinterpret_cast<const T*>(first), counter};
+		return GatherResult::Success;
 	}
-};
-struct imemstream: virtual membuf, std::istream
-{
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
+
+	storage.resize(counter);
+	counter = 0;
+	for (const auto& header : headers)
 	{
+		const auto [offset, count] = getChunk(header);
+		if (count == 0 || offset == std::numeric_limits<uint32_t>::max())
+		{
+			continue;
+		}
+		std::memcpy(&storage[counter], data.data() + offset, count * sizeof(T));
+		counter += count;
 	}
-};
+	result = storage;
+	return GatherResult::Success;
+}
 } // namespace
 
 template <typename Item>
-void add_span(std::vector<std::span<Item>>& container, typename std::vector<Item>& items, size_t offset, size_t length)
+void add_span(std::vector<std::span<const Item>>& container, std::type_identity_t<std::span<const Item>> items, size_t offset,
+              size_t length)
 {
 	if (length > 0)
 	{
-		container.emplace_back(&items[offset], length);
+		container.emplace_back(items.subspan(offset, length));
 	}
 	else
 	{
@@ -295,6 +337,9 @@ std::string_view openblack::l3d::ResultToStr(L3DResult result)
 }
 
 L3DFile::L3DFile() noexcept = default;
+// The views point into heap memory which moves along with the vectors
+L3DFile::L3DFile(L3DFile&&) noexcept = default;
+L3DFile& L3DFile::operator=(L3DFile&&) noexcept = default;
 L3DFile::~L3DFile() noexcept = default;
 
 L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
@@ -461,8 +506,8 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 	}
 
 	// Reserve space for vertices
-	_vertices.resize(totalVertices);
-	if (!_vertices.empty())
+	_ownedVertices.resize(totalVertices);
+	if (!_ownedVertices.empty())
 	{
 		uint32_t counter = 0;
 		for (const auto& header : _primitiveHeaders)
@@ -471,12 +516,12 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			{
 				continue;
 			}
-			if (header.verticesOffset + header.numVertices * sizeof(_vertices[0]) > fsize)
+			if (header.verticesOffset + header.numVertices * sizeof(_ownedVertices[0]) > fsize)
 			{
 				return L3DResult::ErrBadVertexOffset;
 			}
 			stream.seekg(header.verticesOffset);
-			stream.read(reinterpret_cast<char*>(&_vertices[counter]), header.numVertices * sizeof(_vertices[0]));
+			stream.read(reinterpret_cast<char*>(&_ownedVertices[counter]), header.numVertices * sizeof(_ownedVertices[0]));
 			counter += header.numVertices;
 		}
 		if (counter != totalVertices)
@@ -486,8 +531,8 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 	}
 
 	// Reserve space for indices
-	_indices.resize(totalIndices);
-	if (!_indices.empty())
+	_ownedIndices.resize(totalIndices);
+	if (!_ownedIndices.empty())
 	{
 		uint32_t counter = 0;
 		for (const auto& header : _primitiveHeaders)
@@ -496,12 +541,12 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			{
 				continue;
 			}
-			if (header.trianglesOffset + header.numTriangles * 3 * sizeof(_indices[0]) > fsize)
+			if (header.trianglesOffset + header.numTriangles * 3 * sizeof(_ownedIndices[0]) > fsize)
 			{
 				return L3DResult::ErrBadTriangleOffset;
 			}
 			stream.seekg(header.trianglesOffset);
-			stream.read(reinterpret_cast<char*>(&_indices[counter]), header.numTriangles * 3 * sizeof(_indices[0]));
+			stream.read(reinterpret_cast<char*>(&_ownedIndices[counter]), header.numTriangles * 3 * sizeof(_ownedIndices[0]));
 			counter += header.numTriangles * 3;
 		}
 		if (counter != totalIndices)
@@ -511,8 +556,8 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 	}
 
 	// Reserve space for look-up table data
-	_vertexGroups.resize(totalGroups);
-	if (!_vertexGroups.empty())
+	_ownedVertexGroups.resize(totalGroups);
+	if (!_ownedVertexGroups.empty())
 	{
 		uint32_t counter = 0;
 		for (const auto& header : _primitiveHeaders)
@@ -521,12 +566,13 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			{
 				continue;
 			}
-			if (header.groupsOffset + header.numGroups * sizeof(_vertexGroups[0]) > fsize)
+			if (header.groupsOffset + header.numGroups * sizeof(_ownedVertexGroups[0]) > fsize)
 			{
 				return L3DResult::ErrBadVertexGroupOffset;
 			}
 			stream.seekg(header.groupsOffset);
-			stream.read(reinterpret_cast<char*>(&_vertexGroups[counter]), header.numGroups * sizeof(_vertexGroups[0]));
+			stream.read(reinterpret_cast<char*>(&_ownedVertexGroups[counter]),
+			            header.numGroups * sizeof(_ownedVertexGroups[0]));
 			counter += header.numGroups;
 		}
 		if (counter != totalGroups)
@@ -536,9 +582,9 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 	}
 
 	// Reserve space for vertex blend data
-	_blends.resize(totalBlendValues);
+	_ownedBlends.resize(totalBlendValues);
 
-	if (!_blends.empty())
+	if (!_ownedBlends.empty())
 	{
 		uint32_t counter = 0;
 		for (const auto& header : _primitiveHeaders)
@@ -547,12 +593,12 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			{
 				continue;
 			}
-			if (header.vertexBlendsOffset + header.numVertexBlends * sizeof(_blends[0]) > fsize)
+			if (header.vertexBlendsOffset + header.numVertexBlends * sizeof(_ownedBlends[0]) > fsize)
 			{
 				return L3DResult::ErrBadBlendOffset;
 			}
 			stream.seekg(header.vertexBlendsOffset);
-			stream.read(reinterpret_cast<char*>(&_blends[counter]), header.numVertexBlends * sizeof(_blends[0]));
+			stream.read(reinterpret_cast<char*>(&_ownedBlends[counter]), header.numVertexBlends * sizeof(_ownedBlends[0]));
 			counter += header.numVertexBlends;
 		}
 		if (counter != totalBlendValues)
@@ -562,8 +608,8 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 	}
 
 	// Reserve space for bone data
-	_bones.resize(totalBones);
-	if (!_bones.empty())
+	_ownedBones.resize(totalBones);
+	if (!_ownedBones.empty())
 	{
 		uint32_t counter = 0;
 		for (const auto& header : _submeshHeaders)
@@ -572,12 +618,12 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			{
 				continue;
 			}
-			if (header.bonesOffset + header.numBones * sizeof(_bones[0]) > fsize)
+			if (header.bonesOffset + header.numBones * sizeof(_ownedBones[0]) > fsize)
 			{
 				return L3DResult::ErrBadBoneOffset;
 			}
 			stream.seekg(header.bonesOffset);
-			stream.read(reinterpret_cast<char*>(&_bones[counter]), header.numBones * sizeof(_bones[0]));
+			stream.read(reinterpret_cast<char*>(&_ownedBones[counter]), header.numBones * sizeof(_ownedBones[0]));
 			counter += header.numBones;
 		}
 		if (counter != totalBones)
@@ -585,6 +631,11 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			return L3DResult::ErrBadBoneCount;
 		}
 	}
+	_vertices = _ownedVertices;
+	_indices = _ownedIndices;
+	_vertexGroups = _ownedVertexGroups;
+	_blends = _ownedBlends;
+	_bones = _ownedBones;
 
 	// Get additional data. Strictly in this order
 	// Footprint data
@@ -709,6 +760,277 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 		}
 	}
 
+	CreateSpans();
+
+	_isLoaded = true;
+
+	return L3DResult::Success;
+}
+
+L3DResult L3DFile::ReadFile(std::span<const std::byte> data) noexcept
+{
+	assert(!_isLoaded);
+
+	if (!ReadAt(data, 0, &_header))
+	{
+		return L3DResult::ErrFileTooSmall;
+	}
+	if (_header.magic != k_Magic)
+	{
+		return L3DResult::ErrBadHeader;
+	}
+
+	std::vector<uint32_t> submeshOffsets(_header.submeshCount);
+	if (!submeshOffsets.empty() && _header.submeshOffsetsOffset != std::numeric_limits<uint32_t>::max())
+	{
+		if (!ReadAt(data, _header.submeshOffsetsOffset, submeshOffsets.data(), submeshOffsets.size()))
+		{
+			return L3DResult::ErrBadSubmeshOffset;
+		}
+	}
+	std::vector<uint32_t> skinOffsets(_header.skinCount);
+	if (!skinOffsets.empty() && _header.skinOffsetsOffset != std::numeric_limits<uint32_t>::max())
+	{
+		if (!ReadAt(data, _header.skinOffsetsOffset, skinOffsets.data(), skinOffsets.size()))
+		{
+			return L3DResult::ErrBadSkinOffset;
+		}
+	}
+	_extraPoints.resize(_header.extraDataCount);
+	if (!_extraPoints.empty() && _header.extraDataOffset != std::numeric_limits<uint32_t>::max())
+	{
+		if (!ReadAt(data, _header.extraDataOffset, _extraPoints.data(), _extraPoints.size()))
+		{
+			return L3DResult::ErrBadPointsOffset;
+		}
+	}
+
+	size_t totalPrimitives = 0;
+	_submeshHeaders.resize(submeshOffsets.size());
+	for (size_t i = 0; i < submeshOffsets.size(); ++i)
+	{
+		if (!ReadAt(data, submeshOffsets[i], &_submeshHeaders[i]))
+		{
+			return L3DResult::ErrBadSubmeshHeaderOffset;
+		}
+		totalPrimitives += _submeshHeaders[i].numPrimitives;
+	}
+
+	// See the stream version about skins at the end of the file
+	_skins.reserve(skinOffsets.size());
+	for (auto offset : skinOffsets)
+	{
+		if (offset == data.size())
+		{
+			continue;
+		}
+		if (!ReadAt(data, offset, &_skins.emplace_back()))
+		{
+			return L3DResult::ErrBadSkinTextureOffset;
+		}
+	}
+
+	std::vector<uint32_t> primitiveOffsets(totalPrimitives);
+	size_t primitiveCounter = 0;
+	for (const auto& header : _submeshHeaders)
+	{
+		if (header.numPrimitives == 0)
+		{
+			continue;
+		}
+		if (!ReadAt(data, header.primitivesOffset, &primitiveOffsets[primitiveCounter], header.numPrimitives))
+		{
+			return L3DResult::ErrBadPrimitiveOffset;
+		}
+		primitiveCounter += header.numPrimitives;
+	}
+
+	_primitiveHeaders.resize(primitiveOffsets.size());
+	for (size_t i = 0; i < primitiveOffsets.size(); ++i)
+	{
+		if (!ReadAt(data, primitiveOffsets[i], &_primitiveHeaders[i]))
+		{
+			return L3DResult::ErrBadPrimitiveHeaderOffset;
+		}
+	}
+
+	switch (GatherArray(
+	    data, _primitiveHeaders,
+	    [](const auto& header) { return std::pair<uint32_t, size_t> {header.verticesOffset, header.numVertices}; },
+	    _ownedVertices, _vertices))
+	{
+	case GatherResult::BadOffset:
+		return L3DResult::ErrBadVertexOffset;
+	case GatherResult::BadCount:
+		return L3DResult::ErrBadVertexCount;
+	case GatherResult::Success:
+		break;
+	}
+	switch (GatherArray(
+	    data, _primitiveHeaders,
+	    [](const auto& header) { return std::pair<uint32_t, size_t> {header.trianglesOffset, header.numTriangles * 3}; },
+	    _ownedIndices, _indices))
+	{
+	case GatherResult::BadOffset:
+		return L3DResult::ErrBadTriangleOffset;
+	case GatherResult::BadCount:
+		return L3DResult::ErrBadTriangleCount;
+	case GatherResult::Success:
+		break;
+	}
+	switch (GatherArray(
+	    data, _primitiveHeaders,
+	    [](const auto& header) { return std::pair<uint32_t, size_t> {header.groupsOffset, header.numGroups}; },
+	    _ownedVertexGroups, _vertexGroups))
+	{
+	case GatherResult::BadOffset:
+		return L3DResult::ErrBadVertexGroupOffset;
+	case GatherResult::BadCount:
+		return L3DResult::ErrBadVertexGroupCount;
+	case GatherResult::Success:
+		break;
+	}
+	switch (GatherArray(
+	    data, _primitiveHeaders,
+	    [](const auto& header) { return std::pair<uint32_t, size_t> {header.vertexBlendsOffset, header.numVertexBlends}; },
+	    _ownedBlends, _blends))
+	{
+	case GatherResult::BadOffset:
+		return L3DResult::ErrBadBlendOffset;
+	case GatherResult::BadCount:
+		return L3DResult::ErrBadBlendCount;
+	case GatherResult::Success:
+		break;
+	}
+	switch (GatherArray(
+	    data, _submeshHeaders,
+	    [](const auto& header) { return std::pair<uint32_t, size_t> {header.bonesOffset, header.numBones}; }, _ownedBones,
+	    _bones))
+	{
+	case GatherResult::BadOffset:
+		return L3DResult::ErrBadBoneOffset;
+	case GatherResult::BadCount:
+		return L3DResult::ErrBadBoneCount;
+	case GatherResult::Success:
+		break;
+	}
+
+	// Additional data, each block follows the previous one
+	const auto headerFlags = static_cast<uint32_t>(_header.flags);
+	size_t additionalDataOffset = _header.footprintDataOffset;
+	if ((headerFlags & static_cast<uint32_t>(L3DMeshFlags::ContainsLandscapeFeature)) != 0u)
+	{
+		L3DFootprintHeader header;
+		if (!ReadAt(data, additionalDataOffset, &header) || header.size < sizeof(header) - 8)
+		{
+			return L3DResult::ErrBadFootprintOffset;
+		}
+		std::vector<uint8_t> footprintData(header.size);
+		const size_t footprintDataSize = header.size - sizeof(header) + 8;
+		if (!ReadAt(data, additionalDataOffset + sizeof(header), footprintData.data(), footprintDataSize))
+		{
+			return L3DResult::ErrBadFootprintOffset;
+		}
+
+		size_t offset = 0;
+		std::vector<L3DFootprintEntry> entries(header.count);
+		const auto footprint = std::as_bytes(std::span(footprintData));
+		for (auto& entry : entries)
+		{
+			if (!ReadAt(footprint, offset, &entry.unknown1) || !ReadAt(footprint, offset + 4, &entry.unknown2) ||
+			    !ReadAt(footprint, offset + 8, &entry.triangleCount))
+			{
+				return L3DResult::ErrBadFootprintOffset;
+			}
+			offset += sizeof(entry.unknown1) + sizeof(entry.unknown2) + sizeof(entry.triangleCount);
+
+			entry.triangles.resize(entry.triangleCount);
+			if (!ReadAt(footprint, offset, entry.triangles.data(), entry.triangles.size()))
+			{
+				return L3DResult::ErrBadFootprintMeshOffset;
+			}
+			offset += entry.triangles.size() * sizeof(entry.triangles[0]);
+
+			entry.pixels.resize(static_cast<size_t>(header.width) * header.height);
+			if (!ReadAt(footprint, offset, entry.pixels.data(), entry.pixels.size()))
+			{
+				return L3DResult::ErrBadFootprintTextureOffset;
+			}
+			offset += entry.pixels.size() * sizeof(entry.pixels[0]);
+
+			if (!ReadAt(footprint, offset, &entry.unknown3) || !ReadAt(footprint, offset + 4, &entry.unknown4) ||
+			    !ReadAt(footprint, offset + 8, &entry.unknown5))
+			{
+				return L3DResult::ErrBadFootprintPixelOffset;
+			}
+			offset += sizeof(entry.unknown3) + sizeof(entry.unknown4) + sizeof(entry.unknown5);
+		}
+
+		L3DFootprintFooter footer;
+		if (!ReadAt(data, additionalDataOffset + sizeof(header) + footprintDataSize, &footer))
+		{
+			return L3DResult::ErrBadFootprintOffset;
+		}
+
+		_footprint = std::make_optional(L3DFootprint {header, entries, footer});
+		additionalDataOffset += header.size;
+	}
+
+	if ((headerFlags & static_cast<uint32_t>(L3DMeshFlags::ContainsUV2)) != 0u)
+	{
+		// TODO(#483): Investigate optional UV2 block
+		uint32_t uv2DataSize = 0;
+		if (!ReadAt(data, additionalDataOffset, &uv2DataSize))
+		{
+			return L3DResult::ErrFileTooSmall;
+		}
+		_uv2Data.resize(uv2DataSize);
+		if (!ReadAt(data, additionalDataOffset + sizeof(uv2DataSize) + 8, _uv2Data.data(), _uv2Data.size()))
+		{
+			return L3DResult::ErrFileTooSmall;
+		}
+		additionalDataOffset += uv2DataSize;
+	}
+
+	if ((headerFlags & static_cast<uint32_t>(L3DMeshFlags::ContainsNameData)) != 0u)
+	{
+		uint32_t nameDataSize = 0;
+		if (!ReadAt(data, additionalDataOffset, &nameDataSize))
+		{
+			return L3DResult::ErrFileTooSmall;
+		}
+		_nameData.resize(nameDataSize);
+		if (!ReadAt(data, additionalDataOffset + sizeof(nameDataSize) + 8, _nameData.data(), _nameData.size()))
+		{
+			return L3DResult::ErrFileTooSmall;
+		}
+		additionalDataOffset += nameDataSize;
+	}
+
+	if ((headerFlags & static_cast<uint32_t>(L3DMeshFlags::ContainsExtraMetrics)) != 0u && _header.footprintDataOffset > 0)
+	{
+		// Size, count and offset of the matrices
+		std::array<uint32_t, 3> extraMetricsHeader;
+		if (!ReadAt(data, additionalDataOffset, extraMetricsHeader.data(), extraMetricsHeader.size()))
+		{
+			return L3DResult::ErrFileTooSmall;
+		}
+		_extraMetrics.resize(extraMetricsHeader[1]);
+		if (!ReadAt(data, additionalDataOffset + sizeof(extraMetricsHeader), _extraMetrics.data(), _extraMetrics.size()))
+		{
+			return L3DResult::ErrFileTooSmall;
+		}
+	}
+
+	CreateSpans();
+
+	_isLoaded = true;
+
+	return L3DResult::Success;
+}
+
+void L3DFile::CreateSpans() noexcept
+{
 	// Create spans per submesh
 	_primitiveSpans.reserve(_submeshHeaders.size());
 	_boneSpans.reserve(_submeshHeaders.size());
@@ -752,10 +1074,6 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			vertexGroupStart += vertexGroupLength;
 		}
 	}
-
-	_isLoaded = true;
-
-	return L3DResult::Success;
 }
 
 L3DResult L3DFile::WriteFile(std::ostream& stream) const noexcept
@@ -862,23 +1180,37 @@ L3DResult L3DFile::Open(const std::filesystem::path& filepath) noexcept
 {
 	assert(!_isLoaded);
 
-	std::ifstream stream(filepath, std::ios::binary);
+	std::ifstream stream(filepath, std::ios::binary | std::ios::ate);
 
 	if (!stream.is_open())
 	{
 		return L3DResult::ErrCantOpen;
 	}
 
-	return ReadFile(stream);
+	std::vector<uint8_t> buffer(static_cast<size_t>(stream.tellg()));
+	stream.seekg(0);
+	if (!stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size())))
+	{
+		return L3DResult::ErrCantOpen;
+	}
+
+	return Open(std::move(buffer));
+}
+
+L3DResult L3DFile::Open(std::span<const uint8_t> buffer) noexcept
+{
+	assert(!_isLoaded);
+
+	return ReadFile(std::as_bytes(buffer));
 }
 
-L3DResult L3DFile::Open(const std::vector<uint8_t>& buffer) noexcept
+L3DResult L3DFile::Open(std::vector<uint8_t>&& buffer) noexcept
 {
 	assert(!_isLoaded);
 
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
+	_data = std::move(buffer);
 
-	return ReadFile(stream);
+	return ReadFile(std::as_bytes(std::span(_data)));
 }
 
 L3DResult L3DFile::Write(const std::filesystem::path& filepath) noexcept
@@ -977,22 +1309,24 @@ void L3DFile::AddPrimitives(const std::vector<L3DPrimitiveHeader>& headers) noex
 
 void L3DFile::AddVertices(const std::vector<L3DVertex>& vertices) noexcept
 {
-	auto size = _vertices.size();
+	auto size = _ownedVertices.size();
 	for (const auto& vertex : vertices)
 	{
-		_vertices.push_back(vertex);
+		_ownedVertices.push_back(vertex);
 	}
-	_vertexSpans.emplace_back(&_vertices[static_cast<uint32_t>(size)], static_cast<uint32_t>(vertices.size()));
+	_vertices = _ownedVertices;
+	_vertexSpans.emplace_back(&_ownedVertices[static_cast<uint32_t>(size)], static_cast<uint32_t>(vertices.size()));
 }
 
 void L3DFile::AddIndices(const std::vector<uint16_t>& indices) noexcept
 {
-	auto size = _indices.size();
+	auto size = _ownedIndices.size();
 	for (const auto& index : indices)
 	{
-		_indices.push_back(index);
+		_ownedIndices.push_back(index);
 	}
-	_indexSpans.emplace_back(&_indices[static_cast<uint32_t>(size)], static_cast<uint32_t>(indices.size()));
+	_indices = _ownedIndices;
+	_indexSpans.emplace_back(&_ownedIndices[static_cast<uint32_t>(size)], static_cast<uint32_t>(indices.size()));
 }
 
 void L3DFile::AddBones(const std::vector<L3DBone>& bones) noexcept
@@ -1000,7 +1334,8 @@ void L3DFile::AddBones(const std::vector<L3DBone>& bones) noexcept
 	auto size = _boneSpans.size();
 	for (const auto& bone : bones)
 	{
-		_bones.push_back(bone);
+		_ownedBones.push_back(bone);
 	}
-	_boneSpans.emplace_back(&_bones[static_cast<uint32_t>(size)], static_cast<uint32_t>(bones.size()));
+	_bones = _ownedBones;
+	_boneSpans.emplace_back(&_ownedBones[static_cast<uint32_t>(size)], static_cast<uint32_t>(bones.size()));
 }
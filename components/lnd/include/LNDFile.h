@@ -9,9 +9,12 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <array>
 #include <filesystem>
 #include <iosfwd>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -204,6 +207,9 @@ class LNDFile
 	/// Read file from the input source
 	LNDResult ReadFile(std::istream& stream) noexcept;
 
+	/// Read file from memory, bounds are checked before anything is copied
+	LNDResult ReadFile(std::span<const std::byte> data) noexcept;
+
 	/// Read lnd file from the filesystem
 	LNDResult Open(const std::filesystem::path& filepath) noexcept;
 
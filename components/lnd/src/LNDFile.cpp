@@ -118,45 +118,20 @@ LNDFile::~LNDFile() noexcept = default;
 
 namespace
 {
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
+/// Copies count items at offset out of data, returns false when they go beyond the end of data
+template <typename T>
+bool ReadAt(std::span<const std::byte> data, size_t offset, T* out, size_t count = 1) noexcept
 {
-	membuf(char const* base, size_t size)
+	if (offset > data.size() || (data.size() - offset) / sizeof(T) < count)
 	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
+		return false;
 	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
+	if (count > 0)
 	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
-		{
-			setg(eback(), egptr() + off, egptr());
-		}
-		else if (way == std::ios_base::beg)
-		{
-			setg(eback(), eback() + off, egptr());
-		}
-		return gptr() - eback();
-	}
-
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		return seekoff(pos - pos_type(static_cast<off_type>(0)), std::ios_base::beg, which);
+		std::memcpy(out, data.data() + offset, count * sizeof(T));
 	}
-};
-struct imemstream: virtual membuf, std::istream
-{
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
-	{
-	}
-};
+	return true;
+}
 } // namespace
 
 std::string_view openblack::lnd::ResultToStr(LNDResult result)
@@ -278,6 +253,84 @@ LNDResult LNDFile::ReadFile(std::istream& stream) noexcept
 	return LNDResult::Success;
 }
 
+LNDResult LNDFile::ReadFile(std::span<const std::byte> data) noexcept
+{
+	assert(!_isLoaded);
+
+	if (!ReadAt(data, 0, &_header))
+	{
+		return LNDResult::ErrFileTooSmall;
+	}
+	size_t offset = sizeof(_header);
+
+	if (_header.blockSize != sizeof(LNDBlock))
+	{
+		return LNDResult::ErrNonStandardBlockSize;
+	}
+	if (_header.materialSize != sizeof(LNDMaterial))
+	{
+		return LNDResult::ErrNonStandardMaterialSize;
+	}
+	if (_header.countrySize != sizeof(LNDCountry))
+	{
+		return LNDResult::ErrNonStandardCountrySize;
+	}
+
+	// Texture sizes include their size field
+	_lowResolutionTextures.resize(_header.lowResolutionCount);
+	for (auto& texture : _lowResolutionTextures)
+	{
+		if (!ReadAt(data, offset, &texture.header) || texture.header.size < sizeof(texture.header.size))
+		{
+			return LNDResult::ErrFileTooSmall;
+		}
+		offset += sizeof(texture.header);
+		texture.texels.resize(texture.header.size - sizeof(texture.header.size));
+		if (!ReadAt(data, offset, texture.texels.data(), texture.texels.size()))
+		{
+			return LNDResult::ErrFileTooSmall;
+		}
+		offset += texture.texels.size() * sizeof(texture.texels[0]);
+	}
+
+	// See the stream version about the block count
+	const size_t blockCount = _header.blockCount > 0 ? _header.blockCount - 1 : 0;
+	if (offset > data.size() || (data.size() - offset) / sizeof(LNDBlock) < blockCount)
+	{
+		return LNDResult::ErrBadBlockSize;
+	}
+	_blocks.resize(blockCount);
+	ReadAt(data, offset, _blocks.data(), _blocks.size());
+	offset += _blocks.size() * sizeof(_blocks[0]);
+
+	if ((data.size() - offset) / sizeof(LNDCountry) < _header.countryCount)
+	{
+		return LNDResult::ErrBadCountrySize;
+	}
+	_countries.resize(_header.countryCount);
+	ReadAt(data, offset, _countries.data(), _countries.size());
+	offset += _countries.size() * sizeof(_countries[0]);
+
+	if ((data.size() - offset) / sizeof(LNDMaterial) < _header.materialCount)
+	{
+		return LNDResult::ErrBadMaterialSize;
+	}
+	_materials.resize(_header.materialCount);
+	ReadAt(data, offset, _materials.data(), _materials.size());
+	offset += _materials.size() * sizeof(_materials[0]);
+
+	if (!ReadAt(data, offset, &_extra))
+	{
+		return LNDResult::ErrExtraTextureData;
+	}
+	offset += sizeof(_extra);
+
+	_unaccounted.resize(data.size() - offset);
+	ReadAt(data, offset, _unaccounted.data(), _unaccounted.size());
+
+	return LNDResult::Success;
+}
+
 LNDResult LNDFile::WriteFile(std::ostream& stream) const noexcept
 {
 	// First 1052 bytes
@@ -327,9 +380,7 @@ LNDResult LNDFile::Open(const std::vector<uint8_t>& buffer) noexcept
 {
 	assert(!_isLoaded);
 
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
-
-	return ReadFile(stream);
+	return ReadFile(std::as_bytes(std::span(buffer)));
 }
 
 LNDResult LNDFile::Write(const std::filesystem::path& filepath) noexcept
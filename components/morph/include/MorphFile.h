@@ -9,8 +9,11 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <array>
 #include <filesystem>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -25,6 +28,8 @@ enum class MorphResult : uint8_t
 	ErrSpecFileCantOpen,
 	ErrSpecFileVersionMismatch,
 	ErrSpecFileAnimationsBeforeCategories,
+	ErrBadAnimationOffset,
+	ErrBadHairOffset,
 };
 
 std::string_view ResultToStr(MorphResult result);
@@ -179,8 +184,8 @@ class MorphFile
 	std::vector<HairGroup> _hairGroups;
 	std::vector<std::vector<ExtraData>> _extraData; ///< related to \ref _base_animation
 
-	/// Read file from the input source
-	MorphResult ReadFile(std::istream& stream, const std::filesystem::path& specsDirectory) noexcept;
+	/// Read the spec file matching the header
+	MorphResult ReadSpecFileFor(const MorphHeader& header, const std::filesystem::path& specsDirectory) noexcept;
 	MorphResult ReadSpecFile(const std::filesystem::path& specFilePath) noexcept;
 	std::vector<Animation> ReadAnimations(std::istream& stream, const std::vector<uint32_t>& offsets) noexcept;
 	HairGroup ReadHairGroup(std::istream& stream) noexcept;
@@ -189,6 +194,12 @@ class MorphFile
 	MorphFile() noexcept;
 	virtual ~MorphFile() noexcept;
 
+	/// Read file from the input source
+	MorphResult ReadFile(std::istream& stream, const std::filesystem::path& specsDirectory) noexcept;
+
+	/// Read file from memory, bounds are checked before anything is copied
+	MorphResult ReadFile(std::span<const std::byte> data, const std::filesystem::path& specsDirectory) noexcept;
+
 	/// Read morph file from the filesystem
 	MorphResult Open(const std::filesystem::path& filepath, const std::filesystem::path& specsDirectory) noexcept;
 
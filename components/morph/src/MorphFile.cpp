@@ -91,45 +91,71 @@ using namespace openblack::morph;
 
 namespace
 {
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
+/// Copies count items at offset out of data, returns false when they go beyond the end of data
+template <typename T>
+bool ReadAt(std::span<const std::byte> data, size_t offset, T* out, size_t count = 1) noexcept
 {
-	membuf(char const* base, size_t size)
+	if (offset > data.size() || (data.size() - offset) / sizeof(T) < count)
 	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
+		return false;
 	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
+	if (count > 0)
 	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
-		{
-			setg(eback(), egptr() + off, egptr());
-		}
-		else if (way == std::ios_base::beg)
-		{
-			setg(eback(), eback() + off, egptr());
-		}
-		return gptr() - eback();
+		std::memcpy(out, data.data() + offset, count * sizeof(T));
 	}
+	return true;
+}
 
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
+/// Same as \ref ReadAt for an array of count items which is resized first, then moves offset past them
+template <typename T>
+bool ReadArray(std::span<const std::byte> data, size_t& offset, std::vector<T>& out, size_t count) noexcept
+{
+	if (offset > data.size() || (data.size() - offset) / sizeof(T) < count)
 	{
-		return seekoff(pos - static_cast<off_type>(0), std::ios_base::beg, which);
+		return false;
 	}
-};
-struct imemstream: virtual membuf, std::istream
+	out.resize(count);
+	ReadAt(data, offset, out.data(), count);
+	offset += count * sizeof(T);
+	return true;
+}
+
+bool ReadAnimationsAt(std::span<const std::byte> data, const std::vector<uint32_t>& offsets,
+                      std::vector<Animation>& animations) noexcept
 {
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
+	for (auto offset : offsets)
 	{
+		if (offset == 0)
+		{
+			continue;
+		}
+		size_t cursor = offset;
+		auto& animation = animations.emplace_back();
+		if (!ReadAt(data, cursor, &animation.header))
+		{
+			return false;
+		}
+		cursor += sizeof(animation.header);
+		if (!ReadArray(data, cursor, animation.rotatedJointIndices, animation.header.rotatedJointCount) ||
+		    !ReadArray(data, cursor, animation.translatedJointIndices, animation.header.translatedJointCount))
+		{
+			return false;
+		}
+		const size_t frameSize =
+		    (animation.header.rotatedJointCount + animation.header.translatedJointCount) * sizeof(std::array<float, 3>);
+		if (frameSize != 0 && (data.size() - cursor) / frameSize < animation.header.frameCount)
+		{
+			return false;
+		}
+		animation.keyframes.resize(animation.header.frameCount);
+		for (auto& frame : animation.keyframes)
+		{
+			ReadArray(data, cursor, frame.eulerAngles, animation.header.rotatedJointCount);
+			ReadArray(data, cursor, frame.translations, animation.header.translatedJointCount);
+		}
 	}
-};
+	return true;
+}
 
 // https://stackoverflow.com/questions/6089231/getting-std-ifstream-to-handle-lf-cr-and-crlf
 std::istream& safe_getline(std::istream& is, std::string& t)
@@ -188,6 +214,10 @@ std::string_view openblack::morph::ResultToStr(MorphResult result)
 		return "Spec file version mismatch.";
 	case MorphResult::ErrSpecFileAnimationsBeforeCategories:
 		return "Spec file has animations before categories.";
+	case MorphResult::ErrBadAnimationOffset:
+		return "Animation data is beyond the end of the file.";
+	case MorphResult::ErrBadHairOffset:
+		return "Hair data is beyond the end of the file.";
 	}
 	std::unreachable();
 }
@@ -298,6 +328,22 @@ HairGroup MorphFile::ReadHairGroup(std::istream& stream) noexcept
 	return hairGroup;
 }
 
+MorphResult MorphFile::ReadSpecFileFor(const MorphHeader& header, const std::filesystem::path& specsDirectory) noexcept
+{
+	std::string specName;
+	// this field is a good guess for hand or not, but a better choice might be
+	// getting the segment name from pack
+	if (header.unknown0x0 != 0u)
+	{
+		specName = "ctrspec" + std::to_string(header.specFileVersion) + ".txt";
+	}
+	else
+	{
+		specName = "hndspec" + std::to_string(header.specFileVersion) + ".txt";
+	}
+	return ReadSpecFile(specsDirectory / specName);
+}
+
 MorphResult MorphFile::ReadFile(std::istream& stream, const std::filesystem::path& specsDirectory) noexcept
 {
 	assert(!_isLoaded);
@@ -321,18 +367,7 @@ MorphResult MorphFile::ReadFile(std::istream& stream, const std::filesystem::pat
 	assert(_header.binaryVersion > 4); // structure is much different below v5
 
 	// Parse spec file (a separate text file) using the version
-	std::string specName;
-	// this field is a good guess for hand or not, but a better choice might be
-	// getting the segment name from pack
-	if (_header.unknown0x0 != 0u)
-	{
-		specName = "ctrspec" + std::to_string(_header.specFileVersion) + ".txt";
-	}
-	else
-	{
-		specName = "hndspec" + std::to_string(_header.specFileVersion) + ".txt";
-	}
-	const auto specResult = ReadSpecFile(specsDirectory / specName);
+	const auto specResult = ReadSpecFileFor(_header, specsDirectory);
 	if (specResult != MorphResult::Success)
 	{
 		return specResult;
@@ -402,6 +437,96 @@ MorphResult MorphFile::ReadFile(std::istream& stream, const std::filesystem::pat
 	return MorphResult::Success;
 }
 
+MorphResult MorphFile::ReadFile(std::span<const std::byte> data, const std::filesystem::path& specsDirectory) noexcept
+{
+	assert(!_isLoaded);
+
+	if (!ReadAt(data, 0, &_header))
+	{
+		return MorphResult::ErrFileTooSmall;
+	}
+
+	assert(_header.binaryVersion > 4); // structure is much different below v5
+
+	const auto specResult = ReadSpecFileFor(_header, specsDirectory);
+	if (specResult != MorphResult::Success)
+	{
+		return specResult;
+	}
+	size_t numAnimations = 0;
+	for (auto& animSet : _animationSpecs.animationSets)
+	{
+		numAnimations += animSet.animations.size();
+	}
+
+	// See the stream version for the layout
+	size_t offset = sizeof(_header);
+	std::vector<uint32_t> animationOffsets;
+	uint32_t extraOffset = 0;
+	if (!ReadArray(data, offset, animationOffsets, numAnimations) || !ReadAt(data, offset, &extraOffset) ||
+	    !ReadAnimationsAt(data, animationOffsets, _baseAnimation))
+	{
+		return MorphResult::ErrBadAnimationOffset;
+	}
+
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		if (std::strlen(_header.variantMeshNames.at(i).data()) > 0)
+		{
+			offset = extraOffset;
+			std::vector<uint32_t> variantAnimationOffsets;
+			if (!ReadArray(data, offset, variantAnimationOffsets, numAnimations) || !ReadAt(data, offset, &extraOffset) ||
+			    !ReadAnimationsAt(data, variantAnimationOffsets, _variantAnimations.at(i)))
+			{
+				return MorphResult::ErrBadAnimationOffset;
+			}
+		}
+	}
+
+	offset = extraOffset;
+	if (!ReadAt(data, offset, &_hairHeader))
+	{
+		return MorphResult::ErrBadHairOffset;
+	}
+	offset += sizeof(_hairHeader);
+	for (uint32_t i = 0; i < _hairHeader.hairGroupCount; ++i)
+	{
+		auto& hairGroup = _hairGroups.emplace_back();
+		if (!ReadAt(data, offset, &hairGroup.header))
+		{
+			return MorphResult::ErrBadHairOffset;
+		}
+		offset += sizeof(hairGroup.header);
+		if (!ReadArray(data, offset, hairGroup.hairs, hairGroup.header.hairCount))
+		{
+			return MorphResult::ErrBadHairOffset;
+		}
+	}
+
+	// Extra data runs until a zero or the end of the file
+	_extraData.resize(numAnimations);
+	for (size_t i = 0; i < numAnimations; ++i)
+	{
+		if (animationOffsets[i] == 0)
+		{
+			continue;
+		}
+		uint32_t hasData; // TODO(#467): unknown if this serves another function
+		while (ReadAt(data, offset, &hasData) && hasData != 0u)
+		{
+			offset += sizeof(hasData);
+			auto& extraData = _extraData[i].emplace_back();
+			ReadAt(data, offset, &extraData);
+			offset += sizeof(extraData);
+		}
+		offset += sizeof(hasData);
+	}
+
+	_isLoaded = true;
+
+	return MorphResult::Success;
+}
+
 MorphResult MorphFile::Open(const std::filesystem::path& filepath, const std::filesystem::path& specsDirectory) noexcept
 {
 	assert(!_isLoaded);
@@ -420,7 +545,5 @@ MorphResult MorphFile::Open(const std::vector<uint8_t>& buffer, const std::files
 {
 	assert(!_isLoaded);
 
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
-
-	return ReadFile(stream, specsDirectory);
+	return ReadFile(std::as_bytes(std::span(buffer)), specsDirectory);
 }
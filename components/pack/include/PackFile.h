@@ -14,6 +14,7 @@
 #include <istream>
 #include <map>
 #include <memory>
+#include <span>
 #include <streambuf>
 #include <string>
 #include <vector>
@@ -46,6 +47,14 @@ enum class PackResult : uint8_t
 
 std::string_view ResultToStr(PackResult result);
 
+enum class PackOpenMode : uint8_t
+{
+	/// Read the whole file into memory
+	Copy,
+	/// Map the file into memory, pages are only read once they are accessed
+	MemoryMap,
+};
+
 struct InfoBlockLookup
 {
 	uint32_t blockId;
@@ -108,7 +117,8 @@ struct G3DTexture
 {
 	G3DTextureHeader header;
 	DdsHeader ddsHeader;
-	std::vector<uint8_t> ddsData;
+	/// Points into the data of the \ref PackFile it came from
+	std::span<const uint8_t> ddsData;
 };
 
 enum class AudioBankLoop : uint16_t
@@ -178,35 +188,55 @@ struct AudioBankSampleHeader
 
 /**
   This class is used to read LionHead Packs files
+
+  The whole file is either read into memory once or memory mapped. Blocks, meshes, textures and audio samples are
+  spans into that data so they are only valid for as long as the PackFile is alive.
  */
 class PackFile
 {
 protected:
 	static constexpr const std::array<char, 8> k_Magic = {'L', 'i', 'O', 'n', 'H', 'e', 'A', 'd'};
 
+	class MappedFile;
+
 	/// True when a file has been loaded
 	bool _isLoaded {false};
 
-	std::map<std::string, std::vector<uint8_t>> _blocks;
+	/// File contents when read with \ref PackOpenMode::Copy
+	std::vector<uint8_t> _data;
+	/// File contents when read with \ref PackOpenMode::MemoryMap
+	std::unique_ptr<MappedFile> _mappedFile;
+	/// Blocks created for writing
+	std::map<std::string, std::vector<uint8_t>> _ownedBlocks;
+	/// Meshes inserted for writing
+	std::vector<std::vector<uint8_t>> _ownedMeshes;
+
+	std::map<std::string, std::span<const uint8_t>> _blocks;
 	std::vector<InfoBlockLookup> _infoBlockLookup;
 	std::vector<BodyBlockLookup> _bodyBlockLookup;
 	/// Metadata and DDS formatted texture data
 	std::map<std::string, G3DTexture> _textures;
 	/// Bytes of l3d meshes
-	std::vector<std::vector<uint8_t>> _meshes;
-	/// Bytes of anm meshes
+	std::vector<std::span<const uint8_t>> _meshes;
+	/// Bytes of anm meshes, copied as their header and body come from different blocks
 	std::vector<std::vector<uint8_t>> _animations;
 	/// Headers of snd audio samples
 	std::vector<AudioBankSampleHeader> _audioSampleHeaders;
 	/// Bytes of snd audio samples
-	std::vector<std::vector<uint8_t>> _audioSampleData;
+	std::vector<std::span<const uint8_t>> _audioSampleData;
+
+	/// Parse the whole file
+	PackResult Parse(std::span<const uint8_t> data) noexcept;
 
 	/// Read blocks from pack
-	PackResult ReadBlocks(std::istream& stream) noexcept;
+	PackResult ReadBlocks(std::span<const uint8_t> data) noexcept;
 
 	/// Write blocks to file
 	PackResult WriteBlocks(std::ostream& stream) const noexcept;
 
+	/// Add a block created for writing
+	PackResult InsertBlock(const std::string& name, std::vector<uint8_t>&& data) noexcept;
+
 	/// Parse Info Block for mesh pack
 	PackResult ResolveInfoBlock() noexcept;
 
@@ -230,16 +260,18 @@ class PackFile
 
 public:
 	PackFile() noexcept;
+	PackFile(const PackFile&) = delete;
+	PackFile& operator=(const PackFile&) = delete;
 	virtual ~PackFile() noexcept;
 
 	/// Read file from the input source
 	PackResult ReadFile(std::istream& stream) noexcept;
 
 	/// Read g3d file from the filesystem
-	PackResult Open(const std::filesystem::path& filepath) noexcept;
+	PackResult Open(const std::filesystem::path& filepath, PackOpenMode mode = PackOpenMode::Copy) noexcept;
 
 	/// Read g3d file from a buffer
-	PackResult Open(const std::vector<uint8_t>& buffer) noexcept;
+	PackResult Open(std::span<const uint8_t> buffer) noexcept;
 
 	/// Write pack file to path on the filesystem
 	PackResult Write(const std::filesystem::path& filepath) noexcept;
@@ -262,16 +294,16 @@ class PackFile
 	/// Create Body block from look-up table
 	PackResult CreateBodyBlock() noexcept;
 
-	[[nodiscard]] const std::map<std::string, std::vector<uint8_t>>& GetBlocks() const noexcept { return _blocks; }
+	[[nodiscard]] const std::map<std::string, std::span<const uint8_t>>& GetBlocks() const noexcept { return _blocks; }
 	[[nodiscard]] bool HasBlock(const std::string& name) const noexcept { return _blocks.contains(name); }
-	[[nodiscard]] const std::vector<uint8_t>& GetBlock(const std::string& name) const noexcept { return _blocks.at(name); }
+	[[nodiscard]] std::span<const uint8_t> GetBlock(const std::string& name) const noexcept { return _blocks.at(name); }
 	[[nodiscard]] std::unique_ptr<std::istream> GetBlockAsStream(const std::string& name) const noexcept;
 	[[nodiscard]] const std::vector<InfoBlockLookup>& GetInfoBlockLookup() const noexcept { return _infoBlockLookup; }
 	[[nodiscard]] const std::vector<BodyBlockLookup>& GetBodyBlockLookup() const noexcept { return _bodyBlockLookup; }
 	[[nodiscard]] const std::map<std::string, G3DTexture>& GetTextures() const noexcept { return _textures; }
 	[[nodiscard]] const G3DTexture& GetTexture(const std::string& name) const noexcept { return _textures.at(name); }
-	[[nodiscard]] const std::vector<std::vector<uint8_t>>& GetMeshes() const noexcept { return _meshes; }
-	[[nodiscard]] const std::vector<uint8_t>& GetMesh(uint32_t index) const noexcept { return _meshes[index]; }
+	[[nodiscard]] const std::vector<std::span<const uint8_t>>& GetMeshes() const noexcept { return _meshes; }
+	[[nodiscard]] std::span<const uint8_t> GetMesh(uint32_t index) const noexcept { return _meshes[index]; }
 	[[nodiscard]] const std::vector<std::vector<uint8_t>>& GetAnimations() const noexcept { return _animations; }
 	[[nodiscard]] const std::vector<uint8_t>& GetAnimation(uint32_t index) const noexcept { return _animations[index]; }
 	[[nodiscard]] const std::vector<AudioBankSampleHeader>& GetAudioSampleHeaders() const noexcept
@@ -282,8 +314,11 @@ class PackFile
 	{
 		return _audioSampleHeaders[index];
 	}
-	[[nodiscard]] const std::vector<std::vector<uint8_t>>& GetAudioSamplesData() const noexcept { return _audioSampleData; }
-	[[nodiscard]] const std::vector<uint8_t>& GetAudioSampleData(uint32_t index) const noexcept
+	[[nodiscard]] const std::vector<std::span<const uint8_t>>& GetAudioSamplesData() const noexcept
+	{
+		return _audioSampleData;
+	}
+	[[nodiscard]] std::span<const uint8_t> GetAudioSampleData(uint32_t index) const noexcept
 	{
 		return _audioSampleData[index];
 	}
@@ -126,9 +126,21 @@
 #include <cassert>
 #include <cstring>
 
+#include <algorithm>
 #include <fstream>
 #include <utility>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using namespace openblack::pack;
 
 namespace
@@ -184,6 +196,112 @@ struct PackBlockHeader
 constexpr const std::array<char, 4> k_BlockMagic = {'M', 'K', 'J', 'C'};
 } // namespace
 
+/// Read only mapping of a whole file
+class PackFile::MappedFile
+{
+public:
+	/// Returns nullptr if the file can not be opened or mapped
+	static std::unique_ptr<MappedFile> Open(const std::filesystem::path& filepath) noexcept;
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile() noexcept;
+
+	[[nodiscard]] std::span<const uint8_t> GetData() const noexcept { return {_data, _size}; }
+
+private:
+	MappedFile() noexcept = default;
+
+	const uint8_t* _data {nullptr};
+	size_t _size {0};
+#ifdef _WIN32
+	HANDLE _file {INVALID_HANDLE_VALUE};
+	HANDLE _mapping {nullptr};
+#endif
+};
+
+#ifdef _WIN32
+std::unique_ptr<PackFile::MappedFile> PackFile::MappedFile::Open(const std::filesystem::path& filepath) noexcept
+{
+	auto mappedFile = std::unique_ptr<MappedFile>(new MappedFile);
+	mappedFile->_file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	                                FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (mappedFile->_file == INVALID_HANDLE_VALUE)
+	{
+		return nullptr;
+	}
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(mappedFile->_file, &size) == 0 || size.QuadPart == 0)
+	{
+		return nullptr;
+	}
+	mappedFile->_mapping = CreateFileMappingW(mappedFile->_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappedFile->_mapping == nullptr)
+	{
+		return nullptr;
+	}
+	mappedFile->_data = static_cast<const uint8_t*>(MapViewOfFile(mappedFile->_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (mappedFile->_data == nullptr)
+	{
+		return nullptr;
+	}
+	mappedFile->_size = static_cast<size_t>(size.QuadPart);
+	return mappedFile;
+}
+
+PackFile::MappedFile::~MappedFile() noexcept
+{
+	if (_data != nullptr)
+	{
+		UnmapViewOfFile(_data);
+	}
+	if (_mapping != nullptr)
+	{
+		CloseHandle(_mapping);
+	}
+	if (_file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(_file);
+	}
+}
+#else
+std::unique_ptr<PackFile::MappedFile> PackFile::MappedFile::Open(const std::filesystem::path& filepath) noexcept
+{
+	const int fd = open(filepath.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return nullptr;
+	}
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+	{
+		close(fd);
+		return nullptr;
+	}
+	const auto size = static_cast<size_t>(fileStat.st_size);
+	void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps its own reference to the file
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	auto mappedFile = std::unique_ptr<MappedFile>(new MappedFile);
+	mappedFile->_data = static_cast<const uint8_t*>(data);
+	mappedFile->_size = size;
+	return mappedFile;
+}
+
+PackFile::MappedFile::~MappedFile() noexcept
+{
+	if (_data != nullptr)
+	{
+		munmap(const_cast<uint8_t*>(_data), _size);
+	}
+}
+#endif
+
 std::string_view openblack::pack::ResultToStr(PackResult result)
 {
 	switch (result)
@@ -230,53 +348,43 @@ std::string_view openblack::pack::ResultToStr(PackResult result)
 	std::unreachable();
 }
 
-PackResult PackFile::ReadBlocks(std::istream& stream) noexcept
+PackResult PackFile::ReadBlocks(std::span<const uint8_t> data) noexcept
 {
 	assert(!_isLoaded);
 
-	// Total file size
-	std::size_t fsize = 0;
-	if (stream.seekg(0, std::ios_base::end))
-	{
-		fsize = static_cast<std::size_t>(stream.tellg());
-		stream.seekg(0);
-	}
-
-	std::array<char, k_Magic.size()> magic;
-	if (fsize < magic.size() + sizeof(PackBlockHeader))
+	if (data.size() < k_Magic.size() + sizeof(PackBlockHeader))
 	{
 		return PackResult::ErrFileTooSmall;
 	}
 
 	// First 8 bytes
-	stream.read(magic.data(), magic.size());
-	if (std::memcmp(magic.data(), k_Magic.data(), magic.size()) != 0)
+	if (std::memcmp(data.data(), k_Magic.data(), k_Magic.size()) != 0)
 	{
 		return PackResult::ErrUnrecognizedHeader;
 	}
 
-	if (fsize < static_cast<std::size_t>(stream.tellg()) + sizeof(PackBlockHeader))
-	{
-		return PackResult::ErrFileTooSmall;
-	}
-
 	PackBlockHeader header;
-	while (fsize - sizeof(PackBlockHeader) > static_cast<std::size_t>(stream.tellg()))
+	size_t offset = k_Magic.size();
+	while (data.size() - sizeof(PackBlockHeader) > offset)
 	{
-		stream.read(reinterpret_cast<char*>(&header), sizeof(PackBlockHeader));
+		std::memcpy(&header, data.data() + offset, sizeof(PackBlockHeader));
+		offset += sizeof(PackBlockHeader);
 
-		if (_blocks.contains(header.blockName.data()))
+		// Names fill the whole array when they are 32 characters long
+		const auto nameLength = std::find(header.blockName.begin(), header.blockName.end(), '\0') - header.blockName.begin();
+		auto name = std::string(header.blockName.data(), static_cast<size_t>(nameLength));
+		if (_blocks.contains(name))
 		{
 			return PackResult::ErrDuplicateBlockName;
 		}
 
-		_blocks[std::string(header.blockName.data())] = std::vector<uint8_t>(header.blockSize);
-		stream.read(reinterpret_cast<char*>(_blocks[header.blockName.data()].data()), header.blockSize);
-	}
+		if (header.blockSize > data.size() - offset)
+		{
+			return PackResult::ErrFileNotEvenlySplit;
+		}
 
-	if (fsize < static_cast<std::size_t>(stream.tellg()))
-	{
-		return PackResult::ErrFileNotEvenlySplit;
+		_blocks[std::move(name)] = data.subspan(offset, header.blockSize);
+		offset += header.blockSize;
 	}
 
 	return PackResult::Success;
@@ -390,11 +498,13 @@ PackResult PackFile::ExtractTexturesFromBlock() noexcept
 			return PackResult::ErrMissingTextureBlock;
 		}
 
-		auto stream = GetBlockAsStream(blockName.data());
-
-		stream->read(reinterpret_cast<char*>(&header), sizeof(header));
-		std::vector<uint8_t> dds(header.size);
-		stream->read(reinterpret_cast<char*>(dds.data()), dds.size() * sizeof(dds[0]));
+		const auto block = GetBlock(blockName.data());
+		if (block.size() < sizeof(header))
+		{
+			return PackResult::ErrFileTooSmall;
+		}
+		std::memcpy(&header, block.data(), sizeof(header));
+		const auto dds = block.subspan(sizeof(header), std::min<size_t>(header.size, block.size() - sizeof(header)));
 
 		if (header.id != item.blockId)
 		{
@@ -406,10 +516,12 @@ PackResult PackFile::ExtractTexturesFromBlock() noexcept
 			return PackResult::ErrTextureDuplicate;
 		}
 
-		imemstream ddsStream(reinterpret_cast<const char*>(dds.data()), dds.size());
-
 		DdsHeader ddsHeader;
-		ddsStream.read(reinterpret_cast<char*>(&ddsHeader), sizeof(DdsHeader));
+		if (dds.size() < sizeof(DdsHeader))
+		{
+			return PackResult::ErrTextureInvalidDDSHeaderSize;
+		}
+		std::memcpy(&ddsHeader, dds.data(), sizeof(DdsHeader));
 
 		// Verify the header to validate the DDS file
 		if (ddsHeader.size != sizeof(DdsHeader) || ddsHeader.format.size != sizeof(DdsPixelFormat))
@@ -437,10 +549,12 @@ PackResult PackFile::ExtractTexturesFromBlock() noexcept
 			ddsHeader.pitchOrLinearSize = ((ddsHeader.width + 3) / 4) * ((ddsHeader.height + 3) / 4) * blockSize;
 		}
 
-		std::vector<uint8_t> dssTexels(ddsHeader.pitchOrLinearSize);
-		ddsStream.read(reinterpret_cast<char*>(dssTexels.data()), dssTexels.size());
+		if (ddsHeader.pitchOrLinearSize > dds.size() - sizeof(DdsHeader))
+		{
+			return PackResult::ErrFileTooSmall;
+		}
 
-		_textures[blockName.data()] = {header, ddsHeader, dssTexels};
+		_textures[blockName.data()] = {header, ddsHeader, dds.subspan(sizeof(DdsHeader), ddsHeader.pitchOrLinearSize)};
 	}
 
 	return PackResult::Success;
@@ -448,8 +562,7 @@ PackResult PackFile::ExtractTexturesFromBlock() noexcept
 
 PackResult PackFile::ExtractAnimationsFromBlock() noexcept
 {
-	auto data = GetBlock("Body");
-	imemstream stream(reinterpret_cast<const char*>(data.data()), data.size());
+	const auto data = GetBlock("Body");
 
 	// Read lookup
 	constexpr uint32_t blockNameSize = 0x20;
@@ -465,12 +578,16 @@ PackResult PackFile::ExtractAnimationsFromBlock() noexcept
 			return PackResult::ErrMissingTextureBlock;
 		}
 
-		auto animationData = GetBlock(blockName.data());
-		_animations[i].resize(animationHeaderSize + animationData.size());
+		const auto offset = _bodyBlockLookup[i].offset;
+		if (offset > data.size() || animationHeaderSize > data.size() - offset)
+		{
+			return PackResult::ErrFileTooSmall;
+		}
 
-		stream.seekg(_bodyBlockLookup[i].offset);
-		stream.read(reinterpret_cast<char*>(_animations[i].data()), animationHeaderSize);
-		memcpy(_animations[i].data() + animationHeaderSize, animationData.data(), animationData.size());
+		const auto animationData = GetBlock(blockName.data());
+		_animations[i].resize(animationHeaderSize + animationData.size());
+		std::memcpy(_animations[i].data(), data.data() + offset, animationHeaderSize);
+		std::memcpy(_animations[i].data() + animationHeaderSize, animationData.data(), animationData.size());
 	}
 
 	return PackResult::Success;
@@ -483,10 +600,7 @@ PackResult PackFile::ExtractSoundsFromBlock() noexcept
 		return PackResult::ErrMissingAudioWaveDataBlock;
 	}
 
-	auto data = GetBlock("LHAudioWaveData");
-	imemstream stream(reinterpret_cast<const char*>(data.data()), data.size());
-	//	auto isSector = false;
-	//	auto isPrevSector = false;
+	const auto data = GetBlock("LHAudioWaveData");
 
 	_audioSampleData.resize(_audioSampleHeaders.size());
 	for (int i = 0; const auto& sample : _audioSampleHeaders)
@@ -495,15 +609,12 @@ PackResult PackFile::ExtractSoundsFromBlock() noexcept
 		{
 			return PackResult::ErrFileTooSmall;
 		}
-		if (sample.offset + sample.size > data.size())
+		if (sample.size > data.size() - sample.offset)
 		{
 			return PackResult::ErrFileTooSmall;
 		}
 
-		_audioSampleData[i].resize(sample.size);
-
-		stream.seekg(sample.offset);
-		stream.read(reinterpret_cast<char*>(_audioSampleData[i].data()), sample.size);
+		_audioSampleData[i] = data.subspan(sample.offset, sample.size);
 
 		++i;
 	}
@@ -517,7 +628,11 @@ PackResult PackFile::ResolveMeshBlock() noexcept
 	{
 		return PackResult::ErrMissingMeshBlock;
 	}
-	auto data = GetBlock("MESHES");
+	const auto data = GetBlock("MESHES");
+	if (data.size() < k_BlockMagic.size() + sizeof(uint32_t))
+	{
+		return PackResult::ErrMeshBlockHeaderMalformed;
+	}
 
 	imemstream stream(reinterpret_cast<const char*>(data.data()), data.size());
 	// Greetings Jean-Claude Cottier
@@ -530,15 +645,22 @@ PackResult PackFile::ResolveMeshBlock() noexcept
 
 	uint32_t meshCount;
 	stream.read(reinterpret_cast<char*>(&meshCount), sizeof(meshCount));
+	if (meshCount > (data.size() - k_BlockMagic.size() - sizeof(meshCount)) / sizeof(uint32_t))
+	{
+		return PackResult::ErrMeshBlockHeaderMalformed;
+	}
 	std::vector<uint32_t> meshOffsets(meshCount);
 	stream.read(reinterpret_cast<char*>(meshOffsets.data()), meshOffsets.size() * sizeof(meshOffsets[0]));
 
 	_meshes.resize(meshOffsets.size());
 	for (std::size_t i = 0; i < _meshes.size(); i++)
 	{
-		auto size = (i == _meshes.size() - 1 ? data.size() : meshOffsets[i + 1]) - meshOffsets[i];
-		_meshes[i].resize(size);
-		stream.read(reinterpret_cast<char*>(_meshes[i].data()), _meshes[i].size() * sizeof(_meshes[i][0]));
+		const size_t end = i == _meshes.size() - 1 ? data.size() : meshOffsets[i + 1];
+		if (meshOffsets[i] > end || end > data.size())
+		{
+			return PackResult::ErrMeshBlockHeaderMalformed;
+		}
+		_meshes[i] = data.subspan(meshOffsets[i], end - meshOffsets[i]);
 	}
 
 	return PackResult::Success;
@@ -574,18 +696,25 @@ PackResult PackFile::CreateTextureBlocks() noexcept
 	return PackResult::ErrNotImplemented;
 }
 
-PackResult PackFile::CreateRawBlock(const std::string& name, std::vector<uint8_t>&& data) noexcept
+PackResult PackFile::InsertBlock(const std::string& name, std::vector<uint8_t>&& data) noexcept
 {
 	if (HasBlock(name))
 	{
 		return PackResult::ErrDuplicateBlockName;
 	}
 
-	_blocks[name] = std::move(data);
+	// Map nodes do not move so the span stays valid
+	const auto& block = _ownedBlocks[name] = std::move(data);
+	_blocks[name] = block;
 
 	return PackResult::Success;
 }
 
+PackResult PackFile::CreateRawBlock(const std::string& name, std::vector<uint8_t>&& data) noexcept
+{
+	return InsertBlock(name, std::move(data));
+}
+
 PackResult PackFile::CreateMeshBlock() noexcept
 {
 	if (HasBlock("MESHES"))
@@ -626,14 +755,13 @@ PackResult PackFile::CreateMeshBlock() noexcept
 		}
 	}
 
-	_blocks["MESHES"] = std::move(contents);
-
-	return PackResult::Success;
+	return InsertBlock("MESHES", std::move(contents));
 }
 
 PackResult PackFile::InsertMesh(std::vector<uint8_t> data) noexcept
 {
-	_meshes.emplace_back(std::move(data));
+	// Moving the vectors when this one grows keeps their data where it is
+	_meshes.emplace_back(_ownedMeshes.emplace_back(std::move(data)));
 
 	return PackResult::Success;
 }
@@ -656,9 +784,7 @@ PackResult PackFile::CreateInfoBlock() noexcept
 
 	std::memcpy(contents.data() + offset, _infoBlockLookup.data(), _infoBlockLookup.size() * sizeof(_infoBlockLookup[0]));
 
-	_blocks["INFO"] = std::move(contents);
-
-	return PackResult::Success;
+	return InsertBlock("INFO", std::move(contents));
 }
 
 PackResult PackFile::CreateBodyBlock() noexcept
@@ -668,21 +794,17 @@ PackResult PackFile::CreateBodyBlock() noexcept
 		return PackResult::ErrDuplicateBlockName;
 	}
 
-	std::vector<uint8_t> contents;
-
-	_blocks["Body"] = std::move(contents);
-
-	return PackResult::Success;
+	return InsertBlock("Body", {});
 }
 
 PackFile::PackFile() noexcept = default;
 PackFile::~PackFile() noexcept = default;
 
-PackResult PackFile::ReadFile(std::istream& stream) noexcept
+PackResult PackFile::Parse(std::span<const uint8_t> data) noexcept
 {
 	PackResult result;
 
-	result = ReadBlocks(stream);
+	result = ReadBlocks(data);
 	if (result != PackResult::Success)
 	{
 		return result;
@@ -752,8 +874,39 @@ PackResult PackFile::ReadFile(std::istream& stream) noexcept
 	return PackResult::Success;
 }
 
-PackResult PackFile::Open(const std::filesystem::path& filepath) noexcept
+PackResult PackFile::ReadFile(std::istream& stream) noexcept
 {
+	assert(!_isLoaded);
+
+	// Total file size
+	std::size_t fsize = 0;
+	if (stream.seekg(0, std::ios_base::end))
+	{
+		fsize = static_cast<std::size_t>(stream.tellg());
+		stream.seekg(0);
+	}
+
+	// The only copy, everything else points into it
+	_data.resize(fsize);
+	stream.read(reinterpret_cast<char*>(_data.data()), static_cast<std::streamsize>(_data.size()));
+
+	return Parse(_data);
+}
+
+PackResult PackFile::Open(const std::filesystem::path& filepath, PackOpenMode mode) noexcept
+{
+	assert(!_isLoaded);
+
+	if (mode == PackOpenMode::MemoryMap)
+	{
+		_mappedFile = MappedFile::Open(filepath);
+		if (!_mappedFile)
+		{
+			return PackResult::ErrCantOpen;
+		}
+		return Parse(_mappedFile->GetData());
+	}
+
 	std::ifstream stream(filepath, std::ios::binary);
 
 	if (!stream.is_open())
@@ -764,13 +917,13 @@ PackResult PackFile::Open(const std::filesystem::path& filepath) noexcept
 	return ReadFile(stream);
 }
 
-PackResult PackFile::Open(const std::vector<uint8_t>& buffer) noexcept
+PackResult PackFile::Open(std::span<const uint8_t> buffer) noexcept
 {
 	assert(!_isLoaded);
 
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
+	_data.assign(buffer.begin(), buffer.end());
 
-	return ReadFile(stream);
+	return Parse(_data);
 }
 
 PackResult PackFile::Write(const std::filesystem::path& filepath) noexcept
@@ -12,6 +12,7 @@
 
 #include "LandIsland.h"
 
+#include <array>
 #include <stdexcept>
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
@@ -28,6 +29,7 @@
 #include "Graphics/Mesh.h"
 #include "Graphics/Texture2D.h"
 #include "Locator.h"
+#include "Resources/AssetCache.h"
 
 using namespace openblack;
 using namespace openblack::graphics;
@@ -48,7 +50,7 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading Land from file: {}", path.string());
 	lnd::LNDFile lnd;
 
-	const auto result = lnd.ReadFile(*Locator::filesystem::value().GetData(path));
+	const auto result = lnd.Open(Locator::filesystem::value().ReadAll(path));
 	if (result != lnd::LNDResult::Success)
 	{
 		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open lnd file from filesystem {}: {}", path.string(),
@@ -139,9 +141,38 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 	                        static_cast<uint32_t>(sizeof(lnd.GetExtra().bump.texels[0]) * lnd.GetExtra().bump.texels.size()));
 
 	// build the meshes (we could move this elsewhere)
-	for (auto& block : _landBlocks)
+	const std::array sources {path};
+	const auto baked = Locator::assetCache::has_value() ? Locator::assetCache::value().Find("terrain", sources) : nullptr;
+	bool built = false;
+	if (baked != nullptr)
 	{
-		block.BuildMesh(*this);
+		try
+		{
+			resources::BlobReader reader(baked->GetData());
+			for (auto& block : _landBlocks)
+			{
+				block.BuildMesh(reader.ReadArray<LandVertex>());
+			}
+			built = true;
+		}
+		catch (const std::runtime_error& err)
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Failed to load baked terrain of {}: {}", path.string(), err.what());
+		}
+	}
+	if (!built)
+	{
+		resources::BlobWriter writer;
+		for (auto& block : _landBlocks)
+		{
+			const auto vertices = block.BuildVertexList(*this);
+			block.BuildMesh(vertices);
+			writer.WriteArray(vertices);
+		}
+		if (Locator::assetCache::has_value())
+		{
+			Locator::assetCache::value().Store("terrain", sources, writer.Release());
+		}
 	}
 	bgfx::frame();
 }
@@ -11,6 +11,12 @@
 
 #include "Sky.h"
 
+#include <cstring>
+
+#include <exception>
+#include <span>
+#include <vector>
+
 #include <glm/vec3.hpp>
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
@@ -21,6 +27,8 @@
 #include "FileSystem/FileSystemInterface.h"
 #include "Graphics/Texture2D.h"
 #include "Locator.h"
+#include "Resources/AssetCache.h"
+#include "Resources/Loaders.h"
 
 using namespace openblack::filesystem;
 using namespace openblack::graphics;
@@ -36,8 +44,27 @@ Sky::Sky() noexcept
 
 	// load in the mesh
 	_mesh = std::make_unique<graphics::L3DMesh>("Sky");
-	_mesh->LoadFromFilesystem(fileSystem.GetPath<filesystem::Path::WeatherSystem>() / "sky.l3d");
+	try
+	{
+		const auto path = fileSystem.GetPath<filesystem::Path::WeatherSystem>() / "sky.l3d";
+		if (const auto baked = resources::L3DLoader::FindBaked(path))
+		{
+			_mesh->LoadBaked(baked->GetData());
+		}
+		else
+		{
+			const auto l3d = resources::L3DLoader::Parse(path);
+			resources::L3DLoader::StoreBaked(path, *l3d);
+			_mesh->Load(*l3d);
+		}
+	}
+	catch (const std::exception& err)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to load sky mesh: {}", err.what());
+	}
 
+	std::vector<std::filesystem::path> paths;
+	paths.reserve(k_TextureResolution[2]);
 	// TODO (#749) Maybe use std::views::enumerate
 	for (uint32_t idx = 0; const auto& alignment : k_Alignments)
 	{
@@ -51,7 +78,23 @@ Sky::Sky() noexcept
 				prefix = string_utils::Capitalise(prefix);
 			}
 			const auto filename = fmt::format("{}_{}_{}.555", prefix, alignment, time);
-			const auto path = fileSystem.GetPath<filesystem::Path::WeatherSystem>() / filename;
+			paths.emplace_back(fileSystem.GetPath<filesystem::Path::WeatherSystem>() / filename);
+			++idx;
+		}
+	}
+
+	// The texture array is baked as a whole, it is stale as soon as any of its bitmaps changes
+	const auto bitmapsData = std::span(reinterpret_cast<uint8_t*>(_bitmaps.data()), sizeof(_bitmaps));
+	const auto baked = Locator::assetCache::has_value() ? Locator::assetCache::value().Find("sky", paths) : nullptr;
+	if (baked != nullptr && baked->GetData().size() == bitmapsData.size())
+	{
+		std::memcpy(bitmapsData.data(), baked->GetData().data(), bitmapsData.size());
+	}
+	else
+	{
+		// TODO (#749) Maybe use std::views::enumerate
+		for (uint32_t idx = 0; const auto& path : paths)
+		{
 			SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading sky texture: {}", path.generic_string());
 
 			Bitmap16B* bitmap = Bitmap16B::LoadFromFile(path);
@@ -59,6 +102,10 @@ Sky::Sky() noexcept
 			delete bitmap;
 			++idx;
 		}
+		if (Locator::assetCache::has_value())
+		{
+			Locator::assetCache::value().Store("sky", paths, bitmapsData);
+		}
 	}
 
 	_texture = std::make_unique<Texture2D>("Sky");
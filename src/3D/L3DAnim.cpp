@@ -9,11 +9,17 @@
 
 #include "L3DAnim.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <stdexcept>
 
 #include <ANMFile.h>
-#include <glm/gtx/matrix_interpolation.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/matrix.hpp>
+#include <glm/vector_relational.hpp>
 #include <spdlog/spdlog.h>
 
 #include "FileSystem/FileSystemInterface.h"
@@ -21,6 +27,25 @@
 
 using namespace openblack;
 
+namespace
+{
+constexpr float k_QuantizationScale = 32767.0f;
+/// Clips whose scales are all closer to 1 than this don't store them
+constexpr float k_ScaleEpsilon = 1e-3f;
+
+/// Rotation of \p rotation, which must be normalized, scaled by \p scale and translated by \p translation
+glm::mat4 ComposeBone(const glm::vec4& rotation, const glm::vec3& translation, const glm::vec3& scale) noexcept
+{
+	const auto matrix = glm::mat3_cast(glm::quat(rotation.w, rotation.x, rotation.y, rotation.z));
+	return {
+	    glm::vec4(matrix[0] * scale.x, 0.0f),
+	    glm::vec4(matrix[1] * scale.y, 0.0f),
+	    glm::vec4(matrix[2] * scale.z, 0.0f),
+	    glm::vec4(translation, 1.0f),
+	};
+}
+} // namespace
+
 void L3DAnim::Load(const anm::ANMFile& anm) noexcept
 {
 	_name = std::string(anm.GetHeader().name.data(), anm.GetHeader().name.size());
@@ -37,23 +62,59 @@ void L3DAnim::Load(const anm::ANMFile& anm) noexcept
 	_unknown_0x48 = anm.GetHeader().unknown0x48;
 	_unknown_0x50 = anm.GetHeader().unknown0x50;
 
-	_frames.reserve(anm.GetKeyframes().size());
-	for (const auto& keyframe : anm.GetKeyframes())
+	const auto& keyframes = anm.GetKeyframes();
+	_boneCount = 0;
+	for (const auto& keyframe : keyframes)
+	{
+		_boneCount = std::max(_boneCount, keyframe.bones.size());
+	}
+	_frameTimes.clear();
+	_frameTimes.reserve(keyframes.size());
+	_rotations.assign(keyframes.size() * _boneCount, glm::i16vec4(0, 0, 0, static_cast<int16_t>(k_QuantizationScale)));
+	_translations.assign(keyframes.size() * _boneCount, glm::vec3(0.0f));
+	_scales.assign(keyframes.size() * _boneCount, glm::vec3(1.0f));
+
+	bool scaled = false;
+	for (size_t frame = 0; frame < keyframes.size(); ++frame)
 	{
-		auto& frame = _frames.emplace_back();
-		frame.time = keyframe.time;
-		frame.bones.resize(keyframe.bones.size());
-		for (uint32_t i = 0; i < keyframe.bones.size(); ++i)
+		const auto& keyframe = keyframes[frame];
+		_frameTimes.push_back(keyframe.time);
+		for (size_t i = 0; i < keyframe.bones.size(); ++i)
 		{
-			// clang-format off
-			auto matrix = glm::mat4(keyframe.bones[i].matrix[0], keyframe.bones[i].matrix[1], keyframe.bones[i].matrix[2], 0.0f,
-			                        keyframe.bones[i].matrix[3], keyframe.bones[i].matrix[4], keyframe.bones[i].matrix[5], 0.0f,
-			                        keyframe.bones[i].matrix[6], keyframe.bones[i].matrix[7], keyframe.bones[i].matrix[8], 0.0f,
-			                        keyframe.bones[i].matrix[9], keyframe.bones[i].matrix[10], keyframe.bones[i].matrix[11], 1.0f);
-			// clang-format on
-			frame.bones[i] = matrix;
+			const auto& m = keyframe.bones[i].matrix;
+			auto axes = glm::mat3(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8]);
+			auto scale = glm::vec3(glm::length(axes[0]), glm::length(axes[1]), glm::length(axes[2]));
+			// A mirrored bone can't be represented by a rotation alone
+			if (glm::determinant(axes) < 0.0f)
+			{
+				scale.x = -scale.x;
+			}
+
+			const auto index = frame * _boneCount + i;
+			// Collapsed bones keep the identity rotation
+			if (glm::all(glm::greaterThan(glm::abs(scale), glm::vec3(k_ScaleEpsilon))))
+			{
+				axes[0] /= scale.x;
+				axes[1] /= scale.y;
+				axes[2] /= scale.z;
+				auto rotation = glm::normalize(glm::quat_cast(axes));
+				if (rotation.w < 0.0f)
+				{
+					rotation = -rotation;
+				}
+				const auto components = glm::vec4(rotation.x, rotation.y, rotation.z, rotation.w);
+				_rotations[index] = glm::i16vec4(glm::round(components * k_QuantizationScale));
+			}
+			_translations[index] = glm::vec3(m[9], m[10], m[11]);
+			_scales[index] = scale;
+			scaled |= glm::any(glm::greaterThan(glm::abs(scale - 1.0f), glm::vec3(k_ScaleEpsilon)));
 		}
 	}
+	if (!scaled)
+	{
+		_scales.clear();
+		_scales.shrink_to_fit();
+	}
 }
 
 bool L3DAnim::LoadFromFilesystem(const std::filesystem::path& path) noexcept
@@ -61,7 +122,7 @@ bool L3DAnim::LoadFromFilesystem(const std::filesystem::path& path) noexcept
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading L3DAnim from file: {}", path.generic_string());
 	anm::ANMFile anm;
 
-	const auto result = anm.ReadFile(*Locator::filesystem::value().GetData(path));
+	const auto result = anm.Open(Locator::filesystem::value().ReadAll(path));
 
 	if (result != anm::ANMResult::Success)
 	{
@@ -91,7 +152,7 @@ bool L3DAnim::LoadFromFile(const std::filesystem::path& path) noexcept
 	return true;
 }
 
-bool L3DAnim::LoadFromBuffer(const std::vector<uint8_t>& data) noexcept
+bool L3DAnim::LoadFromBuffer(std::span<const uint8_t> data) noexcept
 {
 	anm::ANMFile anm;
 
@@ -108,56 +169,76 @@ bool L3DAnim::LoadFromBuffer(const std::vector<uint8_t>& data) noexcept
 	return true;
 }
 
-std::vector<glm::mat4> L3DAnim::GetBoneMatrices(uint32_t time) const noexcept
+size_t L3DAnim::GetSizeInBytes() const noexcept
 {
-	if (_frames.empty())
+	return sizeof(*this) + _frameTimes.size() * sizeof(_frameTimes[0]) + _rotations.size() * sizeof(_rotations[0]) +
+	       _translations.size() * sizeof(_translations[0]) + _scales.size() * sizeof(_scales[0]);
+}
+
+size_t L3DAnim::GetFrameBones(size_t frame, std::span<glm::mat4> bones) const noexcept
+{
+	const auto count = std::min(bones.size(), _boneCount);
+	const auto first = frame * _boneCount;
+	for (size_t i = 0; i < count; ++i)
 	{
-		return {};
+		const auto rotation = glm::normalize(glm::vec4(_rotations[first + i]));
+		const auto scale = _scales.empty() ? glm::vec3(1.0f) : _scales[first + i];
+		bones[i] = ComposeBone(rotation, _translations[first + i], scale);
 	}
-	if (_duration == 0)
+	return count;
+}
+
+size_t L3DAnim::EvaluateBones(uint32_t time, std::span<glm::mat4> bones) const noexcept
+{
+	if (_frameTimes.empty())
 	{
-		return _frames[0].bones;
+		return 0;
 	}
-	uint32_t animationTime = time % _duration;
-	uint32_t index = 0;
-	uint32_t previousTime = 0;
-	for (const auto& frame : _frames)
+	if (_duration == 0)
 	{
-		if (frame.time < animationTime)
-		{
-			previousTime = frame.time;
-			index++;
-		}
-		else
-		{
-			break;
-		}
+		return GetFrameBones(0, bones);
 	}
-	// No interpolation needed
-	if (index == 0)
+
+	// First keyframe at or after the time, the pose is held before the first and after the last keyframe
+	const uint32_t animationTime = time % _duration;
+	const auto next = std::lower_bound(_frameTimes.cbegin(), _frameTimes.cend(), animationTime);
+	if (next == _frameTimes.cbegin())
 	{
-		return _frames[0].bones;
+		return GetFrameBones(0, bones);
 	}
-	if (index >= _frames.size())
+	if (next == _frameTimes.cend())
 	{
-		return _frames[_frames.size() - 1].bones;
+		return GetFrameBones(_frameTimes.size() - 1, bones);
 	}
-	float t = static_cast<float>(animationTime - previousTime) / (_frames[index].time - previousTime);
-
-	// Interpolate
-	std::vector<glm::mat4> bones;
-	bones.resize(_frames[index].bones.size());
-	for (uint32_t i = 0; i < bones.size(); ++i)
+	const auto index = static_cast<size_t>(std::distance(_frameTimes.cbegin(), next));
+	const auto previousTime = _frameTimes[index - 1];
+	const float t = static_cast<float>(animationTime - previousTime) / static_cast<float>(_frameTimes[index] - previousTime);
+
+	// Both keyframes are contiguous blocks of the streams. The blend is plain vec4 arithmetic with no branch other than the
+	// quaternion sign flip so that it maps onto SIMD lanes.
+	const auto count = std::min(bones.size(), _boneCount);
+	const auto from = (index - 1) * _boneCount;
+	const auto to = index * _boneCount;
+	for (size_t i = 0; i < count; ++i)
 	{
-		// Doing matrix interpolation is not ideal. Would prefer quaternions but
-		// extracting a quaternion from a glm::mat4 does not reconstruct the
-		// same matrix from the quaternion.
-		bones[i] = glm::mat4(glm::mix(_frames[index - 1].bones[i][0], _frames[index].bones[i][0], t),
-		                     glm::mix(_frames[index - 1].bones[i][1], _frames[index].bones[i][1], t),
-		                     glm::mix(_frames[index - 1].bones[i][2], _frames[index].bones[i][2], t),
-		                     glm::mix(_frames[index - 1].bones[i][3], _frames[index].bones[i][3], t));
+		// The quantization scale cancels out when normalizing
+		const auto a = glm::vec4(_rotations[from + i]);
+		auto b = glm::vec4(_rotations[to + i]);
+		if (glm::dot(a, b) < 0.0f)
+		{
+			b = -b;
+		}
+		const auto rotation = glm::normalize(glm::mix(a, b, t));
+		const auto translation = glm::mix(_translations[from + i], _translations[to + i], t);
+		const auto scale = _scales.empty() ? glm::vec3(1.0f) : glm::mix(_scales[from + i], _scales[to + i], t);
+		bones[i] = ComposeBone(rotation, translation, scale);
 	}
+	return count;
+}
 
-	// assert(index < _frames.size());
+std::vector<glm::mat4> L3DAnim::GetBoneMatrices(uint32_t time) const noexcept
+{
+	std::vector<glm::mat4> bones(_boneCount);
+	EvaluateBones(time, bones);
 	return bones;
 }
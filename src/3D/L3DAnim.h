@@ -12,9 +12,12 @@
 #include <cstdint>
 
 #include <filesystem>
+#include <span>
 #include <vector>
 
-#include <glm/fwd.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
 
 namespace openblack
 {
@@ -28,26 +31,32 @@ namespace debug::gui
 class MeshViewer;
 }
 
+/// Skeletal animation clip. Each bone pose is stored as a quantized rotation, a translation and, only for clips which need
+/// it, a scale, in separate streams laid out keyframe after keyframe so that evaluating a skeleton reads two contiguous
+/// blocks. Shear in the source matrices is not preserved.
 class L3DAnim
 {
 public:
-	struct Frame
-	{
-		uint32_t time;
-		std::vector<glm::mat4> bones;
-	};
-
 	L3DAnim() noexcept = default;
 	virtual ~L3DAnim() noexcept = default;
 
 	void Load(const anm::ANMFile& anm) noexcept;
 	bool LoadFromFilesystem(const std::filesystem::path& path) noexcept;
 	bool LoadFromFile(const std::filesystem::path& path) noexcept;
-	bool LoadFromBuffer(const std::vector<uint8_t>& data) noexcept;
+	bool LoadFromBuffer(std::span<const uint8_t> data) noexcept;
 
 	[[nodiscard]] const std::string& GetName() const noexcept { return _name; }
 	[[nodiscard]] uint32_t GetDuration() const noexcept { return _duration; }
-	[[nodiscard]] const std::vector<Frame>& GetFrames() const noexcept { return _frames; }
+	[[nodiscard]] size_t GetFrameCount() const noexcept { return _frameTimes.size(); }
+	[[nodiscard]] uint32_t GetFrameTime(size_t frame) const noexcept { return _frameTimes[frame]; }
+	[[nodiscard]] size_t GetBoneCount() const noexcept { return _boneCount; }
+	[[nodiscard]] size_t GetSizeInBytes() const noexcept;
+	/// Write the pose of keyframe \p frame to the first bones of \p bones, returns the number of bones written
+	size_t GetFrameBones(size_t frame, std::span<glm::mat4> bones) const noexcept;
+	/// Write the pose at \p time in milliseconds to the first bones of \p bones without allocating, returns the number of
+	/// bones written. The time wraps around the duration and the pose is blended between the surrounding keyframes.
+	size_t EvaluateBones(uint32_t time, std::span<glm::mat4> bones) const noexcept;
+	/// Same as \ref EvaluateBones into a new list of \ref GetBoneCount matrices
 	[[nodiscard]] std::vector<glm::mat4> GetBoneMatrices(uint32_t time) const noexcept;
 
 private:
@@ -64,7 +73,15 @@ class L3DAnim
 	uint32_t _unknown_0x48; // TODO(#471): Always 0 in Body Block
 	uint32_t _unknown_0x50; // TODO(#471): Seems to be a uint16_t padded
 
-	std::vector<Frame> _frames;
+	/// Sorted time of each keyframe in milliseconds
+	std::vector<uint32_t> _frameTimes;
+	size_t _boneCount {0};
+	/// Unit quaternions as x, y, z, w quantized to 16 bits, \ref _boneCount per keyframe
+	std::vector<glm::i16vec4> _rotations;
+	/// \ref _boneCount per keyframe
+	std::vector<glm::vec3> _translations;
+	/// \ref _boneCount per keyframe, empty when no bone of the clip is scaled or mirrored
+	std::vector<glm::vec3> _scales;
 
 	friend debug::gui::MeshViewer; // TODO(#471): Remove me once the unknowns are known and replace with getters
 };
@@ -9,7 +9,11 @@
 
 #include "L3DMesh.h"
 
+#include <algorithm>
+#include <bit>
+#include <exception>
 #include <filesystem>
+#include <map>
 #include <stdexcept>
 
 #include <BulletCollision/CollisionShapes/btConvexHullShape.h>
@@ -24,103 +28,68 @@
 #include "Graphics/Texture2D.h"
 #include "Graphics/VertexBuffer.h"
 #include "Locator.h"
+#include "Resources/AssetCache.h"
 
 using namespace openblack;
 using namespace openblack::graphics;
 
-L3DMesh::L3DMesh(std::string debugName) noexcept
-    : _flags(static_cast<l3d::L3DMeshFlags>(0))
-    , _debugName(std::move(debugName))
+namespace
 {
-}
-
-L3DMesh::~L3DMesh() noexcept = default;
-
-bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
+struct FootprintVertex
 {
-	bool result = true;
+	glm::vec2 pos;
+	glm::vec2 texCoord;
+};
 
-	_flags = static_cast<l3d::L3DMeshFlags>(l3d.GetHeader().flags);
-	_nameData = l3d.GetNameData();
-	for (const auto& skin : l3d.GetSkins())
-	{
-		_skins[skin.id] = std::make_unique<Texture2D>(_debugName.c_str());
-		_skins[skin.id]->Create(l3d::L3DTexture::k_Width, l3d::L3DTexture::k_Height, 1, Format::BGRA4, Wrapping::Repeat,
-		                        Filter::Linear, skin.texels.data(),
-		                        static_cast<uint32_t>(skin.texels.size() * sizeof(skin.texels[0])));
-	}
-
-	if (HasDoorPosition() && !l3d.GetExtraPoints().empty())
-	{
-		_doorPos = glm::vec3(l3d.GetExtraPoints()[0].x, l3d.GetExtraPoints()[0].y, l3d.GetExtraPoints()[0].z);
-	}
+bool HasFootprint(const l3d::L3DFile& l3d)
+{
+	const auto flags = static_cast<l3d::L3DMeshFlags>(l3d.GetHeader().flags);
+	return static_cast<bool>(flags & l3d::L3DMeshFlags::ContainsLandscapeFeature) && l3d.GetFootprint().has_value();
+}
 
-	if (ContainsLandscapeFeature() && l3d.GetFootprint().has_value())
+std::vector<FootprintVertex> GetFootprintVertices(const l3d::L3DFootprint& footprint, const l3d::L3DFootprintEntry& entry)
+{
+	std::vector<FootprintVertex> vertices;
+	vertices.reserve(entry.triangles.size() * 3);
+	for (const auto& t : entry.triangles)
 	{
-		struct FootprintVertex
-		{
-			glm::vec2 pos;
-			glm::vec2 texCoord;
-		};
-		VertexDecl decl;
-		decl.reserve(1);
-		decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
-		decl.emplace_back(VertexAttrib::Attribute::TexCoord0, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
-
-		const auto& footprint = *l3d.GetFootprint();
-
-		// TODO (#749) use use std::views::enumerate
-		for (uint32_t i = 1; const auto& entry : footprint.entries)
+		for (uint8_t k = 0; k < 3; ++k)
 		{
-			auto texture = std::make_unique<Texture2D>("footprints/texture/" + _debugName + "/" + std::to_string(i));
-			++i;
-			texture->Create(static_cast<uint16_t>(footprint.header.width), static_cast<uint16_t>(footprint.header.height), 1,
-			                graphics::Format::BGRA4, Wrapping::ClampEdge, Filter::Linear, entry.pixels.data(),
-			                static_cast<uint32_t>(entry.pixels.size() * sizeof(entry.pixels[0])));
-
-			const bgfx::Memory* verticesMem =
-			    bgfx::alloc(static_cast<uint32_t>(sizeof(FootprintVertex) * entry.triangles.size() * 3));
-			auto* vertices = reinterpret_cast<FootprintVertex*>(verticesMem->data);
-			// TODO (#749) Maybe use std::views::enumerate
-			for (uint8_t j = 0; const auto& t : entry.triangles)
-			{
-				for (uint8_t k = 0; k < 3; ++k)
-				{
-					// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): access is bound to size
-					auto& vertex = vertices[j];
-					++j;
-
-					// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): access is bound to size
-					const auto& world = t.world[k];
-					// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): access is bound to size
-					const auto& uv = t.texture[k];
-
-					vertex.pos.x = world.x;
-					vertex.pos.y = world.y;
-					vertex.texCoord.x = uv.x / footprint.header.width;
-					vertex.texCoord.y = uv.y / footprint.header.height;
-				}
-			}
-
-			auto* vertexBuffer = new VertexBuffer("footprints/quad/" + _debugName + "/" + std::to_string(i), verticesMem, decl);
-			auto mesh = std::make_unique<Mesh>(vertexBuffer);
-			_footprints.emplace_back(Footprint {std::move(texture), std::move(mesh)});
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): access is bound to size
+			const auto& world = t.world[k];
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): access is bound to size
+			const auto& uv = t.texture[k];
+
+			auto& vertex = vertices.emplace_back();
+			vertex.pos.x = world.x;
+			vertex.pos.y = world.y;
+			vertex.texCoord.x = uv.x / footprint.header.width;
+			vertex.texCoord.y = uv.y / footprint.header.height;
 		}
 	}
+	return vertices;
+}
 
-	if (ContainsExtraMetrics() && !l3d.GetExtraMetrics().empty())
+std::vector<glm::mat4> GetExtraMetrics(const l3d::L3DFile& l3d)
+{
+	std::vector<glm::mat4> extraMetrics;
+	if (static_cast<bool>(static_cast<l3d::L3DMeshFlags>(l3d.GetHeader().flags) & l3d::L3DMeshFlags::ContainsExtraMetrics))
 	{
-		const auto& extraMetrics = l3d.GetExtraMetrics();
-		_extraMetrics.reserve(extraMetrics.size());
-		for (const auto& e : extraMetrics)
+		extraMetrics.reserve(l3d.GetExtraMetrics().size());
+		for (const auto& e : l3d.GetExtraMetrics())
 		{
-			_extraMetrics.emplace_back(static_cast<glm::mat4>(glm::make_mat4x3(e.data())));
+			extraMetrics.emplace_back(static_cast<glm::mat4>(glm::make_mat4x3(e.data())));
 		}
 	}
+	return extraMetrics;
+}
 
+void GetBones(const l3d::L3DFile& l3d, std::vector<uint32_t>& bonesParents, std::vector<glm::mat4>& bonesDefaultMatrices)
+{
 	std::map<uint32_t, glm::mat4> matrices;
 	const auto& bones = l3d.GetBones();
-	_bonesParents.resize(bones.size());
+	bonesParents.resize(bones.size());
+	bonesDefaultMatrices.reserve(bones.size());
 	for (uint32_t i = 0; i < bones.size(); ++i)
 	{
 		const auto& bone = bones[i];
@@ -130,49 +99,254 @@ bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
 		                        bone.orientation[6], bone.orientation[7], bone.orientation[8], 0.0f,
 		                        bone.position.x, bone.position.y, bone.position.z, 1.0f);
 		// clang-format on
-		_bonesParents[i] = bone.parent;
+		bonesParents[i] = bone.parent;
 		if (bone.parent != std::numeric_limits<uint32_t>::max())
 		{
 			matrix = matrices[bone.parent] * matrix;
 		}
-		_bonesDefaultMatrices.emplace_back(matrix);
+		bonesDefaultMatrices.emplace_back(matrix);
 		matrices.emplace(i, matrix);
 	}
+}
+} // namespace
+
+L3DMesh::L3DMesh(std::string debugName) noexcept
+    : _flags(static_cast<l3d::L3DMeshFlags>(0))
+    , _debugName(std::move(debugName))
+{
+}
+
+L3DMesh::~L3DMesh() noexcept = default;
+
+std::vector<uint8_t> L3DMesh::Bake(const l3d::L3DFile& l3d)
+{
+	resources::BlobWriter writer;
+
+	const auto flags = static_cast<l3d::L3DMeshFlags>(l3d.GetHeader().flags);
+	writer.Write(flags);
+	writer.WriteArray(l3d.GetNameData());
+	writer.Write(static_cast<uint32_t>(l3d.GetSkins().size()));
+	for (const auto& skin : l3d.GetSkins())
+	{
+		writer.Write(skin.id);
+		writer.WriteArray(skin.texels);
+	}
+
+	const bool hasDoorPosition =
+	    static_cast<bool>(flags & l3d::L3DMeshFlags::HasDoorPosition) && !l3d.GetExtraPoints().empty();
+	writer.Write(hasDoorPosition);
+	if (hasDoorPosition)
+	{
+		writer.Write(glm::vec3(l3d.GetExtraPoints()[0].x, l3d.GetExtraPoints()[0].y, l3d.GetExtraPoints()[0].z));
+	}
 
-	auto submeshCount = l3d.GetSubmeshHeaders().size();
+	if (HasFootprint(l3d))
+	{
+		const auto& footprint = *l3d.GetFootprint();
+		writer.Write(static_cast<uint32_t>(footprint.entries.size()));
+		for (const auto& entry : footprint.entries)
+		{
+			writer.Write(static_cast<uint16_t>(footprint.header.width));
+			writer.Write(static_cast<uint16_t>(footprint.header.height));
+			writer.WriteArray(entry.pixels);
+			writer.WriteArray(GetFootprintVertices(footprint, entry));
+		}
+	}
+	else
+	{
+		writer.Write(static_cast<uint32_t>(0));
+	}
+
+	writer.WriteArray(GetExtraMetrics(l3d));
+
+	std::vector<uint32_t> bonesParents;
+	std::vector<glm::mat4> bonesDefaultMatrices;
+	GetBones(l3d, bonesParents, bonesDefaultMatrices);
+	writer.WriteArray(bonesParents);
+	writer.WriteArray(bonesDefaultMatrices);
+
+	const auto submeshCount = static_cast<uint32_t>(l3d.GetSubmeshHeaders().size());
+	writer.Write(submeshCount);
 	for (uint32_t i = 0; i < submeshCount; ++i)
 	{
-		auto subMesh = std::make_unique<L3DSubMesh>(*this);
-		if (!subMesh->Load(l3d, i))
+		L3DSubMesh::Bake(l3d, i, writer);
+		if (l3d.GetSubmeshHeaders()[i].flags.isPhysics)
 		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open L3DSubMesh");
-			result = false;
-			continue;
+			writer.WriteArray(l3d.GetVertexSpan(i));
 		}
-		if (subMesh->GetFlags().isPhysics)
+	}
+
+	return writer.Release();
+}
+
+bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
+{
+	bool result = true;
+
+	_flags = static_cast<l3d::L3DMeshFlags>(l3d.GetHeader().flags);
+	_nameData = l3d.GetNameData();
+	for (const auto& skin : l3d.GetSkins())
+	{
+		CreateSkin(skin.id, skin.texels);
+	}
+
+	if (HasDoorPosition() && !l3d.GetExtraPoints().empty())
+	{
+		_doorPos = glm::vec3(l3d.GetExtraPoints()[0].x, l3d.GetExtraPoints()[0].y, l3d.GetExtraPoints()[0].z);
+	}
+
+	if (HasFootprint(l3d))
+	{
+		const auto& footprint = *l3d.GetFootprint();
+		for (const auto& entry : footprint.entries)
 		{
-			const auto& verticesSpan = l3d.GetVertexSpan(i);
-			auto* physicsMesh =
-			    new btConvexHullShape(reinterpret_cast<const btScalar*>(verticesSpan.data()),
-			                          static_cast<int>(verticesSpan.size()), static_cast<int>(sizeof(verticesSpan[0])));
-			physicsMesh->optimizeConvexHull();
-			_physicsMesh.reset(physicsMesh);
-			// FIXME(bwrsandman): Some meshes have multiple physics meshes
+			const auto vertices = GetFootprintVertices(footprint, entry);
+			const auto* verticesMem = bgfx::copy(vertices.data(), static_cast<uint32_t>(vertices.size() * sizeof(vertices[0])));
+			CreateFootprint(static_cast<uint16_t>(footprint.header.width), static_cast<uint16_t>(footprint.header.height),
+			                entry.pixels, verticesMem);
 		}
-		const auto& bb = subMesh->GetBoundingBox();
-		_boundingBox.minima = glm::min(_boundingBox.minima, bb.minima);
-		_boundingBox.maxima = glm::max(_boundingBox.maxima, bb.maxima);
+	}
+
+	_extraMetrics = GetExtraMetrics(l3d);
+	GetBones(l3d, _bonesParents, _bonesDefaultMatrices);
 
-		_subMeshes.emplace_back(std::move(subMesh));
+	uint32_t lodMask = 0;
+	for (uint32_t i = 0; i < l3d.GetSubmeshHeaders().size(); ++i)
+	{
+		auto subMesh = std::make_unique<L3DSubMesh>(*this);
+		const bool loaded = subMesh->Load(l3d, i);
+		result = AddSubMesh(std::move(subMesh), loaded, l3d.GetVertexSpan(i), lodMask) && result;
 	}
 	// TODO(bwrsandman): if no physics mesh was found, make physics mesh the bounding box
 
-	// TODO(bwrsandman): store vertex and index buffers at mesh level
-	bgfx::frame();
+	// Only count levels which can be drawn without falling through gaps in the mask
+	_lodCount = std::max(static_cast<uint8_t>(std::countr_one(lodMask)), static_cast<uint8_t>(1));
 
 	return result;
 }
 
+bool L3DMesh::LoadBaked(std::span<const uint8_t> data) noexcept
+{
+	bool result = true;
+
+	try
+	{
+		resources::BlobReader reader(data);
+
+		_flags = reader.Read<l3d::L3DMeshFlags>();
+		_nameData = reader.ReadString();
+		const auto skinCount = reader.Read<uint32_t>();
+		for (uint32_t i = 0; i < skinCount; ++i)
+		{
+			const auto id = reader.Read<SkinId>();
+			CreateSkin(id, reader.ReadArray<l3d::L3DTexture::RGBA4>());
+		}
+
+		if (reader.Read<bool>())
+		{
+			_doorPos = reader.Read<glm::vec3>();
+		}
+
+		const auto footprintCount = reader.Read<uint32_t>();
+		for (uint32_t i = 0; i < footprintCount; ++i)
+		{
+			const auto width = reader.Read<uint16_t>();
+			const auto height = reader.Read<uint16_t>();
+			const auto pixels = reader.ReadArray<uint16_t>();
+			const auto vertices = reader.ReadArray<FootprintVertex>();
+			CreateFootprint(width, height, pixels,
+			                bgfx::copy(vertices.data(), static_cast<uint32_t>(vertices.size_bytes())));
+		}
+
+		const auto extraMetrics = reader.ReadArray<glm::mat4>();
+		_extraMetrics.assign(extraMetrics.begin(), extraMetrics.end());
+		const auto bonesParents = reader.ReadArray<uint32_t>();
+		_bonesParents.assign(bonesParents.begin(), bonesParents.end());
+		const auto bonesDefaultMatrices = reader.ReadArray<glm::mat4>();
+		_bonesDefaultMatrices.assign(bonesDefaultMatrices.begin(), bonesDefaultMatrices.end());
+
+		const auto submeshCount = reader.Read<uint32_t>();
+		uint32_t lodMask = 0;
+		for (uint32_t i = 0; i < submeshCount; ++i)
+		{
+			auto subMesh = std::make_unique<L3DSubMesh>(*this);
+			const bool loaded = subMesh->Load(reader);
+			std::span<const l3d::L3DVertex> physicsVertices;
+			if (subMesh->GetFlags().isPhysics)
+			{
+				physicsVertices = reader.ReadArray<l3d::L3DVertex>();
+			}
+			result = AddSubMesh(std::move(subMesh), loaded, physicsVertices, lodMask) && result;
+		}
+		// TODO(bwrsandman): if no physics mesh was found, make physics mesh the bounding box
+
+		// Only count levels which can be drawn without falling through gaps in the mask
+		_lodCount = std::max(static_cast<uint8_t>(std::countr_one(lodMask)), static_cast<uint8_t>(1));
+	}
+	catch (const std::exception& err)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to load baked l3d mesh {}: {}", _debugName, err.what());
+		return false;
+	}
+
+	return result;
+}
+
+void L3DMesh::CreateSkin(SkinId id, std::span<const l3d::L3DTexture::RGBA4> texels)
+{
+	_skins[id] = std::make_unique<Texture2D>(_debugName.c_str());
+	_skins[id]->Create(l3d::L3DTexture::k_Width, l3d::L3DTexture::k_Height, 1, Format::BGRA4, Wrapping::Repeat, Filter::Linear,
+	                   texels.data(), static_cast<uint32_t>(texels.size_bytes()));
+}
+
+void L3DMesh::CreateFootprint(uint16_t width, uint16_t height, std::span<const uint16_t> pixels,
+                              const bgfx::Memory* vertices)
+{
+	VertexDecl decl;
+	decl.reserve(2);
+	decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
+	decl.emplace_back(VertexAttrib::Attribute::TexCoord0, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
+
+	const auto i = _footprints.size() + 1;
+	auto texture = std::make_unique<Texture2D>("footprints/texture/" + _debugName + "/" + std::to_string(i));
+	texture->Create(width, height, 1, graphics::Format::BGRA4, Wrapping::ClampEdge, Filter::Linear, pixels.data(),
+	                static_cast<uint32_t>(pixels.size_bytes()));
+
+	auto* vertexBuffer = new VertexBuffer("footprints/quad/" + _debugName + "/" + std::to_string(i + 1), vertices, decl);
+	auto mesh = std::make_unique<Mesh>(vertexBuffer);
+	_footprints.emplace_back(Footprint {std::move(texture), std::move(mesh)});
+}
+
+bool L3DMesh::AddSubMesh(std::unique_ptr<L3DSubMesh> subMesh, bool loaded, std::span<const l3d::L3DVertex> physicsVertices,
+                         uint32_t& lodMask)
+{
+	if (!loaded)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open L3DSubMesh");
+		return false;
+	}
+
+	if (subMesh->GetFlags().isPhysics)
+	{
+		auto* physicsMesh =
+		    new btConvexHullShape(reinterpret_cast<const btScalar*>(physicsVertices.data()),
+		                          static_cast<int>(physicsVertices.size()), static_cast<int>(sizeof(physicsVertices[0])));
+		physicsMesh->optimizeConvexHull();
+		_physicsMesh.reset(physicsMesh);
+		// FIXME(bwrsandman): Some meshes have multiple physics meshes
+	}
+	else
+	{
+		lodMask |= subMesh->GetFlags().lodMask;
+	}
+	const auto& bb = subMesh->GetBoundingBox();
+	_boundingBox.minima = glm::min(_boundingBox.minima, bb.minima);
+	_boundingBox.maxima = glm::max(_boundingBox.maxima, bb.maxima);
+
+	_subMeshes.emplace_back(std::move(subMesh));
+	return true;
+}
+
 bool L3DMesh::LoadFromFilesystem(const std::filesystem::path& path) noexcept
 {
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading L3DMesh from file: {}", path.generic_string());
@@ -180,7 +354,7 @@ bool L3DMesh::LoadFromFilesystem(const std::filesystem::path& path) noexcept
 
 	try
 	{
-		l3d.ReadFile(*Locator::filesystem::value().GetData(path));
+		l3d.Open(Locator::filesystem::value().ReadAll(path));
 	}
 	catch (std::runtime_error& err)
 	{
@@ -215,7 +389,7 @@ bool L3DMesh::LoadFromFile(const std::filesystem::path& path) noexcept
 	return true;
 }
 
-bool L3DMesh::LoadFromBuffer(const std::vector<uint8_t>& data) noexcept
+bool L3DMesh::LoadFromBuffer(std::span<const uint8_t> data) noexcept
 {
 	l3d::L3DFile l3d;
 
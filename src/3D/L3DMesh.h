@@ -12,6 +12,7 @@
 #include <filesystem>
 #include <limits>
 #include <optional>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -88,13 +89,23 @@ class L3DMesh
 		std::unique_ptr<graphics::Texture2D> texture;
 		std::unique_ptr<graphics::Mesh> mesh;
 	};
+	/// Number of bits of \ref l3d::L3DSubmeshHeader::Flags::lodMask
+	static constexpr uint8_t k_MaxLods = 3;
+
 	explicit L3DMesh(std::string debugName = "") noexcept;
 	virtual ~L3DMesh() noexcept;
 
+	/// Convert l3d to the layout of the GPU resources without creating them so it can run on any thread.
+	/// The result can be stored in the \ref resources::AssetCache and given to \ref LoadBaked.
+	[[nodiscard]] static std::vector<uint8_t> Bake(const l3d::L3DFile& l3d);
+
+	/// Create the GPU resources straight from l3d
 	bool Load(const l3d::L3DFile& l3d) noexcept;
+	/// Create the GPU resources from the result of \ref Bake
+	bool LoadBaked(std::span<const uint8_t> data) noexcept;
 	bool LoadFromFilesystem(const std::filesystem::path& path) noexcept;
 	bool LoadFromFile(const std::filesystem::path& path) noexcept;
-	bool LoadFromBuffer(const std::vector<uint8_t>& data) noexcept;
+	bool LoadFromBuffer(std::span<const uint8_t> data) noexcept;
 
 	[[nodiscard]] uint8_t GetNumSubMeshes() const { return static_cast<uint8_t>(_subMeshes.size()); }
 	[[nodiscard]] const std::vector<std::unique_ptr<L3DSubMesh>>& GetSubMeshes() const { return _subMeshes; }
@@ -109,8 +120,17 @@ class L3DMesh
 	[[nodiscard]] const btConvexShape& GetPhysicsMesh() const { return *_physicsMesh; }
 	[[nodiscard]] float GetMass() const { return _physicsMass; }
 	[[nodiscard]] AxisAlignedBoundingBox GetBoundingBox() const { return _boundingBox; }
+	/// Number of levels of detail used by the drawable submeshes, level 0 being the most detailed
+	[[nodiscard]] uint8_t GetLodCount() const { return _lodCount; }
 
 private:
+	void CreateSkin(SkinId id, std::span<const l3d::L3DTexture::RGBA4> texels);
+	void CreateFootprint(uint16_t width, uint16_t height, std::span<const uint16_t> pixels,
+	                     const bgfx::Memory* vertices);
+	/// Keeps a submesh which could be loaded, the physics vertices are only used if it is the physics mesh
+	bool AddSubMesh(std::unique_ptr<L3DSubMesh> subMesh, bool loaded, std::span<const l3d::L3DVertex> physicsVertices,
+	                uint32_t& lodMask);
+
 	l3d::L3DMeshFlags _flags;
 	std::string _debugName;
 
@@ -124,6 +144,7 @@ class L3DMesh
 	/// Bounding box if no physics mesh was found
 	std::unique_ptr<btConvexShape> _physicsMesh;
 	float _physicsMass {1.0f}; // TODO(bwrsandman): Find somewhere in file a value
+	uint8_t _lodCount {1};
 	AxisAlignedBoundingBox _boundingBox {
 	    {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()},
 	    {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()},
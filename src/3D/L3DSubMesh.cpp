@@ -9,6 +9,10 @@
 
 #include "L3DSubMesh.h"
 
+#include <span>
+#include <string>
+#include <utility>
+
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/component_wise.hpp>
 #include <glm/gtx/vec_swizzle.hpp>
@@ -18,6 +22,7 @@
 #include "Graphics/ShaderProgram.h"
 #include "Graphics/VertexBuffer.h"
 #include "L3DMesh.h"
+#include "Resources/AssetCache.h"
 
 using namespace openblack::graphics;
 
@@ -39,30 +44,52 @@ L3DSubMesh::L3DSubMesh(L3DMesh& mesh) noexcept
 
 L3DSubMesh::~L3DSubMesh() noexcept = default;
 
-bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
+namespace
+{
+std::pair<uint32_t, uint32_t> CountVerticesAndIndices(std::span<const l3d::L3DPrimitiveHeader> primitiveSpan)
 {
-	const auto& header = l3d.GetSubmeshHeaders()[meshIndex];
-	const auto primitiveSpan = l3d.GetPrimitiveSpan(meshIndex);
-	const auto& verticesSpan = l3d.GetVertexSpan(meshIndex);
-	const auto& indexSpan = l3d.GetIndexSpan(meshIndex);
-	const auto& vertexGroupSpans = l3d.GetVertexGroupSpan(meshIndex);
-	const auto& boneSpans = l3d.GetBoneSpan(meshIndex);
-
-	_flags = header.flags;
-
-	// Count vertices and indices
 	uint32_t nVertices = 0;
 	uint32_t nIndices = 0;
-	for (auto& primitive : primitiveSpan)
+	for (const auto& primitive : primitiveSpan)
 	{
 		nVertices += primitive.numVertices;
 		nIndices += primitive.numTriangles * 3;
 	}
+	return {nVertices, nIndices};
+}
+
+std::unique_ptr<Mesh> CreateMesh(const std::string& debugName, const bgfx::Memory* vertices, const bgfx::Memory* indices)
+{
+	VertexDecl decl;
+	decl.reserve(4);
+	decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(3), VertexAttrib::Type::Float);
+	decl.emplace_back(VertexAttrib::Attribute::TexCoord0, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
+	decl.emplace_back(VertexAttrib::Attribute::Normal, static_cast<uint8_t>(3), VertexAttrib::Type::Float);
+	decl.emplace_back(VertexAttrib::Attribute::Indices, static_cast<uint8_t>(2), VertexAttrib::Type::Int16);
+
+	// build our buffers
+	auto* vertexBuffer = new VertexBuffer(debugName, vertices, decl);
+	auto* indexBuffer = new IndexBuffer(debugName, indices, IndexBuffer::Type::Uint16);
+	return std::make_unique<graphics::Mesh>(vertexBuffer, indexBuffer);
+}
+} // namespace
+
+void L3DSubMesh::Convert(const l3d::L3DFile& l3d, uint32_t meshIndex, std::span<EnhancedL3DVertex> vertices,
+                         std::span<uint16_t> indices, std::vector<Primitive>& primitives,
+                         AxisAlignedBoundingBox& boundingBox)
+{
+	const auto& header = l3d.GetSubmeshHeaders()[meshIndex];
+	const auto primitiveSpan = l3d.GetPrimitiveSpan(meshIndex);
+	const auto& verticesSpan = l3d.GetVertexSpan(meshIndex);
+	const auto& indexSpan = l3d.GetIndexSpan(meshIndex);
+	const auto& vertexGroupSpans = l3d.GetVertexGroupSpan(meshIndex);
+	const auto& boneSpans = l3d.GetBoneSpan(meshIndex);
+	const auto nVertices = static_cast<uint32_t>(vertices.size());
 
 	// Construct bounding box
-	_boundingBox.maxima = glm::vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
-	_boundingBox.minima = glm::vec3(FLT_MAX, FLT_MAX, FLT_MAX);
-	if (_flags.hasBones)
+	boundingBox.maxima = glm::vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+	boundingBox.minima = glm::vec3(FLT_MAX, FLT_MAX, FLT_MAX);
+	if (header.flags.hasBones)
 	{
 		for (auto& primitive : primitiveSpan)
 		{
@@ -84,8 +111,8 @@ bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
 				{
 					const auto& vertex = verticesSpan[vertexOffset + j];
 					const auto position = glm::xyz(matrix * glm::vec4(glm::make_vec3(&vertex.position.x), 1.0f));
-					_boundingBox.maxima = glm::max(_boundingBox.maxima, position);
-					_boundingBox.minima = glm::min(_boundingBox.minima, position);
+					boundingBox.maxima = glm::max(boundingBox.maxima, position);
+					boundingBox.minima = glm::min(boundingBox.minima, position);
 				}
 				vertexOffset += vertexGroupSpans[i].vertexCount;
 			}
@@ -96,37 +123,24 @@ bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
 		for (uint32_t i = 0; i < nVertices; i++)
 		{
 			const auto position = glm::make_vec3(&verticesSpan[i].position.x);
-			_boundingBox.maxima = glm::max(_boundingBox.maxima, position);
-			_boundingBox.minima = glm::min(_boundingBox.minima, position);
+			boundingBox.maxima = glm::max(boundingBox.maxima, position);
+			boundingBox.minima = glm::min(boundingBox.minima, position);
 		}
 	}
 
-	if (nVertices == 0)
-	{
-		return false;
-	}
-
 	// Get vertices
-	const bgfx::Memory* verticesMem = bgfx::alloc(sizeof(EnhancedL3DVertex) * nVertices);
-	auto* verticesMemAccess = reinterpret_cast<EnhancedL3DVertex*>(verticesMem->data);
 	for (uint32_t i = 0; i < nVertices; ++i)
 	{
-		verticesMemAccess[i].pos = glm::make_vec3(&verticesSpan[i].position.x);
-		verticesMemAccess[i].uv = glm::make_vec2(&verticesSpan[i].texCoord.x);
+		vertices[i].pos = glm::make_vec3(&verticesSpan[i].position.x);
+		vertices[i].uv = glm::make_vec2(&verticesSpan[i].texCoord.x);
 		// TODO(bwrsandman): build normals from mesh
-		verticesMemAccess[i].norm = glm::make_vec3(&verticesSpan[i].normal.x);
-		verticesMemAccess[i].index.x = -1;
-		verticesMemAccess[i].index.y = -1;
-	}
-
-	if (nIndices == 0)
-	{
-		return false;
+		vertices[i].norm = glm::make_vec3(&verticesSpan[i].normal.x);
+		vertices[i].index.x = -1;
+		vertices[i].index.y = -1;
 	}
 
 	// Get Indices
-	const bgfx::Memory* indicesMem = bgfx::alloc(sizeof(uint16_t) * nIndices);
-	auto* indices = reinterpret_cast<uint16_t*>(indicesMem->data);
+	primitives.reserve(primitiveSpan.size());
 
 	// Fill bone index
 	uint32_t vertexIndex = 0;
@@ -134,8 +148,8 @@ bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
 	{
 		for (uint32_t i = 0; i < vertexGroupSpan.vertexCount; ++i)
 		{
-			verticesMemAccess[vertexIndex].index[0] = vertexGroupSpan.boneIndex;
-			verticesMemAccess[vertexIndex].index[1] = -1;
+			vertices[vertexIndex].index[0] = vertexGroupSpan.boneIndex;
+			vertices[vertexIndex].index[1] = -1;
 			vertexIndex++;
 		}
 	}
@@ -186,7 +200,7 @@ bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
 		const auto& lutEntry = materialTypeLut.at(static_cast<uint32_t>(primitive.material.type));
 
 		// TODO(bwrsandman): Interpret cull mode, color byte ordering and render mode, then store in primitive
-		_primitives.emplace_back(Primitive {
+		primitives.emplace_back(Primitive {
 		    primitive.material.skinID,
 		    startIndex,
 		    primitive.numTriangles * 3,
@@ -202,23 +216,73 @@ bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
 		startIndex += static_cast<uint16_t>(primitive.numTriangles * 3);
 	}
 
-	VertexDecl decl;
-	decl.reserve(4);
-	decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(3), VertexAttrib::Type::Float);
-	decl.emplace_back(VertexAttrib::Attribute::TexCoord0, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
-	decl.emplace_back(VertexAttrib::Attribute::Normal, static_cast<uint8_t>(3), VertexAttrib::Type::Float);
-	decl.emplace_back(VertexAttrib::Attribute::Indices, static_cast<uint8_t>(2), VertexAttrib::Type::Int16);
+}
 
-	// build our buffers
-	auto* vertexBuffer = new VertexBuffer(_l3dMesh.GetDebugName(), verticesMem, decl);
-	auto* indexBuffer = new IndexBuffer(_l3dMesh.GetDebugName(), indicesMem, IndexBuffer::Type::Uint16);
-	_mesh = std::make_unique<graphics::Mesh>(vertexBuffer, indexBuffer);
+bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
+{
+	_flags = l3d.GetSubmeshHeaders()[meshIndex].flags;
+	const auto [nVertices, nIndices] = CountVerticesAndIndices(l3d.GetPrimitiveSpan(meshIndex));
+	if (nVertices == 0 || nIndices == 0)
+	{
+		return false;
+	}
+
+	// Converted straight into the memory handed to bgfx
+	const bgfx::Memory* verticesMem = bgfx::alloc(sizeof(EnhancedL3DVertex) * nVertices);
+	const bgfx::Memory* indicesMem = bgfx::alloc(sizeof(uint16_t) * nIndices);
+	Convert(l3d, meshIndex, {reinterpret_cast<EnhancedL3DVertex*>(verticesMem->data), nVertices},
+	        {reinterpret_cast<uint16_t*>(indicesMem->data), nIndices}, _primitives, _boundingBox);
+	_mesh = CreateMesh(_l3dMesh.GetDebugName(), verticesMem, indicesMem);
 
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "{} submesh {} with {} verts and {} indices", _l3dMesh.GetDebugName(), meshIndex,
 	                    nVertices, nIndices);
 	return true;
 }
 
+void L3DSubMesh::Bake(const l3d::L3DFile& l3d, uint32_t meshIndex, resources::BlobWriter& writer)
+{
+	const auto [nVertices, nIndices] = CountVerticesAndIndices(l3d.GetPrimitiveSpan(meshIndex));
+	writer.Write(l3d.GetSubmeshHeaders()[meshIndex].flags);
+	writer.Write(nVertices != 0 && nIndices != 0);
+	if (nVertices == 0 || nIndices == 0)
+	{
+		return;
+	}
+
+	std::vector<EnhancedL3DVertex> vertices(nVertices);
+	std::vector<uint16_t> indices(nIndices);
+	std::vector<Primitive> primitives;
+	AxisAlignedBoundingBox boundingBox;
+	Convert(l3d, meshIndex, vertices, indices, primitives, boundingBox);
+
+	writer.Write(boundingBox);
+	writer.WriteArray(primitives);
+	writer.WriteArray(vertices);
+	writer.WriteArray(indices);
+}
+
+bool L3DSubMesh::Load(resources::BlobReader& reader)
+{
+	_flags = reader.Read<l3d::L3DSubmeshHeader::Flags>();
+	if (!reader.Read<bool>())
+	{
+		return false;
+	}
+	_boundingBox = reader.Read<AxisAlignedBoundingBox>();
+	const auto primitives = reader.ReadArray<Primitive>();
+	_primitives.assign(primitives.begin(), primitives.end());
+	const auto vertices = reader.ReadArray<EnhancedL3DVertex>();
+	const auto indices = reader.ReadArray<uint16_t>();
+
+	// Copied since the baked data may be a mapped file which goes away before bgfx uploads it
+	_mesh = CreateMesh(_l3dMesh.GetDebugName(), bgfx::copy(vertices.data(), static_cast<uint32_t>(vertices.size_bytes())),
+	                   bgfx::copy(indices.data(), static_cast<uint32_t>(indices.size_bytes())));
+
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "{} submesh with {} verts and {} indices", _l3dMesh.GetDebugName(),
+	                    vertices.size(), indices.size());
+	return true;
+}
+
 Mesh& L3DSubMesh::GetMesh() const
 {
 	return *_mesh;
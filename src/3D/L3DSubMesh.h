@@ -12,6 +12,7 @@
 #include <cstdint>
 
 #include <memory>
+#include <span>
 #include <vector>
 
 #include <L3DFile.h>
@@ -21,6 +22,17 @@
 
 #include "../Graphics/RenderPass.h"
 
+namespace openblack
+{
+struct EnhancedL3DVertex;
+} // namespace openblack
+
+namespace openblack::resources
+{
+class BlobReader;
+class BlobWriter;
+} // namespace openblack::resources
+
 namespace openblack::graphics
 {
 class L3DMesh;
@@ -53,7 +65,12 @@ class L3DSubMesh
 	explicit L3DSubMesh(graphics::L3DMesh& mesh) noexcept;
 	~L3DSubMesh() noexcept;
 
+	/// Create the buffers of a submesh straight from l3d, false if it has no vertices or no indices
 	bool Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept;
+	/// Convert a submesh to the layout of its GPU buffers without creating them so it can run on any thread
+	static void Bake(const l3d::L3DFile& l3d, uint32_t meshIndex, resources::BlobWriter& writer);
+	/// Create the buffers of a submesh written by \ref Bake, false if it has no vertices or no indices
+	bool Load(resources::BlobReader& reader);
 
 	[[nodiscard]] openblack::l3d::L3DSubmeshHeader::Flags GetFlags() const { return _flags; }
 	[[nodiscard]] bool IsPhysics() const { return _flags.isPhysics; }
@@ -62,6 +79,10 @@ class L3DSubMesh
 	[[nodiscard]] const std::vector<Primitive>& GetPrimitives() const { return _primitives; }
 
 private:
+	/// Fill buffers of the vertex and index counts of the submesh
+	static void Convert(const l3d::L3DFile& l3d, uint32_t meshIndex, std::span<EnhancedL3DVertex> vertices,
+	                    std::span<uint16_t> indices, std::vector<Primitive>& primitives, AxisAlignedBoundingBox& boundingBox);
+
 	graphics::L3DMesh& _l3dMesh;
 
 	openblack::l3d::L3DSubmeshHeader::Flags _flags;
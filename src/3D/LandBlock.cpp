@@ -15,6 +15,7 @@
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <LNDFile.h>
+#include <glm/common.hpp>
 
 #include "Dynamics/LandBlockBulletMeshInterface.h"
 #include "Graphics/Mesh.h"
@@ -35,7 +36,7 @@ LandVertex::LandVertex(const glm::vec3& position, const glm::vec3& weight, const
 {
 }
 
-void LandBlock::BuildMesh(LandIslandInterface& island)
+void LandBlock::BuildMesh(std::span<const LandVertex> vertices)
 {
 	if (_mesh != nullptr)
 	{
@@ -58,7 +59,16 @@ void LandBlock::BuildMesh(LandIslandInterface& island)
 	// water alpha
 	decl.emplace_back(VertexAttrib::Attribute::Color3, static_cast<uint8_t>(1), VertexAttrib::Type::Float, true);
 
-	const auto* verts = BuildVertexList(island);
+	// Copied since the vertices may be a mapped file which goes away before bgfx uploads them
+	const auto* verts = bgfx::copy(vertices.data(), static_cast<uint32_t>(vertices.size_bytes()));
+
+	const auto mapPosition = glm::vec3(_block->mapX, 0.0f, _block->mapZ);
+	_boundingBox = {vertices[0].position + mapPosition, vertices[0].position + mapPosition};
+	for (uint32_t i = 1; i < vertices.size(); ++i)
+	{
+		_boundingBox.minima = glm::min(_boundingBox.minima, vertices[i].position + mapPosition);
+		_boundingBox.maxima = glm::max(_boundingBox.maxima, vertices[i].position + mapPosition);
+	}
 
 	auto* vertexBuffer = new VertexBuffer("LandBlock", verts, decl);
 	_mesh = std::make_unique<Mesh>(vertexBuffer);
@@ -76,11 +86,11 @@ void LandBlock::BuildMesh(LandIslandInterface& island)
 	_rigidBody->setUserIndex(-1);
 }
 
-const bgfx::Memory* LandBlock::BuildVertexList(LandIslandInterface& island)
+std::vector<LandVertex> LandBlock::BuildVertexList(LandIslandInterface& island) const
 {
 	// reserve 16*16 quads of 2 tris with 3 verts = 1536
-	const bgfx::Memory* verticesMem = bgfx::alloc(sizeof(LandVertex) * 1536);
-	auto* vertices = reinterpret_cast<LandVertex*>(verticesMem->data);
+	std::vector<LandVertex> vertices;
+	vertices.reserve(1536);
 
 	auto countries = island.GetCountries();
 
@@ -92,7 +102,6 @@ const bgfx::Memory* LandBlock::BuildVertexList(LandIslandInterface& island)
 
 	const auto blockOffset = static_cast<glm::u16vec2>(GetBlockPosition() * 16);
 
-	uint16_t index = 0;
 	for (int x = 0; x < 16; x++)
 	{
 		for (int z = 0; z < 16; z++)
@@ -174,18 +183,18 @@ const bgfx::Memory* LandBlock::BuildVertexList(LandIslandInterface& island)
 				return {pos[static_cast<size_t>(corner)], weight, mat, blend, cell.luminosity, getAlpha(cell.properties)};
 			};
 
-			auto makeTriangle = [&makeVert, &vertices, &index](const std::array<Corner, 3>& corners, bool forward) {
+			auto makeTriangle = [&makeVert, &vertices](const std::array<Corner, 3>& corners, bool forward) {
 				if (forward)
 				{
-					vertices[index++] = makeVert(corners[0], glm::vec3(1, 0, 0), corners);
-					vertices[index++] = makeVert(corners[1], glm::vec3(0, 1, 0), corners);
-					vertices[index++] = makeVert(corners[2], glm::vec3(0, 0, 1), corners);
+					vertices.push_back(makeVert(corners[0], glm::vec3(1, 0, 0), corners));
+					vertices.push_back(makeVert(corners[1], glm::vec3(0, 1, 0), corners));
+					vertices.push_back(makeVert(corners[2], glm::vec3(0, 0, 1), corners));
 				}
 				else
 				{
-					vertices[index++] = makeVert(corners[2], glm::vec3(0, 0, 1), corners);
-					vertices[index++] = makeVert(corners[1], glm::vec3(0, 1, 0), corners);
-					vertices[index++] = makeVert(corners[0], glm::vec3(1, 0, 0), corners);
+					vertices.push_back(makeVert(corners[2], glm::vec3(0, 0, 1), corners));
+					vertices.push_back(makeVert(corners[1], glm::vec3(0, 1, 0), corners));
+					vertices.push_back(makeVert(corners[0], glm::vec3(1, 0, 0), corners));
 				}
 			};
 
@@ -204,7 +213,7 @@ const bgfx::Memory* LandBlock::BuildVertexList(LandIslandInterface& island)
 		}
 	}
 
-	return verticesMem;
+	return vertices;
 }
 
 const lnd::LNDCell* LandBlock::GetCells() const
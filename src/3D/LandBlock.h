@@ -12,11 +12,14 @@
 #include <cstdint>
 
 #include <array>
+#include <span>
+#include <vector>
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 
+#include "3D/AxisAlignedBoundingBox.h"
 #include "Graphics/ShaderProgram.h"
 #include "LandIslandInterface.h"
 
@@ -62,12 +65,17 @@ class LandBlock
 {
 public:
 	LandBlock() = default;
-	void BuildMesh(LandIslandInterface& island);
+	/// Vertices of the block's mesh, does not create any graphics resources
+	[[nodiscard]] std::vector<LandVertex> BuildVertexList(LandIslandInterface& island) const;
+	/// Create the mesh and physics shape from the vertices made by \ref BuildVertexList
+	void BuildMesh(std::span<const LandVertex> vertices);
 
 	[[nodiscard]] const graphics::Mesh& GetMesh() const { return *_mesh; }
 	[[nodiscard]] const lnd::LNDCell* GetCells() const;
 	[[nodiscard]] glm::ivec2 GetBlockPosition() const;
 	[[nodiscard]] glm::vec2 GetMapPosition() const;
+	/// World space bounds of the block's mesh, valid after \ref BuildMesh
+	[[nodiscard]] const AxisAlignedBoundingBox& GetBoundingBox() const { return _boundingBox; }
 	[[nodiscard]] std::unique_ptr<btRigidBody>& GetRigidBody() { return _rigidBody; };
 	[[nodiscard]] const std::unique_ptr<lnd::LNDBlock>& GetLndBlock() const { return _block; };
 	void SetLndBlock(const lnd::LNDBlock& block);
@@ -78,7 +86,6 @@ class LandBlock
 	std::unique_ptr<dynamics::LandBlockBulletMeshInterface> _dynamicsMeshInterface;
 	std::unique_ptr<btBvhTriangleMeshShape> _physicsMesh;
 	std::unique_ptr<btRigidBody> _rigidBody;
-
-	const bgfx::Memory* BuildVertexList(LandIslandInterface& island);
+	AxisAlignedBoundingBox _boundingBox {};
 };
 } // namespace openblack
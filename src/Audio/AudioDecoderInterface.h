@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
@@ -19,8 +20,16 @@ namespace openblack::audio
 class AudioDecoderInterface
 {
 public:
-	virtual bool Open(const std::vector<uint8_t>& buffer) = 0;
+	/// The encoded data is not copied and must outlive the decoder
+	virtual bool Open(std::span<const uint8_t> buffer) = 0;
+	/// Decode the whole stream
 	virtual void Read(std::vector<int16_t>& buffer) = 0;
+	/// Decode the next interleaved frames into buffer, returns the number of frames written or 0 at the end of the stream
+	virtual size_t ReadFrames(std::span<int16_t> buffer) = 0;
+	/// Continue decoding from the first frame
+	virtual bool Rewind() = 0;
+	[[nodiscard]] virtual size_t GetFrameCount() = 0;
+	[[nodiscard]] virtual int GetSampleRate() = 0;
 	[[nodiscard]] virtual ChannelLayout GetChannelLayout() = 0;
 };
 } // namespace openblack::audio
@@ -11,9 +11,12 @@
 
 #include "AudioManager.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 
 #include <PackFile.h>
+#include <glm/geometric.hpp>
 #include <glm/gtc/constants.hpp>
 #include <spdlog/spdlog.h>
 
@@ -32,24 +35,30 @@ namespace openblack::audio
 {
 
 AudioManager::AudioManager()
-    : _audioPlayer(new AudioPlayer())
+    : AudioManager(std::make_unique<AudioPlayer>())
+{
+}
+
+AudioManager::AudioManager(std::unique_ptr<AudioPlayerInterface> audioPlayer)
+    : _audioPlayer(std::move(audioPlayer))
+    , _lastUpdate(std::chrono::steady_clock::now())
 {
 	_audioPlayer->Initialize();
 }
 
 AudioManager::~AudioManager()
 {
+	StopMusic();
 	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<Transform, AudioEmitter>([this](entt::entity entity, const Transform&, const AudioEmitter& emitter) {
-		DestroyEmitter(entity);
-		auto sound = Locator::resources::value().GetSounds().Handle(emitter.soundId);
-		_audioPlayer->DeleteBuffer(sound->bufferId);
+	registry.Each<Transform, AudioEmitter>(
+	    [this](entt::entity entity, const Transform&, const AudioEmitter&) { DestroyEmitter(entity); });
+	// Emitters of the same sound share its buffer, it is deleted once with the sound
+	Locator::resources::value().GetSounds().Each([this](entt::id_type, const auto& sound) {
+		if (sound->bufferId != 0)
+		{
+			_audioPlayer->DeleteBuffer(sound->bufferId);
+		}
 	});
-
-	if (registry.Valid(_musicEntity))
-	{
-		DestroyEmitter(_musicEntity);
-	}
 }
 
 void AudioManager::Stop()
@@ -62,6 +71,10 @@ void AudioManager::Stop()
 
 void AudioManager::Update()
 {
+	const auto now = std::chrono::steady_clock::now();
+	const auto deltaTime = std::chrono::duration<float>(now - _lastUpdate).count();
+	_lastUpdate = now;
+
 	auto& camera = Locator::camera::value();
 	auto pos = camera.GetOrigin();
 	auto vel = camera.GetOriginVelocity();
@@ -69,24 +82,124 @@ void AudioManager::Update()
 	auto top = camera.GetUp();
 	_audioPlayer->UpdateListener(pos, vel, forward, top);
 	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<Transform, AudioEmitter>(
-	    [this](entt::entity entity, const Transform& transform, const AudioEmitter& emitter) {
-		    auto volume = _globalVolume * emitter.volume;
-		    if (entity == _musicEntity)
-		    {
-			    volume *= _musicVolume;
-		    }
-		    else
-		    {
-			    volume *= _sfxVolume;
-		    }
-		    _audioPlayer->UpdateSource(emitter.sourceId, transform.position, volume, emitter.loop == PlayType::Repeat);
-		    auto audioStatus = _audioPlayer->GetStatus(emitter.sourceId);
-		    if (audioStatus == AudioStatus::Stopped)
-		    {
-			    DestroyEmitter(entity);
-		    }
-	    });
+
+	// Rank the emitters without calling OpenAL, virtual emitters keep their own time
+	_voiceCandidates.clear();
+	registry.Each<Transform, AudioEmitter>([this, pos, deltaTime](entt::entity entity, const Transform& transform,
+	                                                              AudioEmitter& emitter) {
+		auto volume = _globalVolume * emitter.volume;
+		if (entity == _musicEntity)
+		{
+			UpdateMusic(emitter, transform, volume * _musicVolume);
+			return;
+		}
+		if (emitter.state == AudioStatus::Stopped)
+		{
+			DestroyEmitter(entity);
+			return;
+		}
+		if (emitter.sourceId == AudioEmitter::k_VirtualSource && emitter.state == AudioStatus::Playing)
+		{
+			emitter.elapsed += deltaTime;
+			if (emitter.elapsed >= emitter.duration)
+			{
+				if (emitter.loop != PlayType::Repeat || emitter.duration <= 0.0f)
+				{
+					DestroyEmitter(entity);
+					return;
+				}
+				emitter.elapsed = std::fmod(emitter.elapsed, emitter.duration);
+			}
+		}
+		// Paused emitters still take part so that they lose their voice
+		const auto hasVoice = emitter.sourceId != AudioEmitter::k_VirtualSource;
+		if (emitter.state == AudioStatus::Playing || hasVoice)
+		{
+			const auto audibility =
+			    emitter.state == AudioStatus::Playing ? GetAudibility(emitter, transform, pos, volume * _sfxVolume) : 0.0f;
+			_voiceCandidates.push_back({emitter.priority, audibility, entity, hasVoice});
+		}
+	});
+
+	// Paused and out of range emitters never get a voice, whatever their priority, so they are not ranked
+	const auto audibleEnd = std::partition(_voiceCandidates.begin(), _voiceCandidates.end(),
+	                                       [](const auto& candidate) { return candidate.audibility >= k_MinAudibility; });
+	// Higher priorities first, then the loudest
+	const auto voiceCount = std::min(static_cast<size_t>(audibleEnd - _voiceCandidates.begin()), k_MaxVoices);
+	const auto voiceEnd = _voiceCandidates.begin() + static_cast<std::ptrdiff_t>(voiceCount);
+	std::nth_element(_voiceCandidates.begin(), voiceEnd, audibleEnd, [](const auto& lhs, const auto& rhs) {
+		return lhs.priority != rhs.priority ? lhs.priority > rhs.priority : lhs.audibility > rhs.audibility;
+	});
+
+	// Release voices first so that the budget is never exceeded while promoting
+	for (size_t i = voiceCount; i < _voiceCandidates.size(); ++i)
+	{
+		if (_voiceCandidates[i].hasVoice)
+		{
+			DemoteEmitter(registry.Get<AudioEmitter>(_voiceCandidates[i].entity));
+		}
+	}
+	// Only the emitters with a voice are updated in OpenAL
+	for (size_t i = 0; i < voiceCount; ++i)
+	{
+		const auto entity = _voiceCandidates[i].entity;
+		auto [transform, emitter] = registry.Get<Transform, AudioEmitter>(entity);
+		const auto volume = _globalVolume * emitter.volume * _sfxVolume;
+		if (emitter.sourceId == AudioEmitter::k_VirtualSource)
+		{
+			PromoteEmitter(emitter, transform, volume);
+			continue;
+		}
+		_audioPlayer->UpdateSource(emitter.sourceId, transform.position, volume, emitter.loop == PlayType::Repeat);
+		if (_audioPlayer->GetStatus(emitter.sourceId) == AudioStatus::Stopped)
+		{
+			DestroyEmitter(entity);
+		}
+	}
+}
+
+float AudioManager::GetAudibility(const AudioEmitter& emitter, const Transform& transform, glm::vec3 listener, float volume)
+{
+	const auto distance = glm::length(emitter.relative ? transform.position : transform.position - listener);
+	// The second radius is the distance past which the emitter can't be heard
+	if (emitter.radius.y > 0.0f && distance > emitter.radius.y)
+	{
+		return 0.0f;
+	}
+	const auto referenceDistance = std::max(emitter.radius.x, 1.0f);
+	return volume * referenceDistance / std::max(distance, referenceDistance);
+}
+
+void AudioManager::PromoteEmitter(AudioEmitter& emitter, const Transform& transform, float volume)
+{
+	emitter.sourceId = _audioPlayer->CreateSource(emitter.pitch, emitter.relative);
+	_audioPlayer->QueueBuffer(emitter.sourceId, emitter.bufferId);
+	_audioPlayer->SetPlaybackOffset(emitter.sourceId, emitter.elapsed);
+	_audioPlayer->PlaySource(emitter.sourceId, transform.position, volume, emitter.loop == PlayType::Repeat);
+}
+
+void AudioManager::DemoteEmitter(AudioEmitter& emitter)
+{
+	emitter.elapsed = _audioPlayer->GetPlaybackOffset(emitter.sourceId);
+	_audioPlayer->DeleteSource(emitter.sourceId);
+	emitter.sourceId = AudioEmitter::k_VirtualSource;
+}
+
+void AudioManager::UpdateMusic(const AudioEmitter& emitter, const Transform& transform, float volume)
+{
+	// The stream rewinds itself to loop, a looping OpenAL source would never release its buffers
+	_audioPlayer->UpdateSource(emitter.sourceId, transform.position, volume, false);
+	if (!_musicStream->Update(emitter.sourceId))
+	{
+		StopMusic();
+		return;
+	}
+	// Start once the first chunks are queued and resume if the source ran out of buffers
+	const auto status = _audioPlayer->GetStatus(emitter.sourceId);
+	if ((status == AudioStatus::Initial || status == AudioStatus::Stopped) && _musicStream->HasQueuedBuffers())
+	{
+		_audioPlayer->PlaySource(emitter.sourceId, transform.position, volume, false);
+	}
 }
 
 BufferId AudioManager::CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate)
@@ -99,8 +212,14 @@ void AudioManager::PlayEmitter(entt::entity emitter)
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& emitterComponent = registry.Get<AudioEmitter>(emitter);
-	auto& transform = registry.Get<Transform>(emitter);
-	_audioPlayer->PlaySource(emitterComponent.sourceId, transform.position, 1.f, emitterComponent.loop == PlayType::Repeat);
+	emitterComponent.state = AudioStatus::Playing;
+	// Virtual emitters start playing once Update gives them a voice
+	if (emitterComponent.sourceId != AudioEmitter::k_VirtualSource)
+	{
+		auto& transform = registry.Get<Transform>(emitter);
+		const auto loop = emitter != _musicEntity && emitterComponent.loop == PlayType::Repeat;
+		_audioPlayer->PlaySource(emitterComponent.sourceId, transform.position, 1.f, loop);
+	}
 }
 
 void AudioManager::PauseEmitter(entt::entity emitter)
@@ -108,15 +227,29 @@ void AudioManager::PauseEmitter(entt::entity emitter)
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& component = registry.Get<AudioEmitter>(emitter);
-	_audioPlayer->PauseSource(component.sourceId);
+	component.state = AudioStatus::Paused;
+	if (component.sourceId != AudioEmitter::k_VirtualSource)
+	{
+		_audioPlayer->PauseSource(component.sourceId);
+	}
 }
 
 void AudioManager::StopEmitter(entt::entity emitter)
 {
+	if (emitter == _musicEntity)
+	{
+		// Otherwise the stream would restart the source on the next update
+		StopMusic();
+		return;
+	}
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& component = registry.Get<AudioEmitter>(emitter);
-	_audioPlayer->StopSource(component.sourceId);
+	component.state = AudioStatus::Stopped;
+	if (component.sourceId != AudioEmitter::k_VirtualSource)
+	{
+		_audioPlayer->StopSource(component.sourceId);
+	}
 }
 
 void AudioManager::DestroyEmitter(entt::entity emitter)
@@ -124,7 +257,10 @@ void AudioManager::DestroyEmitter(entt::entity emitter)
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& component = registry.Get<AudioEmitter>(emitter);
-	_audioPlayer->DeleteSource(component.sourceId);
+	if (component.sourceId != AudioEmitter::k_VirtualSource)
+	{
+		_audioPlayer->DeleteSource(component.sourceId);
+	}
 	registry.Destroy(emitter);
 }
 
@@ -134,13 +270,14 @@ entt::entity AudioManager::CreateEmitter(entt::id_type id, PlayType playType, gl
 	auto sound = Locator::resources::value().GetSounds().Handle(id);
 	auto& registry = Locator::entitiesRegistry::value();
 	auto entity = registry.Create();
-	auto sourceId = _audioPlayer->CreateSource(static_cast<float>(sound->pitch), relative);
 	if (!sound->buffer.empty())
 	{
 		CreateBuffer(sound);
 	}
-	_audioPlayer->QueueBuffer(sourceId, sound->bufferId);
-	registry.Assign<AudioEmitter>(entity, sourceId, id, 0, position, direction, radius, volume, playType, status, relative);
+	// The emitter starts virtual, Update gives it a source if it is important enough
+	registry.Assign<AudioEmitter>(entity, AudioEmitter::k_VirtualSource, id, sound->priority, position, direction, radius,
+	                              volume, playType, status, relative, static_cast<float>(sound->pitch), sound->bufferId,
+	                              sound->duration);
 	registry.Assign<Transform>(entity, glm::zero<glm::vec3>(), glm::one<glm::mat4>(), glm::one<glm::vec3>());
 	return entity;
 }
@@ -183,6 +320,8 @@ void AudioManager::CreateBuffer(Sound& sound)
 	sound.bufferId = CreateBuffer(sound.channelLayout, decodeBuffer, sound.sampleRate);
 	sound.duration = _audioPlayer->GetDuration(sound.bufferId);
 	sound.sizeInBytes = decodeBuffer.size() * sizeof(decodeBuffer[0]);
+	// The encoded samples are not needed anymore, later emitters share the buffer
+	sound.buffer.clear();
 }
 
 bool AudioManager::EmitterExists(entt::entity emitter)
@@ -196,6 +335,14 @@ float AudioManager::GetProgress(entt::entity entity)
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(entity));
 	auto& emitter = registry.Get<AudioEmitter>(entity);
+	if (entity == _musicEntity)
+	{
+		return _musicStream->GetProgress(emitter.sourceId);
+	}
+	if (emitter.sourceId == AudioEmitter::k_VirtualSource)
+	{
+		return emitter.duration > 0.0f ? emitter.elapsed / emitter.duration : 0.0f;
+	}
 	auto sizeInBytes = Locator::resources::value().GetSounds().Handle(emitter.soundId)->sizeInBytes;
 	return _audioPlayer->GetProgress(sizeInBytes, emitter.sourceId);
 }
@@ -205,6 +352,10 @@ AudioStatus AudioManager::GetStatus(entt::entity emitter)
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& component = registry.Get<AudioEmitter>(emitter);
+	if (component.sourceId == AudioEmitter::k_VirtualSource)
+	{
+		return component.state;
+	}
 	return _audioPlayer->GetStatus(component.sourceId);
 }
 
@@ -251,21 +402,32 @@ const std::map<std::string, SoundGroup>& AudioManager::GetSoundGroups()
 void AudioManager::PlayMusic(const std::string& packPath, PlayType type)
 {
 	StopMusic();
-	const entt::id_type id = entt::hashed_string(fmt::format("{}", packPath).c_str());
-	if (!Locator::resources::value().GetSounds().Contains(packPath))
+	try
 	{
-		pack::PackFile soundPack;
-		soundPack.Open(packPath);
-		const auto& audioHeaders = soundPack.GetAudioSampleHeaders();
-		const auto& audioData = soundPack.GetAudioSamplesData();
-		Locator::resources::value().GetSounds().Load(id, resources::SoundLoader::FromBufferTag {}, audioHeaders[0], audioData);
+		_musicStream = std::make_unique<MusicStream>(*_audioPlayer, packPath, type == PlayType::Repeat);
 	}
-	auto sound = Locator::resources::value().GetSounds().Handle(id);
-	auto position = glm::one<glm::vec3>();
-	auto direction = glm::zero<glm::vec3>();
-	auto radius = glm::zero<glm::vec3>();
-	_musicEntity = CreateEmitter(id, type, position, direction, radius, sound->volume, AudioStatus::Playing, true);
-	PlayEmitter(_musicEntity);
+	catch (const std::runtime_error& error)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "{}", error.what());
+		return;
+	}
+
+	// Only the sample's header is kept as a resource, the samples are decoded from the pack as they are played
+	const entt::id_type id = entt::hashed_string(packPath.c_str());
+	auto& sounds = Locator::resources::value().GetSounds();
+	if (!sounds.Contains(id))
+	{
+		sounds.Load(id, resources::SoundLoader::FromBufferTag {}, _musicStream->GetHeader(),
+		            std::span<const std::span<const uint8_t>> {});
+	}
+	auto sound = sounds.Handle(id);
+	auto& registry = Locator::entitiesRegistry::value();
+	_musicEntity = registry.Create();
+	// The source is played by UpdateMusic once the worker has decoded the first chunks
+	auto sourceId = _audioPlayer->CreateSource(static_cast<float>(sound->pitch), true);
+	registry.Assign<AudioEmitter>(_musicEntity, sourceId, id, 0, glm::one<glm::vec3>(), glm::zero<glm::vec3>(),
+	                              glm::zero<glm::vec2>(), sound->volume, type, AudioStatus::Playing, true);
+	registry.Assign<Transform>(_musicEntity, glm::zero<glm::vec3>(), glm::one<glm::mat4>(), glm::one<glm::vec3>());
 }
 
 void AudioManager::StopMusic()
@@ -273,13 +435,14 @@ void AudioManager::StopMusic()
 	auto& registry = Locator::entitiesRegistry::value();
 	if (!EmitterExists(_musicEntity))
 	{
+		_musicStream.reset();
 		return;
 	}
 	auto& emitter = registry.Get<AudioEmitter>(_musicEntity);
-	// Clean up the audio player's music resources
+	// Deleting the source releases the stream's buffers so they can be deleted with it
 	_audioPlayer->StopSource(emitter.sourceId);
 	_audioPlayer->DeleteSource(emitter.sourceId);
-	[[maybe_unused]] auto music = Locator::resources::value().GetSounds().Handle(emitter.soundId);
+	_musicStream.reset();
 	//	Erase the music resource as it is no longer being played
 	Locator::resources::value().GetSounds().Erase(emitter.soundId);
 	//	Remove the entity
@@ -9,7 +9,9 @@
 
 #pragma once
 
+#include <chrono>
 #include <map>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -21,6 +23,8 @@
 #include "AudioDecoderInterface.h"
 #include "AudioManagerInterface.h"
 #include "AudioPlayer.h"
+#include "ECS/Components/Transform.h"
+#include "MusicStream.h"
 #include "SoundGroup.h"
 
 #if !defined(LOCATOR_IMPLEMENTATIONS)
@@ -39,6 +43,8 @@ class AudioManager final: public AudioManagerInterface
 {
 public:
 	AudioManager();
+	/// Play through \p audioPlayer instead of OpenAL
+	explicit AudioManager(std::unique_ptr<AudioPlayerInterface> audioPlayer);
 	~AudioManager();
 	BufferId CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) override;
 	void CreateBuffer(Sound& sound) override;
@@ -70,16 +76,43 @@ class AudioManager final: public AudioManagerInterface
 	const SoundGroup& GetSoundGroup(const std::string& name) override;
 	const std::map<std::string, SoundGroup>& GetSoundGroups() override;
 
+	/// Most sound effects playing at once, the other emitters are virtual
+	static constexpr size_t k_MaxVoices = 32;
+	/// Emitters quieter than this (about -60dB) are virtualised even when voices are free
+	static constexpr float k_MinAudibility = 0.001f;
+
 private:
+	struct VoiceCandidate
+	{
+		int priority;
+		float audibility;
+		entt::entity entity;
+		bool hasVoice;
+	};
+
+	/// Estimate of the gain the emitter would be heard with, following OpenAL's default inverse distance model
+	[[nodiscard]] static float GetAudibility(const ecs::components::AudioEmitter& emitter,
+	                                         const ecs::components::Transform& transform, glm::vec3 listener, float volume);
+	/// Give the emitter a source and start it where its virtual playback got to
+	void PromoteEmitter(ecs::components::AudioEmitter& emitter, const ecs::components::Transform& transform, float volume);
+	/// Release the emitter's source and keep tracking its playback position
+	void DemoteEmitter(ecs::components::AudioEmitter& emitter);
+	/// Feed the decoded chunks of the music stream to its source and stop the music once the track has played
+	void UpdateMusic(const ecs::components::AudioEmitter& emitter, const ecs::components::Transform& transform, float volume);
+
 	std::unique_ptr<AudioPlayerInterface> _audioPlayer;
 	/// All sounds are loaded
 	std::map<std::string, SoundGroup> _soundGroups;
-	/// Music resources are loaded on demand to avoid storing large audio buffers. There are no resource IDs yet
+	/// Music is streamed from its pack on demand to avoid storing large audio buffers. There are no resource IDs yet
 	std::vector<std::string> _music;
+	std::unique_ptr<MusicStream> _musicStream;
 	float _globalVolume {1.0f};
 	float _musicVolume {1.0f};
 	float _sfxVolume {1.0f};
 	entt::entity _musicEntity {entt::null};
+	/// Reused every update to rank the emitters
+	std::vector<VoiceCandidate> _voiceCandidates;
+	std::chrono::steady_clock::time_point _lastUpdate;
 };
 
 } // namespace openblack::audio
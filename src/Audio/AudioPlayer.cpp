@@ -111,6 +111,14 @@ void AudioPlayer::UpdateListener(glm::vec3 pos, glm::vec3 vel, glm::vec3 front,
 }
 
 BufferId AudioPlayer::CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate)
+{
+	BufferId id;
+	alCheckCall(alGenBuffers(1, &id));
+	UpdateBuffer(id, layout, buffer, sampleRate);
+	return id;
+}
+
+void AudioPlayer::UpdateBuffer(BufferId id, ChannelLayout layout, std::span<const int16_t> buffer, int sampleRate)
 {
 	int playerLayout;
 	if (layout == ChannelLayout::Mono)
@@ -125,11 +133,8 @@ BufferId AudioPlayer::CreateBuffer(ChannelLayout layout, const std::vector<int16
 	{
 		throw std::runtime_error("Unknown channel layout");
 	}
-	BufferId id;
-	alCheckCall(alGenBuffers(1, &id));
-	auto bufferSize = static_cast<ALsizei>(buffer.size() * sizeof(buffer[0]));
+	auto bufferSize = static_cast<ALsizei>(buffer.size_bytes());
 	alCheckCall(alBufferData(id, playerLayout, buffer.data(), bufferSize, sampleRate));
-	return id;
 }
 
 void AudioPlayer::QueueBuffer(SourceId sourceId, BufferId bufferId)
@@ -137,6 +142,20 @@ void AudioPlayer::QueueBuffer(SourceId sourceId, BufferId bufferId)
 	alCheckCall(alSourceQueueBuffers(sourceId, 1, &bufferId));
 }
 
+BufferId AudioPlayer::UnqueueBuffer(SourceId sourceId)
+{
+	BufferId id;
+	alCheckCall(alSourceUnqueueBuffers(sourceId, 1, &id));
+	return id;
+}
+
+int AudioPlayer::GetProcessedBufferCount(SourceId sourceId) const
+{
+	ALint processed;
+	alCheckCall(alGetSourcei(sourceId, AL_BUFFERS_PROCESSED, &processed));
+	return processed;
+}
+
 void AudioPlayer::DeleteBuffer(BufferId id)
 {
 	alCheckCall(alDeleteBuffers(1, &id));
@@ -207,6 +226,18 @@ void AudioPlayer::StopSource(SourceId id) const
 	alCheckCall(alSourceStop(id));
 }
 
+void AudioPlayer::SetPlaybackOffset(SourceId id, float seconds)
+{
+	alCheckCall(alSourcef(id, AL_SEC_OFFSET, seconds));
+}
+
+float AudioPlayer::GetPlaybackOffset(SourceId id) const
+{
+	ALfloat offset;
+	alCheckCall(alGetSourcef(id, AL_SEC_OFFSET, &offset));
+	return offset;
+}
+
 float AudioPlayer::GetVolume() const
 {
 	return 0;
@@ -27,7 +27,10 @@ class AudioPlayer final: public AudioPlayerInterface
 	void Initialize() override;
 	void UpdateListener(glm::vec3 pos, glm::vec3 vel, glm::vec3 front, glm::vec3 up) const override;
 	BufferId CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) override;
+	void UpdateBuffer(BufferId id, ChannelLayout layout, std::span<const int16_t> buffer, int sampleRate) override;
 	void QueueBuffer(SourceId sourceId, BufferId buffer) override;
+	BufferId UnqueueBuffer(SourceId sourceId) override;
+	int GetProcessedBufferCount(SourceId sourceId) const override;
 	void DeleteBuffer(BufferId id) override;
 	void DeleteSource(SourceId id) override;
 	void UpdateSource(SourceId id, glm::vec3 pos, float volume, bool loop) override;
@@ -38,6 +41,8 @@ class AudioPlayer final: public AudioPlayerInterface
 	void PlaySource(SourceId id, float volume, bool loop) override;
 	void PauseSource(SourceId id) const override;
 	void StopSource(SourceId id) const override;
+	void SetPlaybackOffset(SourceId id, float seconds) override;
+	float GetPlaybackOffset(SourceId id) const override;
 	void SetVolume(SourceId id, float volume) override;
 	[[nodiscard]] float GetVolume() const override;
 	[[nodiscard]] AudioStatus GetStatus(SourceId id) const override;
@@ -16,6 +16,7 @@ extern "C" {
 
 #include <filesystem>
 #include <queue>
+#include <span>
 #include <vector>
 
 #include <glm/vec3.hpp>
@@ -32,7 +33,12 @@ class AudioPlayerInterface
 	virtual void Initialize() = 0;
 	virtual void UpdateListener(glm::vec3 pos, glm::vec3 vel, glm::vec3 front, glm::vec3 up) const = 0;
 	[[nodiscard]] virtual BufferId CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) = 0;
+	/// Replace the samples of an existing buffer, it must not be queued on a playing source
+	virtual void UpdateBuffer(BufferId id, ChannelLayout layout, std::span<const int16_t> buffer, int sampleRate) = 0;
 	virtual void QueueBuffer(SourceId sourceId, BufferId buffer) = 0;
+	/// Remove the oldest buffer the source has finished playing from its queue
+	[[nodiscard]] virtual BufferId UnqueueBuffer(SourceId sourceId) = 0;
+	[[nodiscard]] virtual int GetProcessedBufferCount(SourceId sourceId) const = 0;
 	virtual void DeleteBuffer(BufferId id) = 0;
 	[[nodiscard]] virtual SourceId CreateSource(float pitch, bool relative) = 0;
 	virtual void DeleteSource(SourceId id) = 0;
@@ -43,6 +49,9 @@ class AudioPlayerInterface
 	virtual void PlaySource(SourceId id, float volume, bool loop) = 0;
 	virtual void PauseSource(SourceId id) const = 0;
 	virtual void StopSource(SourceId id) const = 0;
+	/// Position in seconds in the buffers queued on the source
+	virtual void SetPlaybackOffset(SourceId id, float seconds) = 0;
+	[[nodiscard]] virtual float GetPlaybackOffset(SourceId id) const = 0;
 	virtual void SetVolume(SourceId id, float volume) = 0;
 	[[nodiscard]] virtual float GetVolume() const = 0;
 	[[nodiscard]] virtual AudioStatus GetStatus(SourceId id) const = 0;
@@ -27,7 +27,7 @@ extern "C" {
 
 using namespace openblack::audio;
 
-bool MpegAudioDecoder::Open(const std::vector<uint8_t>& buffer)
+bool MpegAudioDecoder::Open(std::span<const uint8_t> buffer)
 {
 	const auto status = drmp3_init_memory(&_mp3, buffer.data(), buffer.size(), nullptr);
 	return static_cast<bool>(status);
@@ -40,6 +40,28 @@ void MpegAudioDecoder::Read(std::vector<int16_t>& buffer)
 	[[maybe_unused]] const auto framesRead = drmp3_read_pcm_frames_s16(&_mp3, frameCount, buffer.data());
 }
 
+size_t MpegAudioDecoder::ReadFrames(std::span<int16_t> buffer)
+{
+	const auto frameCount = buffer.size() / _mp3.channels;
+	return static_cast<size_t>(drmp3_read_pcm_frames_s16(&_mp3, frameCount, buffer.data()));
+}
+
+bool MpegAudioDecoder::Rewind()
+{
+	return static_cast<bool>(drmp3_seek_to_pcm_frame(&_mp3, 0));
+}
+
+size_t MpegAudioDecoder::GetFrameCount()
+{
+	// Scans the frame headers without decoding and restores the current position
+	return static_cast<size_t>(drmp3_get_pcm_frame_count(&_mp3));
+}
+
+int MpegAudioDecoder::GetSampleRate()
+{
+	return static_cast<int>(_mp3.sampleRate);
+}
+
 ChannelLayout MpegAudioDecoder::GetChannelLayout()
 {
 	switch (_mp3.channels)
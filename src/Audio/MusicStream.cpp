@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "MusicStream.h"
+
+#include <cassert>
+
+#include <algorithm>
+#include <cmath>
+
+#include <PackFile.h>
+#include <fmt/format.h>
+
+#include "MpegAudioDecoder.h"
+#include "WavAudioDecoder.h"
+
+using namespace openblack::audio;
+
+MusicStream::MusicStream(AudioPlayerInterface& player, const std::filesystem::path& packPath, bool loop)
+    : _player(player)
+    , _pack(std::make_unique<pack::PackFile>())
+    , _loop(loop)
+{
+	const auto result = _pack->Open(packPath, pack::PackOpenMode::MemoryMap);
+	if (result != pack::PackResult::Success)
+	{
+		throw std::runtime_error(fmt::format("Unable to open music pack {}: {}", packPath.string(), pack::ResultToStr(result)));
+	}
+	if (_pack->GetAudioSamplesData().empty())
+	{
+		throw std::runtime_error(fmt::format("Music pack {} has no samples", packPath.string()));
+	}
+
+	// The decoders read straight from the mapping
+	const auto data = _pack->GetAudioSamplesData()[0];
+	_decoder = std::make_unique<MpegAudioDecoder>();
+	if (!_decoder->Open(data))
+	{
+		_decoder = std::make_unique<WavAudioDecoder>();
+		if (!_decoder->Open(data))
+		{
+			throw std::runtime_error(fmt::format("Unable to decode music pack {}", packPath.string()));
+		}
+	}
+	Start();
+}
+
+MusicStream::MusicStream(AudioPlayerInterface& player, std::unique_ptr<AudioDecoderInterface> decoder, bool loop)
+    : _player(player)
+    , _decoder(std::move(decoder))
+    , _loop(loop)
+{
+	Start();
+}
+
+void MusicStream::Start()
+{
+	_channelLayout = _decoder->GetChannelLayout();
+	_channels = _channelLayout == ChannelLayout::Stereo ? 2 : 1;
+	_sampleRate = _decoder->GetSampleRate();
+
+	for (auto& chunk : _chunks)
+	{
+		chunk.samples.resize(k_ChunkFrames * _channels);
+	}
+	_freeBuffers.reserve(_buffers.size());
+	for (auto& buffer : _buffers)
+	{
+		buffer = _player.CreateBuffer(_channelLayout, {}, _sampleRate);
+		_freeBuffers.push_back(buffer);
+	}
+
+	_worker = std::jthread([this](const std::stop_token& stopToken) { Decode(stopToken); });
+}
+
+MusicStream::~MusicStream()
+{
+	_worker.request_stop();
+	for (auto buffer : _buffers)
+	{
+		_player.DeleteBuffer(buffer);
+	}
+}
+
+const openblack::pack::AudioBankSampleHeader& MusicStream::GetHeader() const
+{
+	assert(_pack != nullptr && "Streams of a decoder have no pack");
+	return _pack->GetAudioSampleHeaders()[0];
+}
+
+void MusicStream::Decode(const std::stop_token& stopToken)
+{
+	_frameCount = _decoder->GetFrameCount();
+
+	size_t writeChunk = 0;
+	while (!stopToken.stop_requested())
+	{
+		{
+			std::unique_lock lock(_mutex);
+			if (!_chunkConsumed.wait(lock, stopToken, [this] { return _decodedChunks < _chunks.size(); }))
+			{
+				return;
+			}
+		}
+
+		// Update does not read the chunk until it is counted as decoded
+		auto& chunk = _chunks[writeChunk];
+		chunk.frames = _decoder->ReadFrames(chunk.samples);
+		if (chunk.frames == 0 && _loop && _decoder->Rewind())
+		{
+			chunk.frames = _decoder->ReadFrames(chunk.samples);
+		}
+
+		const std::lock_guard lock(_mutex);
+		if (chunk.frames == 0)
+		{
+			_endOfStream = true;
+			return;
+		}
+		writeChunk = (writeChunk + 1) % _chunks.size();
+		++_decodedChunks;
+	}
+}
+
+bool MusicStream::Update(SourceId source)
+{
+	for (auto processed = _player.GetProcessedBufferCount(source); processed > 0; --processed)
+	{
+		const auto buffer = _player.UnqueueBuffer(source);
+		const auto index = std::distance(_buffers.begin(), std::ranges::find(_buffers, buffer));
+		_playedFrames += _bufferFrames[index];
+		_freeBuffers.push_back(buffer);
+	}
+
+	size_t decodedChunks;
+	{
+		const std::lock_guard lock(_mutex);
+		decodedChunks = _decodedChunks;
+	}
+	const auto uploads = std::min(decodedChunks, _freeBuffers.size());
+	for (size_t i = 0; i < uploads; ++i)
+	{
+		const auto& chunk = _chunks[_readChunk];
+		const auto buffer = _freeBuffers.back();
+		_freeBuffers.pop_back();
+		_player.UpdateBuffer(buffer, _channelLayout, std::span(chunk.samples).first(chunk.frames * _channels), _sampleRate);
+		_player.QueueBuffer(source, buffer);
+		_bufferFrames[std::distance(_buffers.begin(), std::ranges::find(_buffers, buffer))] = chunk.frames;
+		_readChunk = (_readChunk + 1) % _chunks.size();
+	}
+
+	bool finished;
+	{
+		const std::lock_guard lock(_mutex);
+		_decodedChunks -= uploads;
+		finished = _endOfStream && _decodedChunks == 0;
+	}
+	if (uploads > 0)
+	{
+		_chunkConsumed.notify_one();
+	}
+
+	return !finished || HasQueuedBuffers();
+}
+
+bool MusicStream::HasQueuedBuffers() const
+{
+	return _freeBuffers.size() < _buffers.size();
+}
+
+float MusicStream::GetProgress(SourceId source) const
+{
+	const size_t frameCount = _frameCount;
+	if (frameCount == 0)
+	{
+		return 0.0f;
+	}
+	// The source's offset is relative to the oldest buffer still queued
+	const auto played = static_cast<float>(_playedFrames % frameCount) / static_cast<float>(frameCount);
+	const auto queued = _player.GetProgress(frameCount * _channels * sizeof(int16_t), source);
+	return std::fmod(played + queued, 1.0f);
+}
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AudioPlayerInterface.h"
+
+namespace openblack::pack
+{
+class PackFile;
+struct AudioBankSampleHeader;
+} // namespace openblack::pack
+
+namespace openblack::audio
+{
+class AudioDecoderInterface;
+
+/// Plays the first sample of a music pack by decoding it in fixed size chunks on a worker thread.
+/// The pack stays memory mapped while the stream lives and at most k_BufferCount chunks are decoded ahead of playback so
+/// memory use does not depend on the length of the track. OpenAL is only called from the thread calling \ref Update.
+class MusicStream
+{
+public:
+	/// About a third of a second of 44.1kHz audio per buffer
+	static constexpr size_t k_ChunkFrames = 16384;
+	static constexpr size_t k_BufferCount = 4;
+
+	/// Throws if the pack can't be opened or its first sample can't be decoded
+	MusicStream(AudioPlayerInterface& player, const std::filesystem::path& packPath, bool loop);
+	/// Stream from a decoder which is already open, there is no pack header
+	MusicStream(AudioPlayerInterface& player, std::unique_ptr<AudioDecoderInterface> decoder, bool loop);
+	MusicStream(const MusicStream&) = delete;
+	MusicStream& operator=(const MusicStream&) = delete;
+	/// The buffers are deleted, they must not be queued on a source anymore
+	~MusicStream();
+
+	/// Only for streams opened from a pack
+	[[nodiscard]] const pack::AudioBankSampleHeader& GetHeader() const;
+	/// Recycle the buffers the source has finished playing and queue the chunks decoded since the last update.
+	/// Returns false once the track has ended and every chunk has been played.
+	bool Update(SourceId source);
+	[[nodiscard]] bool HasQueuedBuffers() const;
+	[[nodiscard]] float GetProgress(SourceId source) const;
+
+private:
+	struct Chunk
+	{
+		std::vector<int16_t> samples;
+		size_t frames;
+	};
+
+	/// Allocate the chunks and buffers for the decoder's format then start the worker
+	void Start();
+	void Decode(const std::stop_token& stopToken);
+
+	AudioPlayerInterface& _player;
+	std::unique_ptr<pack::PackFile> _pack;
+	std::unique_ptr<AudioDecoderInterface> _decoder;
+	ChannelLayout _channelLayout;
+	size_t _channels;
+	int _sampleRate;
+	bool _loop;
+	/// Known once the worker has scanned the track
+	std::atomic<size_t> _frameCount {0};
+
+	std::array<BufferId, k_BufferCount> _buffers;
+	std::array<size_t, k_BufferCount> _bufferFrames {};
+	/// Buffers which are not queued on the source
+	std::vector<BufferId> _freeBuffers;
+	/// Frames of the buffers already played and unqueued
+	size_t _playedFrames {0};
+
+	/// Ring of decoded chunks, filled by the worker and emptied by \ref Update
+	std::array<Chunk, k_BufferCount> _chunks;
+	size_t _readChunk {0};
+	/// Guarded by _mutex along with _endOfStream
+	size_t _decodedChunks {0};
+	bool _endOfStream {false};
+	std::mutex _mutex;
+	std::condition_variable_any _chunkConsumed;
+	/// Last so that it is joined before anything it uses is destroyed
+	std::jthread _worker;
+};
+
+} // namespace openblack::audio
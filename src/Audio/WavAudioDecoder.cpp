@@ -18,7 +18,7 @@ extern "C" {
 
 using namespace openblack::audio;
 
-bool WavAudioDecoder::Open(const std::vector<uint8_t>& buffer)
+bool WavAudioDecoder::Open(std::span<const uint8_t> buffer)
 {
 	const auto status = drwav_init_memory(&_wav, buffer.data(), buffer.size(), nullptr);
 	return static_cast<bool>(status);
@@ -32,6 +32,29 @@ void WavAudioDecoder::Read(std::vector<int16_t>& buffer)
 	[[maybe_unused]] auto framesRead = drwav_read_pcm_frames_s16(&_wav, frameCount, buffer.data());
 }
 
+size_t WavAudioDecoder::ReadFrames(std::span<int16_t> buffer)
+{
+	const auto frameCount = buffer.size() / _wav.channels;
+	return static_cast<size_t>(drwav_read_pcm_frames_s16(&_wav, frameCount, buffer.data()));
+}
+
+bool WavAudioDecoder::Rewind()
+{
+	return static_cast<bool>(drwav_seek_to_pcm_frame(&_wav, 0));
+}
+
+size_t WavAudioDecoder::GetFrameCount()
+{
+	drwav_uint64 frameCount;
+	drwav_get_length_in_pcm_frames(&_wav, &frameCount);
+	return static_cast<size_t>(frameCount);
+}
+
+int WavAudioDecoder::GetSampleRate()
+{
+	return static_cast<int>(_wav.sampleRate);
+}
+
 ChannelLayout WavAudioDecoder::GetChannelLayout()
 {
 	switch (_wav.channels)
@@ -19,8 +19,12 @@ namespace openblack::audio
 class WavAudioDecoder final: public AudioDecoderInterface
 {
 public:
-	bool Open(const std::vector<uint8_t>& buffer) override;
+	bool Open(std::span<const uint8_t> buffer) override;
 	void Read(std::vector<int16_t>& buffer) override;
+	size_t ReadFrames(std::span<int16_t> buffer) override;
+	bool Rewind() override;
+	[[nodiscard]] size_t GetFrameCount() override;
+	[[nodiscard]] int GetSampleRate() override;
 	[[nodiscard]] ChannelLayout GetChannelLayout() override;
 
 private:
@@ -396,6 +396,7 @@ void SetPosition() // 024 SET_POSITION
 		if (transform != nullptr)
 		{
 			transform->position = position;
+			registry.SetDirty(static_cast<entt::entity>(objId));
 		}
 	}
 }
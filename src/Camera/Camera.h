@@ -18,6 +18,7 @@
 #include <glm/vec3.hpp>
 
 #include "CameraModel.h"
+#include "Frustum.h"
 #include "Common/ZoomInterpolator.h"
 #include "ECS/Components/Transform.h"
 
@@ -48,6 +49,7 @@ class Camera
 	[[nodiscard]] glm::mat4 GetViewProjectionMatrix(Interpolation interpolation = Camera::Interpolation::Current) const;
 	[[nodiscard]] glm::mat4 GetViewProjectionMatrix(Projection projection,
 	                                                Interpolation interpolation = Camera::Interpolation::Current) const;
+	[[nodiscard]] Frustum GetFrustum(Interpolation interpolation = Camera::Interpolation::Current) const;
 
 	[[nodiscard]] std::optional<ecs::components::Transform>
 	RaycastMouseToLand(bool includeWater = true, Interpolation interpolation = Camera::Interpolation::Current) const;
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/vector_relational.hpp>
+
+#include "3D/AxisAlignedBoundingBox.h"
+
+namespace openblack
+{
+
+/// Six planes of a view-projection matrix, normals point inwards
+struct Frustum
+{
+	enum class Plane : uint8_t
+	{
+		Left,
+		Right,
+		Bottom,
+		Top,
+		Near,
+		Far,
+
+		_count
+	};
+
+	std::array<glm::vec4, static_cast<size_t>(Plane::_count)> planes;
+
+	/// Extract planes using the Gribb-Hartmann method. The near plane assumes a [-1, 1] depth range which is also
+	/// conservative for [0, 1] depth ranges.
+	explicit Frustum(const glm::mat4& viewProjection)
+	{
+		const auto row = [&viewProjection](int i) {
+			return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+		};
+		const auto r0 = row(0);
+		const auto r1 = row(1);
+		const auto r2 = row(2);
+		const auto r3 = row(3);
+		planes[static_cast<size_t>(Plane::Left)] = r3 + r0;
+		planes[static_cast<size_t>(Plane::Right)] = r3 - r0;
+		planes[static_cast<size_t>(Plane::Bottom)] = r3 + r1;
+		planes[static_cast<size_t>(Plane::Top)] = r3 - r1;
+		planes[static_cast<size_t>(Plane::Near)] = r3 + r2;
+		planes[static_cast<size_t>(Plane::Far)] = r3 - r2;
+		for (auto& plane : planes)
+		{
+			plane /= glm::length(glm::vec3(plane));
+		}
+	}
+
+	[[nodiscard]] inline bool Intersects(const glm::vec3& center, float radius) const
+	{
+		for (const auto& plane : planes)
+		{
+			if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	[[nodiscard]] inline bool Intersects(const AxisAlignedBoundingBox& box) const
+	{
+		for (const auto& plane : planes)
+		{
+			// Test the corner furthest along the plane normal
+			const auto normal = glm::vec3(plane);
+			const auto corner = glm::mix(box.minima, box.maxima, glm::greaterThan(normal, glm::vec3(0.0f)));
+			if (glm::dot(normal, corner) + plane.w < 0.0f)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+} // namespace openblack
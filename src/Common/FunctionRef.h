@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace openblack
+{
+
+template <typename Signature>
+class FunctionRef;
+
+/// Non-owning reference to a callable, to pass callbacks through virtual calls without the allocation of a std::function.
+/// The callable must outlive the reference, which is the case for a lambda passed as an argument.
+template <typename Return, typename... Args>
+class FunctionRef<Return(Args...)>
+{
+public:
+	FunctionRef() = default;
+
+	template <typename Callable>
+	    requires(!std::is_same_v<std::remove_cvref_t<Callable>, FunctionRef> &&
+	             std::is_invocable_r_v<Return, Callable&, Args...>)
+	// NOLINTNEXTLINE(google-explicit-constructor): Implicit like std::function
+	FunctionRef(Callable&& callable)
+	    : _callable(const_cast<void*>(static_cast<const void*>(std::addressof(callable))))
+	    , _invoke([](void* callable, Args... args) -> Return {
+		    return std::invoke(*static_cast<std::remove_reference_t<Callable>*>(callable), std::forward<Args>(args)...);
+	    })
+	{
+	}
+
+	Return operator()(Args... args) const { return _invoke(_callable, std::forward<Args>(args)...); }
+
+	explicit operator bool() const { return _invoke != nullptr; }
+
+private:
+	void* _callable {nullptr};
+	Return (*_invoke)(void*, Args...) {nullptr};
+};
+
+} // namespace openblack
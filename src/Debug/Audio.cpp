@@ -200,7 +200,8 @@ void Audio::AudioSettings() noexcept
 	ImGui::Separator();
 	Locator::entitiesRegistry::value().Each<ecs::components::AudioEmitter>(
 	    [this](entt::entity entity, const AudioEmitter& emitter) {
-		    if (ImGui::Selectable(("##" + std::to_string(emitter.sourceId)).c_str(), _selectedEmitter == entity,
+		    // Virtual emitters all share the same source id
+		    if (ImGui::Selectable(("##" + std::to_string(entt::to_integral(entity))).c_str(), _selectedEmitter == entity,
 		                          ImGuiSelectableFlags_SpanAllColumns))
 		    {
 			    _selectedEmitter = entity;
@@ -279,7 +280,8 @@ void Audio::AudioSettings() noexcept
 	ImGui::Separator();
 	Locator::entitiesRegistry::value().Each<ecs::components::AudioEmitter>(
 	    [this](entt::entity entity, const AudioEmitter& emitter) {
-		    if (ImGui::Selectable(("##" + std::to_string(emitter.sourceId)).c_str(), _selectedEmitter == entity,
+		    // Virtual emitters all share the same source id
+		    if (ImGui::Selectable(("##" + std::to_string(entt::to_integral(entity))).c_str(), _selectedEmitter == entity,
 		                          ImGuiSelectableFlags_SpanAllColumns))
 		    {
 			    _selectedEmitter = entity;
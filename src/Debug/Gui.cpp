@@ -62,6 +62,7 @@
 #include "PathFinding.h"
 #include "Profiler.h"
 #include "Resources/ResourcesInterface.h"
+#include "ResourcesViewer.h"
 #include "Temple.h"
 #include "TextureViewer.h"
 #include "Windowing/WindowingInterface.h"
@@ -110,6 +111,7 @@ std::unique_ptr<DebugGuiInterface> DebugGuiInterface::Create(graphics::RenderPas
 	debugWindows.emplace_back(new Profiler);
 	debugWindows.emplace_back(new MeshViewer);
 	debugWindows.emplace_back(new TextureViewer);
+	debugWindows.emplace_back(new ResourcesViewer);
 	debugWindows.emplace_back(new Console);
 	debugWindows.emplace_back(new LandIsland);
 	debugWindows.emplace_back(new LHVMViewer);
@@ -563,6 +565,10 @@ bool Gui::ShowMenu() noexcept
 				ImGui::Checkbox("Bounding Boxes", &config.drawBoundingBoxes);
 				ImGui::Checkbox("Footpaths", &config.drawFootpaths);
 				ImGui::Checkbox("Streams", &config.drawStreams);
+				ImGui::Checkbox("Frustum Culling", &config.frustumCulling);
+				ImGui::Checkbox("Level of Detail", &config.levelOfDetail);
+				ImGui::DragFloat2("LOD Distances", config.lodDistances.data(), 10.0f, 0.0f, 10000.0f, "%.0f");
+				ImGui::SliderFloat("LOD Hysteresis", &config.lodHysteresis, 0.0f, 0.5f);
 
 				ImGui::EndMenu();
 			}
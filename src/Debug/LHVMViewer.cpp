@@ -326,11 +326,9 @@ void LHVMViewer::DrawTasksTab(const lhvm::LHVM& lhvm) noexcept
 
 	if (ImGui::BeginListBox("##tasks", ImVec2(240, ImGui::GetContentRegionAvail().y)))
 	{
-		for (auto const& taskEntry : tasks)
+		for (auto const& task : tasks)
 		{
-			auto const& task = taskEntry.second;
-
-			if (ImGui::Selectable(task.name.c_str(), task.id == selectedTaskID))
+			if (ImGui::Selectable(lhvm.GetScripts().at(task.scriptId - 1).name.c_str(), task.id == selectedTaskID))
 			{
 				SelectTask(task.id);
 			}
@@ -346,9 +344,10 @@ void LHVMViewer::DrawTasksTab(const lhvm::LHVM& lhvm) noexcept
 
 	ImGui::SameLine();
 
-	if (tasks.contains(selectedTaskID))
+	if (const auto* selectedTask = lhvm.GetTask(selectedTaskID))
 	{
-		auto task = tasks.at(selectedTaskID);
+		const auto& task = *selectedTask;
+		const auto& script = lhvm.GetScripts().at(task.scriptId - 1);
 
 		ImGui::BeginChild("##task");
 		ImGui::Text("Task ID: %d", task.id);
@@ -364,12 +363,12 @@ void LHVMViewer::DrawTasksTab(const lhvm::LHVM& lhvm) noexcept
 
 		ImGui::Text("Name: ");
 		ImGui::SameLine();
-		if (ImGui::TextButtonColored(Disassembly_ColorFuncName, task.name.c_str()))
+		if (ImGui::TextButtonColored(Disassembly_ColorFuncName, script.name.c_str()))
 		{
 			SelectScript(task.scriptId);
 		}
 
-		ImGui::Text("File: %s", task.filename.c_str());
+		ImGui::Text("File: %s", script.filename.c_str());
 		ImGui::Text("Variables offset: 0x%04x", task.variablesOffset);
 		ImGui::Text("Instruction address: 0x%04x", task.instructionAddress);
 		ImGui::Text("Prev instruction address: 0x%04x", task.pevInstructionAddress);
@@ -394,9 +393,15 @@ void LHVMViewer::DrawTasksTab(const lhvm::LHVM& lhvm) noexcept
 		{
 			if (ImGui::BeginTabItem("Local Variables"))
 			{
-				for (const auto& var : task.localVars)
+				const auto& scripts = lhvm.GetScripts();
+				const auto* const script =
+				    task.scriptId > 0 && task.scriptId <= scripts.size() ? &scripts[task.scriptId - 1] : nullptr;
+				for (size_t i = 0; i < task.localVars.size(); i++)
 				{
-					ImGui::Text("%s = %s", var.name.c_str(), DataToString(var.value, var.type).c_str());
+					const auto& var = task.localVars[i];
+					const auto* const name =
+					    script != nullptr && i < script->variables.size() ? script->variables[i].c_str() : "?";
+					ImGui::Text("%s = %s", name, DataToString(var.value, var.type).c_str());
 				}
 				ImGui::EndTabItem();
 			}
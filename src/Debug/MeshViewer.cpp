@@ -230,15 +230,14 @@ void MeshViewer::Draw() noexcept
 	if (_selectedAnimation)
 	{
 		auto const& animation = animations.Handle(*_selectedAnimation);
-		ImGui::Text("%zu frames", animation->GetFrames().size());
+		ImGui::Text("%zu frames", animation->GetFrameCount());
 		ImGui::Text("Duration %u frames", animation->GetDuration());
-		ImGui::SliderInt("frame", &_selectedFrame, 0, static_cast<int>(animation->GetFrames().size() - 1));
-		if (_selectedFrame > static_cast<int>(animation->GetFrames().size()))
+		ImGui::SliderInt("frame", &_selectedFrame, 0, static_cast<int>(animation->GetFrameCount() - 1));
+		if (_selectedFrame > static_cast<int>(animation->GetFrameCount()))
 		{
-			_selectedFrame = static_cast<int>(animation->GetFrames().size()) - 1;
+			_selectedFrame = static_cast<int>(animation->GetFrameCount()) - 1;
 		}
-		ImGui::Text("Time %u, Bones %zu", animation->GetFrames()[_selectedFrame].time,
-		            animation->GetFrames()[_selectedFrame].bones.size());
+		ImGui::Text("Time %u, Bones %zu", animation->GetFrameTime(_selectedFrame), animation->GetBoneCount());
 		ImGui::Text("unknown at 0x20 = 0x%08X", animation->_unknown_0x20);
 		ImGui::Text("unknowns 0x24-0x34 =\n%.4f %.4f %.4f %.4f %.4f", animation->_unknown_0x24, animation->_unknown_0x28,
 		            animation->_unknown_0x2C, animation->_unknown_0x30, animation->_unknown_0x34);
@@ -257,13 +256,13 @@ void MeshViewer::Draw() noexcept
 	                  ImGuiChildFlags_Border);
 	uint32_t displayedAnimations = 0;
 	if (_matchBones && _selectedAnimation.has_value() &&
-	    animations.Handle(*_selectedAnimation)->GetBoneMatrices(0).size() != mesh->GetBoneMatrices().size())
+	    animations.Handle(*_selectedAnimation)->GetBoneCount() != mesh->GetBoneMatrices().size())
 	{
 		_selectedAnimation.reset();
 	}
 	animations.Each([this, &mesh, &displayedAnimations](entt::id_type id, const L3DAnim& animation) {
 		if (_filter.PassFilter(animation.GetName().c_str()) &&
-		    (!_matchBones || (animation.GetBoneMatrices(0).size() == mesh->GetBoneMatrices().size())))
+		    (!_matchBones || (animation.GetBoneCount() == mesh->GetBoneMatrices().size())))
 		{
 			displayedAnimations++;
 			if (ImGui::Selectable(animation.GetName().c_str(), _selectedAnimation == id))
@@ -342,10 +341,9 @@ void MeshViewer::Update() noexcept
 			const std::vector<uint32_t>& boneParents = mesh->GetBoneParents();
 			if (_selectedAnimation.has_value() && _matchBones)
 			{
-				const auto& frames = animations.Handle(*_selectedAnimation)->GetFrames();
-				for (uint32_t i = 0; i < frames[_selectedFrame].bones.size(); ++i)
+				const auto count = animations.Handle(*_selectedAnimation)->GetFrameBones(_selectedFrame, bones);
+				for (uint32_t i = 0; i < count; ++i)
 				{
-					bones[i] = frames[_selectedFrame].bones[i];
 					if (boneParents[i] != std::numeric_limits<uint32_t>::max())
 					{
 						bones[i] = bones[boneParents[i]] * bones[i];
@@ -70,7 +70,10 @@ void PathFinding::Draw() noexcept
 		{
 			auto& transform = registry.Get<Transform>(_selectedVillager.value());
 			auto& wallHug = registry.Get<WallHug>(_selectedVillager.value());
-			ImGui::DragFloat3("Position", glm::value_ptr(transform.position));
+			if (ImGui::DragFloat3("Position", glm::value_ptr(transform.position)))
+			{
+				registry.SetDirty(_selectedVillager.value());
+			}
 			ImGui::DragFloat2("Goal", glm::value_ptr(wallHug.goal));
 			ImGui::DragFloat("Speed", &wallHug.speed);
 		}
@@ -98,6 +101,7 @@ void PathFinding::Draw() noexcept
 				if (ImGui::Button("Execute"))
 				{
 					registry.Get<Transform>(*_selectedVillager).position = _destination;
+					registry.SetDirty(*_selectedVillager);
 				}
 				ImGui::PopItemFlag();
 				ImGui::PopStyleVar();
@@ -217,7 +221,8 @@ void PathFinding::Update() noexcept
 		if (!found)
 		{
 			auto& map = Locator::entitiesMap::value();
-			for (const auto& entity : map.GetMobileInGridCell(_handPosition))
+			// Villagers close to a cell border can overlap the neighbouring cell
+			for (const auto& entity : map.GetMobileInRadius(glm::xz(_handPosition), ecs::MapInterface::k_CellSize))
 			{
 				if (registry.AllOf<Villager>(entity))
 				{
@@ -11,8 +11,13 @@
 
 #include <cinttypes>
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include <bgfx/bgfx.h>
 #include <imgui_widget_flamegraph.h>
+#include <spdlog/fmt/fmt.h>
 
 #include "ECS/Components/Transform.h"
 #include "ECS/Components/Tree.h"
@@ -105,33 +110,54 @@ void Profiler::Draw() noexcept
 	const auto& profiler = Locator::profiler::value();
 	const auto& entry = profiler.GetEntries().at(profiler.GetEntryIndex(-1));
 
-	ImGuiWidgetFlameGraph::PlotFlame(
-	    "CPU",
-	    [](float* startTimestamp, float* endTimestamp, ImU8* level, const char** caption, const void* data, int idx) -> void {
-		    const auto* entry = reinterpret_cast<const openblack::Profiler::Entry*>(data);
-		    const auto& stage = entry->stages.at(idx);
-		    if (startTimestamp != nullptr)
-		    {
-			    const std::chrono::duration<float, std::milli> fltStart = stage.start - entry->frameStart;
-			    *startTimestamp = fltStart.count();
-		    }
-		    if (endTimestamp != nullptr)
-		    {
-			    *endTimestamp = stage.end.time_since_epoch().count() / 1e6f;
-
-			    const std::chrono::duration<float, std::milli> fltEnd = stage.end - entry->frameStart;
-			    *endTimestamp = fltEnd.count();
-		    }
-		    if (level != nullptr)
-		    {
-			    *level = stage.level;
-		    }
-		    if (caption != nullptr)
-		    {
-			    *caption = openblack::Profiler::k_StageNames.at(idx).data();
-		    }
-	    },
-	    &entry, static_cast<uint8_t>(openblack::Profiler::Stage::_count), 0, "Main Thread", 0, FLT_MAX, ImVec2(width, 0));
+	// One flame graph per thread which ran stages this frame
+	struct Lane
+	{
+		const openblack::Profiler::Entry* entry;
+		std::vector<uint8_t> stages;
+	};
+	std::map<uint32_t, Lane> lanes;
+	for (uint8_t i = 0; i < entry.stages.size(); ++i)
+	{
+		const auto& stage = entry.stages.at(i);
+		if (stage.finalized && stage.start >= entry.frameStart)
+		{
+			auto& lane = lanes.try_emplace(stage.lane, Lane {&entry, {}}).first->second;
+			lane.stages.push_back(i);
+		}
+	}
+	for (const auto& [laneIndex, lane] : lanes)
+	{
+		const auto label = laneIndex == 0 ? std::string("CPU") : fmt::format("Worker {}", laneIndex);
+		const auto overlay = laneIndex == 0 ? std::string("Main Thread") : fmt::format("Worker Thread {}", laneIndex);
+		ImGuiWidgetFlameGraph::PlotFlame(
+		    label.c_str(),
+		    [](float* startTimestamp, float* endTimestamp, ImU8* level, const char** caption, const void* data,
+		       int idx) -> void {
+			    const auto* lane = reinterpret_cast<const Lane*>(data);
+			    const auto stageIndex = lane->stages.at(idx);
+			    const auto& stage = lane->entry->stages.at(stageIndex);
+			    if (startTimestamp != nullptr)
+			    {
+				    const std::chrono::duration<float, std::milli> fltStart = stage.start - lane->entry->frameStart;
+				    *startTimestamp = fltStart.count();
+			    }
+			    if (endTimestamp != nullptr)
+			    {
+				    const std::chrono::duration<float, std::milli> fltEnd = stage.end - lane->entry->frameStart;
+				    *endTimestamp = fltEnd.count();
+			    }
+			    if (level != nullptr)
+			    {
+				    *level = stage.level;
+			    }
+			    if (caption != nullptr)
+			    {
+				    *caption = openblack::Profiler::k_StageNames.at(stageIndex).data();
+			    }
+		    },
+		    &lane, static_cast<int>(lane.stages.size()), 0, overlay.c_str(), 0, FLT_MAX, ImVec2(width, 0));
+	}
 
 	ImGuiWidgetFlameGraph::PlotFlame(
 	    "GPU",
@@ -173,8 +199,16 @@ void Profiler::Draw() noexcept
 		{
 			std::chrono::duration<float, std::milli> const duration = stage.end - stage.start;
 			ImGui::SetCursorPosX(cursorX + indentSize * stage.level);
-			ImGui::Text("    %s: %0.3f", openblack::Profiler::k_StageNames.at(i).data(), duration.count());
-			if (stage.level == 0)
+			if (stage.lane == 0)
+			{
+				ImGui::Text("    %s: %0.3f", openblack::Profiler::k_StageNames.at(i).data(), duration.count());
+			}
+			else
+			{
+				ImGui::Text("    %s: %0.3f (worker %u)", openblack::Profiler::k_StageNames.at(i).data(), duration.count(),
+				            stage.lane);
+			}
+			if (stage.level == 0 && stage.lane == 0)
 			{
 				frameDuration -= duration;
 			}
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "ResourcesViewer.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <imgui.h>
+
+#include "Locator.h"
+#include "Resources/ResourcesInterface.h"
+
+using namespace openblack;
+using namespace openblack::debug::gui;
+
+namespace
+{
+constexpr float k_BytesPerMiB = 1024.0f * 1024.0f;
+
+template <typename Manager>
+void DrawRow(const char* name, Manager& manager, bool evictable)
+{
+	ImGui::Text("%s", name);
+	ImGui::NextColumn();
+	ImGui::Text("%zu / %zu", static_cast<size_t>(manager.Size()), manager.GetRegisteredCount());
+	ImGui::NextColumn();
+	ImGui::Text("%.2f", static_cast<float>(manager.GetResidentBytes()) / k_BytesPerMiB);
+	ImGui::NextColumn();
+	if (evictable)
+	{
+		auto budget = static_cast<uint32_t>(manager.GetMemoryBudget() >> 20);
+		ImGui::PushID(name);
+		ImGui::SetNextItemWidth(-1.0f);
+		if (ImGui::InputScalar("##budget", ImGuiDataType_U32, &budget))
+		{
+			manager.SetMemoryBudget(static_cast<size_t>(budget) << 20);
+		}
+		ImGui::PopID();
+	}
+	else
+	{
+		ImGui::Text("-");
+	}
+	ImGui::NextColumn();
+}
+} // namespace
+
+ResourcesViewer::ResourcesViewer() noexcept
+    : Window("Resources", ImVec2(500.0f, 250.0f))
+{
+}
+
+void ResourcesViewer::Draw() noexcept
+{
+	auto& resources = Locator::resources::value();
+
+	ImGui::Columns(4, "resources");
+	ImGui::Text("Type");
+	ImGui::NextColumn();
+	ImGui::Text("Loaded / Registered");
+	ImGui::NextColumn();
+	ImGui::Text("MiB");
+	ImGui::NextColumn();
+	ImGui::Text("Budget MiB (0 = none)");
+	ImGui::NextColumn();
+	ImGui::Separator();
+
+	DrawRow("Meshes", resources.GetMeshes(), true);
+	DrawRow("Textures", resources.GetTextures(), true);
+	DrawRow("Animations", resources.GetAnimations(), true);
+	DrawRow("Sounds", resources.GetSounds(), false);
+	DrawRow("Levels", resources.GetLevels(), false);
+	DrawRow("Creature Minds", resources.GetCreatureMinds(), false);
+	DrawRow("Glows", resources.GetGlows(), false);
+
+	ImGui::Columns(1);
+}
+
+void ResourcesViewer::Update() noexcept {}
+
+void ResourcesViewer::ProcessEventOpen([[maybe_unused]] const SDL_Event& event) noexcept {}
+
+void ResourcesViewer::ProcessEventAlways([[maybe_unused]] const SDL_Event& event) noexcept {}
@@ -0,0 +1,28 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include "Window.h"
+
+namespace openblack::debug::gui
+{
+/// Loaded and registered resources per type and the memory they use
+class ResourcesViewer final: public Window
+{
+public:
+	ResourcesViewer() noexcept;
+
+protected:
+	void Draw() noexcept override;
+	void Update() noexcept override;
+	void ProcessEventOpen(const SDL_Event& event) noexcept override;
+	void ProcessEventAlways(const SDL_Event& event) noexcept override;
+};
+} // namespace openblack::debug::gui
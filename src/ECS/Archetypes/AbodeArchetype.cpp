@@ -9,6 +9,8 @@
 
 #include "AbodeArchetype.h"
 
+#include <vector>
+
 #include <glm/gtx/euler_angles.hpp>
 #include <spdlog/spdlog.h>
 
@@ -59,30 +61,8 @@ void AddStoragePitComponents(entt::entity entity, const Mesh& pitMesh, const GAb
 	pit.foodPile = PotArchetype::Create(position + translation, yAngleRadians, info.potForResourceFood, foodAmount);
 }
 
-entt::entity AbodeArchetype::Create(uint32_t townId, const glm::vec3& position, AbodeInfo type, float yAngleRadians,
-                                    float scale, uint32_t foodAmount, uint32_t woodAmount)
+bool MorphsWithTerrain(const GAbodeInfo& info)
 {
-	auto& registry = Locator::entitiesRegistry::value();
-
-	// If there is no town, assign to closest
-	if (registry.Context().towns.find(townId) == registry.Context().towns.end())
-	{
-		SPDLOG_LOGGER_WARN(spdlog::get("scripting"), "Function {} has invalid Town ({}).", __func__, townId);
-		const auto town = Locator::townSystem::value().FindClosestTown(position);
-		if (town != entt::null)
-		{
-			townId = registry.Get<Town>(town).id;
-		}
-		else
-		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "Function {} has could not find closest town.", __func__, townId);
-			return entt::null;
-		}
-	}
-
-	const auto entity = registry.Create();
-
-	const auto& info = Locator::infoConstants::value().abode.at(static_cast<size_t>(type));
 	bool morphsWithTerrain = false;
 	morphsWithTerrain |= info.abodeType == AbodeType::Graveyard;
 	morphsWithTerrain |= info.abodeType == AbodeType::StoragePit;
@@ -100,29 +80,93 @@ entt::entity AbodeArchetype::Create(uint32_t townId, const glm::vec3& position,
 	morphsWithTerrain |= info.abodeType == AbodeType::FootballPitch;
 	morphsWithTerrain |= info.abodeType == AbodeType::TownCentre;
 	morphsWithTerrain |= info.abodeType == AbodeType::Field;
+	return morphsWithTerrain;
+}
 
-	const auto& transform =
-	    registry.Assign<Transform>(entity, position, glm::mat3(glm::eulerAngleY(-yAngleRadians)), glm::vec3(scale));
-	registry.Assign<Abode>(entity, info.abodeNumber, townId, foodAmount, woodAmount);
-	auto resourceId = resources::MeshIdToResourceId(info.meshId);
-	const auto& mesh = registry.Assign<Mesh>(entity, resourceId, static_cast<int8_t>(0), static_cast<int8_t>(0));
-	if (morphsWithTerrain)
+entt::entity AbodeArchetype::Create(uint32_t townId, const glm::vec3& position, AbodeInfo type, float yAngleRadians,
+                                    float scale, uint32_t foodAmount, uint32_t woodAmount)
+{
+	const Parameters parameters {townId, position, type, yAngleRadians, scale, foodAmount, woodAmount};
+	return Create(std::span(&parameters, 1)).front();
+}
+
+std::vector<entt::entity> AbodeArchetype::Create(std::span<const Parameters> batch)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto& infos = Locator::infoConstants::value().abode;
+	const auto& towns = registry.Context().towns;
+
+	// Index in the batch of each abode which is created
+	std::vector<size_t> created;
+	std::vector<Transform> transforms;
+	std::vector<Abode> abodes;
+	std::vector<Mesh> meshes;
+	std::vector<Fixed> fixeds;
+	created.reserve(batch.size());
+	transforms.reserve(batch.size());
+	abodes.reserve(batch.size());
+	meshes.reserve(batch.size());
+	fixeds.reserve(batch.size());
+	for (size_t i = 0; i < batch.size(); ++i)
 	{
-		registry.Assign<MorphWithTerrain>(entity);
+		const auto& parameters = batch[i];
+		auto townId = parameters.townId;
+
+		// If there is no town, assign to closest
+		if (towns.find(townId) == towns.end())
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("scripting"), "Function {} has invalid Town ({}).", __func__, townId);
+			const auto town = Locator::townSystem::value().FindClosestTown(parameters.position);
+			if (town == entt::null)
+			{
+				SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "Function {} has could not find closest town.", __func__);
+				continue;
+			}
+			townId = registry.Get<Town>(town).id;
+		}
+
+		const auto& info = infos.at(static_cast<size_t>(parameters.type));
+		created.push_back(i);
+		const auto& transform = transforms.emplace_back(Transform {
+		    parameters.position, glm::mat3(glm::eulerAngleY(-parameters.yAngleRadians)), glm::vec3(parameters.scale)});
+		abodes.emplace_back(Abode {info.abodeNumber, townId, parameters.foodAmount, parameters.woodAmount, {}});
+		meshes.emplace_back(Mesh {resources::MeshIdToResourceId(info.meshId), static_cast<int8_t>(0), static_cast<int8_t>(0)});
+		// Create Fixed component with a 2d bounding circle
+		const auto [point, radius] = GetFixedObstacleBoundingCircle(info.meshId, transform);
+		fixeds.emplace_back(point, radius);
 	}
 
-	// Create Fixed component with a 2d bounding circle
-	const auto [point, radius] = GetFixedObstacleBoundingCircle(info.meshId, transform);
-	registry.Assign<Fixed>(entity, point, radius);
+	std::vector<entt::entity> entities(created.size());
+	registry.Reserve<Transform, Abode, Mesh, Fixed>(created.size());
+	registry.Create(entities.begin(), entities.end());
+	registry.Insert<Transform>(entities.begin(), entities.end(), transforms.begin());
+	registry.Insert<Abode>(entities.begin(), entities.end(), abodes.begin());
+	registry.Insert<Mesh>(entities.begin(), entities.end(), meshes.begin());
+	registry.Insert<Fixed>(entities.begin(), entities.end(), fixeds.begin());
 
-	switch (info.abodeType)
+	std::vector<entt::entity> morphing;
+	for (size_t j = 0; j < entities.size(); ++j)
 	{
-	case AbodeType::StoragePit:
-		AddStoragePitComponents(entity, mesh, info, position, yAngleRadians, foodAmount, woodAmount);
-		break;
-	default:
-		break;
+		const auto& parameters = batch[created[j]];
+		const auto& info = infos.at(static_cast<size_t>(parameters.type));
+		if (MorphsWithTerrain(info))
+		{
+			morphing.push_back(entities[j]);
+		}
+		// Storage pits are rare and create their pots, they are completed one by one
+		if (info.abodeType == AbodeType::StoragePit)
+		{
+			AddStoragePitComponents(entities[j], meshes[j], info, parameters.position, parameters.yAngleRadians,
+			                        parameters.foodAmount, parameters.woodAmount);
+		}
 	}
+	registry.Insert<MorphWithTerrain>(morphing.begin(), morphing.end());
+	registry.SetDirty(entities.begin(), entities.end());
 
-	return entity;
+	std::vector<entt::entity> result(batch.size(), entt::null);
+	for (size_t j = 0; j < entities.size(); ++j)
+	{
+		result[created[j]] = entities[j];
+	}
+	return result;
 }
@@ -9,8 +9,11 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
+
 #include <entt/fwd.hpp>
-#include <glm/fwd.hpp>
+#include <glm/vec3.hpp>
 
 #include "Enums.h"
 
@@ -19,8 +22,22 @@ namespace openblack::ecs::archetypes
 class AbodeArchetype
 {
 public:
+	struct Parameters
+	{
+		uint32_t townId;
+		glm::vec3 position;
+		AbodeInfo type;
+		float yAngleRadians;
+		float scale;
+		uint32_t foodAmount;
+		uint32_t woodAmount;
+	};
+
 	static entt::entity Create(uint32_t townId, const glm::vec3& position, AbodeInfo type, float yAngleRadians, float scale,
 	                           uint32_t foodAmount, uint32_t woodAmount);
+	/// Create all entities in one batch, the registry is only marked dirty once. The single entity overload is a batch of one.
+	/// Abodes which have no town to belong to are not created, their entity is entt::null.
+	static std::vector<entt::entity> Create(std::span<const Parameters> batch);
 	AbodeArchetype() = delete;
 };
 } // namespace openblack::ecs::archetypes
@@ -9,6 +9,8 @@
 
 #include "BigForestArchetype.h"
 
+#include <vector>
+
 #include <glm/gtx/euler_angles.hpp>
 
 #include "ECS/Components/Fixed.h"
@@ -26,22 +28,45 @@ using namespace openblack;
 using namespace openblack::ecs::archetypes;
 using namespace openblack::ecs::components;
 
-entt::entity BigForestArchetype::Create(const glm::vec3& position, BigForestInfo type, [[maybe_unused]] uint32_t unknown,
-                                        float yAngleRadians, float scale)
+entt::entity BigForestArchetype::Create(const glm::vec3& position, BigForestInfo type, uint32_t unknown, float yAngleRadians,
+                                        float scale)
+{
+	const Parameters parameters {position, type, unknown, yAngleRadians, scale};
+	return Create(std::span(&parameters, 1)).front();
+}
+
+std::vector<entt::entity> BigForestArchetype::Create(std::span<const Parameters> batch)
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	const auto entity = registry.Create();
+	const auto& infos = Locator::infoConstants::value().bigForest;
+
+	std::vector<Transform> transforms;
+	std::vector<Fixed> fixeds;
+	std::vector<Mesh> meshes;
+	transforms.reserve(batch.size());
+	fixeds.reserve(batch.size());
+	meshes.reserve(batch.size());
+	for (const auto& parameters : batch)
+	{
+		const auto& info = infos.at(static_cast<size_t>(parameters.type));
 
-	const auto& info = Locator::infoConstants::value().bigForest.at(static_cast<size_t>(type));
+		const auto& transform = transforms.emplace_back(Transform {
+		    parameters.position, glm::mat3(glm::eulerAngleY(-parameters.yAngleRadians)), glm::vec3(parameters.scale)});
+		const auto [point, radius] = GetFixedObstacleBoundingCircle(info.meshId, transform);
+		fixeds.emplace_back(point, radius);
+		meshes.emplace_back(Mesh {resources::MeshIdToResourceId(info.meshId), static_cast<int8_t>(0), static_cast<int8_t>(1)});
+	}
 
-	const auto& transform = registry.Assign<Transform>(entity, position, glm::eulerAngleY(-yAngleRadians), glm::vec3(scale));
-	const auto [point, radius] = GetFixedObstacleBoundingCircle(info.meshId, transform);
-	registry.Assign<Fixed>(entity, point, radius);
-	registry.Assign<Forest>(entity);
-	registry.Assign<BigForest>(entity);
-	registry.Assign<MorphWithTerrain>(entity);
-	const auto resourceId = resources::MeshIdToResourceId(info.meshId);
-	registry.Assign<Mesh>(entity, resourceId, static_cast<int8_t>(0), static_cast<int8_t>(1));
+	std::vector<entt::entity> entities(batch.size());
+	registry.Reserve<Transform, Fixed, Forest, BigForest, MorphWithTerrain, Mesh>(batch.size());
+	registry.Create(entities.begin(), entities.end());
+	registry.Insert<Transform>(entities.begin(), entities.end(), transforms.begin());
+	registry.Insert<Fixed>(entities.begin(), entities.end(), fixeds.begin());
+	registry.Insert<Forest>(entities.begin(), entities.end());
+	registry.Insert<BigForest>(entities.begin(), entities.end());
+	registry.Insert<MorphWithTerrain>(entities.begin(), entities.end());
+	registry.Insert<Mesh>(entities.begin(), entities.end(), meshes.begin());
+	registry.SetDirty(entities.begin(), entities.end());
 
-	return entity;
+	return entities;
 }
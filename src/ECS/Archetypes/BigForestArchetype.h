@@ -9,8 +9,11 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
+
 #include <entt/fwd.hpp>
-#include <glm/fwd.hpp>
+#include <glm/vec3.hpp>
 
 #include "Enums.h"
 
@@ -19,8 +22,19 @@ namespace openblack::ecs::archetypes
 class BigForestArchetype
 {
 public:
+	struct Parameters
+	{
+		glm::vec3 position;
+		BigForestInfo type;
+		uint32_t unknown;
+		float yAngleRadians;
+		float scale;
+	};
+
 	static entt::entity Create(const glm::vec3& position, BigForestInfo type, uint32_t unknown, float yAngleRadians,
 	                           float scale);
+	/// Create all entities in one batch, the registry is only marked dirty once. The single entity overload is a batch of one.
+	static std::vector<entt::entity> Create(std::span<const Parameters> batch);
 	BigForestArchetype() = delete;
 };
 } // namespace openblack::ecs::archetypes
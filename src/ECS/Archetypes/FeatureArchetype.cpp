@@ -9,6 +9,8 @@
 
 #include "FeatureArchetype.h"
 
+#include <vector>
+
 #include <BulletCollision/CollisionShapes/btConvexShape.h>
 #include <glm/gtx/euler_angles.hpp>
 
@@ -30,34 +32,67 @@ using namespace openblack::ecs::archetypes;
 using namespace openblack::ecs::components;
 
 entt::entity FeatureArchetype::Create(const glm::vec3& position, FeatureInfo type, float yAngleRadians, float scale)
+{
+	const Parameters parameters {position, type, yAngleRadians, scale};
+	return Create(std::span(&parameters, 1)).front();
+}
+
+std::vector<entt::entity> FeatureArchetype::Create(std::span<const Parameters> batch)
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	const auto entity = registry.Create();
+	const auto& infos = Locator::infoConstants::value().feature;
 
-	const auto& info = Locator::infoConstants::value().feature.at(static_cast<size_t>(type));
+	std::vector<Transform> transforms;
+	std::vector<Fixed> fixeds;
+	std::vector<Feature> features;
+	std::vector<Mesh> meshes;
+	transforms.reserve(batch.size());
+	fixeds.reserve(batch.size());
+	features.reserve(batch.size());
+	meshes.reserve(batch.size());
+	for (const auto& parameters : batch)
+	{
+		const auto& info = infos.at(static_cast<size_t>(parameters.type));
+
+		const auto& transform = transforms.emplace_back(Transform {
+		    parameters.position, glm::mat3(glm::eulerAngleY(-parameters.yAngleRadians)), glm::vec3(parameters.scale)});
+		const auto [point, radius] = GetFixedObstacleBoundingCircle(info.meshId, transform);
+		fixeds.emplace_back(point, radius);
+		features.emplace_back(Feature {parameters.type});
+		meshes.emplace_back(Mesh {resources::MeshIdToResourceId(info.meshId), static_cast<int8_t>(0), static_cast<int8_t>(1)});
+	}
 
-	const auto& transform = registry.Assign<Transform>(entity, position, glm::eulerAngleY(-yAngleRadians), glm::vec3(scale));
-	const auto [point, radius] = GetFixedObstacleBoundingCircle(info.meshId, transform);
-	registry.Assign<Fixed>(entity, point, radius);
-	registry.Assign<Feature>(entity, type);
-	const auto resourceId = resources::MeshIdToResourceId(info.meshId);
-	registry.Assign<Mesh>(entity, resourceId, static_cast<int8_t>(0), static_cast<int8_t>(1));
+	std::vector<entt::entity> entities(batch.size());
+	registry.Reserve<Transform, Fixed, Feature, Mesh>(batch.size());
+	registry.Create(entities.begin(), entities.end());
+	registry.Insert<Transform>(entities.begin(), entities.end(), transforms.begin());
+	registry.Insert<Fixed>(entities.begin(), entities.end(), fixeds.begin());
+	registry.Insert<Feature>(entities.begin(), entities.end(), features.begin());
+	registry.Insert<Mesh>(entities.begin(), entities.end(), meshes.begin());
 
-	auto l3dMesh = Locator::resources::value().GetMeshes().Handle(resourceId);
-	if (l3dMesh->HasPhysicsMesh())
+	// Rigid bodies are only for some features and can not be copied into place
+	auto& meshManager = Locator::resources::value().GetMeshes();
+	for (size_t i = 0; i < entities.size(); ++i)
 	{
+		auto l3dMesh = meshManager.Handle(meshes[i].id);
+		if (!l3dMesh->HasPhysicsMesh())
+		{
+			continue;
+		}
 		auto& shape = l3dMesh->GetPhysicsMesh();
 		btVector3 bodyInertia(0, 0, 0);
 		shape.calculateLocalInertia(l3dMesh->GetMass(), bodyInertia);
 
 		btTransform startTransform;
 		startTransform.setIdentity();
-		startTransform.setOrigin(btVector3(transform.position.x, transform.position.y, transform.position.z));
+		const auto& position = transforms[i].position;
+		startTransform.setOrigin(btVector3(position.x, position.y, position.z));
 
 		btRigidBody::btRigidBodyConstructionInfo rbInfo(l3dMesh->GetMass(), nullptr, &shape, bodyInertia);
 
-		registry.Assign<RigidBody>(entity, rbInfo, startTransform);
+		registry.Assign<RigidBody>(entities[i], l3dMesh, rbInfo, startTransform);
 	}
+	registry.SetDirty(entities.begin(), entities.end());
 
-	return entity;
+	return entities;
 }
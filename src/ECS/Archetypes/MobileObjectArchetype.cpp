@@ -9,6 +9,8 @@
 
 #include "MobileObjectArchetype.h"
 
+#include <vector>
+
 #include <glm/gtx/euler_angles.hpp>
 
 #include "AbodeArchetype.h"
@@ -25,17 +27,40 @@ using namespace openblack::ecs::archetypes;
 using namespace openblack::ecs::components;
 
 entt::entity MobileObjectArchetype::Create(const glm::vec3& position, MobileObjectInfo type, float yAngleRadians, float scale)
+{
+	const Parameters parameters {position, type, yAngleRadians, scale};
+	return Create(std::span(&parameters, 1)).front();
+}
+
+std::vector<entt::entity> MobileObjectArchetype::Create(std::span<const Parameters> batch)
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	const auto entity = registry.Create();
+	const auto& infos = Locator::infoConstants::value().mobileObject;
+
+	std::vector<Transform> transforms;
+	std::vector<MobileObject> mobileObjects;
+	std::vector<Mesh> meshes;
+	transforms.reserve(batch.size());
+	mobileObjects.reserve(batch.size());
+	meshes.reserve(batch.size());
+	for (const auto& parameters : batch)
+	{
+		const auto& info = infos.at(static_cast<size_t>(parameters.type));
 
-	const auto& info = Locator::infoConstants::value().mobileObject.at(static_cast<size_t>(type));
+		transforms.emplace_back(Transform {parameters.position, glm::mat3(glm::eulerAngleY(-parameters.yAngleRadians)),
+		                                   glm::vec3(parameters.scale)});
+		mobileObjects.emplace_back(MobileObject {parameters.type});
+		meshes.emplace_back(Mesh {resources::MeshIdToResourceId(info.meshId), static_cast<int8_t>(0), static_cast<int8_t>(1)});
+	}
 
-	registry.Assign<Transform>(entity, position, glm::eulerAngleY(-yAngleRadians), glm::vec3(scale));
-	registry.Assign<Mobile>(entity);
-	registry.Assign<MobileObject>(entity, type);
-	const auto resourceId = resources::MeshIdToResourceId(info.meshId);
-	registry.Assign<Mesh>(entity, resourceId, static_cast<int8_t>(0), static_cast<int8_t>(1));
+	std::vector<entt::entity> entities(batch.size());
+	registry.Reserve<Transform, Mobile, MobileObject, Mesh>(batch.size());
+	registry.Create(entities.begin(), entities.end());
+	registry.Insert<Transform>(entities.begin(), entities.end(), transforms.begin());
+	registry.Insert<Mobile>(entities.begin(), entities.end());
+	registry.Insert<MobileObject>(entities.begin(), entities.end(), mobileObjects.begin());
+	registry.Insert<Mesh>(entities.begin(), entities.end(), meshes.begin());
+	registry.SetDirty(entities.begin(), entities.end());
 
-	return entity;
+	return entities;
 }
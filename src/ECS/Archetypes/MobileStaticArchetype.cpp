@@ -9,6 +9,8 @@
 
 #include "MobileStaticArchetype.h"
 
+#include <vector>
+
 #include <glm/gtx/euler_angles.hpp>
 
 #include "AbodeArchetype.h"
@@ -26,20 +28,43 @@ using namespace openblack::ecs::components;
 
 entt::entity MobileStaticArchetype::Create(const glm::vec3& position, MobileStaticInfo type, float altitude,
                                            float xAngleRadians, float yAngleRadians, float zAngleRadians, float scale)
+{
+	const Parameters parameters {position, type, altitude, xAngleRadians, yAngleRadians, zAngleRadians, scale};
+	return Create(std::span(&parameters, 1)).front();
+}
+
+std::vector<entt::entity> MobileStaticArchetype::Create(std::span<const Parameters> batch)
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	const auto entity = registry.Create();
+	const auto& infos = Locator::infoConstants::value().mobileStatic;
 
-	const auto& info = Locator::infoConstants::value().mobileStatic.at(static_cast<size_t>(type));
+	std::vector<Transform> transforms;
+	std::vector<MobileStatic> mobileStatics;
+	std::vector<Mesh> meshes;
+	transforms.reserve(batch.size());
+	mobileStatics.reserve(batch.size());
+	meshes.reserve(batch.size());
+	for (const auto& parameters : batch)
+	{
+		const auto& info = infos.at(static_cast<size_t>(parameters.type));
 
-	glm::vec3 offset(0.0f, altitude, 0.0f);
+		const glm::vec3 offset(0.0f, parameters.altitude, 0.0f);
+		transforms.emplace_back(Transform {parameters.position + offset,
+		                                   glm::mat3(glm::eulerAngleXYZ(-parameters.xAngleRadians, -parameters.yAngleRadians,
+		                                                                -parameters.zAngleRadians)),
+		                                   glm::vec3(parameters.scale)});
+		mobileStatics.emplace_back(MobileStatic {parameters.type});
+		meshes.emplace_back(Mesh {resources::MeshIdToResourceId(info.meshId), static_cast<int8_t>(0), static_cast<int8_t>(1)});
+	}
 
-	registry.Assign<Transform>(entity, position + offset, glm::eulerAngleXYZ(-xAngleRadians, -yAngleRadians, -zAngleRadians),
-	                           glm::vec3(scale));
-	registry.Assign<Mobile>(entity);
-	registry.Assign<MobileStatic>(entity, type);
-	const auto resourceId = resources::MeshIdToResourceId(info.meshId);
-	registry.Assign<Mesh>(entity, resourceId, static_cast<int8_t>(0), static_cast<int8_t>(1));
+	std::vector<entt::entity> entities(batch.size());
+	registry.Reserve<Transform, Mobile, MobileStatic, Mesh>(batch.size());
+	registry.Create(entities.begin(), entities.end());
+	registry.Insert<Transform>(entities.begin(), entities.end(), transforms.begin());
+	registry.Insert<Mobile>(entities.begin(), entities.end());
+	registry.Insert<MobileStatic>(entities.begin(), entities.end(), mobileStatics.begin());
+	registry.Insert<Mesh>(entities.begin(), entities.end(), meshes.begin());
+	registry.SetDirty(entities.begin(), entities.end());
 
-	return entity;
+	return entities;
 }
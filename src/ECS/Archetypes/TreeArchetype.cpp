@@ -9,6 +9,8 @@
 
 #include "TreeArchetype.h"
 
+#include <vector>
+
 #include <glm/gtx/euler_angles.hpp>
 
 #include "ECS/Components/Fixed.h"
@@ -25,20 +27,46 @@ using namespace openblack;
 using namespace openblack::ecs::archetypes;
 using namespace openblack::ecs::components;
 
-entt::entity TreeArchetype::Create([[maybe_unused]] uint32_t forestId, const glm::vec3& position, TreeInfo type,
-                                   [[maybe_unused]] bool isNonScenic, float yAngleRadians, float maxSize, float scale)
+entt::entity TreeArchetype::Create(uint32_t forestId, const glm::vec3& position, TreeInfo type, bool isNonScenic,
+                                   float yAngleRadians, float maxSize, float scale)
+{
+	const Parameters parameters {forestId, position, type, isNonScenic, yAngleRadians, maxSize, scale};
+	return Create(std::span(&parameters, 1)).front();
+}
+
+std::vector<entt::entity> TreeArchetype::Create(std::span<const Parameters> batch)
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	const auto entity = registry.Create();
+	const auto& infos = Locator::infoConstants::value().tree;
+
+	std::vector<Transform> transforms;
+	std::vector<Fixed> fixeds;
+	std::vector<Tree> trees;
+	std::vector<Mesh> meshes;
+	transforms.reserve(batch.size());
+	fixeds.reserve(batch.size());
+	trees.reserve(batch.size());
+	meshes.reserve(batch.size());
+	for (const auto& parameters : batch)
+	{
+		const auto& info = infos.at(static_cast<size_t>(parameters.type));
 
-	const auto& info = Locator::infoConstants::value().tree.at(static_cast<size_t>(type));
+		const auto& transform = transforms.emplace_back(Transform {
+		    parameters.position, glm::mat3(glm::eulerAngleY(-parameters.yAngleRadians)), glm::vec3(parameters.scale)});
+		const auto [point, radius] = GetFixedObstacleBoundingCircle(info.normal, transform);
+		fixeds.emplace_back(point, radius);
+		trees.emplace_back(Tree {parameters.type, parameters.maxSize});
+		meshes.emplace_back(Mesh {resources::MeshIdToResourceId(info.normal), static_cast<int8_t>(0), static_cast<int8_t>(-1)});
+	}
 
-	const auto& transform = registry.Assign<Transform>(entity, position, glm::eulerAngleY(-yAngleRadians), glm::vec3(scale));
-	const auto [point, radius] = GetFixedObstacleBoundingCircle(info.normal, transform);
-	registry.Assign<Fixed>(entity, point, radius);
-	registry.Assign<Tree>(entity, type, maxSize);
-	const auto resourceId = resources::MeshIdToResourceId(info.normal);
-	registry.Assign<Mesh>(entity, resourceId, static_cast<int8_t>(0), static_cast<int8_t>(-1));
+	std::vector<entt::entity> entities(batch.size());
+	registry.Reserve<Transform, Fixed, Tree, Mesh>(batch.size());
+	registry.Create(entities.begin(), entities.end());
+	registry.Insert<Transform>(entities.begin(), entities.end(), transforms.begin());
+	registry.Insert<Fixed>(entities.begin(), entities.end(), fixeds.begin());
+	registry.Insert<Tree>(entities.begin(), entities.end(), trees.begin());
+	registry.Insert<Mesh>(entities.begin(), entities.end(), meshes.begin());
+	registry.SetDirty(entities.begin(), entities.end());
 
-	return entity;
+	return entities;
 }
@@ -9,8 +9,11 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
+
 #include <entt/fwd.hpp>
-#include <glm/fwd.hpp>
+#include <glm/vec3.hpp>
 
 #include "Enums.h"
 
@@ -19,8 +22,21 @@ namespace openblack::ecs::archetypes
 class TreeArchetype
 {
 public:
+	struct Parameters
+	{
+		uint32_t forestId;
+		glm::vec3 position;
+		TreeInfo type;
+		bool isNonScenic;
+		float yAngleRadians;
+		float maxSize;
+		float scale;
+	};
+
 	static entt::entity Create(uint32_t forestId, const glm::vec3& position, TreeInfo type, bool isNonScenic,
 	                           float yAngleRadians, float maxSize, float scale);
+	/// Create all entities in one batch, the registry is only marked dirty once. The single entity overload is a batch of one.
+	static std::vector<entt::entity> Create(std::span<const Parameters> batch);
 	TreeArchetype() = delete;
 };
 } // namespace openblack::ecs::archetypes
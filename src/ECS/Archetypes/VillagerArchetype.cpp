@@ -13,6 +13,7 @@
 #include <glm/vec3.hpp>
 
 #include "Common/RandomNumberManager.h"
+#include "ECS/Components/Animation.h"
 #include "ECS/Components/LivingAction.h"
 #include "ECS/Components/Mesh.h"
 #include "ECS/Components/Mobile.h"
@@ -60,6 +61,9 @@ entt::entity VillagerArchetype::Create([[maybe_unused]] const glm::vec3& abodePo
 	registry.Assign<WallHug>(entity, glm::vec2(), glm::vec2(), GetSpeedStateSpeed(info.speedGroup.speedDefault));
 	const auto resourceId = resources::MeshIdToResourceId(info.highDetail);
 	registry.Assign<Mesh>(entity, resourceId, static_cast<int8_t>(0), static_cast<int8_t>(0));
+	// Stand idle until actions pick their own animation, start at a random frame so the villagers don't move in step
+	registry.Assign<Animation>(entity, resources::AnimIdToResourceId(AnimId::PStand),
+	                           static_cast<float>(Locator::rng::value().NextValue<uint16_t>(0, 1000)));
 	auto turnsSinceStateChange = Locator::rng::value().NextValue<uint16_t>(1, 500);
 	registry.Assign<LivingAction>(entity, VillagerStates::Created, turnsSinceStateChange);
 
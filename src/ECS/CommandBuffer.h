@@ -0,0 +1,219 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <limits>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <entt/core/type_info.hpp>
+#include <entt/entity/entity.hpp>
+#include <entt/entity/registry.hpp>
+
+namespace openblack::ecs
+{
+
+/// Structural changes recorded for later, to be played back with \ref Registry::Playback.
+/// Recording does not touch the registry so it is safe while iterating or from worker threads, as long as each thread
+/// records into its own buffer. Per-thread buffers can be merged in a deterministic order with \ref Append.
+/// Commands are fixed-size records. Arguments of up to \ref k_MaxArgumentsSize bytes are copied into the command itself,
+/// larger ones into an arena owned by the buffer which the command refers to.
+/// Arguments are copied as bytes so they must be trivially copyable: components owning memory (std::vector, std::string,
+/// ...) can't be recorded and need to be assigned on the registry after playback.
+class CommandBuffer
+{
+public:
+	static constexpr size_t k_MaxArgumentsSize = 32;
+
+	/// Create an entity with the given components on playback. Components must be trivially copyable.
+	template <typename... Components>
+	void Create(Components... components)
+	{
+		Record<Components...>(Kind::Create, 0, entt::null, &ApplyCreate<Components...>, components...);
+	}
+
+	void Destroy(entt::entity entity) { Record<>(Kind::Destroy, 0, entity, nullptr); }
+
+	template <typename Component, typename... Args>
+	void Assign(entt::entity entity, Args... args)
+	{
+		Record<Args...>(Kind::Component, entt::type_hash<Component>::value(), entity, &ApplyAssign<Component, Args...>,
+		                args...);
+	}
+
+	template <typename Component, typename... Args>
+	void AssignOrReplace(entt::entity entity, Args... args)
+	{
+		Record<Args...>(Kind::Component, entt::type_hash<Component>::value(), entity,
+		                &ApplyAssignOrReplace<Component, Args...>, args...);
+	}
+
+	template <typename... Components>
+	void Remove(entt::entity entity)
+	{
+		(Record<>(Kind::Component, entt::type_hash<Components>::value(), entity, &ApplyRemove<Components>), ...);
+	}
+
+	template <typename After, typename Before, typename... Args>
+	void SwapComponents(entt::entity entity, Args... args)
+	{
+		Remove<Before>(entity);
+		Assign<After>(entity, args...);
+	}
+
+	/// Mark an entity as dirty on playback, for changes made to its components in place
+	void SetDirty(entt::entity entity) { Record<>(Kind::Dirty, 0, entity, nullptr); }
+
+	/// Move the commands of other after the ones of this buffer
+	void Append(CommandBuffer&& other)
+	{
+		if (_commands.empty())
+		{
+			_commands = std::move(other._commands);
+			_arena = std::move(other._arena);
+		}
+		else
+		{
+			const auto arenaOffset = static_cast<uint32_t>(_arena.size());
+			for (auto& command : other._commands)
+			{
+				if (command.arenaOffset != k_Inline)
+				{
+					command.arenaOffset += arenaOffset;
+				}
+			}
+			_commands.insert(_commands.end(), other._commands.cbegin(), other._commands.cend());
+			_arena.insert(_arena.end(), other._arena.cbegin(), other._arena.cend());
+		}
+		other.Clear();
+	}
+
+	[[nodiscard]] bool Empty() const { return _commands.empty(); }
+	[[nodiscard]] size_t Size() const { return _commands.size(); }
+	void Clear()
+	{
+		_commands.clear();
+		_arena.clear();
+	}
+
+private:
+	friend class Registry;
+
+	/// Playback order of the commands
+	enum class Kind : uint8_t
+	{
+		Create,
+		Component,
+		Destroy,
+		Dirty,
+	};
+
+	using Apply = void (*)(entt::registry& registry, entt::entity entity, const std::byte* arguments);
+
+	/// Value of \ref Command::arenaOffset for arguments stored in the command
+	static constexpr uint32_t k_Inline = std::numeric_limits<uint32_t>::max();
+
+	struct Command
+	{
+		Kind kind;
+		entt::id_type type;
+		entt::entity entity;
+		/// Index of the arguments in \ref _arena, or \ref k_Inline
+		uint32_t arenaOffset;
+		Apply apply;
+		/// Holds a std::tuple of the recorded arguments if they fit
+		alignas(std::max_align_t) std::array<std::byte, k_MaxArgumentsSize> arguments;
+	};
+	static_assert(std::is_trivially_copyable_v<Command>);
+
+	template <typename... Args>
+	void Record(Kind kind, entt::id_type type, entt::entity entity, Apply apply, Args... args)
+	{
+		using Arguments = std::tuple<Args...>;
+		static_assert((std::is_trivially_copyable_v<Args> && ...), "Recorded arguments are copied as bytes");
+		static_assert(alignof(Arguments) <= alignof(std::max_align_t));
+
+		auto& command = _commands.emplace_back();
+		command.kind = kind;
+		command.type = type;
+		command.entity = entity;
+		command.apply = apply;
+		if constexpr (sizeof(Arguments) <= k_MaxArgumentsSize)
+		{
+			command.arenaOffset = k_Inline;
+			new (command.arguments.data()) Arguments(args...);
+		}
+		else
+		{
+			command.arenaOffset = static_cast<uint32_t>(_arena.size());
+			_arena.resize(_arena.size() + (sizeof(Arguments) + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+			new (&_arena[command.arenaOffset]) Arguments(args...);
+		}
+	}
+
+	/// Arguments to pass to \ref Command::apply, only valid until the next command is recorded
+	[[nodiscard]] const std::byte* GetArgumentsData(const Command& command) const
+	{
+		if (command.arenaOffset == k_Inline)
+		{
+			return command.arguments.data();
+		}
+		return reinterpret_cast<const std::byte*>(&_arena[command.arenaOffset]);
+	}
+
+	template <typename... Args>
+	static const std::tuple<Args...>& GetArguments(const std::byte* arguments)
+	{
+		return *std::launder(reinterpret_cast<const std::tuple<Args...>*>(arguments));
+	}
+
+	template <typename... Components>
+	static void ApplyCreate(entt::registry& registry, entt::entity entity, const std::byte* arguments)
+	{
+		std::apply(
+		    [&registry, entity](const Components&... components) {
+			    (registry.emplace<Components>(entity, components), ...);
+		    },
+		    GetArguments<Components...>(arguments));
+	}
+
+	template <typename Component, typename... Args>
+	static void ApplyAssign(entt::registry& registry, entt::entity entity, const std::byte* arguments)
+	{
+		std::apply([&registry, entity](const Args&... args) { registry.emplace<Component>(entity, args...); },
+		           GetArguments<Args...>(arguments));
+	}
+
+	template <typename Component, typename... Args>
+	static void ApplyAssignOrReplace(entt::registry& registry, entt::entity entity, const std::byte* arguments)
+	{
+		std::apply([&registry, entity](const Args&... args) { registry.emplace_or_replace<Component>(entity, args...); },
+		           GetArguments<Args...>(arguments));
+	}
+
+	template <typename Component>
+	static void ApplyRemove(entt::registry& registry, entt::entity entity, const std::byte* /*arguments*/)
+	{
+		registry.remove<Component>(entity);
+	}
+
+	std::vector<Command> _commands;
+	/// Arguments too large for \ref Command::arguments, in units of std::max_align_t to keep them aligned
+	std::vector<std::max_align_t> _arena;
+};
+
+} // namespace openblack::ecs
@@ -0,0 +1,28 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <entt/fwd.hpp>
+
+namespace openblack::ecs::components
+{
+
+/// Skeletal animation played by the boned mesh of the entity.
+/// The rendering system gives it a bone palette when the entity is marked dirty, assigning it to an entity already
+/// being drawn needs a \ref Registry::SetDirty.
+struct Animation
+{
+	entt::id_type id;
+	/// Milliseconds into the animation, wraps around its duration
+	float time = 0.0f;
+	float speed = 1.0f;
+};
+
+} // namespace openblack::ecs::components
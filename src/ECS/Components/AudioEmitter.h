@@ -17,8 +17,11 @@
 
 namespace openblack::ecs::components
 {
+/// Emitters only hold an OpenAL source while they are one of the most important audible emitters, see
+/// AudioManager::Update. Without one they are virtual and their playback position is tracked in elapsed.
 struct AudioEmitter
 {
+	/// \ref k_VirtualSource while the emitter has no voice
 	audio::SourceId sourceId;
 	entt::id_type soundId;
 	int priority = 0;
@@ -29,5 +32,13 @@ struct AudioEmitter
 	audio::PlayType loop = audio::PlayType::Once;
 	audio::AudioStatus state = audio::AudioStatus::Playing;
 	bool relative;
+	/// Kept from the sound so that the emitter gets it back each time it is given a source
+	float pitch = 1.0f;
+	audio::BufferId bufferId = 0;
+	/// In seconds, used to keep time while virtual
+	float duration = 0;
+	float elapsed = 0;
+
+	static constexpr audio::SourceId k_VirtualSource = 0;
 };
 } // namespace openblack::ecs::components
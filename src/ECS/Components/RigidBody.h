@@ -9,20 +9,33 @@
 
 #pragma once
 
+#include <memory>
+#include <utility>
+
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <LinearMath/btDefaultMotionState.h>
+#include <entt/resource/resource.hpp>
+
+namespace openblack::graphics
+{
+class L3DMesh;
+}
 
 namespace openblack::ecs::components
 {
 
 struct RigidBody
 {
+	/// Owns the collision shape, keeps it from being evicted while the body is in the world
+	entt::resource<graphics::L3DMesh> mesh;
 	btRigidBody handle;
 	// TODO(bwrsandman): it would be more cache friendly to not use a pointer here
 	std::unique_ptr<btDefaultMotionState> motionState;
 
-	RigidBody(const btRigidBody::btRigidBodyConstructionInfo& info, const btTransform& startTransform)
-	    : handle {info}
+	RigidBody(entt::resource<graphics::L3DMesh> l3dMesh, const btRigidBody::btRigidBodyConstructionInfo& info,
+	          const btTransform& startTransform)
+	    : mesh {std::move(l3dMesh)}
+	    , handle {info}
 	    , motionState(std::make_unique<btDefaultMotionState>(startTransform))
 	{
 		handle.setMotionState(motionState.get());
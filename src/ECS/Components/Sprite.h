@@ -9,15 +9,21 @@
 
 #pragma once
 
-#include <bgfx/bgfx.h>
+#include <entt/resource/resource.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec4.hpp>
 
+namespace openblack::graphics
+{
+class Texture2D;
+}
+
 namespace openblack::ecs::components
 {
 struct Sprite
 {
-	bgfx::TextureHandle texture;
+	/// Holding the texture keeps it from being evicted while the sprite exists
+	entt::resource<graphics::Texture2D> texture;
 	glm::vec2 uvMin;
 	glm::vec2 uvExtent;
 	glm::vec4 tint;
@@ -11,13 +11,16 @@
 
 #include <cstdint>
 
-#include <array>
-#include <unordered_set>
+#include <optional>
+#include <span>
+#include <vector>
 
 #include <entt/fwd.hpp>
 #include <glm/fwd.hpp>
 #include <glm/vec2.hpp>
 
+#include "Common/FunctionRef.h"
+
 namespace openblack::ecs
 {
 
@@ -25,24 +28,53 @@ class MapInterface
 {
 public:
 	using CellId = glm::u16vec2;
+	/// Return false to skip an entity in a query. Only referenced for the duration of the query.
+	using Filter = FunctionRef<bool(entt::entity)>;
+
+	struct RayHit
+	{
+		entt::entity entity;
+		float distance;
+	};
 
 	static constexpr float k_PositionToGridFactor = static_cast<float>(0x10000) * 0.1f;
 	static constexpr glm::u16vec2 k_GridSize = {0x200, 0x200};
+	/// Width of a cell in world units
+	static constexpr float k_CellSize = static_cast<float>(0x10000) / k_PositionToGridFactor;
 
 	static CellId GetGridCell(const glm::vec2& pos);
 	static CellId GetGridCell(const glm::vec3& pos);
 	static glm::vec2 GetCellCenter(const CellId& cellId);
 
-	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetFixedInGridCell(const CellId& cellId) const = 0;
-	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetFixedInGridCell(const glm::vec3& pos) const = 0;
-	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetMobileInGridCell(const CellId& cellId) const = 0;
-	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetMobileInGridCell(const glm::vec3& pos) const = 0;
+	// Spans are invalidated by the next call to \ref Rebuild
+	[[nodiscard]] virtual std::span<const entt::entity> GetFixedInGridCell(const CellId& cellId) const = 0;
+	[[nodiscard]] virtual std::span<const entt::entity> GetFixedInGridCell(const glm::vec3& pos) const = 0;
+	[[nodiscard]] virtual std::span<const entt::entity> GetMobileInGridCell(const CellId& cellId) const = 0;
+	[[nodiscard]] virtual std::span<const entt::entity> GetMobileInGridCell(const glm::vec3& pos) const = 0;
 
+	/// Fixed objects whose bounding circle overlaps the disc, sorted by entity
+	[[nodiscard]] virtual std::vector<entt::entity> GetFixedInRadius(const glm::vec2& center, float radius) const = 0;
+	/// Mobile objects whose position is in the disc
+	[[nodiscard]] virtual std::vector<entt::entity> GetMobileInRadius(const glm::vec2& center, float radius) const = 0;
+	/// Closest fixed object whose bounding circle is entered by the ray before \p maxDistance.
+	/// Objects containing the origin are ignored. \p direction must be normalized.
+	[[nodiscard]] virtual std::optional<RayHit> RaycastFixed(const glm::vec2& origin, const glm::vec2& direction,
+	                                                         float maxDistance, Filter filter = {}) const = 0;
+
+	/// Request a rebuild of the fixed grid and a visit of all mobile objects on the next \ref Rebuild
+	virtual void SetDirty() = 0;
+	/// Request a rebuild of the fixed grid on the next \ref Rebuild if the entity is fixed, otherwise only this entity's
+	/// mobile cell is updated
+	virtual void SetDirty(entt::entity entity) = 0;
+	/// Bring the grids up to date. Fixed objects are only re-inserted when they changed and mobile objects are only
+	/// moved when they changed cell.
 	virtual void Rebuild() = 0;
 
+	virtual ~MapInterface() = default;
+
 private:
-	virtual void Clear() = 0;
-	virtual void Build() = 0;
+	virtual void BuildFixed() = 0;
+	virtual void UpdateMobile() = 0;
 };
 
 } // namespace openblack::ecs
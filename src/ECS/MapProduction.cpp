@@ -10,10 +10,17 @@
 #define LOCATOR_IMPLEMENTATIONS
 #include "MapProduction.h"
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
 #include <glm/gtx/component_wise.hpp>
 #include <glm/gtx/norm.hpp>
 #include <glm/gtx/vec_swizzle.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vector_relational.hpp>
 
 #include "ECS/Components/Fixed.h"
 #include "ECS/Components/Mobile.h"
@@ -24,72 +31,387 @@
 using namespace openblack::ecs;
 using namespace openblack::ecs::components;
 
-const std::unordered_set<entt::entity>& MapProduction::GetFixedInGridCell(const CellId& cellId) const
+namespace
+{
+uint32_t GetCellIndex(const MapInterface::CellId& cellId)
+{
+	return cellId.x + cellId.y * MapInterface::k_GridSize.x;
+}
+
+glm::ivec2 GetUnclampedCell(const glm::vec2& pos)
+{
+	return glm::ivec2(glm::floor(pos / MapInterface::k_CellSize));
+}
+
+bool IsInGrid(const glm::ivec2& cell)
+{
+	return glm::all(glm::greaterThanEqual(cell, glm::ivec2(0))) &&
+	       glm::all(glm::lessThan(cell, glm::ivec2(MapInterface::k_GridSize)));
+}
+
+/// Clamped before the conversion so that positions far outside of the grid, or infinite, are valid
+glm::ivec2 GetClampedCell(const glm::vec2& pos)
+{
+	const auto cell = glm::clamp(glm::floor(pos / MapInterface::k_CellSize), glm::vec2(0.0f),
+	                             glm::vec2(MapInterface::k_GridSize) - 1.0f);
+	return glm::ivec2(cell);
+}
+
+/// Objects span multiple cells, keep the ones already tested in a sorted vector. Returns false if \p entity was in it.
+bool InsertTested(std::vector<entt::entity>& tested, entt::entity entity)
+{
+	const auto iter = std::lower_bound(tested.begin(), tested.end(), entity);
+	if (iter != tested.end() && *iter == entity)
+	{
+		return false;
+	}
+	tested.insert(iter, entity);
+	return true;
+}
+} // namespace
+
+std::span<const entt::entity> MapProduction::GetFixedInGridCell(const CellId& cellId) const
 {
-	return _fixedGrid.at(cellId.x + cellId.y * k_GridSize.x);
+	const auto index = GetCellIndex(cellId);
+	if (index + 1 >= _fixedCellOffsets.size())
+	{
+		return {};
+	}
+	const auto first = _fixedCellOffsets[index];
+	const auto last = _fixedCellOffsets[index + 1];
+	return std::span(_fixedCellEntities).subspan(first, last - first);
 }
 
-const std::unordered_set<entt::entity>& MapProduction::GetFixedInGridCell(const glm::vec3& pos) const
+std::span<const entt::entity> MapProduction::GetFixedInGridCell(const glm::vec3& pos) const
 {
 	const auto cellId = GetGridCell(pos);
 	return GetFixedInGridCell(cellId);
 }
 
-const std::unordered_set<entt::entity>& MapProduction::GetMobileInGridCell(const CellId& cellId) const
+std::span<const entt::entity> MapProduction::GetMobileInGridCell(const CellId& cellId) const
 {
-	return _mobileGrid.at(cellId.x + cellId.y * k_GridSize.x);
+	const auto iter = _mobileGrid.find(GetCellIndex(cellId));
+	if (iter == _mobileGrid.cend())
+	{
+		return {};
+	}
+	return iter->second;
 }
 
-const std::unordered_set<entt::entity>& MapProduction::GetMobileInGridCell(const glm::vec3& pos) const
+std::span<const entt::entity> MapProduction::GetMobileInGridCell(const glm::vec3& pos) const
 {
 	const auto cellId = GetGridCell(pos);
 	return GetMobileInGridCell(cellId);
 }
 
+std::vector<entt::entity> MapProduction::GetFixedInRadius(const glm::vec2& center, float radius) const
+{
+	const auto& registry = Locator::entitiesRegistry::value();
+
+	// Objects are inserted in the cells around their bounding circle, search one extra cell
+	const auto min = GetClampedCell(center - radius - k_CellSize);
+	const auto max = GetClampedCell(center + radius + k_CellSize);
+
+	std::vector<entt::entity> result;
+	for (int y = min.y; y <= max.y; ++y)
+	{
+		for (int x = min.x; x <= max.x; ++x)
+		{
+			for (const auto& entity : GetFixedInGridCell(CellId(x, y)))
+			{
+				const auto& fixed = registry.Get<const Fixed>(entity);
+				const auto r = radius + fixed.boundingRadius;
+				if (glm::distance2(center, fixed.boundingCenter) <= r * r)
+				{
+					result.push_back(entity);
+				}
+			}
+		}
+	}
+
+	// Objects span multiple cells
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+	return result;
+}
+
+std::vector<entt::entity> MapProduction::GetMobileInRadius(const glm::vec2& center, float radius) const
+{
+	const auto& registry = Locator::entitiesRegistry::value();
+
+	const auto min = GetClampedCell(center - radius);
+	const auto max = GetClampedCell(center + radius);
+
+	std::vector<entt::entity> result;
+	for (int y = min.y; y <= max.y; ++y)
+	{
+		for (int x = min.x; x <= max.x; ++x)
+		{
+			for (const auto& entity : GetMobileInGridCell(CellId(x, y)))
+			{
+				const auto& transform = registry.Get<const Transform>(entity);
+				if (glm::distance2(center, glm::xz(transform.position)) <= radius * radius)
+				{
+					result.push_back(entity);
+				}
+			}
+		}
+	}
+	return result;
+}
+
+std::optional<MapInterface::RayHit> MapProduction::RaycastFixed(const glm::vec2& origin, const glm::vec2& direction,
+                                                                float maxDistance, Filter filter) const
+{
+	const auto& registry = Locator::entitiesRegistry::value();
+
+	std::optional<RayHit> result = std::nullopt;
+	std::vector<entt::entity> tested;
+	const auto testCell = [this, &registry, &origin, &direction, &maxDistance, &filter, &result,
+	                       &tested](const glm::ivec2& cell) {
+		if (!IsInGrid(cell))
+		{
+			return;
+		}
+		for (const auto& entity : GetFixedInGridCell(CellId(cell)))
+		{
+			if (!InsertTested(tested, entity) || (filter && !filter(entity)))
+			{
+				continue;
+			}
+
+			// Do a ray-circle intersection in 2d with ray = {origin, direction}, circle = {fixed.c, fixed.r}
+			const auto& fixed = registry.Get<const Fixed>(entity);
+			const auto oc = origin - fixed.boundingCenter;
+			const auto halfB = glm::dot(oc, direction);
+			const auto c = glm::length2(oc) - fixed.boundingRadius * fixed.boundingRadius;
+			const float discriminant = halfB * halfB - c;
+			if (discriminant <= 0.0f)
+			{
+				continue;
+			}
+			const float t = -halfB - glm::sqrt(discriminant);
+			// Behind, inside or too far
+			if (t <= 0.0f || t > maxDistance)
+			{
+				continue;
+			}
+			if (!result.has_value() || t < result->distance)
+			{
+				result = RayHit {entity, t};
+			}
+		}
+	};
+
+	// Walk the cells crossed by the ray (Amanatides & Woo). Objects are inserted in the cells around their bounding
+	// circle so the neighbours of each crossed cell are searched too.
+	auto cell = GetUnclampedCell(origin);
+	glm::ivec2 cellStep;
+	glm::vec2 tMax;
+	glm::vec2 tDelta;
+	for (glm::length_t i = 0; i < 2; ++i)
+	{
+		if (direction[i] == 0.0f)
+		{
+			cellStep[i] = 0;
+			tMax[i] = std::numeric_limits<float>::infinity();
+			tDelta[i] = std::numeric_limits<float>::infinity();
+			continue;
+		}
+		cellStep[i] = direction[i] > 0.0f ? 1 : -1;
+		const float boundary = static_cast<float>(cell[i] + (cellStep[i] > 0 ? 1 : 0)) * k_CellSize;
+		tMax[i] = (boundary - origin[i]) / direction[i];
+		tDelta[i] = k_CellSize / glm::abs(direction[i]);
+	}
+
+	float tEntry = 0.0f;
+	while (tEntry <= maxDistance)
+	{
+		for (int y = -1; y <= 1; ++y)
+		{
+			for (int x = -1; x <= 1; ++x)
+			{
+				testCell(cell + glm::ivec2(x, y));
+			}
+		}
+
+		// Anything hit past this cell is further than what was already found
+		const float tExit = glm::min(tMax.x, tMax.y);
+		if (result.has_value() && result->distance <= tExit)
+		{
+			break;
+		}
+
+		const glm::length_t axis = tMax.x < tMax.y ? 0 : 1;
+		cell[axis] += cellStep[axis];
+		tEntry = tMax[axis];
+		tMax[axis] += tDelta[axis];
+
+		// Left the grid and its neighbours can't be in it either
+		if (glm::any(glm::lessThan(cell, glm::ivec2(-1))) || glm::any(glm::greaterThan(cell, glm::ivec2(k_GridSize))))
+		{
+			break;
+		}
+	}
+
+	return result;
+}
+
+void MapProduction::SetDirty()
+{
+	_fixedDirty = true;
+	_mobileDirty = true;
+	_dirtyEntities.clear();
+}
+
+void MapProduction::SetDirty(entt::entity entity)
+{
+	if (!_mobileDirty)
+	{
+		_dirtyEntities.push_back(entity);
+	}
+	if (_fixedDirty)
+	{
+		return;
+	}
+	const auto& registry = Locator::entitiesRegistry::value();
+	if (registry.Valid(entity) && registry.AllOf<Fixed>(entity))
+	{
+		_fixedDirty = true;
+	}
+}
+
 void MapProduction::Rebuild()
 {
-	Clear();
-	Build();
+	// Fixed components which are added or removed are not seen by SetDirty(entity) but change the count
+	auto& registry = Locator::entitiesRegistry::value();
+	if (_fixedDirty || registry.Size<Fixed>() != _fixedCount)
+	{
+		BuildFixed();
+	}
+	UpdateMobile();
 }
 
-void MapProduction::Clear()
+void MapProduction::BuildFixed()
 {
-	for (auto& g : _fixedGrid)
+	auto& registry = Locator::entitiesRegistry::value();
+
+	// Gather all (cell, entity) pairs in registry order then counting sort them by cell
+	std::vector<std::pair<uint32_t, entt::entity>> cellEntities;
+	cellEntities.reserve(registry.Size<Fixed>());
+	registry.Each<const Fixed, const Transform>(
+	    [&cellEntities](entt::entity entity, const Fixed& fixed, const Transform& transform) {
+		    // TODO(bwrsandman): This is only in the case of a square bb underling the bounding circle (x/z) <= 1.4
+		    const float radius = fixed.boundingRadius * glm::compMax(transform.scale) + 1.0f;
+		    const auto min = GetGridCell(fixed.boundingCenter - radius);
+		    const auto max = GetGridCell(fixed.boundingCenter + radius);
+
+		    for (uint16_t x = min.x; x < max.x + 1; ++x)
+		    {
+			    for (uint16_t y = min.y; y < max.y + 1; ++y)
+			    {
+				    const auto cellId = MapProduction::CellId(x, y);
+				    if (glm::distance2(GetCellCenter(cellId), fixed.boundingCenter) < radius * radius)
+				    {
+					    cellEntities.emplace_back(GetCellIndex(cellId), entity);
+				    }
+			    }
+		    }
+	    });
+
+	_fixedCellOffsets.assign(k_CellCount + 1, 0);
+	for (const auto& [cellIndex, entity] : cellEntities)
+	{
+		++_fixedCellOffsets[cellIndex + 1];
+	}
+	for (uint32_t i = 0; i < k_CellCount; ++i)
 	{
-		g.clear();
+		_fixedCellOffsets[i + 1] += _fixedCellOffsets[i];
 	}
-	for (auto& g : _mobileGrid)
+	_fixedCellEntities.resize(cellEntities.size());
+	std::vector<uint32_t> cursors(_fixedCellOffsets.cbegin(), _fixedCellOffsets.cend() - 1);
+	for (const auto& [cellIndex, entity] : cellEntities)
 	{
-		g.clear();
+		_fixedCellEntities[cursors[cellIndex]++] = entity;
 	}
+
+	_fixedCount = registry.Size<Fixed>();
+	_fixedDirty = false;
 }
 
-void MapProduction::Build()
+void MapProduction::UpdateMobile()
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<const Fixed, const Transform>([this](entt::entity entity, const Fixed& fixed, const Transform& transform) {
-		// TODO(bwrsandman): This is only in the case of a square bb underling the bounding circle (x/z) <= 1.4
-		const float radius = fixed.boundingRadius * glm::compMax(transform.scale) + 1.0f;
-		const auto min = GetGridCell(fixed.boundingCenter - radius);
-		const auto max = GetGridCell(fixed.boundingCenter + radius);
 
-		for (uint16_t x = min.x; x < max.x + 1; ++x)
+	const auto removeFromCell = [this](uint32_t cellIndex, entt::entity entity) {
+		auto iter = _mobileGrid.find(cellIndex);
+		auto& cell = iter->second;
+		cell.erase(std::find(cell.begin(), cell.end(), entity));
+		if (cell.empty())
+		{
+			_mobileGrid.erase(iter);
+		}
+	};
+	const auto place = [this, &removeFromCell](entt::entity entity, uint32_t cellIndex) -> MobileEntry& {
+		auto [iter, inserted] = _mobileEntries.try_emplace(entity, MobileEntry {cellIndex, _mobileStamp});
+		auto& entry = iter->second;
+		if (inserted)
+		{
+			_mobileGrid[cellIndex].push_back(entity);
+		}
+		else if (entry.cellIndex != cellIndex)
 		{
-			for (uint16_t y = min.y; y < max.y + 1; ++y)
+			removeFromCell(entry.cellIndex, entity);
+			_mobileGrid[cellIndex].push_back(entity);
+			entry.cellIndex = cellIndex;
+		}
+		return entry;
+	};
+
+	// Only the entities flagged through SetDirty(entity) can have moved, been added or been removed
+	if (!_mobileDirty)
+	{
+		std::sort(_dirtyEntities.begin(), _dirtyEntities.end());
+		_dirtyEntities.erase(std::unique(_dirtyEntities.begin(), _dirtyEntities.end()), _dirtyEntities.end());
+		for (const auto entity : _dirtyEntities)
+		{
+			if (registry.Valid(entity) && registry.AllOf<Mobile, Transform>(entity))
 			{
-				const auto cellId = MapProduction::CellId(x, y);
-				if (glm::distance2(GetCellCenter(cellId), fixed.boundingCenter) < radius * radius)
-				{
-					auto& cell = _fixedGrid.at(cellId.x + cellId.y * k_GridSize.x);
-					cell.insert(entity);
-				}
+				place(entity, GetCellIndex(GetGridCell(registry.Get<const Transform>(entity).position)));
+			}
+			else if (const auto iter = _mobileEntries.find(entity); iter != _mobileEntries.end())
+			{
+				removeFromCell(iter->second.cellIndex, entity);
+				_mobileEntries.erase(iter);
 			}
 		}
-	});
+		_dirtyEntities.clear();
+		return;
+	}
+
+	++_mobileStamp;
+	size_t seen = 0;
 	registry.Each<const Mobile, const Transform>(
-	    [this](entt::entity entity, [[maybe_unused]] const Mobile& mobile, const Transform& transform) {
-		    const auto cellId = GetGridCell(transform.position);
-		    auto& cell = _mobileGrid.at(cellId.x + cellId.y * k_GridSize.x);
-		    cell.insert(entity);
+	    [this, &seen, &place](entt::entity entity, [[maybe_unused]] const Mobile& mobile, const Transform& transform) {
+		    ++seen;
+		    place(entity, GetCellIndex(GetGridCell(transform.position))).stamp = _mobileStamp;
 	    });
+
+	// Entities which were not seen this time are no longer mobile
+	if (seen != _mobileEntries.size())
+	{
+		for (auto iter = _mobileEntries.begin(); iter != _mobileEntries.end();)
+		{
+			if (iter->second.stamp != _mobileStamp)
+			{
+				removeFromCell(iter->second.cellIndex, iter->first);
+				iter = _mobileEntries.erase(iter);
+			}
+			else
+			{
+				++iter;
+			}
+		}
+	}
+	_mobileDirty = false;
 }
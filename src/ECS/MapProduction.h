@@ -13,6 +13,9 @@
 #error "Locator interface implementations should only be included in Locator.cpp, use interface instead."
 #endif
 
+#include <unordered_map>
+#include <vector>
+
 #include "Map.h"
 
 namespace openblack::ecs
@@ -20,19 +23,47 @@ namespace openblack::ecs
 
 class MapProduction final: public MapInterface
 {
-	[[nodiscard]] const std::unordered_set<entt::entity>& GetFixedInGridCell(const CellId& cellId) const override;
-	[[nodiscard]] const std::unordered_set<entt::entity>& GetFixedInGridCell(const glm::vec3& pos) const override;
-	[[nodiscard]] const std::unordered_set<entt::entity>& GetMobileInGridCell(const CellId& cellId) const override;
-	[[nodiscard]] const std::unordered_set<entt::entity>& GetMobileInGridCell(const glm::vec3& pos) const override;
+	[[nodiscard]] std::span<const entt::entity> GetFixedInGridCell(const CellId& cellId) const override;
+	[[nodiscard]] std::span<const entt::entity> GetFixedInGridCell(const glm::vec3& pos) const override;
+	[[nodiscard]] std::span<const entt::entity> GetMobileInGridCell(const CellId& cellId) const override;
+	[[nodiscard]] std::span<const entt::entity> GetMobileInGridCell(const glm::vec3& pos) const override;
+
+	[[nodiscard]] std::vector<entt::entity> GetFixedInRadius(const glm::vec2& center, float radius) const override;
+	[[nodiscard]] std::vector<entt::entity> GetMobileInRadius(const glm::vec2& center, float radius) const override;
+	[[nodiscard]] std::optional<RayHit> RaycastFixed(const glm::vec2& origin, const glm::vec2& direction, float maxDistance,
+	                                                 Filter filter) const override;
 
+	void SetDirty() override;
+	void SetDirty(entt::entity entity) override;
 	void Rebuild() override;
 
 private:
-	void Clear() override;
-	void Build() override;
+	struct MobileEntry
+	{
+		uint32_t cellIndex;
+		uint32_t stamp; ///< Value of \ref _mobileStamp when last seen, used to find removed entities
+	};
+
+	static constexpr uint32_t k_CellCount = k_GridSize.x * k_GridSize.y;
+
+	void BuildFixed() override;
+	void UpdateMobile() override;
+
+	/// Fixed objects are stored as a compressed sparse row grid: the entities of cell i are in
+	/// [_fixedCellOffsets[i], _fixedCellOffsets[i + 1]) of _fixedCellEntities.
+	std::vector<uint32_t> _fixedCellOffsets;
+	std::vector<entt::entity> _fixedCellEntities;
+	size_t _fixedCount {0};
+	bool _fixedDirty {true};
 
-	std::array<std::unordered_set<entt::entity>, k_GridSize.x * k_GridSize.y> _fixedGrid;
-	std::array<std::unordered_set<entt::entity>, k_GridSize.x * k_GridSize.y> _mobileGrid;
+	/// Only cells containing mobile objects are stored
+	std::unordered_map<uint32_t, std::vector<entt::entity>> _mobileGrid;
+	std::unordered_map<entt::entity, MobileEntry> _mobileEntries;
+	uint32_t _mobileStamp {0};
+	/// Set by \ref SetDirty(), all mobile objects are visited on the next update
+	bool _mobileDirty {true};
+	/// Entities flagged through \ref SetDirty(entt::entity) since the last update. May contain duplicates.
+	std::vector<entt::entity> _dirtyEntities;
 };
 
 } // namespace openblack::ecs
@@ -9,7 +9,13 @@
 
 #include "Registry.h"
 
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "CommandBuffer.h"
 #include "Locator.h"
+#include "Map.h"
 #include "Systems/RenderingSystemInterface.h"
 
 namespace openblack::ecs
@@ -28,6 +34,7 @@ void Registry::Release(entt::entity entity)
 
 void Registry::Destroy(entt::entity entity)
 {
+	SetDirty(entity);
 	_registry.destroy(entity);
 }
 
@@ -49,11 +56,96 @@ void Registry::Reset()
 	_registry.ctx().emplace<RegistryContext>();
 };
 
+void Registry::Playback(CommandBuffer& buffer)
+{
+	using Kind = CommandBuffer::Kind;
+	auto& commands = buffer._commands;
+
+	std::stable_sort(commands.begin(), commands.end(), [](const auto& lhs, const auto& rhs) {
+		return std::tie(lhs.kind, lhs.type) < std::tie(rhs.kind, rhs.type);
+	});
+
+	std::vector<entt::entity> destroyed;
+	std::vector<entt::entity> changed;
+	for (const auto& command : commands)
+	{
+		if (command.kind == Kind::Destroy)
+		{
+			destroyed.push_back(command.entity);
+		}
+		else if (command.kind != Kind::Create)
+		{
+			changed.push_back(command.entity);
+		}
+	}
+	std::sort(destroyed.begin(), destroyed.end());
+	destroyed.erase(std::unique(destroyed.begin(), destroyed.end()), destroyed.end());
+	std::sort(changed.begin(), changed.end());
+	changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+	std::erase_if(changed, [&destroyed](entt::entity entity) {
+		return std::binary_search(destroyed.begin(), destroyed.end(), entity);
+	});
+
+	// Destroyed entities need to be marked while they still have their components
+	for (const auto entity : destroyed)
+	{
+		SetDirty(entity);
+	}
+
+	for (const auto& command : commands)
+	{
+		switch (command.kind)
+		{
+		case Kind::Create:
+		{
+			const auto entity = _registry.create();
+			command.apply(_registry, entity, buffer.GetArgumentsData(command));
+			changed.push_back(entity);
+		}
+		break;
+		case Kind::Component:
+			command.apply(_registry, command.entity, buffer.GetArgumentsData(command));
+			break;
+		case Kind::Destroy:
+			if (_registry.valid(command.entity))
+			{
+				_registry.destroy(command.entity);
+			}
+			break;
+		case Kind::Dirty:
+			break;
+		}
+	}
+
+	for (const auto entity : changed)
+	{
+		SetDirty(entity);
+	}
+
+	buffer.Clear();
+}
+
 void Registry::SetDirty()
 {
 	if (Locator::rendereringSystem::has_value())
 	{
 		Locator::rendereringSystem::value().SetDirty();
 	}
+	if (Locator::entitiesMap::has_value())
+	{
+		Locator::entitiesMap::value().SetDirty();
+	}
+}
+
+void Registry::SetDirty(entt::entity entity)
+{
+	if (Locator::rendereringSystem::has_value())
+	{
+		Locator::rendereringSystem::value().SetDirty(entity);
+	}
+	if (Locator::entitiesMap::has_value())
+	{
+		Locator::entitiesMap::value().SetDirty(entity);
+	}
 }
 } // namespace openblack::ecs
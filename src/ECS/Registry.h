@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <iterator>
+
 #include <entt/entity/entity.hpp>
 #include <entt/entity/helper.hpp>
 #include <entt/entity/registry.hpp>
@@ -28,6 +30,8 @@ class ShaderManager;
 
 namespace openblack::ecs
 {
+class CommandBuffer;
+
 class Registry
 {
 public:
@@ -38,6 +42,32 @@ class Registry
 	{
 		_registry.create(first, last);
 	}
+	/// Grow the entity storage and the storage of each component by count ahead of a batch of creations
+	template <typename... Components>
+	void Reserve(size_t count)
+	{
+		auto& entities = _registry.storage<entt::entity>();
+		entities.reserve(entities.size() + count);
+		(
+		    [this, count] {
+			    auto& storage = _registry.storage<Components>();
+			    storage.reserve(storage.size() + count);
+		    }(),
+		    ...);
+	}
+	/// Assign one component per entity from the range starting at from. Nothing is marked dirty, call SetDirty() once the
+	/// batch is complete.
+	template <typename Component, typename EntityIt, typename ComponentIt>
+	void Insert(EntityIt first, EntityIt last, ComponentIt from)
+	{
+		_registry.insert<Component>(std::move(first), std::move(last), std::move(from));
+	}
+	/// Assign a default constructed component to each entity, e.g. a tag. Nothing is marked dirty.
+	template <typename Component, typename EntityIt>
+	void Insert(EntityIt first, EntityIt last)
+	{
+		_registry.insert<Component>(std::move(first), std::move(last));
+	}
 	virtual void Release(entt::entity entity);
 	template <typename It>
 	void Release(It first, It last)
@@ -49,24 +79,25 @@ class Registry
 	template <typename It>
 	void Destroy(It first, It last)
 	{
+		SetDirty();
 		_registry.destroy(first, last);
 	}
 	template <typename Component, typename... Args>
 	decltype(auto) Assign(entt::entity entity, [[maybe_unused]] Args&&... args)
 	{
-		SetDirty();
+		SetDirty(entity);
 		return _registry.emplace<Component>(entity, std::forward<Args>(args)...);
 	}
 	template <typename Component, typename... Args>
 	decltype(auto) AssignOrReplace(entt::entity entity, [[maybe_unused]] Args&&... args)
 	{
-		SetDirty();
+		SetDirty(entity);
 		return _registry.emplace_or_replace<Component>(entity, std::forward<Args>(args)...);
 	}
 	template <typename Component, typename... Other>
 	decltype(auto) Remove(entt::entity entity)
 	{
-		SetDirty();
+		SetDirty(entity);
 		return _registry.remove<Component, Other...>(entity);
 	}
 	template <typename After, typename Before, typename... Args>
@@ -76,7 +107,31 @@ class Registry
 		Remove<Before>(entity);
 		return Assign<After>(entity, std::forward<Args>(args)...);
 	}
+	/// Apply the recorded commands in one batch and clear the buffer. Creations go first, then component changes grouped
+	/// by component type and destructions last, keeping the recording order within each group. Each touched entity is
+	/// marked dirty once.
+	virtual void Playback(CommandBuffer& buffer);
+	/// Mark all renderable entities and the map grid as needing an update
 	virtual void SetDirty();
+	/// Mark a single entity's renderable and map state as needing an update, call after modifying its Transform
+	virtual void SetDirty(entt::entity entity);
+	/// Mark the entities of a batch of creations. A single entity is marked on its own, larger batches mark everything once.
+	template <typename It>
+	void SetDirty(It first, It last)
+	{
+		if (first == last)
+		{
+			return;
+		}
+		if (std::next(first) == last)
+		{
+			SetDirty(*first);
+		}
+		else
+		{
+			SetDirty();
+		}
+	}
 	virtual RegistryContext& Context();
 	[[nodiscard]] virtual const RegistryContext& Context() const;
 	virtual void Reset();
@@ -102,20 +102,28 @@ void DynamicsSystem::RegisterIslandRigidBodies(LandIslandInterface& island)
 void DynamicsSystem::UpdatePhysicsTransforms()
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<Transform, const RigidBody>([&registry](Transform& transform, const RigidBody& body) {
+	registry.Each<Transform, const RigidBody>([&registry](entt::entity entity, Transform& transform, const RigidBody& body) {
+		// Static and sleeping bodies keep their transform, only mark the ones which moved as dirty
+		if (!body.handle.isActive())
+		{
+			return;
+		}
+
 		btTransform trans;
 		body.motionState->getWorldTransform(trans);
 
-		transform.position.x = trans.getOrigin().getX();
-		transform.position.y = trans.getOrigin().getY();
-		transform.position.z = trans.getOrigin().getZ();
-
-		glm::quat quaternion(trans.getRotation().getW(), trans.getRotation().getX(), trans.getRotation().getY(),
-		                     trans.getRotation().getZ());
-
-		transform.rotation = glm::mat3_cast(quaternion);
+		const glm::vec3 position(trans.getOrigin().getX(), trans.getOrigin().getY(), trans.getOrigin().getZ());
+		const glm::quat quaternion(trans.getRotation().getW(), trans.getRotation().getX(), trans.getRotation().getY(),
+		                           trans.getRotation().getZ());
+		const auto rotation = glm::mat3_cast(quaternion);
+		if (position == transform.position && rotation == transform.rotation)
+		{
+			return;
+		}
 
-		registry.SetDirty();
+		transform.position = position;
+		transform.rotation = rotation;
+		registry.SetDirty(entity);
 	});
 }
 
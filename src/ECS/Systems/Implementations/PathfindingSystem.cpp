@@ -12,6 +12,9 @@
 #include "PathfindingSystem.h"
 
 #include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include <entt/entity/entity.hpp>
 #include <glm/gtx/euler_angles.hpp>
@@ -20,12 +23,14 @@
 #include <spdlog/spdlog.h>
 
 #include "3D/LandIslandInterface.h"
+#include "ECS/CommandBuffer.h"
 #include "ECS/Components/Field.h"
 #include "ECS/Components/Fixed.h"
 #include "ECS/Components/Transform.h"
 #include "ECS/Components/WallHug.h"
 #include "ECS/Map.h"
 #include "ECS/Registry.h"
+#include "Jobs/JobSystem.h"
 #include "Locator.h"
 
 using namespace openblack;
@@ -36,6 +41,45 @@ using namespace openblack::ecs::systems;
 namespace
 {
 
+/// Minimum number of entities handed to a worker at once, smaller passes run on the calling thread
+constexpr size_t k_MinEntitiesPerChunk = 64;
+
+/// Run func on each entity of the view using the job system.
+/// func may only modify the components of the entity it is given and read everything else, adding or removing
+/// components goes through the command buffers. These are played back once all entities are done, in the order the view
+/// visited the entities, so the result does not depend on the number of threads.
+template <typename... Components, typename Func, typename... Exclude>
+void ParallelEach(JobSystem& jobSystem, ecs::Registry& registry, Func func, Exclude... exclude)
+{
+	std::vector<std::tuple<entt::entity, Components*...>> items;
+	registry.Each<Components...>(
+	    [&items](entt::entity entity, Components&... components) { items.emplace_back(entity, &components...); },
+	    exclude...);
+
+	std::vector<CommandBuffer> chunkCommands(jobSystem.GetChunkCount(items.size(), k_MinEntitiesPerChunk));
+	const auto process = [&func](CommandBuffer& commands, const auto& item) {
+		const auto call = [&func, &commands](entt::entity entity, Components*... components) {
+			func(commands, entity, *components...);
+		};
+		std::apply(call, item);
+	};
+	const auto processChunk = [&items, &chunkCommands, &process](size_t chunk, size_t begin, size_t end) {
+		for (auto i = begin; i < end; ++i)
+		{
+			process(chunkCommands[chunk], items[i]);
+		}
+	};
+	jobSystem.ParallelFor(items.size(), k_MinEntitiesPerChunk, processChunk);
+
+	// Sync point: chunks are ordered like the items
+	CommandBuffer commands;
+	for (auto& chunk : chunkCommands)
+	{
+		commands.Append(std::move(chunk));
+	}
+	registry.Playback(commands);
+}
+
 void InitializeStep(Transform& transform, WallHug& wallHug, float angle)
 {
 	transform.rotation = glm::eulerAngleY(-angle - glm::radians(90.0f));
@@ -79,101 +123,41 @@ bool AreWeThere(const glm::vec2& pos, const glm::vec2& goal, float threshold)
 	return glm::distance2(pos, goal) < threshold * threshold;
 }
 
-/// Get neighbouring cells in this order for traversal
-/// +-----+-----+-----+
-/// | [5] | [4] | [7] |
-/// +-----+-----+-----+
-/// | [2] | [0] | [1] |
-/// +-----+-----+-----+
-/// | [6] | [3] | [8] |
-/// +-----+-----+-----+
-std::array<ecs::MapInterface::CellId, 9> GetNeighboringCells(const glm::vec2& pos)
-{
-	const auto cellIndex = MapInterface::GetGridCell(pos);
-	assert(glm::compMin(cellIndex) > 0 && glm::all(glm::lessThan(cellIndex, MapInterface::k_GridSize - glm::u16vec2(1))));
-	return {
-	    cellIndex,                          // Current
-	    {cellIndex.x + 1, cellIndex.y},     // Right
-	    {cellIndex.x - 1, cellIndex.y},     // Left
-	    {cellIndex.x, cellIndex.y + 1},     // Under
-	    {cellIndex.x, cellIndex.y - 1},     // Over
-	    {cellIndex.x - 1, cellIndex.y - 1}, // Over and left
-	    {cellIndex.x - 1, cellIndex.y + 1}, // Under and left
-	    {cellIndex.x + 1, cellIndex.y - 1}, // Over and right
-	    {cellIndex.x + 1, cellIndex.y + 1}, // Under and right
-	};
-}
-
-/// Iterate between all adjacent grids and find closest object that the ray (step) intersects with (circle)
+/// Find the closest object that the ray (step) intersects with (circle)
 /// If that object is in front (and we are not in it) and less than 256 steps away, set as target and store steps
-bool LinearScanForObstacle(entt::entity entity, const glm::vec2& pos, const glm::vec2& step)
+bool LinearScanForObstacle(CommandBuffer& commands, entt::entity entity, const glm::vec2& pos, const glm::vec2& step)
 {
 	const auto& map = Locator::entitiesMap::value();
-	auto& registry = Locator::entitiesRegistry::value();
+	const auto& registry = Locator::entitiesRegistry::value();
 
 	// Reference will be updated or removed
-	registry.Remove<WallHugObjectReference>(entity);
+	commands.Remove<WallHugObjectReference>(entity);
 
-	// FIXME(bwrsandman): This gets first, not closest
-	std::optional<entt::entity> fixedEntity = std::nullopt;
-	for (const auto& c : GetNeighboringCells(pos + step))
-	{
-		// TODO(bwrsandman): Skip if out of bounds or in water
-		const auto& fixed = map.GetFixedInGridCell(c);
-		if (!fixed.empty())
-		{
-			auto iter = std::find_if(fixed.cbegin(), fixed.cend(), [&registry](const auto& f) {
-				return !registry.AnyOf<Field>(f); // TODO(bwrsandman): && registry.AllOf<CollideData>();
-			});
-			if (iter != fixed.cend())
-			{
-				fixedEntity = std::make_optional(*iter);
-				break;
-			}
-		}
-	}
-	if (!fixedEntity.has_value())
-	{
-		return false;
-	}
-
-	// Do ray-circle intersection with all objects found
-	const auto& fixed = registry.Get<Fixed>(*fixedEntity);
 	const auto stepSize = glm::length(step);
 	const auto direction = step / stepSize;
-	// Do a ray-circle intersection in 2d with ray = {pos, normal}, circle = {fixed.c, fixed.r} (same as ray-sphere)
-	const auto oc = pos - fixed.boundingCenter;
-	const auto halfB = glm::dot(oc, direction);
-	const auto c = glm::length2(oc) - fixed.boundingRadius * fixed.boundingRadius;
-	const float discriminant = halfB * halfB - c;
-	const bool hit = discriminant > 0;
-
-	// TODO(bwrsandman): if no hit, go through neighbouring cells, if still none, remove WallHugReference and return 1
-	if (!hit)
-	{
-		return false;
-	}
+	const auto maxSteps = std::numeric_limits<decltype(WallHugObjectReference::stepsAway)>::max();
 
-	const float t = hit ? -halfB - glm::sqrt(discriminant) : -1.0f;
-	const bool inFront = t > 0.0f;
-
-	if (!inFront)
+	// TODO(bwrsandman): Skip if out of bounds or in water
+	const auto hit = map.RaycastFixed(pos, direction, stepSize * maxSteps, [&registry](entt::entity f) {
+		return !registry.AnyOf<Field>(f); // TODO(bwrsandman): && registry.AllOf<CollideData>();
+	});
+	if (!hit.has_value())
 	{
 		return false;
 	}
 
-	const auto numSteps = t / stepSize;
+	const auto numSteps = hit->distance / stepSize;
 	assert(numSteps >= 0); // t wouldn't be positive here and size should always be positive
 
 	// Too far
-	if (numSteps >= std::numeric_limits<decltype(WallHugObjectReference::stepsAway)>::max())
+	if (numSteps >= maxSteps)
 	{
 		return false;
 	}
 
 	// Store object and number of steps away
-	registry.Assign<WallHugObjectReference>(entity, static_cast<decltype(WallHugObjectReference::stepsAway)>(numSteps),
-	                                        *fixedEntity);
+	commands.Assign<WallHugObjectReference>(entity, static_cast<decltype(WallHugObjectReference::stepsAway)>(numSteps),
+	                                        hit->entity);
 	return true;
 }
 
@@ -202,108 +186,107 @@ bool OrbitScanForObstacle(entt::entity entity, bool clockwise, Transform& transf
 			// Needs to return out of this scope and not run the external following code
 		}
 
-		for (const auto& c : GetNeighboringCells(glm::xz(transform.position)))
-		{ // TODO(bwrsandman): Skip if out of bounds or in water
-			const auto& e = map.GetFixedInGridCell(c);
-			if (!e.empty())
+		// Fixed objects around the neighbouring cells
+		// TODO(bwrsandman): Skip if out of bounds or in water
+		const auto nearby = map.GetFixedInRadius(glm::xz(transform.position), MapInterface::k_CellSize);
+		if (!nearby.empty())
+		{
+			auto iter = std::find_if(nearby.begin(), nearby.end(), [&registry, &reference, &obstacleFixed](const auto& f) {
+				if (f == reference.entity)
+				{
+					return false;
+				}
+				if (registry.AnyOf<Field>(f)) // TODO(bwrsandman): || !registry.AllOf<CollideData>();
+				{
+					return false;
+				}
+				const auto& fixed = registry.Get<const Fixed>(f);
+				const auto d2 = glm::distance2(fixed.boundingCenter, obstacleFixed.boundingCenter);
+				const auto r = fixed.boundingRadius + obstacleFixed.boundingRadius;
+				const auto r2 = r * r;
+				return d2 < r2 && d2 > 0.0f;
+			});
+			if (iter != nearby.end())
 			{
-				auto iter = std::find_if(e.cbegin(), e.cend(), [&registry, &reference, &obstacleFixed](const auto& f) {
-					if (f == reference.entity)
-					{
-						return false;
-					}
-					if (registry.AnyOf<Field>(f)) // TODO(bwrsandman): || !registry.AllOf<CollideData>();
-					{
-						return false;
-					}
-					const auto& fixed = registry.Get<const Fixed>(f);
-					const auto d2 = glm::distance2(fixed.boundingCenter, obstacleFixed.boundingCenter);
-					const auto r = fixed.boundingRadius + obstacleFixed.boundingRadius;
-					const auto r2 = r * r;
-					return d2 < r2 && d2 > 0.0f;
-				});
-				if (iter != e.cend())
+				// https://stackoverflow.com/questions/3349125/circle-circle-intersection-points
+				// http://paulbourke.net/geometry/circlesphere/
+				const auto& fixed = registry.Get<const Fixed>(*iter);
+				const auto d2 = glm::distance2(fixed.boundingCenter, obstacleFixed.boundingCenter);
+				const auto d = glm::sqrt(d2);
+
+				// Vanilla bug: Scaling is already applied to boundingRadius, but they apply scale again
+				const float fixedScale = glm::compMax(registry.Get<const Transform>(*iter).scale);
+				const float obstacleScale = glm::compMax(registry.Get<const Transform>(reference.entity).scale);
+				const auto r0 = fixed.boundingRadius * fixedScale;
+				const auto r1 = obstacleFixed.boundingRadius * obstacleScale;
+
+				const auto r02 = r0 * r0;
+				const auto r12 = r1 * r1;
+				const auto p0 = fixed.boundingCenter;
+				const auto p1 = obstacleFixed.boundingCenter;
+				const auto a = (r02 - r12 + d2) / (2.0f * d); // first circle to intersection midpoint
+				const auto h = glm::sqrt(r02 - a * a);        // half height of intersection area
+				const auto p2 = p0 + a * (p1 - p0) / d;       // midpoint of overlap
+				const auto diff = p1 - p0;
+				const auto difft = glm::vec2(diff.y, -diff.x); // 90 degree rotation
+				const auto p3 = p2 + h * difft / d;
+				const auto p4 = p2 - h * difft / d;
+
+				const auto v0 = p3 - obstacleFixed.boundingCenter;
+				const auto v1 = p4 - obstacleFixed.boundingCenter;
+				const auto n0 = glm::normalize(v0);
+				const auto n1 = glm::normalize(v1);
+				const auto dp0 = glm::dot(n0, circleNormal);
+				const auto dp1 = glm::dot(n1, circleNormal);
+				const auto cp0 = glm::cross(glm::vec3(n0, 0.0f), glm::vec3(circleNormal, 0.0f)).z;
+				const auto cp1 = glm::cross(glm::vec3(n1, 0.0f), glm::vec3(circleNormal, 0.0f)).z;
+				auto angle0 = glm::acos(dp0);
+				auto angle1 = glm::acos(dp1);
+
+				if ((cp0 > 0.0f) ^ clockwise)
+				{
+					angle0 = 2.0f * glm::pi<float>() - angle0;
+				}
+				if ((cp1 > 0.0f) ^ clockwise)
 				{
-					// https://stackoverflow.com/questions/3349125/circle-circle-intersection-points
-					// http://paulbourke.net/geometry/circlesphere/
-					const auto& fixed = registry.Get<const Fixed>(*iter);
-					const auto d2 = glm::distance2(fixed.boundingCenter, obstacleFixed.boundingCenter);
-					const auto d = glm::sqrt(d2);
-
-					// Vanilla bug: Scaling is already applied to boundingRadius, but they apply scale again
-					const float fixedScale = glm::compMax(registry.Get<const Transform>(*iter).scale);
-					const float obstacleScale = glm::compMax(registry.Get<const Transform>(reference.entity).scale);
-					const auto r0 = fixed.boundingRadius * fixedScale;
-					const auto r1 = obstacleFixed.boundingRadius * obstacleScale;
-
-					const auto r02 = r0 * r0;
-					const auto r12 = r1 * r1;
-					const auto p0 = fixed.boundingCenter;
-					const auto p1 = obstacleFixed.boundingCenter;
-					const auto a = (r02 - r12 + d2) / (2.0f * d); // first circle to intersection midpoint
-					const auto h = glm::sqrt(r02 - a * a);        // half height of intersection area
-					const auto p2 = p0 + a * (p1 - p0) / d;       // midpoint of overlap
-					const auto diff = p1 - p0;
-					const auto difft = glm::vec2(diff.y, -diff.x); // 90 degree rotation
-					const auto p3 = p2 + h * difft / d;
-					const auto p4 = p2 - h * difft / d;
-
-					const auto v0 = p3 - obstacleFixed.boundingCenter;
-					const auto v1 = p4 - obstacleFixed.boundingCenter;
-					const auto n0 = glm::normalize(v0);
-					const auto n1 = glm::normalize(v1);
-					const auto dp0 = glm::dot(n0, circleNormal);
-					const auto dp1 = glm::dot(n1, circleNormal);
-					const auto cp0 = glm::cross(glm::vec3(n0, 0.0f), glm::vec3(circleNormal, 0.0f)).z;
-					const auto cp1 = glm::cross(glm::vec3(n1, 0.0f), glm::vec3(circleNormal, 0.0f)).z;
-					auto angle0 = glm::acos(dp0);
-					auto angle1 = glm::acos(dp1);
-
-					if ((cp0 > 0.0f) ^ clockwise)
-					{
-						angle0 = 2.0f * glm::pi<float>() - angle0;
-					}
-					if ((cp1 > 0.0f) ^ clockwise)
-					{
-						angle1 = 2.0f * glm::pi<float>() - angle1;
-					}
-
-					const auto t0 = angle0 * 2.0f / 3.0f * r1 / wallHug.speed;
-					const auto t1 = angle1 * 2.0f / 3.0f * r1 / wallHug.speed;
-					int t = static_cast<int>(glm::round(glm::min(t0, t1)));
-
-					assert(t >= 0);
-					if (t < 1)
-					{
-						// We're too close to second circle. Act like we're on the second circle and continue looking forward by
-						// recursively calling function with new obstacle.
-						reference.entity = *iter;
-						found = false; // will do another loop
-					}
-					else if (t < 4)
-					{
-						t = 0;
-						found = true;
-					}
-					else
-					{
-						t = glm::min(t, 255);
-						found = true;
-					}
-
-					reference.stepsAway = static_cast<uint8_t>(t);
+					angle1 = 2.0f * glm::pi<float>() - angle1;
+				}
+
+				const auto t0 = angle0 * 2.0f / 3.0f * r1 / wallHug.speed;
+				const auto t1 = angle1 * 2.0f / 3.0f * r1 / wallHug.speed;
+				int t = static_cast<int>(glm::round(glm::min(t0, t1)));
+
+				assert(t >= 0);
+				if (t < 1)
+				{
+					// We're too close to second circle. Act like we're on the second circle and continue looking forward by
+					// recursively calling function with new obstacle.
+					reference.entity = *iter;
+					found = false; // will do another loop
+				}
+				else if (t < 4)
+				{
+					t = 0;
+					found = true;
 				}
 				else
 				{
-					// TODO(bwrsandman):
-					// if intersect[0].obj is None:  # True
-					//     self.init_steps_xz()
-					//     # self.field_0x78 = 0x10
-					//     self.circle_hug_info.reset(self)
-					//     self.move_state = MoveState.STEP_THROUGH
-					// assert(false);
+					t = glm::min(t, 255);
 					found = true;
 				}
+
+				reference.stepsAway = static_cast<uint8_t>(t);
+			}
+			else
+			{
+				// TODO(bwrsandman):
+				// if intersect[0].obj is None:  # True
+				//     self.init_steps_xz()
+				//     # self.field_0x78 = 0x10
+				//     self.circle_hug_info.reset(self)
+				//     self.move_state = MoveState.STEP_THROUGH
+				// assert(false);
+				found = true;
 			}
 		}
 		if (found)
@@ -317,10 +300,11 @@ bool OrbitScanForObstacle(entt::entity entity, bool clockwise, Transform& transf
 }
 
 template <MoveState S, typename... Exclude>
-void StepForward(ecs::Registry& registry, Exclude... exclude)
+void StepForward(JobSystem& jobSystem, ecs::Registry& registry, Exclude... exclude)
 {
-	registry.Each<MoveStateTagComponent<S>, const WallHug, Transform>(
-	    [](MoveStateTagComponent<S>& state, const WallHug& wallHug, const Transform& transform) {
+	ParallelEach<MoveStateTagComponent<S>, const WallHug, const Transform>(
+	    jobSystem, registry,
+	    [](CommandBuffer&, entt::entity, MoveStateTagComponent<S>& state, const WallHug& wallHug, const Transform& transform) {
 		    const auto goal = glm::xz(transform.position) + wallHug.step;
 		    state.stepGoal = goal;
 	    },
@@ -328,35 +312,46 @@ void StepForward(ecs::Registry& registry, Exclude... exclude)
 }
 
 template <MoveState S>
-bool CellTransition(entt::entity entity, const MoveStateTagComponent<S>& state, Transform& transform, WallHug& wallHug);
+bool CellTransition(CommandBuffer& commands, entt::entity entity, const MoveStateTagComponent<S>& state, Transform& transform,
+                    WallHug& wallHug);
 
 template <>
-bool CellTransition(entt::entity entity, [[maybe_unused]] const MoveStateTagComponent<MoveState::Linear>& state,
-                    Transform& transform, WallHug& wallHug)
+bool CellTransition(CommandBuffer& commands, entt::entity entity,
+                    [[maybe_unused]] const MoveStateTagComponent<MoveState::Linear>& state, Transform& transform,
+                    WallHug& wallHug)
 {
 	InitializeStepToGoal(transform, wallHug);
-	return LinearScanForObstacle(entity, glm::xz(transform.position), wallHug.step);
+	commands.SetDirty(entity);
+	return LinearScanForObstacle(commands, entity, glm::xz(transform.position), wallHug.step);
 }
 
 template <>
-bool CellTransition(entt::entity entity, const MoveStateTagComponent<MoveState::Orbit>& state, Transform& transform,
-                    WallHug& wallHug)
+bool CellTransition(CommandBuffer& commands, entt::entity entity, const MoveStateTagComponent<MoveState::Orbit>& state,
+                    Transform& transform, WallHug& wallHug)
 {
-	return OrbitScanForObstacle(entity, state.clockwise == MoveStateClockwise::Clockwise, transform, wallHug);
+	if (OrbitScanForObstacle(entity, state.clockwise == MoveStateClockwise::Clockwise, transform, wallHug))
+	{
+		// Turned around the obstacle
+		commands.SetDirty(entity);
+		return true;
+	}
+	return false;
 }
 
 /// Transition from one grid cell to another requires another check for obstacle in the line
 template <MoveState S>
-void HandleCellTransition(ecs::Registry& registry)
+void HandleCellTransition(JobSystem& jobSystem, ecs::Registry& registry)
 {
-	registry.Each<const MoveStateTagComponent<S>, WallHug, Transform>(
-	    [](entt::entity entity, const MoveStateTagComponent<S>& state, WallHug& wallHug, Transform& transform) {
+	ParallelEach<const MoveStateTagComponent<S>, WallHug, Transform>(
+	    jobSystem, registry,
+	    [](CommandBuffer& commands, entt::entity entity, const MoveStateTagComponent<S>& state, WallHug& wallHug,
+	       Transform& transform) {
 		    const auto position = glm::xz(transform.position);
 		    const auto positionId = MapInterface::GetGridCell(position);
 		    const auto goalId = MapInterface::GetGridCell(state.stepGoal);
 		    if (positionId != goalId)
 		    {
-			    CellTransition(entity, state, transform, wallHug);
+			    CellTransition(commands, entity, state, transform, wallHug);
 		    }
 	    });
 }
@@ -364,12 +359,14 @@ void HandleCellTransition(ecs::Registry& registry)
 // TODO(bwrsandman): Vanilla is more complex than this. Update to the map might be needed when transitioning from one block to
 // the other.
 template <MoveState S, typename... Exclude>
-void ApplyStepGoal(ecs::Registry& registry, Exclude... exclude)
+void ApplyStepGoal(JobSystem& jobSystem, ecs::Registry& registry, Exclude... exclude)
 {
-	registry.Each<const MoveStateTagComponent<S>, Transform>(
-	    [](const MoveStateTagComponent<S>& state, Transform& transform) {
+	ParallelEach<const MoveStateTagComponent<S>, Transform>(
+	    jobSystem, registry,
+	    [](CommandBuffer& commands, entt::entity entity, const MoveStateTagComponent<S>& state, Transform& transform) {
 		    const float altitude = Locator::terrainSystem::value().GetHeightAt(state.stepGoal);
 		    transform.position = glm::xzy(glm::vec3(state.stepGoal, altitude));
+		    commands.SetDirty(entity);
 	    },
 	    exclude...);
 }
@@ -379,25 +376,30 @@ void ApplyStepGoal(ecs::Registry& registry, Exclude... exclude)
 void PathfindingSystem::Update()
 {
 	auto& registry = Locator::entitiesRegistry::value();
+	auto& jobSystem = Locator::jobSystem::value();
 
 	// 1.  ARRIVED:
 	//         If AreWeThere is false, set to STEP_THROUGH (and it will trigger following steps)
-	registry.Each<const MoveStateArrivedTag, const Transform, const WallHug>(
-	    [&registry](entt::entity entity, const MoveStateArrivedTag& state, const Transform& transform, const WallHug& wallHug) {
+	ParallelEach<const MoveStateArrivedTag, const Transform, const WallHug>(
+	    jobSystem, registry,
+	    [](CommandBuffer& commands, entt::entity entity, const MoveStateArrivedTag& state, const Transform& transform,
+	       const WallHug& wallHug) {
 		    if (AreWeThere(glm::xz(transform.position), wallHug.goal, wallHug.speed))
 		    {
-			    registry.SwapComponents<MoveStateStepThroughTag>(entity, state, state.clockwise);
+			    commands.SwapComponents<MoveStateStepThroughTag, MoveStateArrivedTag>(entity, state.clockwise);
 		    }
 	    });
 
 	// 2.  LINEAR, LINEAR_CW, LINEAR_CCW
 	//         If this is the first turn and there is step size defined
-	registry.Each<const MoveStateLinearTag, Transform, WallHug>(
-	    [](entt::entity entity, const MoveStateLinearTag&, Transform& transform, WallHug& wallHug) {
+	ParallelEach<const MoveStateLinearTag, Transform, WallHug>(
+	    jobSystem, registry,
+	    [](CommandBuffer& commands, entt::entity entity, const MoveStateLinearTag&, Transform& transform, WallHug& wallHug) {
 		    if (wallHug.step == glm::vec2(0.0f, 0.0))
 		    {
 			    InitializeStepToGoal(transform, wallHug);
-			    LinearScanForObstacle(entity, glm::xz(transform.position), wallHug.step);
+			    commands.SetDirty(entity);
+			    LinearScanForObstacle(commands, entity, glm::xz(transform.position), wallHug.step);
 		    }
 	    },
 	    entt::exclude<WallHugObjectReference>);
@@ -435,30 +437,31 @@ void PathfindingSystem::Update()
 
 	// 4a. STEP_THROUGH, EXIT_CIRCLE_CW, EXIT_CIRCLE_CCW, LINEAR without obstacles:
 	//         Do StepForward and ApplyStepGoal for the step distance -> no change to state
-	StepForward<MoveState::StepThrough>(registry);
-	StepForward<MoveState::ExitCircle>(registry);
-	ApplyStepGoal<MoveState::StepThrough>(registry);
-	ApplyStepGoal<MoveState::ExitCircle>(registry);
+	StepForward<MoveState::StepThrough>(jobSystem, registry);
+	StepForward<MoveState::ExitCircle>(jobSystem, registry);
+	ApplyStepGoal<MoveState::StepThrough>(jobSystem, registry);
+	ApplyStepGoal<MoveState::ExitCircle>(jobSystem, registry);
 
 	// 4b. FINAL_STEP, ARRIVED:
 	//         Do ApplyStepGoal for the remaining distance to the goal and return a message to change LIVING STATE
 	//         exclude from next parts -> no change to state
-	ApplyStepGoal<MoveState::FinalStep>(registry);
-	ApplyStepGoal<MoveState::Arrived>(registry);
+	ApplyStepGoal<MoveState::FinalStep>(jobSystem, registry);
+	ApplyStepGoal<MoveState::Arrived>(jobSystem, registry);
 
 	// 4c. ORBIT_CW, ORBIT_CCW:
-	registry.Each<const MoveStateOrbitTag, const WallHugObjectReference, WallHug, Transform>(
-	    [&registry](const MoveStateOrbitTag& state, const WallHugObjectReference& reference, WallHug& wallHug,
-	                Transform& transform) {
+	ParallelEach<const MoveStateOrbitTag, const WallHugObjectReference, WallHug, Transform>(
+	    jobSystem, registry,
+	    [&registry](CommandBuffer&, entt::entity, const MoveStateOrbitTag& state, const WallHugObjectReference& reference,
+	                WallHug& wallHug, Transform& transform) {
 		    IterateStepAroundObstacle(transform, wallHug, registry.Get<Fixed>(reference.entity),
 		                              state.clockwise == MoveStateClockwise::Clockwise);
 	    });
-	StepForward<MoveState::Orbit>(registry);
-	HandleCellTransition<MoveState::Orbit>(registry);
+	StepForward<MoveState::Orbit>(jobSystem, registry);
+	HandleCellTransition<MoveState::Orbit>(jobSystem, registry);
 	// Decrement turns to object, remove reference once at 0, 0xFF means there is obstacle
 	// TODO(#500): split WallHugObjectReference into FutureObstacle and HuggedObstacle
-	registry.Each<const MoveStateOrbitTag, WallHugObjectReference>(
-	    [](const MoveStateOrbitTag&, WallHugObjectReference& reference) {
+	ParallelEach<const MoveStateOrbitTag, WallHugObjectReference>(
+	    jobSystem, registry, [](CommandBuffer&, entt::entity, const MoveStateOrbitTag&, WallHugObjectReference& reference) {
 		    if (reference.stepsAway == std::numeric_limits<decltype(reference.stepsAway)>::max())
 		    {
 			    return;
@@ -480,16 +483,18 @@ void PathfindingSystem::Update()
 			throw std::runtime_error("TODO: probably transitioning to another circle, scan and select new reference");
 		}
 	});
-	ApplyStepGoal<MoveState::Orbit>(registry);
+	ApplyStepGoal<MoveState::Orbit>(jobSystem, registry);
 	// Check if it's time to exit circle hug
-	registry.Each<const MoveStateOrbitTag, WallHug, Transform, WallHugObjectReference>(
-	    [&registry](entt::entity entity, const MoveStateOrbitTag& state, WallHug& wallHug, Transform& transform,
-	                WallHugObjectReference& reference) {
+	ParallelEach<const MoveStateOrbitTag, WallHug, Transform, WallHugObjectReference>(
+	    jobSystem, registry,
+	    [&registry](CommandBuffer& commands, entt::entity entity, const MoveStateOrbitTag& state, WallHug& wallHug,
+	                Transform& transform, WallHugObjectReference& reference) {
 		    const auto pos = glm::xz(transform.position);
 		    if (AreWeThere(pos, wallHug.goal, 0.0f))
 		    {
-			    registry.SwapComponents<MoveStateFinalStepTag>(entity, state, MoveStateClockwise::Undefined, wallHug.goal);
-			    registry.Remove<WallHugObjectReference>(entity);
+			    commands.SwapComponents<MoveStateFinalStepTag, MoveStateOrbitTag>(entity, MoveStateClockwise::Undefined,
+			                                                                     wallHug.goal);
+			    commands.Remove<WallHugObjectReference>(entity);
 		    }
 
 		    const auto diff = pos - wallHug.goal;
@@ -511,18 +516,20 @@ void PathfindingSystem::Update()
 		    const auto& obstacle = registry.Get<const Fixed>(reference.entity);
 		    const auto normal = pos - obstacle.boundingCenter;
 		    InitializeStep(transform, wallHug, glm::atan(normal.y, normal.x));
+		    commands.SetDirty(entity);
 		    // Add exit tag, current tag stay to avoid 6. and is removed after
-		    registry.Assign<MoveStateExitCircleTag>(entity, state.clockwise, state.stepGoal);
+		    commands.Assign<MoveStateExitCircleTag>(entity, state.clockwise, state.stepGoal);
 	    });
 
 	// 4d. LINEAR, LINEAR_CW, LINEAR_CCW:
 	//         Do move_to_circle_hug (complex) -> can change state to ORBIT*
-	StepForward<MoveState::Linear>(registry);
-	HandleCellTransition<MoveState::Linear>(registry);
+	StepForward<MoveState::Linear>(jobSystem, registry);
+	HandleCellTransition<MoveState::Linear>(jobSystem, registry);
 	// Decrement turns to object, transition to orbit at 0
-	registry.Each<const MoveStateLinearTag, Transform, WallHug, WallHugObjectReference>(
-	    [&registry](entt::entity entity, const MoveStateLinearTag& state, Transform& transform, WallHug& wallHug,
-	                WallHugObjectReference& reference) {
+	ParallelEach<const MoveStateLinearTag, Transform, WallHug, WallHugObjectReference>(
+	    jobSystem, registry,
+	    [&registry](CommandBuffer& commands, entt::entity entity, const MoveStateLinearTag& state, Transform& transform,
+	                WallHug& wallHug, WallHugObjectReference& reference) {
 		    assert(reference.stepsAway != 0xFF); // In this case, the component should have been removed
 		    if (reference.stepsAway == 0)
 		    {
@@ -537,14 +544,17 @@ void PathfindingSystem::Update()
 				    clockwise = sin > 0.0f ? MoveStateClockwise::Clockwise : MoveStateClockwise::CounterClockwise;
 			    }
 			    // Add orbit, remove linear later
-			    auto& newState = registry.Assign<MoveStateOrbitTag>(entity, clockwise, state.stepGoal);
+			    commands.Assign<MoveStateOrbitTag>(entity, clockwise, state.stepGoal);
 			    reference.stepsAway = std::numeric_limits<decltype(reference.stepsAway)>::max(); // FIXME: useless value
 			    // TODO(#500): reference.entity should probably be put in another component
 			    // registry.Remove<WallHugObjectReference>(entity);
 			    // registry.Remove<MoveStateLinearTag>(entity); // TODO(#500): Maybe do this later
 
 			    // TODO(bwrsandman): perhaps move this to another Each call
-			    OrbitScanForObstacle(entity, newState.clockwise == MoveStateClockwise::Clockwise, transform, wallHug);
+			    if (OrbitScanForObstacle(entity, clockwise == MoveStateClockwise::Clockwise, transform, wallHug))
+			    {
+				    commands.SetDirty(entity);
+			    }
 		    }
 		    else
 		    {
@@ -552,21 +562,24 @@ void PathfindingSystem::Update()
 		    }
 	    });
 
-	ApplyStepGoal<MoveState::Linear>(registry);
+	ApplyStepGoal<MoveState::Linear>(jobSystem, registry);
 	// Clean-up: Remove those which have been transitioned
+	CommandBuffer cleanup;
 	registry.Each<const MoveStateLinearTag, const MoveStateOrbitTag>(
-	    [&registry](entt::entity entity, const MoveStateLinearTag, const MoveStateOrbitTag) {
-		    registry.Remove<MoveStateLinearTag>(entity);
+	    [&cleanup](entt::entity entity, const MoveStateLinearTag, const MoveStateOrbitTag) {
+		    cleanup.Remove<MoveStateLinearTag>(entity);
 	    });
+	registry.Playback(cleanup);
 
 	// 5.  NOT(FINAL_STEP, ARRIVED): ** PRIOR TO ANY CHANGE OF THE ABOVE STEPS (4c):
 	//         if AreWeThere(): sets to FINAL_STEP
-	registry.Each<WallHug, const Transform>(
-	    [&registry](entt::entity entity, WallHug& wallHug, const Transform& transform) {
+	ParallelEach<WallHug, const Transform>(
+	    jobSystem, registry,
+	    [](CommandBuffer& commands, entt::entity entity, WallHug& wallHug, const Transform& transform) {
 		    if (AreWeThere(glm::xz(transform.position), wallHug.goal, wallHug.speed))
 		    {
-			    registry.Assign<MoveStateFinalStepTag>(entity, MoveStateClockwise::Undefined, wallHug.goal);
-			    registry.Remove<MoveStateLinearTag, MoveStateOrbitTag, MoveStateExitCircleTag, MoveStateStepThroughTag>(entity);
+			    commands.Assign<MoveStateFinalStepTag>(entity, MoveStateClockwise::Undefined, wallHug.goal);
+			    commands.Remove<MoveStateLinearTag, MoveStateOrbitTag, MoveStateExitCircleTag, MoveStateStepThroughTag>(entity);
 		    }
 	    },
 	    entt::exclude<MoveStateFinalStepTag, MoveStateArrivedTag>);
@@ -574,8 +587,9 @@ void PathfindingSystem::Update()
 	// 6.  EXIT_CIRCLE_CW, EXIT_CIRCLE_CCW ** PRIOR TO ANY CHANGE OF THE ABOVE STEPS (4c):
 	//         if the distance to obstacle is greater than the radius of the circle: set to LINEAR_(C)CW and do
 	//         linear_square_sweep
-	registry.Each<const MoveStateExitCircleTag, WallHug, const WallHugObjectReference, Transform>(
-	    [&registry](entt::entity entity, const MoveStateExitCircleTag& state, WallHug& wallHug,
+	ParallelEach<const MoveStateExitCircleTag, WallHug, const WallHugObjectReference, Transform>(
+	    jobSystem, registry,
+	    [&registry](CommandBuffer& commands, entt::entity entity, const MoveStateExitCircleTag& state, WallHug& wallHug,
 	                const WallHugObjectReference& object, Transform& transform) {
 		    if (object.entity != entt::null && !registry.AnyOf<MoveStateOrbitTag>(entity))
 		    {
@@ -586,8 +600,10 @@ void PathfindingSystem::Update()
 				    if (!AreWeThere(position, fixed.boundingCenter, fixed.boundingRadius))
 				    {
 					    InitializeStepToGoal(transform, wallHug);
-					    registry.SwapComponents<MoveStateLinearTag>(entity, state, state.clockwise, state.stepGoal);
-					    LinearScanForObstacle(entity, position, wallHug.step);
+					    commands.SetDirty(entity);
+					    commands.SwapComponents<MoveStateLinearTag, MoveStateExitCircleTag>(entity, state.clockwise,
+					                                                                        state.stepGoal);
+					    LinearScanForObstacle(commands, entity, position, wallHug.step);
 				    }
 			    }
 		    }
@@ -595,7 +611,8 @@ void PathfindingSystem::Update()
 
 	// Remove leftover tag from orbit to exit circle transition
 	registry.Each<const MoveStateExitCircleTag, const MoveStateOrbitTag>(
-	    [&registry](entt::entity entity, const MoveStateExitCircleTag, const MoveStateOrbitTag) {
-		    registry.Remove<MoveStateOrbitTag>(entity);
+	    [&cleanup](entt::entity entity, const MoveStateExitCircleTag, const MoveStateOrbitTag) {
+		    cleanup.Remove<MoveStateOrbitTag>(entity);
 	    });
+	registry.Playback(cleanup);
 }
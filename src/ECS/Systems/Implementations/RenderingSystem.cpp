@@ -11,6 +11,10 @@
 
 #include "RenderingSystem.h"
 
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
 #include <glm/gtx/transform.hpp>
 
 #include "3D/L3DMesh.h"
@@ -28,20 +32,47 @@
 using namespace openblack::ecs::systems;
 using namespace openblack::ecs::components;
 
+namespace
+{
+/// Smallest range of slots reserved per mesh
+constexpr uint32_t k_MinMeshCapacity = 8;
+/// Minimum number of free slots left at the end of the buffer for new meshes and grown ranges
+constexpr uint32_t k_MinFreeSlots = 256;
+/// Dirty slots which are this close to each other are uploaded in the same update
+constexpr uint32_t k_MaxUploadGap = 16;
+
+uint32_t GetMeshCapacity(uint32_t count)
+{
+	return std::bit_ceil(std::max(count, k_MinMeshCapacity));
+}
+
+glm::mat4 GetModelMatrix(const Transform& transform)
+{
+	auto modelMatrix = glm::mat4(transform.rotation);
+	modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
+	modelMatrix = glm::scale(modelMatrix, transform.scale);
+	return modelMatrix;
+}
+} // namespace
+
 RenderingSystem::~RenderingSystem() = default;
 
+uint32_t RenderingSystem::GetSlotCapacity(bool drawBoundingBox) const
+{
+	const auto size = static_cast<uint32_t>(_renderContext.instanceUniforms.size());
+	return drawBoundingBox ? size / 2 : size;
+}
+
 void RenderingSystem::PrepareDrawDescs(bool drawBoundingBox)
 {
 	auto& registry = Locator::entitiesRegistry::value();
 
 	// Count number of instances
-	uint32_t instanceCount = 0;
 	std::unordered_map<entt::id_type, std::pair<uint32_t, bool>> meshIds;
 
-	auto prep = [&meshIds, &instanceCount](const Mesh& mesh, bool morphWithTerrain) {
-		auto count = meshIds.insert(std::make_pair(mesh.id, std::make_pair(mesh.submeshId, morphWithTerrain)));
+	auto prep = [&meshIds](const Mesh& mesh, bool morphWithTerrain) {
+		auto count = meshIds.insert(std::make_pair(mesh.id, std::make_pair(0u, morphWithTerrain)));
 		count.first->second.first++;
-		instanceCount++;
 	};
 
 	registry.Each<const Mesh, const Transform>([&prep](const Mesh& mesh, const Transform& /*unused*/) { prep(mesh, false); },
@@ -49,6 +80,15 @@ void RenderingSystem::PrepareDrawDescs(bool drawBoundingBox)
 	registry.Each<const Mesh, const Transform, const MorphWithTerrain>(
 	    [&prep](const Mesh& mesh, const Transform& /*unused*/, const MorphWithTerrain& /*unused*/) { prep(mesh, true); });
 
+	// Reserve a range of slots per mesh with room to grow so that adding an instance doesn't move every other mesh
+	uint32_t slotCount = 0;
+	for (const auto& [meshId, desc] : meshIds)
+	{
+		slotCount += GetMeshCapacity(desc.first);
+	}
+	slotCount += std::max(slotCount / 4, k_MinFreeSlots);
+
+	uint32_t instanceCount = slotCount;
 	if (drawBoundingBox)
 	{
 		instanceCount *= 2;
@@ -61,14 +101,7 @@ void RenderingSystem::PrepareDrawDescs(bool drawBoundingBox)
 		{
 			bgfx::destroy(_renderContext.instanceUniformBuffer);
 		}
-		bgfx::VertexLayout layout;
-		layout.begin()
-		    .add(bgfx::Attrib::TexCoord7, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord6, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord5, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord4, 4, bgfx::AttribType::Float)
-		    .end();
-		_renderContext.instanceUniformBuffer = bgfx::createDynamicVertexBuffer(instanceCount, layout);
+		_renderContext.instanceUniformBuffer = CreateInstanceUniformBuffer(instanceCount);
 		_renderContext.instanceUniforms.resize(instanceCount);
 	}
 
@@ -77,10 +110,13 @@ void RenderingSystem::PrepareDrawDescs(bool drawBoundingBox)
 	_renderContext.instancedDrawDescs.clear();
 	for (const auto& [meshId, desc] : meshIds)
 	{
+		const auto capacity = GetMeshCapacity(desc.first);
 		_renderContext.instancedDrawDescs.emplace(std::piecewise_construct, std::forward_as_tuple(meshId),
-		                                          std::forward_as_tuple(offset, desc.first, desc.second));
-		offset += desc.first;
+		                                          std::forward_as_tuple(offset, desc.first, capacity, desc.second));
+		offset += capacity;
 	}
+	_slotsReserved = offset;
+	_freeSlots.clear();
 }
 
 void RenderingSystem::PrepareDrawUploadUniforms(bool drawBoundingBox)
@@ -90,25 +126,21 @@ void RenderingSystem::PrepareDrawUploadUniforms(bool drawBoundingBox)
 	// Store offsets of uniforms for descs
 	std::map<entt::id_type, uint32_t> uniformOffsets;
 
+	_instanceSlots.clear();
+	_dirtySlots.clear();
+	ResetSlots(GetSlotCapacity(drawBoundingBox));
+	std::fill(_renderContext.instanceUniforms.begin(), _renderContext.instanceUniforms.end(), glm::mat4(0.0f));
+
 	// Set transforms for instanced draw at offsets
 	registry.Each<const Mesh, const Transform>(
-	    [this, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform) {
+	    [this, &uniformOffsets, drawBoundingBox](entt::entity entity, const Mesh& mesh, const Transform& transform) {
 		    auto offset = uniformOffsets.insert(std::make_pair(mesh.id, 0));
 		    auto desc = _renderContext.instancedDrawDescs.find(mesh.id);
 
-		    auto modelMatrix = glm::mat4(transform.rotation);
-		    modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
-		    modelMatrix = glm::scale(modelMatrix, transform.scale);
-
 		    const uint32_t idx = desc->second.offset + offset.first->second;
-		    _renderContext.instanceUniforms[idx] = modelMatrix;
-		    if (drawBoundingBox)
-		    {
-			    auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
-			    auto box = l3dMesh->GetBoundingBox();
-			    auto boxMatrix = modelMatrix * glm::translate(box.Center()) * glm::scale(box.Size());
-			    _renderContext.instanceUniforms[idx + _renderContext.instanceUniforms.size() / 2] = boxMatrix;
-		    }
+		    WriteInstance(idx, mesh.id, transform, drawBoundingBox);
+		    _instanceSlots.emplace(entity, InstanceSlot {mesh.id, idx});
+		    AssignSlot(idx, entity);
 		    offset.first->second++;
 	    },
 	    entt::exclude<TempleInteriorPart>);
@@ -118,4 +150,241 @@ void RenderingSystem::PrepareDrawUploadUniforms(bool drawBoundingBox)
 		const auto size = static_cast<uint32_t>(_renderContext.instanceUniforms.size() * sizeof(glm::mat4));
 		bgfx::update(_renderContext.instanceUniformBuffer, 0, bgfx::makeRef(_renderContext.instanceUniforms.data(), size));
 	}
+	_dirtySlots.clear();
+}
+
+void RenderingSystem::PrepareDrawUpdateInstances(bool drawBoundingBox)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+
+	for (const auto entity : _dirtyEntities)
+	{
+		const bool renderable = registry.Valid(entity) && registry.AllOf<Mesh, Transform>(entity) &&
+		                        !registry.AnyOf<TempleInteriorPart>(entity);
+
+		auto slot = _instanceSlots.find(entity);
+		if (slot != _instanceSlots.end())
+		{
+			if (renderable && slot->second.meshId == registry.Get<const Mesh>(entity).id)
+			{
+				WriteInstance(slot->second.index, slot->second.meshId, registry.Get<const Transform>(entity), drawBoundingBox);
+				continue;
+			}
+			RemoveInstance(entity, drawBoundingBox);
+		}
+
+		if (renderable)
+		{
+			const auto& mesh = registry.Get<const Mesh>(entity);
+			if (!AddInstance(entity, mesh.id, registry.AllOf<MorphWithTerrain>(entity), drawBoundingBox))
+			{
+				// Out of free slots, lay out every mesh again with more room
+				PrepareDrawDescs(drawBoundingBox);
+				PrepareDrawUploadUniforms(drawBoundingBox);
+				return;
+			}
+		}
+	}
+
+	UploadDirtySlots(drawBoundingBox);
+}
+
+void RenderingSystem::WriteInstance(uint32_t index, entt::id_type meshId, const Transform& transform, bool drawBoundingBox)
+{
+	const auto modelMatrix = GetModelMatrix(transform);
+	_renderContext.instanceUniforms[index] = modelMatrix;
+	if (drawBoundingBox)
+	{
+		auto l3dMesh = Locator::resources::value().GetMeshes().Handle(meshId);
+		auto box = l3dMesh->GetBoundingBox();
+		auto boxMatrix = modelMatrix * glm::translate(box.Center()) * glm::scale(box.Size());
+		_renderContext.instanceUniforms[index + _renderContext.instanceUniforms.size() / 2] = boxMatrix;
+	}
+	_dirtySlots.push_back(index);
+}
+
+void RenderingSystem::MoveInstance(uint32_t from, uint32_t to, bool drawBoundingBox)
+{
+	auto& uniforms = _renderContext.instanceUniforms;
+	uniforms[to] = uniforms[from];
+	if (drawBoundingBox)
+	{
+		uniforms[to + uniforms.size() / 2] = uniforms[from + uniforms.size() / 2];
+	}
+	_instanceSlots.at(_slotEntities[from]).index = to;
+	MoveSlot(from, to);
+	_dirtySlots.push_back(to);
+	ClearInstance(from, drawBoundingBox);
+}
+
+void RenderingSystem::ClearInstance(uint32_t index, bool drawBoundingBox)
+{
+	auto& uniforms = _renderContext.instanceUniforms;
+	uniforms[index] = glm::mat4(0.0f);
+	if (drawBoundingBox)
+	{
+		uniforms[index + uniforms.size() / 2] = glm::mat4(0.0f);
+	}
+	ClearSlot(index);
+	_dirtySlots.push_back(index);
+}
+
+bool RenderingSystem::AddInstance(entt::entity entity, entt::id_type meshId, bool morphWithTerrain, bool drawBoundingBox)
+{
+	auto desc = _renderContext.instancedDrawDescs.find(meshId);
+	if (desc == _renderContext.instancedDrawDescs.end() || desc->second.count == desc->second.capacity)
+	{
+		// Move to a larger range, the old one is released after the instances left it
+		const uint32_t count = desc == _renderContext.instancedDrawDescs.end() ? 0 : desc->second.count;
+		const uint32_t capacity = GetMeshCapacity(count + 1);
+		const auto offset = ReserveSlots(capacity, drawBoundingBox);
+		if (!offset.has_value())
+		{
+			return false;
+		}
+
+		if (desc == _renderContext.instancedDrawDescs.end())
+		{
+			desc = _renderContext.instancedDrawDescs
+			           .emplace(std::piecewise_construct, std::forward_as_tuple(meshId),
+			                    std::forward_as_tuple(*offset, 0, capacity, morphWithTerrain))
+			           .first;
+		}
+		else
+		{
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				MoveInstance(desc->second.offset + i, *offset + i, drawBoundingBox);
+			}
+			ReleaseSlots(desc->second.offset, desc->second.capacity);
+			desc->second.offset = *offset;
+			desc->second.capacity = capacity;
+		}
+	}
+
+	const uint32_t idx = desc->second.offset + desc->second.count;
+	desc->second.count++;
+	_instanceSlots.emplace(entity, InstanceSlot {meshId, idx});
+	_slotEntities[idx] = entity;
+	WriteInstance(idx, meshId, Locator::entitiesRegistry::value().Get<const Transform>(entity), drawBoundingBox);
+
+	return true;
+}
+
+void RenderingSystem::RemoveInstance(entt::entity entity, bool drawBoundingBox)
+{
+	const auto slot = _instanceSlots.at(entity);
+	auto& desc = _renderContext.instancedDrawDescs.at(slot.meshId);
+
+	// Keep the instances of the mesh contiguous by moving the last one into the freed slot
+	const uint32_t last = desc.offset + desc.count - 1;
+	_instanceSlots.erase(entity);
+	if (slot.index != last)
+	{
+		MoveInstance(last, slot.index, drawBoundingBox);
+	}
+	else
+	{
+		ClearInstance(last, drawBoundingBox);
+	}
+	desc.count--;
+}
+
+std::optional<uint32_t> RenderingSystem::ReserveSlots(uint32_t count, bool drawBoundingBox)
+{
+	auto best = _freeSlots.end();
+	for (auto range = _freeSlots.begin(); range != _freeSlots.end(); ++range)
+	{
+		if (range->second >= count && (best == _freeSlots.end() || range->second < best->second))
+		{
+			best = range;
+		}
+	}
+	if (best != _freeSlots.end())
+	{
+		const auto [offset, size] = *best;
+		_freeSlots.erase(best);
+		if (size > count)
+		{
+			_freeSlots.emplace(offset + count, size - count);
+		}
+		return offset;
+	}
+
+	if (_slotsReserved + count > GetSlotCapacity(drawBoundingBox))
+	{
+		return std::nullopt;
+	}
+	const auto offset = _slotsReserved;
+	_slotsReserved += count;
+	return offset;
+}
+
+void RenderingSystem::ReleaseSlots(uint32_t offset, uint32_t count)
+{
+	// Merge with the neighbouring free ranges
+	auto next = _freeSlots.lower_bound(offset);
+	if (next != _freeSlots.end() && offset + count == next->first)
+	{
+		count += next->second;
+		next = _freeSlots.erase(next);
+	}
+	if (next != _freeSlots.begin())
+	{
+		const auto previous = std::prev(next);
+		if (previous->first + previous->second == offset)
+		{
+			offset = previous->first;
+			count += previous->second;
+			_freeSlots.erase(previous);
+		}
+	}
+
+	// A range at the end goes back to the unreserved slots
+	if (offset + count == _slotsReserved)
+	{
+		_slotsReserved = offset;
+		return;
+	}
+	_freeSlots.emplace(offset, count);
+}
+
+void RenderingSystem::UploadDirtySlots(bool drawBoundingBox)
+{
+	if (_dirtySlots.empty())
+	{
+		return;
+	}
+
+	std::sort(_dirtySlots.begin(), _dirtySlots.end());
+	_dirtySlots.erase(std::unique(_dirtySlots.begin(), _dirtySlots.end()), _dirtySlots.end());
+
+	const auto& uniforms = _renderContext.instanceUniforms;
+	const auto boxOffset = static_cast<uint32_t>(uniforms.size() / 2);
+	auto upload = [this, &uniforms, boxOffset, drawBoundingBox](uint32_t first, uint32_t last) {
+		const auto size = static_cast<uint32_t>((last - first + 1) * sizeof(glm::mat4));
+		// Copy rather than reference: the cpu-side list may be modified again before bgfx consumes the update
+		bgfx::update(_renderContext.instanceUniformBuffer, first, bgfx::copy(&uniforms[first], size));
+		if (drawBoundingBox)
+		{
+			bgfx::update(_renderContext.instanceUniformBuffer, first + boxOffset,
+			             bgfx::copy(&uniforms[first + boxOffset], size));
+		}
+	};
+
+	// Merge nearby slots into ranges to keep the number of updates low
+	uint32_t first = _dirtySlots.front();
+	uint32_t last = first;
+	for (const auto slot : _dirtySlots)
+	{
+		if (slot - last > k_MaxUploadGap)
+		{
+			upload(first, last);
+			first = slot;
+		}
+		last = slot;
+	}
+	upload(first, last);
+
+	_dirtySlots.clear();
 }
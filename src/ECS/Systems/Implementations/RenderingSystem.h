@@ -10,6 +10,8 @@
 #pragma once
 
 #include <map>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include <bgfx/bgfx.h>
@@ -22,6 +24,11 @@
 #error "Locator interface implementations should only be included in Locator.cpp, use interface instead."
 #endif
 
+namespace openblack::ecs::components
+{
+struct Transform;
+}
+
 namespace openblack::ecs::systems
 {
 
@@ -31,7 +38,36 @@ class RenderingSystem final: public RenderingSystemCommon
 	~RenderingSystem();
 
 private:
+	struct InstanceSlot
+	{
+		entt::id_type meshId;
+		/// Absolute index into \ref RenderContext::instanceUniforms
+		uint32_t index;
+	};
+
 	void PrepareDrawDescs(bool drawBoundingBox) override;
 	void PrepareDrawUploadUniforms(bool drawBoundingBox) override;
+	void PrepareDrawUpdateInstances(bool drawBoundingBox) override;
+
+	[[nodiscard]] uint32_t GetSlotCapacity(bool drawBoundingBox) const;
+	void WriteInstance(uint32_t index, entt::id_type meshId, const components::Transform& transform, bool drawBoundingBox);
+	void MoveInstance(uint32_t from, uint32_t to, bool drawBoundingBox);
+	void ClearInstance(uint32_t index, bool drawBoundingBox);
+	/// Returns the offset of a range of free slots, preferring the smallest released range which fits
+	[[nodiscard]] std::optional<uint32_t> ReserveSlots(uint32_t count, bool drawBoundingBox);
+	void ReleaseSlots(uint32_t offset, uint32_t count);
+	/// Returns false if the mesh's range had to grow and there is no more room in the instance buffer
+	bool AddInstance(entt::entity entity, entt::id_type meshId, bool morphWithTerrain, bool drawBoundingBox);
+	void RemoveInstance(entt::entity entity, bool drawBoundingBox);
+	void UploadDirtySlots(bool drawBoundingBox);
+
+	/// Which slot of the instance buffer each rendered entity is stored in, inverse of \ref _slotEntities
+	std::unordered_map<entt::entity, InstanceSlot> _instanceSlots;
+	/// Slots after this one have not been reserved by any mesh
+	uint32_t _slotsReserved {0};
+	/// Ranges below \ref _slotsReserved left by meshes which grew, by offset. Adjacent ranges are merged.
+	std::map<uint32_t, uint32_t> _freeSlots;
+	/// Slots which were modified since the last upload
+	std::vector<uint32_t> _dirtySlots;
 };
 } // namespace openblack::ecs::systems
@@ -11,17 +11,36 @@
 
 #include "RenderingSystemCommon.h"
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <utility>
+
+#include <glm/matrix.hpp>
 #include <glm/gtx/transform.hpp>
+#include <spdlog/spdlog.h>
 
+#include "3D/L3DAnim.h"
 #include "3D/L3DMesh.h"
+#include "3D/LandIslandInterface.h"
+#include "Camera/Camera.h"
+#include "Camera/Frustum.h"
+#include "ECS/Components/Animation.h"
+#include "ECS/Components/Footpath.h"
 #include "ECS/Components/Mesh.h"
 #include "ECS/Components/MorphWithTerrain.h"
+#include "ECS/Components/Sprite.h"
 #include "ECS/Components/Stream.h"
 #include "ECS/Components/Temple.h"
 #include "ECS/Components/Transform.h"
 #include "ECS/Registry.h"
+#include "EngineConfig.h"
 #include "Graphics/DebugLines.h"
 #include "Graphics/ShaderManager.h"
+#include "Graphics/Texture2D.h"
 #include "Locator.h"
 #include "Resources/ResourcesInterface.h"
 
@@ -34,9 +53,32 @@ RenderContext::RenderContext()
 }
 RenderContext::~RenderContext()
 {
+	bool destroyed = false;
+	for (auto& view : instancedViews)
+	{
+		if (bgfx::isValid(view.instanceUniformBuffer))
+		{
+			bgfx::destroy(view.instanceUniformBuffer);
+			destroyed = true;
+		}
+	}
 	if (bgfx::isValid(instanceUniformBuffer))
 	{
 		bgfx::destroy(instanceUniformBuffer);
+		destroyed = true;
+	}
+	if (bgfx::isValid(boneTexture))
+	{
+		bgfx::destroy(boneTexture);
+		destroyed = true;
+	}
+	if (bgfx::isValid(spriteInstanceBuffer))
+	{
+		bgfx::destroy(spriteInstanceBuffer);
+		destroyed = true;
+	}
+	if (destroyed)
+	{
 		bgfx::frame();
 		bgfx::frame();
 	}
@@ -44,27 +86,160 @@ RenderContext::~RenderContext()
 
 RenderingSystemCommon::~RenderingSystemCommon() = default;
 
+bgfx::DynamicVertexBufferHandle RenderingSystemCommon::CreateInstanceUniformBuffer(uint32_t count)
+{
+	bgfx::VertexLayout layout;
+	layout.begin()
+	    .add(bgfx::Attrib::TexCoord7, 4, bgfx::AttribType::Float)
+	    .add(bgfx::Attrib::TexCoord6, 4, bgfx::AttribType::Float)
+	    .add(bgfx::Attrib::TexCoord5, 4, bgfx::AttribType::Float)
+	    .add(bgfx::Attrib::TexCoord4, 4, bgfx::AttribType::Float)
+	    .end();
+	return bgfx::createDynamicVertexBuffer(count, layout);
+}
+
+bgfx::DynamicVertexBufferHandle RenderingSystemCommon::CreateViewInstanceBuffer(uint32_t count)
+{
+	bgfx::VertexLayout layout;
+	layout.begin()
+	    .add(bgfx::Attrib::TexCoord7, 4, bgfx::AttribType::Float)
+	    .add(bgfx::Attrib::TexCoord6, 4, bgfx::AttribType::Float)
+	    .add(bgfx::Attrib::TexCoord5, 4, bgfx::AttribType::Float)
+	    .add(bgfx::Attrib::TexCoord4, 4, bgfx::AttribType::Float)
+	    .add(bgfx::Attrib::TexCoord3, 4, bgfx::AttribType::Float)
+	    .end();
+	return bgfx::createDynamicVertexBuffer(count, layout);
+}
+
 void RenderingSystemCommon::SetDirty()
 {
 	_renderContext.dirty = true;
+	_dirtyEntities.clear();
+}
+
+void RenderingSystemCommon::SetDirty(entt::entity entity)
+{
+	// A full rebuild is already pending, no need to track individual entities
+	if (!_renderContext.dirty)
+	{
+		_dirtyEntities.push_back(entity);
+	}
 }
 
-void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams)
+void RenderingSystemCommon::ResetSlots(size_t count)
+{
+	_previousSlots.clear();
+	for (uint32_t i = 0; i < _slotEntities.size(); ++i)
+	{
+		if (_slotEntities[i] != entt::null)
+		{
+			_previousSlots.emplace(_slotEntities[i], i);
+		}
+	}
+	for (size_t v = 0; v < _previousLods.size(); ++v)
+	{
+		auto& lods = _renderContext.instancedViews.at(v).instanceLods;
+		_previousLods.at(v) = std::move(lods);
+		lods.assign(count, 0);
+	}
+	_slotEntities.assign(count, entt::null);
+}
+
+void RenderingSystemCommon::AssignSlot(uint32_t index, entt::entity entity)
+{
+	_slotEntities[index] = entity;
+	const auto previous = _previousSlots.find(entity);
+	if (previous == _previousSlots.end())
+	{
+		return;
+	}
+	for (size_t v = 0; v < _previousLods.size(); ++v)
+	{
+		const auto& previousLods = _previousLods.at(v);
+		if (previous->second < previousLods.size())
+		{
+			_renderContext.instancedViews.at(v).instanceLods[index] = previousLods[previous->second];
+		}
+	}
+}
+
+void RenderingSystemCommon::MoveSlot(uint32_t from, uint32_t to)
+{
+	_slotEntities[to] = _slotEntities[from];
+	for (auto& view : _renderContext.instancedViews)
+	{
+		view.instanceLods[to] = view.instanceLods[from];
+	}
+	ClearSlot(from);
+}
+
+void RenderingSystemCommon::ClearSlot(uint32_t index)
+{
+	_slotEntities[index] = entt::null;
+	for (auto& view : _renderContext.instancedViews)
+	{
+		view.instanceLods[index] = 0;
+	}
+}
+
+void RenderingSystemCommon::PrepareDrawUpdateInstances(bool drawBoundingBox)
+{
+	PrepareDrawDescs(drawBoundingBox);
+	PrepareDrawUploadUniforms(drawBoundingBox);
+}
+
+void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams, bool drawSprites)
 {
 	auto& registry = Locator::entitiesRegistry::value();
 
-	if (_renderContext.dirty || _renderContext.hasBoundingBoxes != drawBoundingBox ||
-	    (_renderContext.footpaths != nullptr) != drawFootpaths || (_renderContext.streams != nullptr) != drawStreams)
+	const bool rebuildInstances = _renderContext.dirty || _renderContext.hasBoundingBoxes != drawBoundingBox;
+	bool rebuildDebugLines = rebuildInstances || (_renderContext.footpaths != nullptr) != drawFootpaths ||
+	                         (_renderContext.streams != nullptr) != drawStreams;
+
+	if (rebuildInstances)
 	{
 		PrepareDrawDescs(drawBoundingBox);
 		PrepareDrawUploadUniforms(drawBoundingBox);
+		++_renderContext.generation;
 
 		_renderContext.boundingBox.reset();
 		if (drawBoundingBox)
 		{
 			_renderContext.boundingBox = graphics::DebugLines::CreateBox(glm::vec4(1.0f, 0.0f, 0.0f, 0.5f));
 		}
+	}
+	else if (!_dirtyEntities.empty())
+	{
+		std::sort(_dirtyEntities.begin(), _dirtyEntities.end());
+		_dirtyEntities.erase(std::unique(_dirtyEntities.begin(), _dirtyEntities.end()), _dirtyEntities.end());
+
+		rebuildDebugLines |= std::any_of(_dirtyEntities.cbegin(), _dirtyEntities.cend(), [&registry](entt::entity entity) {
+			return registry.Valid(entity) && registry.AnyOf<Footpath, Stream>(entity);
+		});
+
+		PrepareDrawUpdateInstances(drawBoundingBox);
+		++_renderContext.generation;
+	}
+	const bool instancesChanged = rebuildInstances || !_dirtyEntities.empty();
+	const bool rebuildSprites = drawSprites && (instancesChanged || !_renderContext.hasSprites);
+	_dirtyEntities.clear();
+	_previousSlots.clear();
+
+	// Palettes only move when the instances do, the views keep their instance data while animations play
+	if (instancesChanged)
+	{
+		AssignBonePalettes();
+	}
+	++_frame;
+
+	if (rebuildSprites)
+	{
+		PrepareDrawSprites();
+	}
+	_renderContext.hasSprites = drawSprites;
 
+	if (rebuildDebugLines)
+	{
 		_renderContext.footpaths.reset();
 		if (drawFootpaths)
 		{
@@ -120,8 +295,391 @@ void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths
 				    graphics::DebugLines::CreateDebugLines(edges.data(), static_cast<uint32_t>(edges.size()));
 			}
 		}
+	}
+
+	_renderContext.dirty = false;
+	_renderContext.hasBoundingBoxes = drawBoundingBox;
+}
+
+void RenderingSystemCommon::PrepareDrawView(graphics::RenderPass viewId, const Camera& camera, bool frustumCulling)
+{
+	const auto& config = Locator::config::value();
+	const auto viewProjection = camera.GetViewProjectionMatrix(Camera::Projection::Normal);
+	const auto lodDistances = config.levelOfDetail ? config.lodDistances
+	                                               : std::array<float, 2> {std::numeric_limits<float>::infinity(),
+	                                                                       std::numeric_limits<float>::infinity()};
+
+	auto& view = _renderContext.instancedViews.at(static_cast<size_t>(viewId));
+	if (view.generation == _renderContext.generation && view.viewProjection == viewProjection &&
+	    view.frustumCulling == frustumCulling && view.lodDistances == lodDistances &&
+	    view.lodHysteresis == config.lodHysteresis)
+	{
+		EvaluateBonePalettes(viewId);
+		return;
+	}
+	view.generation = _renderContext.generation;
+	view.viewProjection = viewProjection;
+	view.frustumCulling = frustumCulling;
+	view.lodDistances = lodDistances;
+	view.lodHysteresis = config.lodHysteresis;
+
+	const Frustum frustum(viewProjection);
+	const auto cameraPosition = glm::vec3(glm::inverse(camera.GetViewMatrix(Camera::Interpolation::Current))[3]);
+	const auto& meshManager = Locator::resources::value().GetMeshes();
+	// Meshes which morph with terrain get their height replaced in the vertex shader
+	const float maxTerrainHeight = std::numeric_limits<uint8_t>::max() * LandIslandInterface::k_HeightUnit;
+
+	view.instanceUniforms.clear();
+	view.instancedDrawDescs.clear();
+	auto& visibleAnimatedInstances = _visibleAnimatedInstances.at(static_cast<size_t>(viewId));
+	visibleAnimatedInstances.clear();
+	std::array<std::vector<RenderContext::ViewInstance>, graphics::L3DMesh::k_MaxLods> buckets;
+	std::array<float, graphics::L3DMesh::k_MaxLods> nearest;
+	for (const auto& [meshId, placers] : _renderContext.instancedDrawDescs)
+	{
+		if (placers.count == 0)
+		{
+			continue;
+		}
+
+		// Bounding sphere of the mesh in model space
+		const auto mesh = meshManager.Handle(meshId);
+		const auto box = mesh->GetBoundingBox();
+		const auto localCenter = glm::vec4(box.Center(), 1.0f);
+		const auto localRadius = 0.5f * glm::length(box.Size());
+		const auto lodCount = mesh->GetLodCount();
+		const auto boned = mesh->IsBoned();
+
+		for (auto& bucket : buckets)
+		{
+			bucket.clear();
+		}
+		nearest.fill(std::numeric_limits<float>::infinity());
+		for (uint32_t i = placers.offset; i < placers.offset + placers.count; ++i)
+		{
+			const auto& model = _renderContext.instanceUniforms[i];
+			const auto center = glm::vec3(model * localCenter);
+			const auto maxScale2 = glm::max(glm::max(glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+			                                         glm::dot(glm::vec3(model[1]), glm::vec3(model[1]))),
+			                                glm::dot(glm::vec3(model[2]), glm::vec3(model[2])));
+			const auto radius = localRadius * glm::sqrt(maxScale2);
+
+			if (frustumCulling)
+			{
+				bool visible;
+				if (placers.morphWithTerrain)
+				{
+					const auto height = center.y - model[3].y;
+					visible = frustum.Intersects(AxisAlignedBoundingBox {
+					    glm::vec3(center.x - radius, glm::min(height, 0.0f) - radius, center.z - radius),
+					    glm::vec3(center.x + radius, glm::max(height, 0.0f) + maxTerrainHeight + radius, center.z + radius),
+					});
+				}
+				else
+				{
+					visible = frustum.Intersects(center, radius);
+				}
+				if (!visible)
+				{
+					if (i < view.instanceLods.size())
+					{
+						view.instanceLods[i] = 0;
+					}
+					continue;
+				}
+			}
+
+			// Pick the level of detail, the band around the previously selected level is widened to avoid popping
+			const uint8_t lod = i < view.instanceLods.size() ? view.instanceLods[i] : 0;
+			const auto distance = glm::distance(cameraPosition, center);
+			uint8_t selected = 0;
+			for (uint8_t level = 0; level + 1 < lodCount && level < lodDistances.size(); ++level)
+			{
+				const auto margin = level < lod ? 1.0f - view.lodHysteresis : 1.0f + view.lodHysteresis;
+				if (distance > lodDistances.at(level) * margin)
+				{
+					selected = level + 1;
+				}
+			}
+			if (i < view.instanceLods.size())
+			{
+				view.instanceLods[i] = selected;
+			}
+
+			// Animated instances read their own palette, the others keep the bind pose
+			auto bones = glm::vec4(-1.0f, 0.0f, 0.0f, 0.0f);
+			const auto animated = boned && i < _slotAnimatedInstances.size() ? _slotAnimatedInstances[i] : k_NotAnimated;
+			if (animated == k_NoPaletteLeft)
+			{
+				continue;
+			}
+			if (animated != k_NotAnimated)
+			{
+				bones.x = static_cast<float>(_animatedInstances[animated].palette);
+				visibleAnimatedInstances.push_back(animated);
+			}
+			buckets.at(selected).push_back({model, bones});
+			nearest.at(selected) = std::min(nearest.at(selected), distance);
+		}
 
-		_renderContext.dirty = false;
-		_renderContext.hasBoundingBoxes = drawBoundingBox;
+		for (uint8_t level = 0; level < lodCount; ++level)
+		{
+			const auto& bucket = buckets.at(level);
+			if (bucket.empty())
+			{
+				continue;
+			}
+			const auto offset = static_cast<uint32_t>(view.instanceUniforms.size());
+			const auto count = static_cast<uint32_t>(bucket.size());
+			view.instanceUniforms.insert(view.instanceUniforms.end(), bucket.cbegin(), bucket.cend());
+			auto& drawDesc =
+			    view.instancedDrawDescs
+			        .emplace(std::piecewise_construct, std::forward_as_tuple(meshId, level),
+			                 std::forward_as_tuple(offset, count, count, placers.morphWithTerrain))
+			        .first->second;
+			drawDesc.distance = nearest.at(level);
+		}
+	}
+
+	EvaluateBonePalettes(viewId);
+	if (view.instanceUniforms.empty())
+	{
+		return;
+	}
+
+	const auto instanceCount = static_cast<uint32_t>(view.instanceUniforms.size());
+	if (view.bufferCapacity < instanceCount)
+	{
+		if (bgfx::isValid(view.instanceUniformBuffer))
+		{
+			bgfx::destroy(view.instanceUniformBuffer);
+		}
+		view.bufferCapacity = std::bit_ceil(instanceCount);
+		view.instanceUniformBuffer = CreateViewInstanceBuffer(view.bufferCapacity);
 	}
+	bgfx::update(view.instanceUniformBuffer, 0,
+	             bgfx::copy(view.instanceUniforms.data(), instanceCount * sizeof(view.instanceUniforms[0])));
+}
+
+void RenderingSystemCommon::PrepareDrawSprites()
+{
+	auto& registry = Locator::entitiesRegistry::value();
+
+	struct Entry
+	{
+		uint16_t texture;
+		RenderContext::SpriteInstance instance;
+		glm::vec4 bounds;
+	};
+	std::vector<Entry> entries;
+	entries.reserve(registry.Size<Sprite>());
+	registry.Each<const Sprite, const Transform>([&entries](const Sprite& sprite, const Transform& transform) {
+		// The sprite plane spans [-1, 1] on its local x and y axes
+		entries.push_back({
+		    sprite.texture->GetNativeHandle().idx,
+		    {
+		        {
+		            glm::vec4(transform.rotation[0] * transform.scale.x, transform.position.x),
+		            glm::vec4(transform.rotation[1] * transform.scale.y, transform.position.y),
+		            glm::vec4(transform.rotation[2] * transform.scale.z, transform.position.z),
+		        },
+		        glm::vec4(sprite.uvExtent, sprite.uvMin),
+		        sprite.tint,
+		    },
+		    glm::vec4(transform.position, glm::length(transform.scale)),
+		});
+	});
+	// Group by texture so that each texture is a single instanced draw
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.texture < b.texture; });
+
+	auto& instances = _renderContext.spriteInstances;
+	auto& bounds = _renderContext.spriteBounds;
+	instances.clear();
+	bounds.clear();
+	_renderContext.spriteDrawDescs.clear();
+	for (const auto& entry : entries)
+	{
+		const auto index = static_cast<uint32_t>(instances.size());
+		auto desc = _renderContext.spriteDrawDescs.try_emplace(entry.texture, index, 0, 0, false).first;
+		desc->second.count++;
+		desc->second.capacity++;
+		instances.push_back(entry.instance);
+		bounds.push_back(entry.bounds);
+	}
+
+	if (instances.empty())
+	{
+		return;
+	}
+
+	const auto instanceCount = static_cast<uint32_t>(instances.size());
+	if (_renderContext.spriteBufferCapacity < instanceCount)
+	{
+		if (bgfx::isValid(_renderContext.spriteInstanceBuffer))
+		{
+			bgfx::destroy(_renderContext.spriteInstanceBuffer);
+		}
+		_renderContext.spriteBufferCapacity = std::bit_ceil(instanceCount);
+		_renderContext.spriteInstanceBuffer = CreateViewInstanceBuffer(_renderContext.spriteBufferCapacity);
+	}
+	bgfx::update(_renderContext.spriteInstanceBuffer, 0, bgfx::copy(instances.data(), instanceCount * sizeof(instances[0])));
+}
+
+void RenderingSystemCommon::UpdateAnimations(std::chrono::microseconds deltaTime)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto& animationManager = Locator::resources::value().GetAnimations();
+	const auto milliseconds = std::chrono::duration<float, std::milli>(deltaTime).count();
+
+	registry.Each<Animation>([&animationManager, milliseconds](Animation& animation) {
+		if (!animationManager.Contains(animation.id))
+		{
+			return;
+		}
+		// Animations still loading have no duration, keep the time until they are loaded
+		const auto duration = static_cast<float>(animationManager.Handle(animation.id)->GetDuration());
+		if (duration <= 0.0f)
+		{
+			return;
+		}
+		animation.time = std::fmod(animation.time + milliseconds * animation.speed, duration);
+		if (animation.time < 0.0f)
+		{
+			animation.time += duration;
+		}
+	});
+}
+
+void RenderingSystemCommon::AssignBonePalettes()
+{
+	constexpr uint32_t k_MatricesPerRow = RenderContext::k_BoneTextureWidth / 4;
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto& meshManager = Locator::resources::value().GetMeshes();
+
+	// The height is a power of two which fits both the device and boneTextureHeight
+	const auto maxTextureSize = std::max<uint32_t>(bgfx::getCaps()->limits.maxTextureSize, 1);
+	const auto maxRows = std::bit_floor(std::min<uint32_t>(maxTextureSize, std::numeric_limits<uint16_t>::max()));
+	const auto maxMatrices = maxRows * k_MatricesPerRow;
+
+	_animatedInstances.clear();
+	_slotAnimatedInstances.assign(_slotEntities.size(), k_NotAnimated);
+	uint32_t matrixCount = 0;
+	uint32_t skipped = 0;
+	for (const auto& [meshId, placers] : _renderContext.instancedDrawDescs)
+	{
+		if (placers.count == 0)
+		{
+			continue;
+		}
+		const auto mesh = meshManager.Handle(meshId);
+		if (!mesh->IsBoned())
+		{
+			continue;
+		}
+		const auto boneCount = static_cast<uint32_t>(mesh->GetBoneMatrices().size());
+		for (uint32_t i = placers.offset; i < placers.offset + placers.count && i < _slotEntities.size(); ++i)
+		{
+			const auto entity = _slotEntities[i];
+			if (entity == entt::null || !registry.Valid(entity) || !registry.AllOf<Animation>(entity))
+			{
+				continue;
+			}
+			if (matrixCount + boneCount > maxMatrices)
+			{
+				_slotAnimatedInstances[i] = k_NoPaletteLeft;
+				++skipped;
+				continue;
+			}
+			_slotAnimatedInstances[i] = static_cast<uint32_t>(_animatedInstances.size());
+			// Evaluated by the first view which draws it
+			_animatedInstances.push_back({entity, meshId, matrixCount, _frame});
+			matrixCount += boneCount;
+		}
+	}
+	_renderContext.bonePalettes.resize(matrixCount);
+	if (skipped > 0)
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "The bone texture is full, {} animated instances are not drawn.", skipped);
+	}
+
+	const auto rowCount = (matrixCount + k_MatricesPerRow - 1) / k_MatricesPerRow;
+	if (rowCount > _renderContext.boneTextureHeight)
+	{
+		if (bgfx::isValid(_renderContext.boneTexture))
+		{
+			bgfx::destroy(_renderContext.boneTexture);
+		}
+		_renderContext.boneTextureHeight = static_cast<uint16_t>(std::min(std::bit_ceil(rowCount), maxRows));
+		_renderContext.boneTexture =
+		    bgfx::createTexture2D(RenderContext::k_BoneTextureWidth, _renderContext.boneTextureHeight, false, 1,
+		                          bgfx::TextureFormat::RGBA32F, BGFX_SAMPLER_POINT | BGFX_SAMPLER_UVW_CLAMP);
+	}
+}
+
+void RenderingSystemCommon::EvaluateBonePalettes(graphics::RenderPass viewId)
+{
+	constexpr uint32_t k_MatricesPerRow = RenderContext::k_BoneTextureWidth / 4;
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto& meshManager = Locator::resources::value().GetMeshes();
+	const auto& animationManager = Locator::resources::value().GetAnimations();
+	auto& palettes = _renderContext.bonePalettes;
+
+	// Range of matrices evaluated for this view, uploaded at the end
+	auto first = std::numeric_limits<uint32_t>::max();
+	uint32_t last = 0;
+	// Instances are grouped by mesh, only look the mesh up when it changes
+	entt::id_type meshId = 0;
+	entt::resource<const L3DMesh> mesh;
+	for (const auto index : _visibleAnimatedInstances.at(static_cast<size_t>(viewId)))
+	{
+		auto& instance = _animatedInstances[index];
+		if (instance.evaluatedFrame == _frame)
+		{
+			continue;
+		}
+		instance.evaluatedFrame = _frame;
+		if (!mesh || instance.meshId != meshId)
+		{
+			meshId = instance.meshId;
+			mesh = meshManager.Handle(meshId);
+		}
+		const auto& bindPose = mesh->GetBoneMatrices();
+		const auto& boneParents = mesh->GetBoneParents();
+		first = std::min(first, instance.palette);
+		last = std::max(last, instance.palette + static_cast<uint32_t>(bindPose.size()));
+
+		// Same as the mesh viewer: bones missing from the animation keep their bind pose
+		const auto bones = std::span(palettes).subspan(instance.palette, bindPose.size());
+		std::copy(bindPose.cbegin(), bindPose.cend(), bones.begin());
+		const auto* animation = registry.Valid(instance.entity) ? registry.TryGet<const Animation>(instance.entity) : nullptr;
+		if (animation == nullptr || !animationManager.Contains(animation->id))
+		{
+			continue;
+		}
+		const auto time = static_cast<uint32_t>(std::max(animation->time, 0.0f));
+		const auto count = animationManager.Handle(animation->id)->EvaluateBones(time, bones);
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (boneParents[i] != std::numeric_limits<uint32_t>::max())
+			{
+				bones[i] = bones[boneParents[i]] * bones[i];
+			}
+		}
+	}
+	if (first >= last)
+	{
+		return;
+	}
+
+	// Only whole rows can be updated, the last row of the palettes is padded with zeros
+	const auto firstRow = first / k_MatricesPerRow;
+	const auto rowCount = (last + k_MatricesPerRow - 1) / k_MatricesPerRow - firstRow;
+	const auto* memory = bgfx::alloc(rowCount * k_MatricesPerRow * sizeof(glm::mat4));
+	const auto begin = firstRow * k_MatricesPerRow;
+	const auto size = (std::min(begin + rowCount * k_MatricesPerRow, static_cast<uint32_t>(palettes.size())) - begin) *
+	                  sizeof(glm::mat4);
+	std::memcpy(memory->data, palettes.data() + begin, size);
+	std::memset(memory->data + size, 0, memory->size - size);
+	bgfx::updateTexture2D(_renderContext.boneTexture, 0, 0, 0, static_cast<uint16_t>(firstRow),
+	                      RenderContext::k_BoneTextureWidth, static_cast<uint16_t>(rowCount), memory);
 }
@@ -9,7 +9,9 @@
 
 #pragma once
 
-#include <map>
+#include <array>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 #include <bgfx/bgfx.h>
@@ -30,14 +32,70 @@ class RenderingSystemCommon: public RenderingSystemInterface
 public:
 	~RenderingSystemCommon();
 	void SetDirty() override;
-	void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams) override;
+	void SetDirty(entt::entity entity) override;
+	void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams, bool drawSprites) override;
+	void PrepareDrawView(graphics::RenderPass viewId, const Camera& camera, bool frustumCulling) override;
+	void UpdateAnimations(std::chrono::microseconds deltaTime) override;
 	const RenderContext& GetContext() override { return _renderContext; }
 
 private:
 	virtual void PrepareDrawDescs(bool drawBoundingBox) = 0;
 	virtual void PrepareDrawUploadUniforms(bool drawBoundingBox) = 0;
+	/// Update only the instances of \ref _dirtyEntities. Defaults to a full rebuild.
+	virtual void PrepareDrawUpdateInstances(bool drawBoundingBox);
+	/// Rebuild \ref RenderContext::spriteInstances from every sprite and upload them
+	void PrepareDrawSprites();
+	/// Give every rendered entity with an Animation and a boned mesh its own palette in \ref RenderContext::bonePalettes
+	void AssignBonePalettes();
+	/// Evaluate and upload the palettes of the animated instances visible in \p viewId which no view evaluated this frame
+	void EvaluateBonePalettes(graphics::RenderPass viewId);
+
+	struct AnimatedInstance
+	{
+		entt::entity entity;
+		entt::id_type meshId;
+		/// Index of the first matrix of the palette in \ref RenderContext::bonePalettes
+		uint32_t palette;
+		/// Value of \ref _frame when the palette was last evaluated
+		uint32_t evaluatedFrame;
+	};
+	static constexpr uint32_t k_NotAnimated = std::numeric_limits<uint32_t>::max();
+	/// Animated instances which did not fit in the bone texture, they are not drawn
+	static constexpr uint32_t k_NoPaletteLeft = k_NotAnimated - 1;
+	/// Grouped by mesh, filled at \ref AssignBonePalettes
+	std::vector<AnimatedInstance> _animatedInstances;
+	/// Index into \ref _animatedInstances of each slot of \ref RenderContext::instanceUniforms, \ref k_NotAnimated or
+	/// \ref k_NoPaletteLeft for the others
+	std::vector<uint32_t> _slotAnimatedInstances;
+	/// Indices into \ref _animatedInstances of the instances each view drew when its instance data was last built
+	std::array<std::vector<uint32_t>, static_cast<size_t>(graphics::RenderPass::_count)> _visibleAnimatedInstances;
+	/// Incremented at every \ref PrepareDraw
+	uint32_t _frame {0};
 
 protected:
+	/// Create a buffer holding \p count model matrices as instance data
+	static bgfx::DynamicVertexBufferHandle CreateInstanceUniformBuffer(uint32_t count);
+	/// Create a buffer holding \p count instances of 5 vec4, such as \ref RenderContext::ViewInstance or
+	/// \ref RenderContext::SpriteInstance
+	static bgfx::DynamicVertexBufferHandle CreateViewInstanceBuffer(uint32_t count);
+
+	/// Empty \ref _slotEntities before the instances are laid out again. The level of detail the views selected for an
+	/// entity follows it to the slot given by \ref AssignSlot.
+	void ResetSlots(size_t count);
+	void AssignSlot(uint32_t index, entt::entity entity);
+	/// Move the entity and the views' level of detail of a slot to another, the old slot is cleared
+	void MoveSlot(uint32_t from, uint32_t to);
+	void ClearSlot(uint32_t index);
+
 	RenderContext _renderContext;
+	/// Entities flagged through \ref SetDirty(entt::entity) since the last \ref PrepareDraw. May contain duplicates.
+	std::vector<entt::entity> _dirtyEntities;
+	/// Entity stored in each slot of \ref RenderContext::instanceUniforms, entt::null for unused slots
+	std::vector<entt::entity> _slotEntities;
+
+private:
+	/// Layout from before \ref ResetSlots, only kept while the instances are laid out again
+	std::unordered_map<entt::entity, uint32_t> _previousSlots;
+	std::array<std::vector<uint8_t>, static_cast<size_t>(graphics::RenderPass::_count)> _previousLods;
 };
 } // namespace openblack::ecs::systems
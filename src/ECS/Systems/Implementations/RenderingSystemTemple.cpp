@@ -79,14 +79,7 @@ void RenderingSystemTemple::PrepareDrawDescs(bool drawBoundingBox)
 		{
 			bgfx::destroy(_renderContext.instanceUniformBuffer);
 		}
-		bgfx::VertexLayout layout;
-		layout.begin()
-		    .add(bgfx::Attrib::TexCoord7, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord6, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord5, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord4, 4, bgfx::AttribType::Float)
-		    .end();
-		_renderContext.instanceUniformBuffer = bgfx::createDynamicVertexBuffer(instanceCount, layout);
+		_renderContext.instanceUniformBuffer = CreateInstanceUniformBuffer(instanceCount);
 		_renderContext.instanceUniforms.resize(instanceCount);
 	}
 
@@ -96,7 +89,7 @@ void RenderingSystemTemple::PrepareDrawDescs(bool drawBoundingBox)
 	for (const auto& [meshId, desc] : meshIds)
 	{
 		_renderContext.instancedDrawDescs.emplace(std::piecewise_construct, std::forward_as_tuple(meshId),
-		                                          std::forward_as_tuple(offset, desc.first, desc.second));
+		                                          std::forward_as_tuple(offset, desc.first, desc.first, desc.second));
 		offset += desc.first;
 	}
 }
@@ -108,9 +101,12 @@ void RenderingSystemTemple::PrepareDrawUploadUniforms(bool drawBoundingBox)
 	// Store offsets of uniforms for descs
 	std::map<entt::id_type, uint32_t> uniformOffsets;
 
+	const auto slotCount = _renderContext.instanceUniforms.size() / (drawBoundingBox ? 2 : 1);
+	ResetSlots(slotCount);
+
 	// Set transforms for instanced draw at offsets
 	registry.Each<const Mesh, const Transform, const TempleInteriorPart>(
-	    [this, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform,
+	    [this, &uniformOffsets, drawBoundingBox](entt::entity entity, const Mesh& mesh, const Transform& transform,
 	                                             const TempleInteriorPart& templePart) {
 		    auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
 
@@ -125,6 +121,7 @@ void RenderingSystemTemple::PrepareDrawUploadUniforms(bool drawBoundingBox)
 
 			    const uint32_t idx = desc->second.offset + offset.first->second;
 			    _renderContext.instanceUniforms[idx] = modelMatrix;
+			    AssignSlot(idx, entity);
 			    if (drawBoundingBox)
 			    {
 				    auto box = l3dMesh->GetBoundingBox();
@@ -11,6 +11,8 @@
 
 #include "TownSystem.h"
 
+#include <glm/gtx/norm.hpp>
+
 #include "ECS/Components/Abode.h"
 #include "ECS/Components/Town.h"
 #include "ECS/Components/Transform.h"
@@ -29,7 +31,7 @@ entt::entity TownSystem::FindAbodeWithSpace(entt::entity townEntity) const
 	const auto& town = registry.Get<Town>(townEntity);
 
 	entt::entity result = entt::null;
-	registry.Each<const Abode>([&town, &infoConstants, &result](entt::entity entity, auto component) {
+	registry.Each<const Abode>([&town, &infoConstants, &result](entt::entity entity, const Abode& component) {
 		if (result != entt::null || component.townId != town.id)
 		{
 			return;
@@ -51,9 +53,10 @@ entt::entity TownSystem::FindClosestTown(const glm::vec3& point) const
 	entt::entity result = entt::null;
 	auto closest = std::numeric_limits<float>::infinity();
 
+	// Towns are neither fixed nor mobile so they are not in the map, this only visits the towns
 	registry.Each<const Town, const Transform>(
 	    [&point, &result, &closest](entt::entity entity, [[maybe_unused]] auto& town, [[maybe_unused]] auto& transform) {
-		    float distance2 = glm::dot(point, transform.position);
+		    float distance2 = glm::distance2(point, transform.position);
 		    if (distance2 < closest)
 		    {
 			    closest = distance2;
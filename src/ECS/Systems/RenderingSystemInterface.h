@@ -9,13 +9,25 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <array>
+#include <chrono>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include <bgfx/bgfx.h>
 #include <entt/fwd.hpp>
 #include <glm/mat4x4.hpp>
 
 #include "Graphics/Mesh.h"
+#include "Graphics/RenderPass.h"
+
+namespace openblack
+{
+class Camera;
+}
 
 namespace openblack::ecs::systems
 {
@@ -30,25 +42,33 @@ struct RenderContext
 
 	struct InstancedDrawDesc
 	{
-		InstancedDrawDesc(uint32_t offset, uint32_t count, bool morphWithTerrain)
+		InstancedDrawDesc(uint32_t offset, uint32_t count, uint32_t capacity, bool morphWithTerrain)
 		    : offset(offset)
 		    , count(count)
+		    , capacity(capacity)
 		    , morphWithTerrain(morphWithTerrain)
 		{
 		}
 		uint32_t offset;
 		uint32_t count;
+		/// Number of slots reserved for this mesh starting at \ref offset.
+		/// Instances can be added without moving other meshes until count reaches capacity.
+		uint32_t capacity;
 		bool morphWithTerrain;
+		/// Distance from the camera to the nearest instance, only set for the buckets of a view
+		float distance {0.0f};
 	};
 
-	/// A list of cpu-side uniforms which is refilled at every \ref PrepareDraw.
-	/// This vector will resize to the number of instances it manages
+	/// A list of cpu-side uniforms which is filled at \ref PrepareDraw.
+	/// This vector will resize to the number of instance slots it manages
 	/// but in practice, it should only grow its reserved memory.
+	/// Slots which are not in use by any instance are zeroed.
 	/// If debug bounding boxes are enabled, it will double in size to fit all
 	/// bounding boxes in the second half of the list.
 	std::vector<glm::mat4> instanceUniforms;
 	/// Stores information for rendering which is prepared at \ref PrepareDraw.
-	std::map<entt::id_type, const InstancedDrawDesc> instancedDrawDescs;
+	/// Offsets are stable between frames unless a full rebuild is required.
+	std::map<entt::id_type, InstancedDrawDesc> instancedDrawDescs;
 	/// Not an actual vertex buffer, but a dynamic general purpose buffer which
 	/// stores uniform data as a GPU-side copy of \ref _instanceUniforms and
 	/// which is populated in \ref PrepareDraw and consumed in \ref DrawModels.
@@ -58,15 +78,91 @@ struct RenderContext
 	/// the instances of entities and their bounding boxes.
 	bgfx::DynamicVertexBufferHandle instanceUniformBuffer;
 
+	/// Mesh and level of detail of a bucket of instances
+	using MeshLod = std::pair<entt::id_type, uint8_t>;
+
+	/// Per instance data of a view, laid out as i_data0 to i_data4 in the object shaders
+	struct ViewInstance
+	{
+		glm::mat4 model;
+		/// x is the index in \ref bonePalettes of the instance's first bone, negative to use the mesh's bind pose
+		glm::vec4 bones;
+	};
+
+	/// Instances as seen from a view's camera, filled at \ref PrepareDrawView.
+	/// Instances outside of the frustum are culled and the others are bucketed by level of detail.
+	struct InstancedView
+	{
+		/// Model matrices and bone palettes of visible instances, packed contiguously per mesh and level of detail.
+		std::vector<ViewInstance> instanceUniforms;
+		/// Same as \ref RenderContext::instancedDrawDescs but indexing into this view's buffer.
+		/// Buckets without any visible instance are omitted.
+		std::map<MeshLod, InstancedDrawDesc> instancedDrawDescs;
+		/// Level of detail last selected for each slot of \ref RenderContext::instanceUniforms, used for hysteresis.
+		/// Moves along with the instance when it changes slot, culled and empty slots are reset to 0.
+		std::vector<uint8_t> instanceLods;
+		/// GPU-side copy of \ref instanceUniforms. It will never shrink.
+		bgfx::DynamicVertexBufferHandle instanceUniformBuffer {BGFX_INVALID_HANDLE};
+		uint32_t bufferCapacity {0};
+		/// Inputs of the last update, used to skip work when neither the camera nor the instances changed.
+		glm::mat4 viewProjection {0.0f};
+		uint32_t generation {0};
+		bool frustumCulling {false};
+		std::array<float, 2> lodDistances {};
+		float lodHysteresis {0.0f};
+	};
+	std::array<InstancedView, static_cast<size_t>(graphics::RenderPass::_count)> instancedViews;
+
+	/// Per instance data of a sprite, laid out as i_data0 to i_data4 in the sprite shader
+	struct SpriteInstance
+	{
+		/// Columns of the rotation and scale, the translation is in their w
+		std::array<glm::vec4, 3> axes;
+		/// Extent and minimum of the sprite's region of the texture
+		glm::vec4 sampleRect;
+		glm::vec4 tint;
+	};
+	/// Every sprite, grouped by texture, filled at \ref PrepareDraw and shared by all views.
+	std::vector<SpriteInstance> spriteInstances;
+	/// Bounding sphere of each sprite of \ref spriteInstances as its center and radius, used for culling.
+	std::vector<glm::vec4> spriteBounds;
+	/// Range of \ref spriteInstances drawn with each texture, keyed by the index of the texture's handle.
+	std::map<uint16_t, InstancedDrawDesc> spriteDrawDescs;
+	/// GPU-side copy of \ref spriteInstances. It will never shrink.
+	bgfx::DynamicVertexBufferHandle spriteInstanceBuffer {BGFX_INVALID_HANDLE};
+	uint32_t spriteBufferCapacity {0};
+	/// Incremented every time \ref instanceUniforms changes.
+	uint32_t generation {1};
+
+	/// Bone matrices of every animated instance, one palette per entity. The palettes only move when the instances change,
+	/// so views don't need to be rebuilt as animations play. Only the palettes of instances drawn by a view are evaluated,
+	/// once per frame at \ref PrepareDrawView.
+	std::vector<glm::mat4> bonePalettes;
+	/// GPU-side copy of \ref bonePalettes, one matrix per 4 RGBA32F texels and \ref k_BoneTextureWidth texels per row.
+	/// The texture grows in height when needed but never shrinks.
+	bgfx::TextureHandle boneTexture {BGFX_INVALID_HANDLE};
+	static constexpr uint16_t k_BoneTextureWidth = 1024;
+	uint16_t boneTextureHeight {0};
+
 	bool dirty {true};
 	bool hasBoundingBoxes {false};
+	bool hasSprites {false};
 };
 
 class RenderingSystemInterface
 {
 public:
+	/// Request a full rebuild of all instances on the next \ref PrepareDraw.
 	virtual void SetDirty() = 0;
-	virtual void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams) = 0;
+	/// Request that only the instance of this entity be updated on the next \ref PrepareDraw.
+	virtual void SetDirty(entt::entity entity) = 0;
+	virtual void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams, bool drawSprites) = 0;
+	/// Fill the instanced view of \p viewId with the instances seen by \p camera and select their level of detail, then
+	/// evaluate the bone palettes of the animated ones. Must be called after \ref PrepareDraw.
+	virtual void PrepareDrawView(graphics::RenderPass viewId, const Camera& camera, bool frustumCulling) = 0;
+	/// Advance the time of every \ref components::Animation, the bone palettes are evaluated at \ref PrepareDrawView.
+	/// Must be called once per frame before \ref PrepareDraw.
+	virtual void UpdateAnimations(std::chrono::microseconds deltaTime) = 0;
 	virtual const RenderContext& GetContext() = 0;
 	inline ~RenderingSystemInterface() = default;
 };
@@ -9,6 +9,11 @@
 
 #pragma once
 
+#include <cstddef>
+
+#include <array>
+#include <filesystem>
+
 #include <bgfx/bgfx.h>
 
 #include "Windowing/WindowingInterface.h"
@@ -34,6 +39,8 @@ struct EngineConfig
 	bool drawBoundingBoxes {false};
 	bool drawFootpaths {false};
 	bool drawStreams {false};
+	bool frustumCulling {true};
+	bool levelOfDetail {true};
 
 	bool vsync {false};
 	bool running {false};
@@ -43,6 +50,11 @@ struct EngineConfig
 	float bumpMapStrength {1.0f};
 	float smallBumpMapStrength {1.0f};
 
+	/// Camera distances past which instances switch to the next level of detail
+	std::array<float, 2> lodDistances {500.0f, 1500.0f};
+	/// Fraction of a distance threshold an instance must cross before switching back
+	float lodHysteresis {0.1f};
+
 	float cameraXFov {70.0f};
 	float cameraNearClip {1.0f};
 	float cameraFarClip {static_cast<float>(0x10000)};
@@ -54,5 +66,17 @@ struct EngineConfig
 	windowing::DisplayMode displayMode {windowing::DisplayMode::Windowed};
 
 	uint32_t numFramesToSimulate {0};
+
+	/// Bytes of meshes, textures and animations kept loaded before the least recently used are evicted, shared as half
+	/// for meshes, three eighths for textures and an eighth for animations.
+	/// 0 to never evict. Sounds are not evicted as emitters hold on to their audio buffers.
+	size_t resourceMemoryBudget {0};
+
+	/// Where post-processed meshes, terrain and sky are kept between runs, empty to always build them on load
+	std::filesystem::path assetCacheDirectory;
+	/// Bake every asset used again instead of reading the cache
+	bool rebuildAssetCache {false};
+	/// Find game files added, removed or renamed while running, e.g. when editing mods
+	bool watchGameFiles {false};
 };
 } // namespace openblack
@@ -11,13 +11,27 @@
 
 #include "DefaultFileSystem.h"
 
+#include <cctype>
+#include <cerrno>
+
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <fstream>
 #include <ios>
 #include <istream>
 #include <memory>
+#include <mutex>
 #include <system_error>
 
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
 #include "FileStream.h"
 #include "fmt/format.h"
 
@@ -31,6 +45,47 @@
 
 using namespace openblack::filesystem;
 
+namespace
+{
+std::string ToLower(std::string string)
+{
+	std::ranges::transform(string, string.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return string;
+}
+} // namespace
+
+DefaultFileSystem::DefaultFileSystem([[maybe_unused]] bool watchForChanges)
+{
+#ifdef __linux__
+	if (watchForChanges)
+	{
+		_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (_inotify < 0)
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Failed to watch game files for changes: {}",
+			                   std::error_code(errno, std::generic_category()).message());
+			return;
+		}
+		_watcher = std::jthread([this](const std::stop_token& stopToken) { WatchChanges(stopToken); });
+	}
+#endif
+}
+
+DefaultFileSystem::~DefaultFileSystem()
+{
+#ifdef __linux__
+	if (_watcher.joinable())
+	{
+		_watcher.request_stop();
+		_watcher.join();
+	}
+	if (_inotify >= 0)
+	{
+		close(_inotify);
+	}
+#endif
+}
+
 // todo: exceptions need to be replaced with real exceptions
 
 std::filesystem::path DefaultFileSystem::FindPath(const std::filesystem::path& path) const
@@ -40,41 +95,209 @@ std::filesystem::path DefaultFileSystem::FindPath(const std::filesystem::path& p
 		throw std::invalid_argument("empty path");
 	}
 
-	// try absolute first
-	if (path.is_absolute())
+	if (auto found = Lookup(path))
 	{
-		if (std::filesystem::exists(path))
+		return *std::move(found);
+	}
+
+	throw std::runtime_error("File " + path.string() + " not found");
+}
+
+std::optional<std::filesystem::path> DefaultFileSystem::Lookup(const std::filesystem::path& path) const
+{
+	const auto key = path.generic_string();
+	std::filesystem::path gamePath;
+	std::vector<std::filesystem::path> additionalPaths;
+	uint64_t generation;
+	{
+		const std::shared_lock<std::shared_mutex> lock(_mutex);
+		const auto cached = _lookups.find(key);
+		if (cached != _lookups.end())
 		{
-			return path;
+			return cached->second;
 		}
+		gamePath = _gamePath;
+		additionalPaths = _additionalPaths;
+		generation = _generation;
 	}
-	else
+
+	std::optional<std::filesystem::path> result;
+	std::error_code error;
+	// try absolute first, then relative to current directory, both as given
+	if (std::filesystem::exists(path, error))
+	{
+		result = path;
+	}
+	else if (!path.is_absolute())
+	{
+		// try relative to game directory then to additional paths, in any case
+		if (!gamePath.empty())
+		{
+			result = Resolve(gamePath, path, generation);
+		}
+		for (auto p = additionalPaths.cbegin(); !result && p != additionalPaths.cend(); ++p)
+		{
+			result = Resolve(*p, path, generation);
+		}
+	}
+
+	if (result.has_value())
+	{
+		const std::unique_lock<std::shared_mutex> lock(_mutex);
+		if (generation == _generation)
+		{
+			_lookups.try_emplace(key, *result);
+		}
+	}
+	return result;
+}
+
+std::optional<std::filesystem::path> DefaultFileSystem::Resolve(const std::filesystem::path& root,
+                                                                const std::filesystem::path& path, uint64_t generation) const
+{
+	auto resolved = root;
+	for (const auto& component : path)
 	{
-		// try relative to current directory
-		if (std::filesystem::exists(path))
+		const auto name = component.string();
+		if (name.empty() || name == ".")
 		{
-			return path;
+			continue;
+		}
+		if (name == "..")
+		{
+			resolved /= component;
+			continue;
 		}
 
-		// try relative to game directory
-		if (std::filesystem::exists(_gamePath / path))
+		const auto index = GetIndex(resolved, generation);
+		const auto entry = index->find(ToLower(name));
+		if (entry == index->end())
 		{
-			return _gamePath / path;
+			return std::nullopt;
 		}
+		// Of names only differing in case prefer the one asked for, otherwise the first in order
+		const auto& names = entry->second;
+		const auto exact = std::ranges::find(names, name);
+		resolved /= exact != names.end() ? *exact : names.front();
+	}
+	return resolved;
+}
 
-		// try relative to additional paths
-		for (const auto& p : _additionalPaths)
+std::shared_ptr<const DefaultFileSystem::DirectoryIndex>
+DefaultFileSystem::GetIndex(const std::filesystem::path& directory, uint64_t generation) const
+{
+	auto key = directory.generic_string();
+	{
+		const std::shared_lock<std::shared_mutex> lock(_mutex);
+		const auto found = _directories.find(key);
+		if (found != _directories.end())
 		{
-			if (std::filesystem::exists(p / path))
+			return found->second;
+		}
+	}
+
+#ifdef __linux__
+	// Watched before listing so that changes made while listing are reported
+	if (_inotify >= 0)
+	{
+		constexpr uint32_t k_WatchMask =
+		    IN_ONLYDIR | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+		const int watch = inotify_add_watch(_inotify, directory.c_str(), k_WatchMask);
+		if (watch >= 0)
+		{
+			const std::unique_lock<std::shared_mutex> lock(_mutex);
+			// Adding a watch again returns the same descriptor, e.g. when indexing again after a change
+			auto& directories = _watches[watch];
+			if (std::ranges::find(directories, key) == directories.end())
 			{
-				return p / path;
+				directories.push_back(key);
 			}
 		}
 	}
+#endif
 
-	throw std::runtime_error("File " + path.string() + " not found");
+	// Left empty for files and missing directories
+	auto index = std::make_shared<DirectoryIndex>();
+	std::error_code error;
+	for (auto entry = std::filesystem::directory_iterator(directory, error);
+	     !error && entry != std::filesystem::directory_iterator(); entry.increment(error))
+	{
+		auto name = entry->path().filename().string();
+		(*index)[ToLower(name)].push_back(std::move(name));
+	}
+	// The listing order is unspecified
+	for (auto& [lower, names] : *index)
+	{
+		std::ranges::sort(names);
+	}
+
+	const std::unique_lock<std::shared_mutex> lock(_mutex);
+	if (generation != _generation)
+	{
+		return index;
+	}
+	// Another lookup may have indexed it meanwhile
+	return _directories.try_emplace(std::move(key), std::move(index)).first->second;
+}
+
+void DefaultFileSystem::Invalidate()
+{
+	++_generation;
+	_lookups.clear();
+	_directories.clear();
 }
 
+#ifdef __linux__
+void DefaultFileSystem::WatchChanges(const std::stop_token& stopToken)
+{
+	constexpr int k_PollTimeoutMs = 100;
+	alignas(inotify_event) std::array<char, 4096> buffer;
+
+	pollfd descriptor {_inotify, POLLIN, 0};
+	while (!stopToken.stop_requested())
+	{
+		if (poll(&descriptor, 1, k_PollTimeoutMs) <= 0)
+		{
+			continue;
+		}
+
+		ssize_t length;
+		while ((length = read(_inotify, buffer.data(), buffer.size())) > 0)
+		{
+			const std::unique_lock<std::shared_mutex> lock(_mutex);
+			for (ssize_t offset = 0; offset < length;)
+			{
+				const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+				offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+				// Events were dropped, any indexed directory may have changed
+				if ((event->mask & IN_Q_OVERFLOW) != 0)
+				{
+					_directories.clear();
+					continue;
+				}
+				const auto watch = _watches.find(event->wd);
+				if (watch == _watches.end())
+				{
+					continue;
+				}
+				// Indexed again on the next lookup going through them
+				for (const auto& directory : watch->second)
+				{
+					_directories.erase(directory);
+				}
+				if ((event->mask & IN_IGNORED) != 0)
+				{
+					_watches.erase(watch);
+				}
+			}
+			++_generation;
+			_lookups.clear();
+		}
+	}
+}
+#endif
+
 bool DefaultFileSystem::IsPathValid(const std::filesystem::path& path)
 {
 	if (path.empty())
@@ -97,15 +320,13 @@ std::unique_ptr<Stream> DefaultFileSystem::Open(const std::filesystem::path& pat
 
 bool DefaultFileSystem::Exists(const std::filesystem::path& path) const
 {
-	try
-	{
-		[[maybe_unused]] auto realPath = FindPath(path);
-		return true;
-	}
-	catch (std::exception&)
-	{
-		return false;
-	}
+	return !path.empty() && Lookup(path).has_value();
+}
+
+void DefaultFileSystem::AddAdditionalPath(const std::filesystem::path& path)
+{
+	const std::unique_lock<std::shared_mutex> lock(_mutex);
+	_additionalPaths.push_back(path);
 }
 
 std::vector<uint8_t> DefaultFileSystem::ReadAll(const std::filesystem::path& path)
@@ -141,16 +362,16 @@ void DefaultFileSystem::Iterate(const std::filesystem::path& path, bool recursiv
 
 void DefaultFileSystem::SetGamePath(const std::filesystem::path& path)
 {
-	_gamePath = path;
+	auto gamePath = path;
 
 #if defined(unix) || defined(__unix__) || defined(__unix)
-	if (_gamePath.string().size() >= 2 && _gamePath.string().c_str()[0] == '~' && _gamePath.string().c_str()[1] == '/')
+	if (gamePath.string().size() >= 2 && gamePath.string().c_str()[0] == '~' && gamePath.string().c_str()[1] == '/')
 	{
-		_gamePath = std::getenv("HOME") + _gamePath.string().substr(1);
+		gamePath = std::getenv("HOME") + gamePath.string().substr(1);
 	}
 #endif
 
-	if (_gamePath.empty())
+	if (gamePath.empty())
 	{
 #ifdef _WIN32
 		DWORD dataLen = 0;
@@ -162,7 +383,7 @@ void DefaultFileSystem::SetGamePath(const std::filesystem::path& path)
 			status = RegGetValue(HKEY_CURRENT_USER, "SOFTWARE\\Lionhead Studios Ltd\\Black & White", "GameDir", RRF_RT_REG_SZ,
 			                     nullptr, data.data(), &dataLen);
 
-			_gamePath = std::filesystem::path(data.data());
+			gamePath = std::filesystem::path(data.data());
 		}
 		else
 		{
@@ -171,9 +392,15 @@ void DefaultFileSystem::SetGamePath(const std::filesystem::path& path)
 #endif // _WIN32
 	}
 
-	if (!_gamePath.empty() && !Exists(_gamePath))
 	{
-		throw std::runtime_error(fmt::format("GamePath does not exist: '{}'", _gamePath.generic_string()));
+		const std::unique_lock<std::shared_mutex> lock(_mutex);
+		_gamePath = gamePath;
+		Invalidate();
+	}
+
+	if (!gamePath.empty() && !Exists(gamePath))
+	{
+		throw std::runtime_error(fmt::format("GamePath does not exist: '{}'", gamePath.generic_string()));
 	}
 }
 std::unique_ptr<std::istream> DefaultFileSystem::GetData(const std::filesystem::path& path)
@@ -10,8 +10,18 @@
 #pragma once
 
 #include <iosfwd>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+#ifdef __linux__
+#include <stop_token>
+#include <thread>
+#endif
+
 #include "FileSystemInterface.h"
 
 #if !defined(LOCATOR_IMPLEMENTATIONS)
@@ -21,9 +31,22 @@
 namespace openblack::filesystem
 {
 
+/// Relative paths are resolved without regard to case through an index of the game and additional directories, built
+/// one directory at a time on first use. Of names only differing in case the one with the exact case is preferred.
+/// Resolved paths are cached until the game path changes, or until a watched directory changes. Adding an additional path
+/// keeps them, it is searched after the paths they were found in. Paths which could not be found are not cached and are
+/// looked up again, they may be created later, e.g. in the user's save or mod directories. The disk is never accessed
+/// with the lock held.
 class DefaultFileSystem: public FileSystemInterface
 {
 public:
+	/// With watchForChanges the indexed directories are watched so that files added, removed or renamed while running are
+	/// found, only implemented with inotify on Linux
+	explicit DefaultFileSystem(bool watchForChanges = false);
+	DefaultFileSystem(const DefaultFileSystem&) = delete;
+	DefaultFileSystem& operator=(const DefaultFileSystem&) = delete;
+	~DefaultFileSystem() override;
+
 	[[nodiscard]] std::filesystem::path FindPath(const std::filesystem::path& path) const override;
 	[[nodiscard]] bool IsPathValid(const std::filesystem::path& path) override;
 	std::unique_ptr<Stream> Open(const std::filesystem::path& path, Stream::Mode mode) override;
@@ -31,14 +54,43 @@ class DefaultFileSystem: public FileSystemInterface
 	[[nodiscard]] bool Exists(const std::filesystem::path& path) const override;
 	void SetGamePath(const std::filesystem::path& path) override;
 	[[nodiscard]] const std::filesystem::path& GetGamePath() const override { return _gamePath; }
-	void AddAdditionalPath(const std::filesystem::path& path) override { _additionalPaths.push_back(path); }
+	void AddAdditionalPath(const std::filesystem::path& path) override;
 	std::vector<uint8_t> ReadAll(const std::filesystem::path& path) override;
 	void Iterate(const std::filesystem::path& path, bool recursive,
 	             const std::function<void(const std::filesystem::path&)>& function) const override;
 
 private:
+	/// Sorted names on disk of the entries of a directory by their lower case name
+	using DirectoryIndex = std::unordered_map<std::string, std::vector<std::string>>;
+
+	[[nodiscard]] std::optional<std::filesystem::path> Lookup(const std::filesystem::path& path) const;
+	/// Expects the lock not to be held, \p generation is the \ref _generation the lookup started at
+	[[nodiscard]] std::optional<std::filesystem::path> Resolve(const std::filesystem::path& root,
+	                                                           const std::filesystem::path& path, uint64_t generation) const;
+	/// Expects the lock not to be held. A missing index is built without the lock and only kept if nothing was invalidated
+	/// since \p generation.
+	[[nodiscard]] std::shared_ptr<const DirectoryIndex> GetIndex(const std::filesystem::path& directory,
+	                                                             uint64_t generation) const;
+	/// Expects the unique lock to be held
+	void Invalidate();
+
+	// FindPath is const and called from loader jobs, the paths are guarded by the mutex as well
+	mutable std::shared_mutex _mutex;
 	std::filesystem::path _gamePath;
 	std::vector<std::filesystem::path> _additionalPaths;
+	mutable std::unordered_map<std::string, std::shared_ptr<const DirectoryIndex>> _directories;
+	mutable std::unordered_map<std::string, std::filesystem::path> _lookups;
+	/// Incremented whenever indexes or lookups are dropped, what was computed across a change is not kept
+	uint64_t _generation {0};
+
+#ifdef __linux__
+	void WatchChanges(const std::stop_token& stopToken);
+
+	int _inotify {-1};
+	/// Indexed directories of each inotify watch descriptor, several when reached through links or ..
+	mutable std::unordered_map<int, std::vector<std::string>> _watches;
+	std::jthread _watcher;
+#endif
 };
 
 } // namespace openblack::filesystem
@@ -9,8 +9,14 @@
 
 #include "Game.h"
 
+#include <array>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include <L3DFile.h>
 #include <LHVM.h>
 #include <SDL.h>
 #include <glm/gtc/constants.hpp>
@@ -23,6 +29,7 @@
 #include <spdlog/spdlog.h>
 
 #include "3D/CreatureBody.h"
+#include "3D/L3DAnim.h"
 #include "3D/L3DMesh.h"
 #include "3D/LandIslandInterface.h"
 #include "3D/OceanInterface.h"
@@ -50,10 +57,14 @@
 #include "Graphics/FrameBuffer.h"
 #include "Graphics/RendererInterface.h"
 #include "Input/GameActionMapInterface.h"
+#include "Jobs/JobSystem.h"
+#include "Jobs/TaskGraph.h"
 #include "LHScriptX/Script.h"
 #include "Locator.h"
 #include "Parsers/InfoFile.h"
 #include "Profiler.h"
+#include "Resources/AssetCache.h"
+#include "Resources/AssetLoader.h"
 #include "Resources/Loaders.h"
 #include "Resources/MeshId.h"
 #include "Resources/ResourcesInterface.h"
@@ -115,6 +126,10 @@ Game::Game(Arguments&& args) noexcept
 	config.rendererType = args.rendererType;
 	config.vsync = args.vsync;
 	config.guiScale = args.guiScale;
+	config.resourceMemoryBudget = static_cast<size_t>(args.resourceBudgetMiB) << 20;
+	config.assetCacheDirectory = args.assetCachePath;
+	config.rebuildAssetCache = args.rebuildAssetCache;
+	config.watchGameFiles = args.watchGameFiles;
 }
 
 Game::~Game() noexcept
@@ -229,25 +244,32 @@ bool Game::ProcessEvents(const SDL_Event& event) noexcept
 	return true;
 }
 
-bool Game::GameLogicLoop() noexcept
+bool Game::IsTurnDue() const noexcept
 {
-	using namespace ecs::components;
-	using namespace ecs::systems;
-
 	if (_paused)
 	{
 		return false;
 	}
 
-	const auto currentTime = std::chrono::steady_clock::now();
-	const auto delta = currentTime - _lastGameLoopTime;
+	const auto delta = std::chrono::steady_clock::now() - _lastGameLoopTime;
 	const auto turnDuration = k_TurnDuration * _gameSpeedMultiplier;
 	// NOLINTNEXTLINE(modernize-use-nullptr): clang-tidy bug
-	if (delta < turnDuration)
+	return delta >= turnDuration;
+}
+
+bool Game::GameLogicLoop() noexcept
+{
+	using namespace ecs::components;
+	using namespace ecs::systems;
+
+	if (!IsTurnDue())
 	{
 		return false;
 	}
 
+	const auto currentTime = std::chrono::steady_clock::now();
+	const auto delta = currentTime - _lastGameLoopTime;
+
 	// Build Map Grid Acceleration Structure
 	Locator::entitiesMap::value().Rebuild();
 
@@ -272,6 +294,74 @@ bool Game::GameLogicLoop() noexcept
 	return false;
 }
 
+void Game::UpdateUniforms() noexcept
+{
+	auto& camera = Locator::camera::value();
+
+	// Update Debug Cross
+	ecs::components::Transform intersectionTransform {};
+	{
+		const auto screenSize =
+		    Locator::windowing::has_value() ? Locator::windowing::value().GetSize() : glm::zero<glm::ivec2>();
+		const auto scale = glm::vec3(50.0f, 50.0f, 50.0f);
+		if (screenSize.x > 0 && screenSize.y > 0)
+		{
+			glm::vec3 rayOrigin;
+			glm::vec3 rayDirection;
+			camera.DeprojectScreenToWorld(static_cast<glm::vec2>(_mousePosition) / static_cast<glm::vec2>(screenSize),
+			                              rayOrigin, rayDirection);
+			auto& dynamicsSystem = Locator::dynamicsSystem::value();
+
+			if (!glm::any(glm::isnan(rayOrigin) || glm::isnan(rayDirection)))
+			{
+				if (auto hit = dynamicsSystem.RayCastClosestHit(rayOrigin, rayDirection, 1e10f))
+				{
+					intersectionTransform = hit->first;
+				}
+				else // For the water
+				{
+					float intersectDistance = 0.0f;
+					const auto planeOrigin = glm::vec3(0.0f, 0.0f, 0.0f);
+					const auto planeNormal = glm::vec3(0.0f, 1.0f, 0.0f);
+					if (glm::intersectRayPlane(rayOrigin, rayDirection, planeOrigin, planeNormal, intersectDistance))
+					{
+						intersectionTransform.position = rayOrigin + rayDirection * intersectDistance;
+						intersectionTransform.rotation = glm::mat3(1.0f);
+					}
+				}
+			}
+			intersectionTransform.scale = scale;
+			_handPose = glm::mat4(1.0f);
+			_handPose = glm::translate(_handPose, intersectionTransform.position);
+			_handPose *= glm::mat4(intersectionTransform.rotation);
+			_handPose = glm::scale(_handPose, intersectionTransform.scale);
+			Locator::rendererInterface::value().UpdateDebugCrossUniforms(
+			    glm::translate(camera.GetFocus(Camera::Interpolation::Target)));
+		}
+	}
+
+	// Update Hand
+	if (!_handGripping)
+	{
+		const glm::vec3 handOffset(0, 1.5f, 0);
+		const glm::mat4 modelRotationCorrection = glm::eulerAngleX(glm::radians(90.0f));
+
+		const auto handEntity = Locator::handSystem::value()
+		                            .GetPlayerHands()[static_cast<size_t>(ecs::systems::HandSystemInterface::Side::Left)];
+		auto& handTransform = Locator::entitiesRegistry::value().Get<ecs::components::Transform>(handEntity);
+		// TODO(#480): move using velocity rather than snapping hand to intersectionTransform
+		const glm::mat3 rotation =
+		    intersectionTransform.rotation * glm::mat3(glm::eulerAngleY(camera.GetRotation().y) * modelRotationCorrection);
+		const auto position = intersectionTransform.position + intersectionTransform.rotation * handOffset;
+		if (position != handTransform.position || rotation != handTransform.rotation)
+		{
+			handTransform.position = position;
+			handTransform.rotation = rotation;
+			Locator::entitiesRegistry::value().SetDirty(handEntity);
+		}
+	}
+}
+
 bool Game::Update() noexcept
 {
 	auto& profiler = Locator::profiler::value();
@@ -292,47 +382,104 @@ bool Game::Update() noexcept
 
 	Locator::debugGui::value().SetScale(config.guiScale);
 
-	// Physics
+	// Before any task can use a resource so that evicting does not race with loading
+	Locator::resources::value().Update(_frameCount);
+
+	using Resource = TaskGraph::Resource;
+	using Affinity = TaskGraph::Affinity;
+	auto& jobSystem = Locator::jobSystem::value();
+	TaskGraph graph;
+
+	// The Bullet step runs on a worker while the SDL events are polled and dispatched on the main thread, the event
+	// handlers don't touch the dynamics world or the rigid bodies. Everything else waits for the step: the debug gui can
+	// ray cast into the physics world and the transforms are applied once it is done.
+	if (_frameCount > 0)
 	{
-		auto physics = profiler.BeginScoped(Profiler::Stage::PhysicsUpdate);
-		if (_frameCount > 0)
-		{
-			auto& dynamicsSystem = Locator::dynamicsSystem::value();
-			dynamicsSystem.Update(deltaTime);
-			dynamicsSystem.UpdatePhysicsTransforms();
-		}
+		graph.AddTask({
+		    .reads = {},
+		    .writes = {Resource::Physics},
+		    .affinity = Affinity::Any,
+		    .func =
+		        [&profiler, &deltaTime]() {
+			        auto physics = profiler.BeginScoped(Profiler::Stage::PhysicsUpdate);
+			        Locator::dynamicsSystem::value().Update(deltaTime);
+		        },
+		});
 	}
 
-	// Input events
+	// Input events, setting a camera bookmark assigns the transform of its entity
+	graph.AddTask({
+	    .reads = {},
+	    .writes = {Resource::Registry, Resource::Input, Resource::Camera, Resource::Config, Resource::DebugGui,
+	               Resource::Renderer},
+	    .affinity = Affinity::MainThread,
+	    .func =
+	        [&profiler]() {
+		        auto sdlInput = profiler.BeginScoped(Profiler::Stage::SdlInput);
+		        if (!Locator::debugGui::value().StealsFocus())
+		        {
+			        Locator::gameActionSystem::value().Frame();
+		        }
+		        SDL_Event e;
+		        while (SDL_PollEvent(&e) != 0)
+		        {
+			        Locator::events::value().Create<SDL_Event>(e);
+		        }
+	        },
+	});
+
+	// The camera model reads the hand positions from the registry
+	graph.AddTask({
+	    .reads = {Resource::Registry, Resource::Input},
+	    .writes = {Resource::Camera},
+	    .affinity = Affinity::MainThread,
+	    .func = [&camera, &deltaTime]() { camera.HandleActions(deltaTime); },
+	});
+
+	// ImGui events + prepare
+	bool guiQuit = false;
+	graph.AddTask({
+	    .reads = {Resource::Input},
+	    .writes = {Resource::Registry, Resource::Map, Resource::Physics, Resource::Camera, Resource::Config,
+	               Resource::DebugGui, Resource::Vm, Resource::Audio, Resource::RenderContext, Resource::Renderer},
+	    .affinity = Affinity::MainThread,
+	    .func =
+	        [&profiler, &config, &guiQuit]() {
+		        if (!config.running)
+		        {
+			        return;
+		        }
+		        auto guiLoop = profiler.BeginScoped(Profiler::Stage::GuiLoop);
+		        guiQuit = Locator::debugGui::value().Loop();
+	        },
+	});
+
+	if (_frameCount > 0)
 	{
-		auto sdlInput = profiler.BeginScoped(Profiler::Stage::SdlInput);
-		if (!Locator::debugGui::value().StealsFocus())
-		{
-			Locator::gameActionSystem::value().Frame();
-		}
-		SDL_Event e;
-		while (SDL_PollEvent(&e) != 0)
-		{
-			Locator::events::value().Create<SDL_Event>(e);
-		}
-		camera.HandleActions(deltaTime);
+		graph.AddTask({
+		    .reads = {Resource::Physics},
+		    .writes = {Resource::Registry, Resource::Map, Resource::RenderContext},
+		    .affinity = Affinity::MainThread,
+		    .func =
+		        [&profiler]() {
+			        auto physics = profiler.BeginScoped(Profiler::Stage::PhysicsTransforms);
+			        Locator::dynamicsSystem::value().UpdatePhysicsTransforms();
+		        },
+		});
 	}
 
-	if (!config.running)
+	graph.Execute(jobSystem);
+
+	if (!config.running || guiQuit)
 	{
-		return false;
+		return false; // Quit event
 	}
 
-	// ImGui events + prepare
+	// The remaining stages share the registry, the map and the render context and run one after the other
 	{
-		auto guiLoop = profiler.BeginScoped(Profiler::Stage::GuiLoop);
-		if (Locator::debugGui::value().Loop())
-		{
-			return false; // Quit event
-		}
+		auto cameraUpdate = profiler.BeginScoped(Profiler::Stage::CameraUpdate);
+		camera.Update(deltaTime);
 	}
-
-	camera.Update(deltaTime);
 	Locator::cameraBookmarkSystem::value().Update(deltaTime);
 
 	// Update Game Logic in Registry
@@ -347,82 +494,23 @@ bool Game::Update() noexcept
 	// Update Uniforms
 	{
 		auto profilerScopedUpdateUniforms = profiler.BeginScoped(Profiler::Stage::UpdateUniforms);
+		UpdateUniforms();
+	}
 
-		// Update Debug Cross
-		ecs::components::Transform intersectionTransform {};
-		{
-			const auto screenSize =
-			    Locator::windowing::has_value() ? Locator::windowing::value().GetSize() : glm::zero<glm::ivec2>();
-			const auto scale = glm::vec3(50.0f, 50.0f, 50.0f);
-			if (screenSize.x > 0 && screenSize.y > 0)
-			{
-				glm::vec3 rayOrigin;
-				glm::vec3 rayDirection;
-				camera.DeprojectScreenToWorld(static_cast<glm::vec2>(_mousePosition) / static_cast<glm::vec2>(screenSize),
-				                              rayOrigin, rayDirection);
-				auto& dynamicsSystem = Locator::dynamicsSystem::value();
-
-				if (!glm::any(glm::isnan(rayOrigin) || glm::isnan(rayDirection)))
-				{
-					if (auto hit = dynamicsSystem.RayCastClosestHit(rayOrigin, rayDirection, 1e10f))
-					{
-						intersectionTransform = hit->first;
-					}
-					else // For the water
-					{
-						float intersectDistance = 0.0f;
-						const auto planeOrigin = glm::vec3(0.0f, 0.0f, 0.0f);
-						const auto planeNormal = glm::vec3(0.0f, 1.0f, 0.0f);
-						if (glm::intersectRayPlane(rayOrigin, rayDirection, planeOrigin, planeNormal, intersectDistance))
-						{
-							intersectionTransform.position = rayOrigin + rayDirection * intersectDistance;
-							intersectionTransform.rotation = glm::mat3(1.0f);
-						}
-					}
-				}
-				intersectionTransform.scale = scale;
-				_handPose = glm::mat4(1.0f);
-				_handPose = glm::translate(_handPose, intersectionTransform.position);
-				_handPose *= glm::mat4(intersectionTransform.rotation);
-				_handPose = glm::scale(_handPose, intersectionTransform.scale);
-				Locator::rendererInterface::value().UpdateDebugCrossUniforms(
-				    glm::translate(camera.GetFocus(Camera::Interpolation::Target)));
-			}
-		}
-
-		// Update Hand
-		if (!_handGripping)
-		{
-			const glm::vec3 handOffset(0, 1.5f, 0);
-			const glm::mat4 modelRotationCorrection = glm::eulerAngleX(glm::radians(90.0f));
-
-			const auto handEntity = Locator::handSystem::value()
-			                            .GetPlayerHands()[static_cast<size_t>(ecs::systems::HandSystemInterface::Side::Left)];
-			auto& handTransform = Locator::entitiesRegistry::value().Get<ecs::components::Transform>(handEntity);
-			// TODO(#480): move using velocity rather than snapping hand to intersectionTransform
-			handTransform.position = intersectionTransform.position;
-			handTransform.rotation = glm::eulerAngleY(camera.GetRotation().y) * modelRotationCorrection;
-			handTransform.rotation = intersectionTransform.rotation * handTransform.rotation;
-			handTransform.position += intersectionTransform.rotation * handOffset;
-			Locator::entitiesRegistry::value().SetDirty();
-		}
-
-		// Update Entities
-		{
-			auto updateEntities = profiler.BeginScoped(Profiler::Stage::UpdateEntities);
-			if (config.drawEntities)
-			{
-				Locator::rendereringSystem::value().PrepareDraw(config.drawBoundingBoxes, config.drawFootpaths,
-				                                                config.drawStreams);
-			}
-		}
-	} // Update Uniforms
+	// Update Entities
+	if (config.drawEntities || config.drawSprites)
+	{
+		auto& renderingSystem = Locator::rendereringSystem::value();
+		renderingSystem.UpdateAnimations(deltaTime);
+		auto updateEntities = profiler.BeginScoped(Profiler::Stage::UpdateEntities);
+		renderingSystem.PrepareDraw(config.drawBoundingBoxes, config.drawFootpaths, config.drawStreams, config.drawSprites);
+	}
 
 	// Update Audio
 	{
 		auto updateAudio = profiler.BeginScoped(Profiler::Stage::UpdateAudio);
 		Locator::audio::value().Update();
-	} // Update Audio
+	}
 
 	return config.numFramesToSimulate == 0 || _frameCount < config.numFramesToSimulate;
 }
@@ -508,26 +596,86 @@ bool Game::Initialize() noexcept
 	auto& levelManager = resources.GetLevels();
 	auto& soundManager = resources.GetSounds();
 	auto& glowManager = resources.GetGlows();
+	auto& audioManager = Locator::audio::value();
+	auto& jobSystem = Locator::jobSystem::value();
+
+	// Meshes hold the largest share of the budget, animations only keep their keyframes
+	meshManager.SetMemoryBudget(config.resourceMemoryBudget / 2);
+	textureManager.SetMemoryBudget(config.resourceMemoryBudget * 3 / 8);
+	animationManager.SetMemoryBudget(config.resourceMemoryBudget / 8);
+	// Animations are parsed on the workers when first played, their entities keep their bind pose meanwhile
+	animationManager.SetPlaceholder(std::make_shared<L3DAnim>());
+
+	// Files are read and parsed on the workers, this thread only creates the bgfx resources and fills the caches.
+	// Meshes, textures, animations and sounds are only registered here and get loaded on their first use.
+	resources::AssetLoader loader(jobSystem);
+	using Finish = resources::AssetLoader::Finish;
+
+	// Packs are memory mapped so that only the entries which get used are read, they stay alive with the sources
+	// registered from them so that evicted entries can be loaded again
+	const auto openPack = [&fileSystem](const std::filesystem::path& path) {
+		auto pack = std::make_shared<pack::PackFile>();
+		auto result = pack->Open(fileSystem.FindPath(path), pack::PackOpenMode::MemoryMap);
+		if (result == pack::PackResult::ErrCantOpen)
+		{
+			// Not a regular file, e.g. an Android asset
+			pack = std::make_shared<pack::PackFile>();
+			result = pack->ReadFile(*fileSystem.GetData(path));
+		}
+		if (result != pack::PackResult::Success)
+		{
+			throw std::runtime_error(
+			    fmt::format("Unable to load {}: {}", path.filename().string(), pack::ResultToStr(result)));
+		}
+		return std::shared_ptr<const pack::PackFile>(pack);
+	};
+
+	const auto addMesh = [&loader, &meshManager](std::string_view category, auto id, const std::filesystem::path& path,
+	                                             bool required = false) {
+		loader.Add(
+		    category,
+		    [&meshManager, id, path]() -> Finish {
+			    std::shared_ptr<resources::BakedBlob> baked = resources::L3DLoader::FindBaked(path);
+			    if (baked != nullptr)
+			    {
+				    return [&meshManager, id, path, baked]() {
+					    meshManager.Load(id, resources::L3DLoader::FromBakedTag {}, path.stem().string(), *baked);
+				    };
+			    }
+			    std::shared_ptr<l3d::L3DFile> file = resources::L3DLoader::Parse(path);
+			    resources::L3DLoader::StoreBaked(path, *file);
+			    return [&meshManager, id, path, file]() {
+				    meshManager.Load(id, resources::L3DLoader::FromParsedTag {}, path.stem().string(), *file);
+			    };
+		    },
+		    required);
+	};
+
+	// Meshes registered from disk are only baked on their first use, a rebuild bakes them all up front so that the
+	// cache is complete for the next start
+	const auto registerMesh = [&loader, &meshManager](auto id, const std::filesystem::path& path) {
+		meshManager.Register(id, resources::L3DLoader::FromDiskTag {}, path);
+		if (Locator::assetCache::has_value() && Locator::assetCache::value().IsRebuilding())
+		{
+			loader.Add("baked meshes", [path]() -> Finish {
+				resources::L3DLoader::StoreBaked(path, *resources::L3DLoader::Parse(path));
+				return []() {};
+			});
+		}
+	};
 
 	fileSystem.Iterate(
-	    fileSystem.GetPath<Path::Citadel>() / "OutsideMeshes", false, [&meshManager](const std::filesystem::path& f) {
+	    fileSystem.GetPath<Path::Citadel>() / "OutsideMeshes", false, [&registerMesh](const std::filesystem::path& f) {
 		    if (f.extension() == ".zzz")
 		    {
-			    SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading temple mesh: {}", f.stem().string());
-			    try
-			    {
-				    meshManager.Load(fmt::format("temple/{}", f.stem().string()), resources::L3DLoader::FromDiskTag {}, f);
-			    }
-			    catch (std::runtime_error& err)
-			    {
-				    SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
-			    }
+			    SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Registering temple mesh: {}", f.stem().string());
+			    registerMesh(fmt::format("temple/{}", f.stem().string()), f);
 		    }
 	    });
 
 	fileSystem.Iterate( //
 	    fileSystem.GetPath<filesystem::Path::Citadel>() / "engine", false,
-	    [&meshManager, &glowManager](const std::filesystem::path& f) {
+	    [&loader, &registerMesh, &glowManager](const std::filesystem::path& f) {
 		    if (f.extension() == ".zzz")
 		    {
 			    if (f.stem().string().ends_with("lo_l3d"))
@@ -537,74 +685,56 @@ bool Game::Initialize() noexcept
 				        "Skipping lo duplicate lo meshes. See https://github.com/openblack/openblack/issues/727");
 				    return;
 			    }
-			    SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading interior temple mesh: {}", f.stem().string());
-			    try
-			    {
-				    meshManager.Load(fmt::format("temple/interior/{}", f.stem().string()), resources::L3DLoader::FromDiskTag {},
-				                     f);
-			    }
-			    catch (std::runtime_error& err)
-			    {
-				    SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
-			    }
+			    SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Registering interior temple mesh: {}", f.stem().string());
+			    registerMesh(fmt::format("temple/interior/{}", f.stem().string()), f);
 		    }
 		    else if (f.extension() == ".glw")
 		    {
 			    SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading interior temple glows: {}", f.stem().string());
-			    try
+			    loader.Add("temple glows", [&glowManager, f]() -> Finish {
+				    auto lights = resources::LightLoader {}(resources::LightLoader::FromDiskTag {}, f);
+				    return [&glowManager, f, lights]() {
+					    glowManager.Load(fmt::format("temple/interior/glow/{}", f.stem().string()),
+					                     resources::LightLoader::FromResourceTag {}, lights);
+				    };
+			    });
+		    }
+	    });
+
+	loader.Add(
+	    "packed meshes",
+	    [&fileSystem, &openPack, &meshManager, &textureManager]() -> Finish {
+		    auto pack = openPack(fileSystem.GetPath<Path::Data>() / "AllMeshes.g3d");
+		    return [pack, &meshManager, &textureManager]() {
+			    for (size_t i = 0; i < pack->GetMeshes().size(); ++i)
 			    {
-				    glowManager.Load(fmt::format("temple/interior/glow/{}", f.stem().string()),
-				                     resources::LightLoader::FromDiskTag {}, f);
+				    const auto meshId = static_cast<MeshId>(i);
+				    meshManager.Register(meshId, resources::L3DLoader::FromPackTag {}, k_MeshNames.at(i), pack, i);
 			    }
-			    catch (std::runtime_error& err)
+			    for (const auto& [name, g3dTexture] : pack->GetTextures())
 			    {
-				    SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
+				    textureManager.Register(g3dTexture.header.id, resources::Texture2DLoader::FromPackTag {}, pack, name);
 			    }
-		    }
-	    });
-
-	pack::PackFile pack;
-
-	auto packResult = pack.ReadFile(*fileSystem.GetData(fileSystem.GetPath<Path::Data>() / "AllMeshes.g3d"));
-	if (packResult != pack::PackResult::Success)
-	{
-		SPDLOG_LOGGER_CRITICAL(spdlog::get("game"), "Unable to load AllMeshes.g3d: {}", pack::ResultToStr(packResult));
-		return false;
-	}
-
-	const auto& meshes = pack.GetMeshes();
-	// TODO (#749) use std::views::enumerate
-	for (size_t i = 0; const auto& mesh : meshes)
-	{
-		const auto meshId = static_cast<MeshId>(i);
-		meshManager.Load(meshId, resources::L3DLoader::FromBufferTag {}, k_MeshNames.at(i), mesh);
-		++i;
-	}
-
-	const auto& textures = pack.GetTextures();
-	for (auto const& [name, g3dTexture] : textures)
-	{
-		textureManager.Load(g3dTexture.header.id, resources::Texture2DLoader::FromPackTag {}, name, g3dTexture);
-	}
-
-	pack::PackFile animationPack;
-	packResult = animationPack.ReadFile(*fileSystem.GetData(fileSystem.GetPath<Path::Data>() / "AllAnims.anm"));
-	if (packResult != pack::PackResult::Success)
-	{
-		SPDLOG_LOGGER_CRITICAL(spdlog::get("game"), "Unable to load AllAnims.anm: {}", pack::ResultToStr(packResult));
-		return false;
-	}
-
-	const auto& animations = animationPack.GetAnimations();
-	// TODO (#749) use std::views::enumerate
-	for (size_t i = 0; i < animations.size(); i++)
-	{
-		animationManager.Load(i, resources::L3DAnimLoader::FromBufferTag {}, animations[i]);
-	}
+		    };
+	    },
+	    true);
+
+	loader.Add(
+	    "packed animations",
+	    [&fileSystem, &openPack, &animationManager]() -> Finish {
+		    auto pack = openPack(fileSystem.GetPath<Path::Data>() / "AllAnims.anm");
+		    return [pack, &animationManager]() {
+			    for (size_t i = 0; i < pack->GetAnimations().size(); i++)
+			    {
+				    animationManager.RegisterAsync(i, resources::L3DAnimLoader::FromPackTag {}, pack, i);
+			    }
+		    };
+	    },
+	    true);
 
-	fileSystem.Iterate(fileSystem.GetPath<Path::CreatureMesh>(), false, [&meshManager](const std::filesystem::path& f) {
+	fileSystem.Iterate(fileSystem.GetPath<Path::CreatureMesh>(), false, [&registerMesh](const std::filesystem::path& f) {
 		const auto& fileName = f.stem().string();
-		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading creature mesh: {}", fileName);
+		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Registering creature mesh: {}", fileName);
 		try
 		{
 			if (string_utils::BeginsWith(fileName, "Hand"))
@@ -612,8 +742,7 @@ bool Game::Initialize() noexcept
 				return;
 			}
 
-			const auto meshId = creature::GetIdFromMeshName(fileName);
-			meshManager.Load(meshId, resources::L3DLoader::FromDiskTag {}, f);
+			registerMesh(creature::GetIdFromMeshName(fileName), f);
 		}
 		catch (std::runtime_error& err)
 		{
@@ -623,131 +752,132 @@ bool Game::Initialize() noexcept
 
 	// Load loose one-off assets
 	{
-		using AFromDiskTag = resources::L3DAnimLoader::FromDiskTag;
-		animationManager.Load("coffre", AFromDiskTag {}, fileSystem.GetPath<Path::Misc>() / "coffre.anm");
-
-		using LFromDiskTag = resources::L3DLoader::FromDiskTag;
-		meshManager.Load("hand", LFromDiskTag {}, fileSystem.GetPath<Path::CreatureMesh>() / "Hand_Boned_Base2.l3d");
-		meshManager.Load("coffre", LFromDiskTag {}, fileSystem.GetPath<Path::Misc>() / "coffre.l3d");
-		meshManager.Load("cone", LFromDiskTag {}, fileSystem.GetPath<Path::Data>() / "cone.l3d");
-		meshManager.Load("marker", LFromDiskTag {}, fileSystem.GetPath<Path::Data>() / "marker.l3d");
-		meshManager.Load("river", LFromDiskTag {}, fileSystem.GetPath<Path::Data>() / "river.l3d");
-		meshManager.Load("river2", LFromDiskTag {}, fileSystem.GetPath<Path::Data>() / "river2.l3d");
-		meshManager.Load("metre_sphere", LFromDiskTag {}, fileSystem.GetPath<Path::Data>() / "metre_sphere.l3d");
+		loader.Add(
+		    "loose assets",
+		    [&fileSystem, &animationManager]() -> Finish {
+			    using AFromDiskTag = resources::L3DAnimLoader::FromDiskTag;
+			    auto animation = resources::L3DAnimLoader {}(AFromDiskTag {}, fileSystem.GetPath<Path::Misc>() / "coffre.anm");
+			    return [&animationManager, animation]() {
+				    animationManager.Load("coffre", resources::L3DAnimLoader::FromResourceTag {}, animation);
+			    };
+		    },
+		    true);
+
+		addMesh("loose assets", "hand", fileSystem.GetPath<Path::CreatureMesh>() / "Hand_Boned_Base2.l3d", true);
+		addMesh("loose assets", "coffre", fileSystem.GetPath<Path::Misc>() / "coffre.l3d", true);
+		addMesh("loose assets", "cone", fileSystem.GetPath<Path::Data>() / "cone.l3d", true);
+		addMesh("loose assets", "marker", fileSystem.GetPath<Path::Data>() / "marker.l3d", true);
+		addMesh("loose assets", "river", fileSystem.GetPath<Path::Data>() / "river.l3d", true);
+		addMesh("loose assets", "river2", fileSystem.GetPath<Path::Data>() / "river2.l3d", true);
+		addMesh("loose assets", "metre_sphere", fileSystem.GetPath<Path::Data>() / "metre_sphere.l3d", true);
 	}
 
+	const auto addLevel = [&loader, &levelManager](const std::string& id, const std::filesystem::path& path,
+	                                               Level::LandType landType) {
+		loader.Add("levels", [&levelManager, id, path, landType]() -> Finish {
+			if (!Level::IsLevelFile(path))
+			{
+				return {};
+			}
+			auto level = resources::LevelLoader {}(resources::LevelLoader::FromDiskTag {}, path, landType);
+			return [&levelManager, id, level]() { levelManager.Load(id, resources::LevelLoader::FromResourceTag {}, level); };
+		});
+	};
+
 	// TODO(raffclar): #400: Parse level files within the resource loader
 	// TODO(raffclar): #405: Determine campaign levels from the challenge script file
 	// Load the campaign levels
-	fileSystem.Iterate(fileSystem.GetPath<Path::Scripts>(), false, [&levelManager](const std::filesystem::path& f) {
+	fileSystem.Iterate(fileSystem.GetPath<Path::Scripts>(), false, [&addLevel](const std::filesystem::path& f) {
 		const auto& name = f.stem().string();
 		if (f.extension() != ".txt" || name.rfind("InfoScript", 0) != std::string::npos)
 		{
 			return;
 		}
 		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading campaign level: {}", f.stem().string());
-		try
-		{
-			if (Level::IsLevelFile(f))
-			{
-				levelManager.Load(fmt::format("campaign/{}", name), resources::LevelLoader::FromDiskTag {}, f,
-				                  Level::LandType::Campaign);
-			}
-		}
-		catch (std::runtime_error& err)
-		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
-		}
+		addLevel(fmt::format("campaign/{}", name), f, Level::LandType::Campaign);
 	});
 	// Load Playgrounds
 	// Attempt to load additional levels as playgrounds
-	fileSystem.Iterate(fileSystem.GetPath<Path::Playgrounds>(), false, [&levelManager](const std::filesystem::path& f) {
-		if (f.extension() != ".txt")
-		{
-			return;
-		}
-		const auto& name = f.stem().string();
-		if (levelManager.Contains(fmt::format("playgrounds/{}", name)))
-		{
-			// Already added
-			return;
-		}
-
-		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading custom level: {}", f.stem().string());
-		try
-		{
-			if (Level::IsLevelFile(f))
-			{
-				levelManager.Load(fmt::format("playgrounds/{}", name), resources::LevelLoader::FromDiskTag {}, f,
-				                  Level::LandType::Skirmish);
-			}
-		}
-		catch (std::runtime_error& err)
-		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
-		}
-	});
+	fileSystem.Iterate(fileSystem.GetPath<Path::Playgrounds>(), false,
+	                   [&addLevel, &levelManager](const std::filesystem::path& f) {
+		                   if (f.extension() != ".txt")
+		                   {
+			                   return;
+		                   }
+		                   const auto& name = f.stem().string();
+		                   if (levelManager.Contains(fmt::format("playgrounds/{}", name)))
+		                   {
+			                   // Already added
+			                   return;
+		                   }
+
+		                   SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading custom level: {}", f.stem().string());
+		                   addLevel(fmt::format("playgrounds/{}", name), f, Level::LandType::Skirmish);
+	                   });
 
 	// Load all sound packs in the Audio directory
-	auto& audioManager = Locator::audio::value();
 	fileSystem.Iterate(
-	    fileSystem.GetPath<Path::Audio>(), true, [&audioManager, &soundManager, &fileSystem](const std::filesystem::path& f) {
+	    fileSystem.GetPath<Path::Audio>(), true,
+	    [&loader, &openPack, &audioManager, &soundManager](const std::filesystem::path& f) {
 		    if (f.extension() != ".sad")
 		    {
 			    return;
 		    }
 
-		    pack::PackFile soundPack;
-		    SPDLOG_LOGGER_DEBUG(spdlog::get("audio"), "Opening sound pack {}", f.filename().string());
-		    const auto result = soundPack.ReadFile(*fileSystem.GetData(f));
-		    if (result != pack::PackResult::Success)
-		    {
-			    SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Unable to load sound pack {}: {}", f.filename().string(),
-			                        pack::ResultToStr(result));
-			    return;
-		    }
-		    const auto& audioHeaders = soundPack.GetAudioSampleHeaders();
-		    const auto& audioData = soundPack.GetAudioSamplesData();
-		    auto soundName = std::filesystem::path(audioHeaders[0].name.data());
+		    loader.Add("sound packs", [&openPack, &audioManager, &soundManager, f]() -> Finish {
+			    SPDLOG_LOGGER_DEBUG(spdlog::get("audio"), "Opening sound pack {}", f.filename().string());
+			    auto soundPack = openPack(f);
+			    const auto& audioHeaders = soundPack->GetAudioSampleHeaders();
+			    const auto& audioData = soundPack->GetAudioSamplesData();
 
-		    if (audioHeaders.empty())
-		    {
-			    SPDLOG_LOGGER_WARN(spdlog::get("audio"), "Empty sound pack found for {}. Skipping", f.filename().string());
-			    return;
-		    }
+			    if (audioHeaders.empty())
+			    {
+				    SPDLOG_LOGGER_WARN(spdlog::get("audio"), "Empty sound pack found for {}. Skipping", f.filename().string());
+				    return {};
+			    }
 
-		    auto groupName = f.filename().string();
+			    // A hacky way of detecting if the sound is music as all music sounds end with "mpg"
+			    if (std::filesystem::path(audioHeaders[0].name.data()).extension() == ".mpg")
+			    {
+				    return [&audioManager, packName = f.string()]() { audioManager.AddMusicEntry(packName); };
+			    }
 
-		    // A hacky way of detecting if the sound is music as all music sounds end with "mpg"
-		    if (soundName.extension() == ".mpg")
-		    {
-			    auto buffers = std::queue<std::vector<uint8_t>>();
-			    auto packName = f.string();
-			    audioManager.AddMusicEntry(packName);
-		    }
-		    else
-		    {
-			    audioManager.CreateSoundGroup(groupName);
-			    for (size_t i = 0; i < audioHeaders.size(); i++)
+			    auto groupName = f.filename().string();
+			    size_t soundCount = 0;
+			    for (; soundCount < audioHeaders.size(); soundCount++)
 			    {
-				    soundName = std::filesystem::path(audioHeaders[i].name.data());
-				    if (audioData[i].empty())
+				    if (audioData[soundCount].empty())
 				    {
 					    SPDLOG_LOGGER_WARN(spdlog::get("audio"), "Empty sound buffer found for {}. Skipping",
-					                       soundName.string());
-					    return;
+					                       std::filesystem::path(audioHeaders[soundCount].name.data()).string());
+					    break;
 				    }
-
-				    const auto stringId = fmt::format("{}/{}", groupName, audioHeaders[i].id);
-				    const entt::id_type id = entt::hashed_string(stringId.c_str());
-				    const std::vector<std::vector<uint8_t>> buffer = {audioData[i]};
-				    SPDLOG_LOGGER_DEBUG(spdlog::get("audio"), "Loading sound {}: {}", stringId, audioHeaders[i].name.data());
-				    soundManager.Load(id, resources::SoundLoader::FromBufferTag {}, audioHeaders[i], buffer);
-				    audioManager.AddToSoundGroup(groupName, id);
 			    }
-		    }
+
+			    return [&audioManager, &soundManager, groupName, soundCount, pack = soundPack]() {
+				    audioManager.CreateSoundGroup(groupName);
+				    const auto& headers = pack->GetAudioSampleHeaders();
+				    for (size_t i = 0; i < soundCount; i++)
+				    {
+					    const auto stringId = fmt::format("{}/{}", groupName, headers[i].id);
+					    const entt::id_type id = entt::hashed_string(stringId.c_str());
+					    SPDLOG_LOGGER_DEBUG(spdlog::get("audio"), "Registering sound {}: {}", stringId, headers[i].name.data());
+					    soundManager.Register(id, resources::SoundLoader::FromPackTag {}, pack, i);
+					    audioManager.AddToSoundGroup(groupName, id);
+				    }
+			    };
+		    });
 	    });
 
+	fileSystem.Iterate(fileSystem.GetPath<Path::Textures>(), false, [&textureManager](const std::filesystem::path& f) {
+		if (string_utils::LowerCase(f.extension().string()) == ".raw")
+		{
+			SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Registering raw texture: {}", f.stem().string());
+			textureManager.Register(fmt::format("raw/{}", f.stem().string()), resources::Texture2DLoader::FromDiskTag {}, f);
+		}
+	});
+
+	// Overlaps with the workers still reading the assets above
 	{
 		InfoFile infoFile;
 		auto result = infoFile.LoadFromFile(Locator::filesystem::value().GetPath<filesystem::Path::Scripts>() / "info.dat");
@@ -759,20 +889,11 @@ bool Game::Initialize() noexcept
 		Locator::infoConstants::reset(result.release());
 	}
 
-	fileSystem.Iterate(fileSystem.GetPath<Path::Textures>(), false, [&textureManager](const std::filesystem::path& f) {
-		if (string_utils::LowerCase(f.extension().string()) == ".raw")
-		{
-			SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading raw texture: {}", f.stem().string());
-			try
-			{
-				textureManager.Load(fmt::format("raw/{}", f.stem().string()), resources::Texture2DLoader::FromDiskTag {}, f);
-			}
-			catch (std::runtime_error& err)
-			{
-				SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
-			}
-		}
-	});
+	if (!loader.Run())
+	{
+		SPDLOG_LOGGER_CRITICAL(spdlog::get("game"), "Failed to load required assets.");
+		return false;
+	}
 
 	return true;
 }
@@ -867,6 +988,7 @@ bool Game::Run() noexcept
 			    .drawTestModel = config.drawTestModel,
 			    .drawDebugCross = config.drawDebugCross,
 			    .drawBoundingBoxes = config.drawBoundingBoxes,
+			    .frustumCulling = config.frustumCulling,
 			    .cullBack = false,
 			    .wireframe = config.wireframe,
 			};
@@ -918,8 +1040,32 @@ bool Game::LoadMap(const std::filesystem::path& path) noexcept
 		return false;
 	}
 
-	const auto data = fileSystem.ReadAll(path);
-	const auto source = std::string(reinterpret_cast<const char*>(data.data()), data.size());
+	// Maps are large lists of commands, the compiled script is cached to skip parsing them on the next load
+	const std::array sources {path};
+	auto compiled = Locator::assetCache::has_value() ? Locator::assetCache::value().Find("script", sources) : nullptr;
+	if (compiled != nullptr && !Script::IsCompatible(compiled->GetData()))
+	{
+		compiled.reset();
+	}
+	if (compiled == nullptr)
+	{
+		const auto data = fileSystem.ReadAll(path);
+		const auto source = std::string(reinterpret_cast<const char*>(data.data()), data.size());
+		try
+		{
+			Script script;
+			compiled = std::make_unique<resources::BakedBlob>(script.Compile(source));
+		}
+		catch (const std::runtime_error& err)
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Could not compile script {}: {}", path.generic_string(), err.what());
+			return false;
+		}
+		if (Locator::assetCache::has_value())
+		{
+			Locator::assetCache::value().Store("script", sources, compiled->GetData());
+		}
+	}
 
 	// Reset everything. Deletes all entities and their components
 	Locator::entitiesRegistry::value().Reset();
@@ -933,8 +1079,7 @@ bool Game::LoadMap(const std::filesystem::path& path) noexcept
 	Locator::camera::value().SetProjectionMatrixPerspective(config.cameraXFov, aspect, config.cameraNearClip,
 	                                                        config.cameraFarClip);
 
-	Script script;
-	script.Load(source);
+	Script::Run(compiled->GetData());
 
 	// Each released map comes with an optional .fot file which contains the footpath information for the map
 	const auto stem = string_utils::LowerCase(path.stem().generic_string());
@@ -60,6 +60,10 @@ struct Arguments
 	std::string gamePath;
 	float guiScale;
 	uint32_t numFramesToSimulate;
+	uint32_t resourceBudgetMiB;
+	std::filesystem::path assetCachePath;
+	bool rebuildAssetCache;
+	bool watchGameFiles;
 	std::string logFile;
 	std::array<spdlog::level::level_enum, k_LoggingSubsystemStrs.size()> logLevels;
 	std::string startLevel;
@@ -78,6 +82,7 @@ class Game
 	virtual ~Game() noexcept;
 
 	bool ProcessEvents(const SDL_Event& event) noexcept;
+	[[nodiscard]] bool IsTurnDue() const noexcept;
 	bool GameLogicLoop() noexcept;
 	bool Update() noexcept;
 	bool Initialize() noexcept;
@@ -102,6 +107,9 @@ class Game
 private:
 	static Game* sInstance;
 
+	/// Update the debug cross and the player's hand from the mouse position
+	void UpdateUniforms() noexcept;
+
 	/// path to Lionhead Studios Ltd/Black & White folder
 	const std::filesystem::path _gamePath;
 
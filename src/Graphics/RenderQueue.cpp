@@ -0,0 +1,181 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "IndexBuffer.h"
+#include "Mesh.h"
+#include "ShaderProgram.h"
+#include "VertexBuffer.h"
+
+using namespace openblack::graphics;
+
+namespace
+{
+// Terrain and opaque: 2 bits layer | 10 bits program | 12 bits texture | 12 bits mesh | 28 bits depth
+// Blended:            2 bits layer | 30 bits inverted depth | 10 bits program | 12 bits texture | 10 bits mesh
+constexpr uint64_t k_ProgramMask = (1u << 10) - 1;
+constexpr uint64_t k_TextureMask = (1u << 12) - 1;
+constexpr uint64_t k_MeshMask = (1u << 12) - 1;
+
+/// Positive floats sort in the same order as their bit pattern
+uint32_t GetDepthBits(float depth)
+{
+	return std::bit_cast<uint32_t>(std::max(depth, 0.0f));
+}
+
+bool SameHandle(const auto& a, const auto& b)
+{
+	return a.idx == b.idx;
+}
+
+bool SameTextures(const RenderQueue::Item& a, const RenderQueue::Item& b)
+{
+	return std::equal(a.textures.cbegin(), a.textures.cend(), b.textures.cbegin(),
+	                  [](const RenderQueue::TextureBinding& x, const RenderQueue::TextureBinding& y) {
+		                  return SameHandle(x.sampler, y.sampler) && SameHandle(x.texture, y.texture) && x.stage == y.stage;
+	                  });
+}
+
+bool SameTransforms(const RenderQueue::Item& a, const RenderQueue::Item& b)
+{
+	return a.transforms == b.transforms && a.transformCount == b.transformCount;
+}
+
+bool SameIndices(const RenderQueue::Item& a, const RenderQueue::Item& b)
+{
+	return a.mesh == b.mesh && a.indexCount == b.indexCount && a.indexOffset == b.indexOffset;
+}
+
+bool SameInstances(const RenderQueue::Item& a, const RenderQueue::Item& b)
+{
+	return a.instanceBuffer == b.instanceBuffer && a.instanceStart == b.instanceStart && a.instanceCount == b.instanceCount;
+}
+
+bool SameState(const RenderQueue::Item& a, const RenderQueue::Item& b)
+{
+	return a.state == b.state && a.rgba == b.rgba;
+}
+
+bool SameUniform(const RenderQueue::UniformValue& a, const RenderQueue::UniformValue& b)
+{
+	return SameHandle(a.handle, b.handle) && a.value == b.value;
+}
+} // namespace
+
+uint64_t RenderQueue::GetSortKey(const Item& item)
+{
+	const uint64_t program = item.program->GetRawHandle().idx & k_ProgramMask;
+	const uint64_t texture = item.textures[0].texture.idx & k_TextureMask;
+	// The address is only used to keep the draws of a mesh together
+	const uint64_t mesh = (reinterpret_cast<uintptr_t>(item.mesh) / alignof(Mesh)) & k_MeshMask;
+	const uint64_t depth = GetDepthBits(item.depth);
+	const uint64_t layer = static_cast<uint64_t>(item.layer) << 62;
+
+	if (item.layer == Layer::Blended)
+	{
+		return layer | ((~depth & 0x7FFFFFFFu) >> 1) << 32 | program << 22 | texture << 10 | (mesh & 0x3FFu);
+	}
+	return layer | program << 50 | texture << 38 | mesh << 26 | depth >> 3;
+}
+
+void RenderQueue::Add(const Item& item)
+{
+	_keys.emplace_back(GetSortKey(item), static_cast<uint32_t>(_items.size()));
+	_items.push_back(item);
+}
+
+void RenderQueue::Submit(RenderPass viewId)
+{
+	std::sort(_keys.begin(), _keys.end());
+
+	const Item* previous = nullptr;
+	for (size_t i = 0; i < _keys.size(); ++i)
+	{
+		const auto& item = _items[_keys[i].second];
+		const auto* next = i + 1 < _keys.size() ? &_items[_keys[i + 1].second] : nullptr;
+
+		// Only set what the previous draw did not keep
+		if (item.transforms != nullptr && item.transformCount > 0 && (previous == nullptr || !SameTransforms(*previous, item)))
+		{
+			bgfx::setTransform(item.transforms, item.transformCount);
+		}
+		if (previous == nullptr || !SameTextures(*previous, item))
+		{
+			for (const auto& binding : item.textures)
+			{
+				if (bgfx::isValid(binding.sampler))
+				{
+					bgfx::setTexture(binding.stage, binding.sampler, binding.texture);
+				}
+			}
+		}
+		if (previous == nullptr || previous->mesh != item.mesh)
+		{
+			item.mesh->GetVertexBuffer().Bind();
+		}
+		if (item.indexCount > 0 && (previous == nullptr || !SameIndices(*previous, item)))
+		{
+			item.mesh->GetIndexBuffer().Bind(item.indexCount, item.indexOffset);
+		}
+		if (item.instanceBuffer != nullptr && (previous == nullptr || !SameInstances(*previous, item)))
+		{
+			bgfx::setInstanceDataBuffer(*item.instanceBuffer, item.instanceStart, item.instanceCount);
+		}
+		if (previous == nullptr || !SameState(*previous, item))
+		{
+			bgfx::setState(item.state, item.rgba);
+		}
+		// Uniforms are not part of the discarded state, they keep their value until set again
+		for (size_t u = 0; u < item.uniforms.size(); ++u)
+		{
+			const auto& uniform = item.uniforms[u];
+			if (bgfx::isValid(uniform.handle) && (previous == nullptr || !SameUniform(previous->uniforms[u], uniform)))
+			{
+				bgfx::setUniform(uniform.handle, &uniform.value);
+			}
+		}
+
+		// Keep what the next draw has in common with this one
+		uint8_t discard = BGFX_DISCARD_NONE;
+		if (next == nullptr || !SameTransforms(item, *next))
+		{
+			discard |= BGFX_DISCARD_TRANSFORM;
+		}
+		if (next == nullptr || !SameTextures(item, *next))
+		{
+			discard |= BGFX_DISCARD_BINDINGS;
+		}
+		if (next == nullptr || item.mesh != next->mesh)
+		{
+			discard |= BGFX_DISCARD_VERTEX_STREAMS;
+		}
+		if (next == nullptr || !SameIndices(item, *next))
+		{
+			discard |= BGFX_DISCARD_INDEX_BUFFER;
+		}
+		if (next == nullptr || !SameInstances(item, *next))
+		{
+			discard |= BGFX_DISCARD_INSTANCE_DATA;
+		}
+		if (next == nullptr || !SameState(item, *next))
+		{
+			discard |= BGFX_DISCARD_STATE;
+		}
+		bgfx::submit(static_cast<bgfx::ViewId>(viewId), item.program->GetRawHandle(), 0, discard);
+
+		previous = &item;
+	}
+
+	_items.clear();
+	_keys.clear();
+}
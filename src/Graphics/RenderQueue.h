@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <bgfx/bgfx.h>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "RenderPass.h"
+
+namespace openblack::graphics
+{
+class Mesh;
+class ShaderProgram;
+
+/// Collects the draws of a pass and submits them ordered by a 64 bit sort key. Draws are submitted layer by layer. Within
+/// the terrain and opaque layers they are grouped by program, texture and mesh and then front to back, blended draws are
+/// back to front. Bindings which consecutive draws have in common are kept by bgfx instead of being set again.
+/// The view must be in bgfx::ViewMode::Sequential, otherwise bgfx sorts the draws again by its own key.
+class RenderQueue
+{
+public:
+	static constexpr size_t k_MaxTextures = 4;
+	static constexpr size_t k_MaxUniforms = 3;
+
+	/// Submission order of the draws, set by the caller rather than guessed from the blend state
+	enum class Layer : uint8_t
+	{
+		/// The main occluder, drawn first so that it rejects what is behind hills. It blends with the water at the shore
+		/// but is still sorted as opaque.
+		Terrain,
+		Opaque,
+		Blended,
+	};
+
+	struct TextureBinding
+	{
+		bgfx::UniformHandle sampler {BGFX_INVALID_HANDLE};
+		bgfx::TextureHandle texture {BGFX_INVALID_HANDLE};
+		uint8_t stage {0};
+	};
+
+	struct UniformValue
+	{
+		bgfx::UniformHandle handle {BGFX_INVALID_HANDLE};
+		glm::vec4 value {0.0f};
+	};
+
+	struct Item
+	{
+		Layer layer {Layer::Opaque};
+		const ShaderProgram* program {nullptr};
+		uint64_t state {0};
+		uint32_t rgba {0};
+		const Mesh* mesh {nullptr};
+		/// Range of the mesh's index buffer, nothing is bound if the count is 0
+		uint32_t indexCount {0};
+		uint32_t indexOffset {0};
+		const bgfx::DynamicVertexBufferHandle* instanceBuffer {nullptr};
+		uint32_t instanceStart {0};
+		uint32_t instanceCount {0};
+		const glm::mat4* transforms {nullptr};
+		uint8_t transformCount {0};
+		/// Bindings with an invalid sampler are skipped. The first texture is part of the sort key.
+		std::array<TextureBinding, k_MaxTextures> textures {};
+		/// Every vec4 uniform the draw depends on, uniforms with an invalid handle are skipped
+		std::array<UniformValue, k_MaxUniforms> uniforms {};
+		/// Distance to the camera. Draws of the blended layer are sorted back to front, the others front to back.
+		float depth {0.0f};
+	};
+
+	void Add(const Item& item);
+	/// Sort and submit every item added since the last submit to \p viewId, then clear the queue
+	void Submit(RenderPass viewId);
+	[[nodiscard]] bool Empty() const { return _items.empty(); }
+
+private:
+	[[nodiscard]] static uint64_t GetSortKey(const Item& item);
+
+	std::vector<Item> _items;
+	/// Sort key and index into \ref _items
+	std::vector<std::pair<uint64_t, uint32_t>> _keys;
+};
+
+} // namespace openblack::graphics
@@ -13,10 +13,14 @@
 
 #include <cstdint>
 
+#include <algorithm>
+#include <optional>
+
 #include <SDL_video.h>
 #include <bgfx/platform.h>
 #include <bimg/bimg.h>
 #include <bx/file.h>
+#include <entt/core/hashed_string.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/transform.hpp>
 #include <spdlog/spdlog.h>
@@ -30,7 +34,6 @@
 #include "3D/SkyInterface.h"
 #include "Camera/Camera.h"
 #include "ECS/Components/Mesh.h"
-#include "ECS/Components/Sprite.h"
 #include "ECS/Registry.h"
 #include "ECS/Systems/RenderingSystemInterface.h"
 #include "EngineConfig.h"
@@ -38,6 +41,7 @@
 #include "Graphics/FrameBuffer.h"
 #include "Graphics/IndexBuffer.h"
 #include "Graphics/Primitive.h"
+#include "Graphics/RenderQueue.h"
 #include "Graphics/ShaderManager.h"
 #include "Graphics/VertexBuffer.h"
 #include "Locator.h"
@@ -62,6 +66,24 @@ constexpr auto k_BgfxDefaultStateInvertedZ = 0 \
                                      | BGFX_STATE_MSAA;
 // clang-format on
 
+/// Culled sprites allowed between two visible ones before a run of instanced sprites is split
+constexpr uint32_t k_MaxCulledSpritesInRun = 8;
+
+// Uniforms bound in per-draw loops, looked up by handle through ShaderProgram::GetUniform
+constexpr entt::id_type k_DiffuseSampler = entt::hashed_string::value("s_diffuse");
+constexpr entt::id_type k_HeightMapSampler = entt::hashed_string::value("s_heightmap");
+constexpr entt::id_type k_BonesSampler = entt::hashed_string::value("s_bones");
+constexpr entt::id_type k_FootprintSampler = entt::hashed_string::value("s_footprint");
+constexpr entt::id_type k_MaterialsSampler = entt::hashed_string::value("s0_materials");
+constexpr entt::id_type k_BumpSampler = entt::hashed_string::value("s1_bump");
+constexpr entt::id_type k_SmallBumpSampler = entt::hashed_string::value("s2_smallBump");
+constexpr entt::id_type k_FootprintsSampler = entt::hashed_string::value("s3_footprints");
+constexpr entt::id_type k_IslandExtentUniform = entt::hashed_string::value("u_islandExtent");
+constexpr entt::id_type k_BoneTextureSizeUniform = entt::hashed_string::value("u_boneTextureSize");
+constexpr entt::id_type k_SkyAlphaThresholdUniform = entt::hashed_string::value("u_skyAlphaThreshold");
+constexpr entt::id_type k_BlockPositionAndSizeUniform = entt::hashed_string::value("u_blockPositionAndSize");
+constexpr entt::id_type k_SkyAndBumpUniform = entt::hashed_string::value("u_skyAndBump");
+
 struct BgfxCallback: public bgfx::CallbackI
 {
 	constexpr static std::array<std::string_view, bgfx::Fatal::Count> k_CodeLookup = {
@@ -244,6 +266,7 @@ Renderer::Renderer(uint32_t bgfxReset, std::unique_ptr<BgfxCallback>&& bgfxCallb
     : _shaderManager(std::make_unique<ShaderManager>())
     , _bgfxCallback(std::move(bgfxCallback))
     , _bgfxReset(bgfxReset)
+    , _renderQueue(std::make_unique<RenderQueue>())
 {
 	_shaderManager->LoadShaders();
 	// allocate vertex buffers for our debug draw and for primitives
@@ -257,6 +280,11 @@ Renderer::Renderer(uint32_t bgfxReset, std::unique_ptr<BgfxCallback>&& bgfxCallb
 		bgfx::setViewName(i, name.data());
 		++i;
 	}
+	// Draws of these views are already ordered by RenderQueue, bgfx must keep the submission order
+	for (const auto viewId : {RenderPass::Reflection, RenderPass::Main, RenderPass::MeshViewer})
+	{
+		bgfx::setViewMode(static_cast<bgfx::ViewId>(viewId), bgfx::ViewMode::Sequential);
+	}
 }
 
 Renderer::~Renderer() noexcept
@@ -314,12 +342,23 @@ const Texture2D* GetTexture(uint32_t skinID, const std::unordered_map<SkinId, st
 	return texture;
 }
 
+Renderer::MeshUniforms::MeshUniforms(const ShaderProgram& program)
+    : diffuseSampler(program.GetUniform(k_DiffuseSampler))
+    , heightMapSampler(program.GetUniform(k_HeightMapSampler))
+    , bonesSampler(program.GetUniform(k_BonesSampler))
+    , islandExtent(program.GetUniform(k_IslandExtentUniform))
+    , boneTextureSize(program.GetUniform(k_BoneTextureSizeUniform))
+    , skyAlphaThreshold(program.GetUniform(k_SkyAlphaThresholdUniform))
+{
+}
+
 void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSubMesh& subMesh, const L3DMeshSubmitDesc& desc,
-                           bool preserveState) const
+                           const MeshUniforms& uniforms, RenderQueue& queue) const
 {
 	assert(&subMesh.GetMesh());
-	// We don't draw physics meshes, we haven't implemented statuses (building and graves) and modern GPUs can handle high lod
-	if (!desc.drawAll && (subMesh.IsPhysics() || subMesh.GetFlags().status != 0 || (subMesh.GetFlags().lodMask & 1) != 1))
+	// We don't draw physics meshes, we haven't implemented statuses (building and graves)
+	if (!desc.drawAll &&
+	    (subMesh.IsPhysics() || subMesh.GetFlags().status != 0 || (subMesh.GetFlags().lodMask & (1u << desc.lod)) == 0))
 	{
 		return;
 	}
@@ -330,79 +369,64 @@ void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSub
 	auto islandExtent = glm::vec4(extent.minimum, extent.maximum);
 	const auto& heightMap = island.GetHeightMap();
 
-	auto const& skins = mesh.GetSkins();
-	bool lastPreserveState = false;
-	const auto& primitives = subMesh.GetPrimitives();
-	for (auto it = primitives.begin(); it != primitives.end(); ++it)
+	RenderQueue::Item item;
+	item.program = desc.program;
+	item.state = desc.state;
+	item.rgba = desc.rgba;
+	item.mesh = &subMesh.GetMesh();
+	item.instanceBuffer = desc.instanceBuffer;
+	item.instanceStart = desc.instanceStart;
+	item.instanceCount = desc.instanceCount;
+	item.transforms = desc.modelMatrices;
+	item.transformCount = desc.matrixCount;
+	item.depth = desc.depth;
+	if (desc.morphWithTerrain)
 	{
-		const auto& prim = *it;
-
-		const bool hasNext = std::next(it) != primitives.end();
+		item.textures[1] = {uniforms.heightMapSampler, heightMap.GetNativeHandle(), 1}; // vs
+		item.uniforms[1] = {uniforms.islandExtent, islandExtent};                        // vs
+	}
+	if (desc.boneTexture != nullptr)
+	{
+		item.textures[2] = {uniforms.bonesSampler, *desc.boneTexture, 2};    // vs
+		item.uniforms[2] = {uniforms.boneTextureSize, desc.boneTextureSize}; // vs
+	}
+	if (!desc.isSky)
+	{
+		item.uniforms[0].handle = uniforms.skyAlphaThreshold;
+	}
 
+	auto const& skins = mesh.GetSkins();
+	for (const auto& prim : subMesh.GetPrimitives())
+	{
 		const Texture2D* texture = GetTexture(prim.skinID, skins);
-		const Texture2D* nextTexture = !hasNext ? nullptr : GetTexture(std::next(it)->skinID, skins);
-
-		const bool primitivePreserveState = texture != nullptr && texture == nextTexture && (preserveState || hasNext);
-
-		uint32_t skip = Mesh::SkipState::SkipNone;
-		if (!lastPreserveState)
-		{
-			if (desc.modelMatrices != nullptr && desc.matrixCount > 0)
-			{
-				bgfx::setTransform(desc.modelMatrices, desc.matrixCount);
-			}
-			if (texture != nullptr)
-			{
-				desc.program->SetTextureSampler("s_diffuse", 0, *texture);
-			}
-			if (desc.morphWithTerrain)
-			{
-				desc.program->SetTextureSampler("s_heightmap", 1, heightMap);   // vs
-				desc.program->SetUniformValue("u_islandExtent", &islandExtent); // vs
-			}
-			if (!desc.isSky)
-			{
-				const glm::vec4 u_skyAlphaThreshold = {
-				    Locator::skySystem::value().GetCurrentSkyType(),
-				    prim.thresholdAlpha ? prim.alphaCutoutThreshold : 0.0f,
-				    0.0f,
-				    0.0f,
-				};
-				desc.program->SetUniformValue("u_skyAlphaThreshold", &u_skyAlphaThreshold);
-			}
-		}
-		else
+		item.textures[0] = texture != nullptr
+		                       ? RenderQueue::TextureBinding {uniforms.diffuseSampler, texture->GetNativeHandle(), 0}
+		                       : RenderQueue::TextureBinding {};
+		if (subMesh.GetMesh().IsIndexed())
 		{
-			skip |= Mesh::SkipState::SkipRenderState;
-			skip |= Mesh::SkipState::SkipVertexBuffer;
+			item.indexCount = prim.indicesCount;
+			item.indexOffset = prim.indicesOffset;
 		}
-
+		if (!desc.isSky)
 		{
-			if (desc.instanceBuffer != nullptr && (skip & Mesh::SkipState::SkipInstanceBuffer) == 0)
-			{
-				bgfx::setInstanceDataBuffer(*desc.instanceBuffer, desc.instanceStart, desc.instanceCount);
-			}
-			if (subMesh.GetMesh().IsIndexed() && (skip & Mesh::SkipState::SkipIndexBuffer) == 0)
-			{
-				subMesh.GetMesh().GetIndexBuffer().Bind(prim.indicesCount, prim.indicesOffset);
-			}
-			if ((skip & Mesh::SkipState::SkipVertexBuffer) == 0)
-			{
-				subMesh.GetMesh().GetVertexBuffer().Bind();
-			}
-			if ((skip & Mesh::SkipState::SkipRenderState) == 0)
-			{
-				bgfx::setState(desc.state, desc.rgba);
-			}
-
-			bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), desc.program->GetRawHandle(), 0,
-			             primitivePreserveState ? BGFX_DISCARD_NONE : BGFX_DISCARD_ALL);
+			item.uniforms[0].value = {
+			    Locator::skySystem::value().GetCurrentSkyType(),
+			    prim.thresholdAlpha ? prim.alphaCutoutThreshold : 0.0f,
+			    0.0f,
+			    0.0f,
+			};
 		}
-		lastPreserveState = primitivePreserveState;
+		queue.Add(item);
 	}
 }
 
 void Renderer::DrawMesh(const graphics::L3DMesh& mesh, const L3DMeshSubmitDesc& desc, uint8_t subMeshIndex) const noexcept
+{
+	DrawMesh(mesh, desc, MeshUniforms(*desc.program), subMeshIndex);
+}
+
+void Renderer::DrawMesh(const graphics::L3DMesh& mesh, const L3DMeshSubmitDesc& desc, const MeshUniforms& uniforms,
+                        uint8_t subMeshIndex) const
 {
 	if (mesh.GetNumSubMeshes() == 0)
 	{
@@ -410,6 +434,10 @@ void Renderer::DrawMesh(const graphics::L3DMesh& mesh, const L3DMeshSubmitDesc&
 		return;
 	}
 
+	// Without a queue to add to, the mesh's draws are still sorted among themselves
+	RenderQueue localQueue;
+	auto& queue = desc.queue != nullptr ? *desc.queue : localQueue;
+
 	const auto& subMeshes = mesh.GetSubMeshes();
 
 	if (subMeshIndex != std::numeric_limits<uint8_t>::max())
@@ -420,14 +448,19 @@ void Renderer::DrawMesh(const graphics::L3DMesh& mesh, const L3DMeshSubmitDesc&
 			                   mesh.GetNumSubMeshes());
 		}
 
-		DrawSubMesh(mesh, *subMeshes[subMeshIndex], desc, false);
-		return;
+		DrawSubMesh(mesh, *subMeshes[subMeshIndex], desc, uniforms, queue);
+	}
+	else
+	{
+		for (const auto& subMesh : subMeshes)
+		{
+			DrawSubMesh(mesh, *subMesh, desc, uniforms, queue);
+		}
 	}
 
-	for (auto it = subMeshes.begin(); it != subMeshes.end(); ++it)
+	if (desc.queue == nullptr)
 	{
-		const L3DSubMesh& subMesh = **it;
-		DrawSubMesh(mesh, subMesh, desc, std::next(it) != subMeshes.end());
+		localQueue.Submit(desc.viewId);
 	}
 }
 
@@ -453,15 +486,20 @@ void Renderer::DrawFootprintPass(const DrawSceneDesc& drawDesc) const
 		const auto& meshManager = Locator::resources::value().GetMeshes();
 		const auto& renderCtx = Locator::rendereringSystem::value().GetContext();
 		const auto* footprintShaderInstanced = _shaderManager->GetShader("FootprintInstanced");
+		const auto footprintSampler = footprintShaderInstanced->GetUniform(k_FootprintSampler);
 		for (const auto& [meshId, placers] : renderCtx.instancedDrawDescs)
 		{
+			if (placers.count == 0)
+			{
+				continue;
+			}
 			auto mesh = meshManager.Handle(meshId);
 			if (!mesh->ContainsLandscapeFeature() || mesh->GetFootprints().empty())
 			{
 				continue;
 			}
 			const auto& footprint = mesh->GetFootprints()[0];
-			footprintShaderInstanced->SetTextureSampler("s_footprint", 0, *footprint.texture);
+			ShaderProgram::SetTextureSampler(footprintSampler, 0, footprint.texture->GetNativeHandle());
 			footprint.mesh->GetVertexBuffer().Bind();
 			bgfx::setInstanceDataBuffer(renderCtx.instanceUniformBuffer, placers.offset, placers.count);
 			const uint64_t state = 0u                       //
@@ -534,6 +572,7 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 	const auto* objectShaderHeightMapInstanced = _shaderManager->GetShader("ObjectHeightMapInstanced");
 
 	const auto skyType = Locator::skySystem::value().GetCurrentSkyType();
+	const auto frustum = desc.camera->GetFrustum();
 
 	{
 		auto section = profiler.BeginScoped(desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawSky
@@ -595,14 +634,6 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 			auto texture = Locator::resources::value().GetTextures().Handle(LandIslandInterface::k_SmallBumpTextureId);
 			const glm::vec4 u_skyAndBump = {skyType, desc.bumpMapStrength, desc.smallBumpMapStrength, 0.0f};
 
-			terrainShader->SetTextureSampler("s0_materials", 0, island.GetAlbedoArray());
-			terrainShader->SetTextureSampler("s1_bump", 1, island.GetBump());
-			terrainShader->SetTextureSampler("s2_smallBump", 2, *texture);
-			terrainShader->SetTextureSampler("s3_footprints", 3, island.GetFootprintFramebuffer().GetColorAttachment());
-
-			terrainShader->SetUniformValue("u_skyAndBump", &u_skyAndBump);
-			terrainShader->SetUniformValue("u_islandExtent", &islandExtent);
-
 			// clang-format off
 			constexpr auto defaultState = 0u
 				| BGFX_STATE_WRITE_MASK
@@ -610,28 +641,37 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 				| BGFX_STATE_BLEND_ALPHA
 				| BGFX_STATE_MSAA
 			;
-
-			constexpr auto discard = 0u
-				| BGFX_DISCARD_INSTANCE_DATA
-				| BGFX_DISCARD_INDEX_BUFFER
-				| BGFX_DISCARD_TRANSFORM
-				| BGFX_DISCARD_VERTEX_STREAMS
-				| BGFX_DISCARD_STATE
-			;
 			// clang-format on
 
+			RenderQueue::Item item;
+			item.layer = RenderQueue::Layer::Terrain;
+			item.program = terrainShader;
+			item.state = defaultState | (desc.cullBack ? BGFX_STATE_CULL_CCW : BGFX_STATE_CULL_CW);
+			item.textures = {{
+			    {terrainShader->GetUniform(k_MaterialsSampler), island.GetAlbedoArray().GetNativeHandle(), 0},
+			    {terrainShader->GetUniform(k_BumpSampler), island.GetBump().GetNativeHandle(), 1},
+			    {terrainShader->GetUniform(k_SmallBumpSampler), texture->GetNativeHandle(), 2},
+			    {terrainShader->GetUniform(k_FootprintsSampler),
+			     island.GetFootprintFramebuffer().GetColorAttachment().GetNativeHandle(), 3},
+			}};
+			item.uniforms = {{
+			    {terrainShader->GetUniform(k_BlockPositionAndSizeUniform), {}},
+			    {terrainShader->GetUniform(k_SkyAndBumpUniform), u_skyAndBump},
+			    {terrainShader->GetUniform(k_IslandExtentUniform), islandExtent},
+			}};
+			const auto cameraOrigin = desc.camera->GetOrigin();
 			for (const auto& block : island.GetBlocks())
 			{
-				// pack uniforms
-				const glm::vec4 mapPositionAndSize = glm::vec4(block.GetMapPosition(), 160.0f, 160.0f);
-				terrainShader->SetUniformValue("u_blockPositionAndSize", &mapPositionAndSize);
-
-				block.GetMesh().GetVertexBuffer().Bind();
+				if (desc.frustumCulling && !frustum.Intersects(block.GetBoundingBox()))
+				{
+					continue;
+				}
 
-				bgfx::setState(defaultState | (desc.cullBack ? BGFX_STATE_CULL_CCW : BGFX_STATE_CULL_CW), 0);
-				bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), terrainShader->GetRawHandle(), 0, discard);
+				item.mesh = &block.GetMesh();
+				item.uniforms[0].value = glm::vec4(block.GetMapPosition(), 160.0f, 160.0f);
+				item.depth = glm::distance(cameraOrigin, block.GetBoundingBox().Center());
+				_renderQueue->Add(item);
 			}
-			bgfx::discard(BGFX_DISCARD_BINDINGS);
 		}
 	}
 
@@ -648,21 +688,40 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 			                   | BGFX_STATE_DEPTH_TEST_GREATER //
 			                   | BGFX_STATE_MSAA               //
 			    ;
-			const auto& renderCtx = Locator::rendereringSystem::value().GetContext();
+			submitDesc.queue = _renderQueue.get();
+			auto& renderingSystem = Locator::rendereringSystem::value();
+			const auto& renderCtx = renderingSystem.GetContext();
+
+			// Only submit instances seen by this view, bucketed by level of detail
+			renderingSystem.PrepareDrawView(desc.viewId, *desc.camera, desc.frustumCulling);
+			const auto& instancedView = renderCtx.instancedViews.at(static_cast<size_t>(desc.viewId));
+
+			if (bgfx::isValid(renderCtx.boneTexture))
+			{
+				const auto width = static_cast<float>(ecs::systems::RenderContext::k_BoneTextureWidth);
+				const auto height = static_cast<float>(renderCtx.boneTextureHeight);
+				submitDesc.boneTexture = &renderCtx.boneTexture;
+				submitDesc.boneTextureSize = glm::vec4(width, height, 1.0f / width, 1.0f / height);
+			}
 
 			// Instance meshes
-			for (const auto& [meshId, placers] : renderCtx.instancedDrawDescs)
+			const MeshUniforms objectUniforms(*objectShaderInstanced);
+			const MeshUniforms heightMapUniforms(*objectShaderHeightMapInstanced);
+			for (const auto& [meshLod, placers] : instancedView.instancedDrawDescs)
 			{
+				const auto& [meshId, lod] = meshLod;
 				auto mesh = meshManager.Handle(meshId);
 
-				submitDesc.instanceBuffer = &renderCtx.instanceUniformBuffer;
+				submitDesc.instanceBuffer = &instancedView.instanceUniformBuffer;
 				submitDesc.instanceStart = placers.offset;
 				submitDesc.instanceCount = placers.count;
+				submitDesc.lod = lod;
+				submitDesc.depth = placers.distance;
 				if (mesh->IsBoned())
 				{
+					// Bind pose of the instances without an animation, the others read theirs from the bone texture
 					submitDesc.modelMatrices = mesh->GetBoneMatrices().data();
 					submitDesc.matrixCount = static_cast<uint8_t>(mesh->GetBoneMatrices().size());
-					// TODO(bwrsandman): Get animation frame instead of default
 				}
 				else
 				{
@@ -674,8 +733,8 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 				submitDesc.morphWithTerrain = placers.morphWithTerrain;
 				submitDesc.program = submitDesc.morphWithTerrain ? objectShaderHeightMapInstanced : objectShaderInstanced;
 
-				// TODO(bwrsandman): choose the correct LOD
-				DrawMesh(*mesh, submitDesc, std::numeric_limits<uint8_t>::max());
+				DrawMesh(*mesh, submitDesc, submitDesc.morphWithTerrain ? heightMapUniforms : objectUniforms,
+				         std::numeric_limits<uint8_t>::max());
 			}
 
 			// Debug
@@ -718,36 +777,77 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 			    profiler.BeginScoped(desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawSprites
 			                                                               : Profiler::Stage::MainPassDrawSprites);
 
-			if (desc.drawSprites)
+			const auto& renderCtx = Locator::rendereringSystem::value().GetContext();
+			if (desc.drawSprites && bgfx::isValid(renderCtx.spriteInstanceBuffer))
 			{
-				using namespace ecs::components;
-
-				auto& registry = Locator::entitiesRegistry::value();
-				registry.Each<const Sprite, const Transform>(
-				    [this, &spriteShader, &desc](const Sprite& sprite, const Transform& transform) {
-					    glm::mat4 modelMatrix = glm::mat4(1.0f);
-					    modelMatrix = glm::translate(modelMatrix, transform.position);
-					    modelMatrix *= glm::mat4(transform.rotation);
-					    modelMatrix = glm::scale(modelMatrix, transform.scale);
-
-					    glm::vec4 u_sampleRect(sprite.uvExtent, sprite.uvMin);
-
-					    bgfx::setTransform(glm::value_ptr(modelMatrix));
-					    spriteShader->SetUniformValue("u_sampleRect", glm::value_ptr(u_sampleRect));
-					    spriteShader->SetUniformValue("u_tint", glm::value_ptr(sprite.tint));
-					    spriteShader->SetTextureSampler("s_diffuse", 0, sprite.texture);
-
-					    _plane->GetVertexBuffer().Bind();
-
-					    bgfx::setState(0 | BGFX_STATE_DEPTH_TEST_GREATER | BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A |
-					                   BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_ONE) |
-					                   BGFX_STATE_BLEND_EQUATION(BGFX_STATE_BLEND_EQUATION_ADD));
+				constexpr auto state = 0 | BGFX_STATE_DEPTH_TEST_GREATER | BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A |
+				                       BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_ONE) |
+				                       BGFX_STATE_BLEND_EQUATION(BGFX_STATE_BLEND_EQUATION_ADD);
+
+				// One instanced draw per texture, or per run of visible sprites when culling
+				RenderQueue::Item item;
+				item.layer = RenderQueue::Layer::Blended;
+				item.program = spriteShader;
+				item.state = state;
+				item.mesh = _plane.get();
+				item.instanceBuffer = &renderCtx.spriteInstanceBuffer;
+				const auto diffuseSampler = spriteShader->GetUniform(k_DiffuseSampler);
+				const auto cameraOrigin = desc.camera->GetOrigin();
+				for (const auto& [textureIndex, placers] : renderCtx.spriteDrawDescs)
+				{
+					item.textures[0] = {diffuseSampler, bgfx::TextureHandle {textureIndex}, 0};
+					// Blended back to front by the farthest sprite of the run
+					auto add = [this, &renderCtx, &item, cameraOrigin](uint32_t offset, uint32_t count) {
+						item.instanceStart = offset;
+						item.instanceCount = count;
+						item.depth = 0.0f;
+						for (uint32_t i = offset; i < offset + count; ++i)
+						{
+							const auto& bounds = renderCtx.spriteBounds[i];
+							item.depth = std::max(item.depth, glm::distance(cameraOrigin, glm::vec3(bounds)));
+						}
+						_renderQueue->Add(item);
+					};
+
+					if (!desc.frustumCulling)
+					{
+						add(placers.offset, placers.count);
+						continue;
+					}
 
-					    bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), spriteShader->GetRawHandle());
-				    });
+					// Culled sprites between two visible ones are drawn anyway when the gap is small enough, a few
+					// invisible quads are cheaper than another submit
+					std::optional<uint32_t> runStart;
+					uint32_t runEnd = 0;
+					for (uint32_t i = placers.offset; i < placers.offset + placers.count; ++i)
+					{
+						const auto& bounds = renderCtx.spriteBounds[i];
+						if (!frustum.Intersects(glm::vec3(bounds), bounds.w))
+						{
+							continue;
+						}
+						if (runStart.has_value() && i - runEnd > k_MaxCulledSpritesInRun)
+						{
+							add(*runStart, runEnd - *runStart);
+							runStart.reset();
+						}
+						if (!runStart.has_value())
+						{
+							runStart = i;
+						}
+						runEnd = i + 1;
+					}
+					if (runStart.has_value())
+					{
+						add(*runStart, runEnd - *runStart);
+					}
+				}
 			}
 		}
 
+		// Terrain, entities and sprites in one sorted batch
+		_renderQueue->Submit(desc.viewId);
+
 		if (desc.drawTestModel)
 		{
 			L3DMeshSubmitDesc submitDesc = {};
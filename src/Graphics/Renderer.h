@@ -44,6 +44,7 @@ namespace graphics
 {
 class L3DSubMesh;
 class Mesh;
+class RenderQueue;
 
 class Renderer final: public RendererInterface
 {
@@ -69,8 +70,23 @@ class Renderer final: public RendererInterface
 	void Reset(glm::u16vec2 resolution) const noexcept final;
 
 private:
+	/// Uniforms bound for every submesh, resolved once per program rather than per draw
+	struct MeshUniforms
+	{
+		explicit MeshUniforms(const ShaderProgram& program);
+
+		bgfx::UniformHandle diffuseSampler;
+		bgfx::UniformHandle heightMapSampler;
+		bgfx::UniformHandle bonesSampler;
+		bgfx::UniformHandle islandExtent;
+		bgfx::UniformHandle boneTextureSize;
+		bgfx::UniformHandle skyAlphaThreshold;
+	};
+
 	void DrawFootprintPass(const DrawSceneDesc& drawDesc) const;
-	void DrawSubMesh(const L3DMesh& mesh, const L3DSubMesh& subMesh, const L3DMeshSubmitDesc& desc, bool preserveState) const;
+	void DrawMesh(const L3DMesh& mesh, const L3DMeshSubmitDesc& desc, const MeshUniforms& uniforms, uint8_t subMeshIndex) const;
+	void DrawSubMesh(const L3DMesh& mesh, const L3DSubMesh& subMesh, const L3DMeshSubmitDesc& desc,
+	                 const MeshUniforms& uniforms, RenderQueue& queue) const;
 	void DrawPass(const DrawSceneDesc& desc) const;
 
 	std::unique_ptr<ShaderManager> _shaderManager;
@@ -82,6 +98,8 @@ class Renderer final: public RendererInterface
 	std::unique_ptr<Mesh> _debugCross;
 	std::unique_ptr<Mesh> _plane;
 	glm::mat4 _debugCrossPose;
+	/// Draws of the pass being drawn, submitted once the terrain, entities and sprites have been added
+	std::unique_ptr<RenderQueue> _renderQueue;
 };
 } // namespace graphics
 } // namespace openblack
@@ -12,6 +12,7 @@
 #include <filesystem>
 
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 
 #include "RenderPass.h"
 
@@ -32,6 +33,7 @@ namespace openblack::graphics
 {
 class L3DMesh;
 class FrameBuffer;
+class RenderQueue;
 class ShaderManager;
 class ShaderProgram;
 
@@ -56,6 +58,7 @@ class RendererInterface
 		bool drawTestModel;
 		bool drawDebugCross;
 		bool drawBoundingBoxes;
+		bool frustumCulling;
 		bool cullBack;
 		bool wireframe;
 	};
@@ -71,9 +74,14 @@ class RendererInterface
 		const bgfx::DynamicVertexBufferHandle* instanceBuffer;
 		uint32_t instanceStart;
 		uint32_t instanceCount;
+		const bgfx::TextureHandle* boneTexture; ///< Bone palettes of animated instances, indexed by their instance data
+		glm::vec4 boneTextureSize;              ///< Width, height and their inverse
+		uint8_t lod; ///< Level of detail, only submeshes with this bit in their lodMask are drawn
 		bool isSky;
 		bool drawAll; ///< For use in the mesh viewer
 		bool morphWithTerrain;
+		RenderQueue* queue; ///< Draws are added to this queue when set, otherwise they are submitted right away
+		float depth;        ///< Distance to the camera, used to sort the queue
 	};
 
 	static std::unique_ptr<RendererInterface> Create(bgfx::RendererType::Enum rendererType, bool vsync) noexcept;
@@ -9,6 +9,11 @@
 
 #include "ShaderProgram.h"
 
+#include <algorithm>
+#include <cassert>
+#include <string_view>
+
+#include <entt/core/hashed_string.hpp>
 #include <spdlog/spdlog.h>
 
 #include "FileSystem/FileSystemInterface.h"
@@ -31,7 +36,7 @@ ShaderProgram::ShaderProgram(const std::string& name, bgfx::ShaderHandle vertexS
 	for (uint16_t i = 0; i < numShaderUniforms; ++i)
 	{
 		bgfx::getUniformInfo(uniforms[i], info);
-		_uniforms.emplace(std::string(info.name), uniforms[i]);
+		_uniforms.emplace_back(entt::hashed_string::value(info.name), uniforms[i]);
 	}
 
 	numShaderUniforms = bgfx::getShaderUniforms(fragmentShader);
@@ -40,8 +45,24 @@ ShaderProgram::ShaderProgram(const std::string& name, bgfx::ShaderHandle vertexS
 	for (uint16_t i = 0; i < numShaderUniforms; ++i)
 	{
 		bgfx::getUniformInfo(uniforms[i], info);
-		_uniforms.emplace(std::string(info.name), uniforms[i]);
+		_uniforms.emplace_back(entt::hashed_string::value(info.name), uniforms[i]);
+	}
+
+	// Uniforms used by both stages are listed twice
+	std::ranges::sort(_uniforms, {}, &decltype(_uniforms)::value_type::first);
+	for (size_t i = 1; i < _uniforms.size(); ++i)
+	{
+		if (_uniforms[i - 1].first == _uniforms[i].first)
+		{
+			// Lookups only compare hashes, two names with the same hash would shadow each other
+			bgfx::UniformInfo previous = {};
+			bgfx::getUniformInfo(_uniforms[i - 1].second, previous);
+			bgfx::getUniformInfo(_uniforms[i].second, info);
+			assert(std::string_view(previous.name) == std::string_view(info.name) && "Uniform name hash collision");
+		}
 	}
+	const auto duplicates = std::ranges::unique(_uniforms, {}, &decltype(_uniforms)::value_type::first);
+	_uniforms.erase(duplicates.begin(), duplicates.end());
 
 	_program = bgfx::createProgram(vertexShader, fragmentShader, true);
 	bgfx::setName(vertexShader, (name + "_vs").c_str());
@@ -57,25 +78,27 @@ ShaderProgram::~ShaderProgram()
 	}
 }
 
-void ShaderProgram::SetTextureSampler(const char* samplerName, uint8_t bindPoint, const Texture2D& texture) const
+bgfx::UniformHandle ShaderProgram::GetUniform(entt::id_type id) const
 {
-	auto uniform = _uniforms.find(samplerName);
-	if (uniform != _uniforms.cend())
-	{
-		bgfx::setTexture(bindPoint, uniform->second, texture.GetNativeHandle());
-	}
-	else
+	const auto uniform = std::ranges::lower_bound(_uniforms, id, {}, &decltype(_uniforms)::value_type::first);
+	if (uniform != _uniforms.cend() && uniform->first == id)
 	{
-		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Could not find texture sampler {}", samplerName);
+		return uniform->second;
 	}
+	return BGFX_INVALID_HANDLE;
+}
+
+void ShaderProgram::SetTextureSampler(const char* samplerName, uint8_t bindPoint, const Texture2D& texture) const
+{
+	SetTextureSampler(samplerName, bindPoint, texture.GetNativeHandle());
 }
 
 void ShaderProgram::SetTextureSampler(const char* samplerName, uint8_t bindPoint, const bgfx::TextureHandle& texture) const
 {
-	auto uniform = _uniforms.find(samplerName);
-	if (uniform != _uniforms.cend())
+	const auto uniform = GetUniform(entt::hashed_string::value(samplerName));
+	if (bgfx::isValid(uniform))
 	{
-		bgfx::setTexture(bindPoint, uniform->second, texture);
+		bgfx::setTexture(bindPoint, uniform, texture);
 	}
 	else
 	{
@@ -85,10 +108,10 @@ void ShaderProgram::SetTextureSampler(const char* samplerName, uint8_t bindPoint
 
 void ShaderProgram::SetUniformValue(const char* uniformName, const void* value) const
 {
-	auto uniform = _uniforms.find(uniformName);
-	if (uniform != _uniforms.cend())
+	const auto uniform = GetUniform(entt::hashed_string::value(uniformName));
+	if (bgfx::isValid(uniform))
 	{
-		bgfx::setUniform(uniform->second, value);
+		bgfx::setUniform(uniform, value);
 	}
 	else
 	{
@@ -96,4 +119,20 @@ void ShaderProgram::SetUniformValue(const char* uniformName, const void* value)
 	}
 }
 
+void ShaderProgram::SetTextureSampler(bgfx::UniformHandle sampler, uint8_t bindPoint, const bgfx::TextureHandle& texture)
+{
+	if (bgfx::isValid(sampler))
+	{
+		bgfx::setTexture(bindPoint, sampler, texture);
+	}
+}
+
+void ShaderProgram::SetUniformValue(bgfx::UniformHandle uniform, const void* value)
+{
+	if (bgfx::isValid(uniform))
+	{
+		bgfx::setUniform(uniform, value);
+	}
+}
+
 } // namespace openblack::graphics
@@ -11,10 +11,12 @@
 
 #include <cstdint>
 
-#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <bgfx/bgfx.h>
+#include <entt/core/fwd.hpp>
 
 namespace openblack::graphics
 {
@@ -34,16 +36,25 @@ class ShaderProgram
 	ShaderProgram(const std::string& name, bgfx::ShaderHandle vertexShader, bgfx::ShaderHandle fragmentShader);
 	~ShaderProgram();
 
+	/// Handle of the uniform or sampler whose name hashes to \p id, e.g. entt::hashed_string("s_diffuse"), invalid if the
+	/// program doesn't use it. Resolve handles once outside of draw loops and bind them with the overloads taking a handle.
+	[[nodiscard]] bgfx::UniformHandle GetUniform(entt::id_type id) const;
+
 	void SetTextureSampler(const char* samplerName, uint8_t bindPoint, const Texture2D& texture) const;
 	void SetTextureSampler(const char* samplerName, uint8_t bindPoint, const bgfx::TextureHandle& texture) const;
 	void SetUniformValue(const char* uniformName, const void* value) const;
+	/// Does nothing if \p sampler is invalid, i.e. the program doesn't sample it
+	static void SetTextureSampler(bgfx::UniformHandle sampler, uint8_t bindPoint, const bgfx::TextureHandle& texture);
+	/// Does nothing if \p uniform is invalid, i.e. the program doesn't use it
+	static void SetUniformValue(bgfx::UniformHandle uniform, const void* value);
 
 	[[nodiscard]] bgfx::ProgramHandle GetRawHandle() const { return _program; }
 
 private:
 	std::string _name;
 	bgfx::ProgramHandle _program;
-	std::map<std::string, bgfx::UniformHandle> _uniforms;
+	/// Sorted by the hash of the uniform's name
+	std::vector<std::pair<entt::id_type, bgfx::UniformHandle>> _uniforms;
 };
 
 } // namespace openblack::graphics
@@ -125,17 +125,15 @@ void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Format
 	}
 	_handle = bgfx::createTexture2D(width, height, false, layers, getBgfxTextureFormat(format), flags, memory);
 	bgfx::setName(_handle, _name.c_str());
-	bgfx::frame();
 
 	bgfx::calcTextureSize(_info, width, height, 1, false, false, layers, getBgfxTextureFormat(format));
-	bgfx::frame();
 }
 
 void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Format format, Wrapping wrapping, Filter filter,
                        const void* data, uint32_t size) noexcept
 {
-
-	Texture2D::Create(width, height, layers, format, wrapping, filter, bgfx::makeRef(data, size));
+	// Copied so that textures can be created at any point of a frame without keeping the data alive until it is rendered
+	Texture2D::Create(width, height, layers, format, wrapping, filter, data != nullptr ? bgfx::copy(data, size) : nullptr);
 }
 
 void Texture2D::DumpTexture() const
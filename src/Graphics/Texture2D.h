@@ -119,6 +119,7 @@ class Texture2D
 	[[nodiscard]] uint16_t GetHeight() const { return _info.height; }
 	[[nodiscard]] uint16_t GetLayerCount() const { return _info.numLayers; }
 	[[nodiscard]] bgfx::TextureFormat::Enum GetFormat() const { return _info.format; }
+	[[nodiscard]] uint32_t GetSizeInBytes() const { return _info.storageSize; }
 
 	void DumpTexture() const;
 
@@ -0,0 +1,240 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace openblack;
+
+namespace
+{
+thread_local uint32_t currentThreadIndex = 0;
+} // namespace
+
+JobSystem::JobSystem(uint32_t workerCount)
+{
+	_queues.reserve(workerCount + 1);
+	for (uint32_t i = 0; i < workerCount + 1; ++i)
+	{
+		_queues.emplace_back(std::make_unique<Queue>());
+	}
+	_workers.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		_workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		const std::lock_guard<std::mutex> lock(_sleepMutex);
+		_stopping = true;
+	}
+	_jobAvailable.notify_all();
+	for (auto& worker : _workers)
+	{
+		worker.join();
+	}
+}
+
+uint32_t JobSystem::GetCurrentThreadIndex() noexcept
+{
+	return currentThreadIndex;
+}
+
+uint32_t JobSystem::GetDefaultWorkerCount() noexcept
+{
+#if defined(__EMSCRIPTEN__)
+	return 0;
+#else
+	const auto hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+#endif
+}
+
+void JobSystem::Schedule(Job job, Counter& counter)
+{
+	const auto threadIndex = std::min<uint32_t>(currentThreadIndex, static_cast<uint32_t>(_queues.size() - 1));
+	counter._pending.fetch_add(1, std::memory_order_relaxed);
+	{
+		auto& queue = *_queues[threadIndex];
+		const std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back({std::move(job), &counter});
+	}
+	_queuedJobs.fetch_add(1, std::memory_order_release);
+
+	// Taking the lock makes sure a worker about to sleep sees the new job
+	{
+		const std::lock_guard<std::mutex> lock(_sleepMutex);
+	}
+	_jobAvailable.notify_one();
+}
+
+void JobSystem::Wait(Counter& counter)
+{
+	const auto threadIndex = std::min<uint32_t>(currentThreadIndex, static_cast<uint32_t>(_queues.size() - 1));
+	while (!counter.Done())
+	{
+		if (RunOne(threadIndex))
+		{
+			continue;
+		}
+
+		// Nothing left to help with, sleep until a job is queued or one of the counter's jobs finishes elsewhere
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+		_jobAvailable.wait(lock, [this, &counter] {
+			return counter.Done() || _queuedJobs.load(std::memory_order_acquire) > 0;
+		});
+	}
+
+	std::exception_ptr exception;
+	{
+		const std::lock_guard<std::mutex> lock(counter._exceptionMutex);
+		exception = std::exchange(counter._exception, nullptr);
+	}
+	if (exception)
+	{
+		std::rethrow_exception(exception);
+	}
+}
+
+size_t JobSystem::GetChunkSize(size_t count, size_t minChunkSize) const noexcept
+{
+	const size_t targetChunks = GetConcurrency() * k_ChunksPerThread;
+	return std::max({(count + targetChunks - 1) / targetChunks, minChunkSize, size_t {1}});
+}
+
+size_t JobSystem::GetChunkCount(size_t count, size_t minChunkSize) const noexcept
+{
+	const auto chunkSize = GetChunkSize(count, minChunkSize);
+	return (count + chunkSize - 1) / chunkSize;
+}
+
+void JobSystem::ParallelFor(size_t count, size_t minChunkSize, const ChunkFunc& func)
+{
+	const auto chunkSize = GetChunkSize(count, minChunkSize);
+	const auto chunkCount = (count + chunkSize - 1) / chunkSize;
+	const auto runChunk = [&func, count, chunkSize](size_t chunk) {
+		func(chunk, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+	};
+
+	if (_workers.empty() || chunkCount <= 1)
+	{
+		for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			runChunk(chunk);
+		}
+		return;
+	}
+
+	std::vector<std::exception_ptr> exceptions(chunkCount);
+	const auto runChunkCaught = [&runChunk, &exceptions](size_t chunk) {
+		try
+		{
+			runChunk(chunk);
+		}
+		catch (...)
+		{
+			exceptions[chunk] = std::current_exception();
+		}
+	};
+
+	Counter counter;
+	for (size_t chunk = 1; chunk < chunkCount; ++chunk)
+	{
+		Schedule([&runChunkCaught, chunk]() { runChunkCaught(chunk); }, counter);
+	}
+	runChunkCaught(0);
+	Wait(counter);
+
+	for (const auto& exception : exceptions)
+	{
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+}
+
+bool JobSystem::RunOne(uint32_t threadIndex)
+{
+	QueuedJob job;
+	bool found = false;
+	{
+		auto& queue = *_queues[threadIndex];
+		const std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			found = true;
+		}
+	}
+	for (size_t offset = 1; !found && offset < _queues.size(); ++offset)
+	{
+		auto& victim = *_queues[(threadIndex + offset) % _queues.size()];
+		const std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty())
+		{
+			job = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			found = true;
+		}
+	}
+	if (!found)
+	{
+		return false;
+	}
+	_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+	try
+	{
+		job.job();
+	}
+	catch (...)
+	{
+		const std::lock_guard<std::mutex> lock(job.counter->_exceptionMutex);
+		if (!job.counter->_exception)
+		{
+			job.counter->_exception = std::current_exception();
+		}
+	}
+	// The counter may be gone as soon as the last job is released
+	if (job.counter->_pending.fetch_sub(1, std::memory_order_release) == 1)
+	{
+		// Taking the lock makes sure a thread about to sleep in Wait sees the counter done
+		{
+			const std::lock_guard<std::mutex> lock(_sleepMutex);
+		}
+		_jobAvailable.notify_all();
+	}
+	return true;
+}
+
+void JobSystem::WorkerLoop(uint32_t threadIndex)
+{
+	currentThreadIndex = threadIndex;
+	while (true)
+	{
+		if (RunOne(threadIndex))
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+		_jobAvailable.wait(lock, [this] { return _stopping || _queuedJobs.load(std::memory_order_acquire) > 0; });
+		if (_stopping)
+		{
+			return;
+		}
+	}
+}
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace openblack
+{
+
+/// Work-stealing job system. Each thread pushes and pops jobs at the back of its own queue while idle workers steal
+/// from the front of the others. Threads outside of the pool share the first queue.
+/// Without workers (single core machines, emscripten) jobs only run when a thread waits on them.
+class JobSystem
+{
+public:
+	using Job = std::function<void()>;
+	/// Called with the index of a chunk and the range of items it covers. Chunks are contiguous and ordered like the items.
+	using ChunkFunc = std::function<void(size_t chunk, size_t begin, size_t end)>;
+
+	/// Number of scheduled jobs which have not run yet, see \ref Wait
+	class Counter
+	{
+	public:
+		[[nodiscard]] bool Done() const noexcept { return _pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<uint32_t> _pending {0};
+		std::mutex _exceptionMutex;
+		std::exception_ptr _exception;
+	};
+
+	explicit JobSystem(uint32_t workerCount = GetDefaultWorkerCount());
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+	JobSystem(JobSystem&&) = delete;
+	JobSystem& operator=(JobSystem&&) = delete;
+	~JobSystem();
+
+	/// Number of threads running jobs, including the calling thread
+	[[nodiscard]] uint32_t GetConcurrency() const noexcept { return static_cast<uint32_t>(_workers.size()) + 1; }
+
+	/// Queue a job on the calling thread's queue, counter is released once it has run
+	void Schedule(Job job, Counter& counter);
+	/// Run jobs on the calling thread until every job of the counter has run, sleeping while there is nothing to run.
+	/// Rethrows the first exception thrown by one of those jobs.
+	void Wait(Counter& counter);
+
+	/// Number of chunks \ref ParallelFor splits count items into
+	[[nodiscard]] size_t GetChunkCount(size_t count, size_t minChunkSize) const noexcept;
+	/// Run func over [0, count) split in \ref GetChunkCount chunks and block until all are done.
+	/// If any chunk throws, the exception of the lowest chunk is rethrown once all chunks have finished.
+	void ParallelFor(size_t count, size_t minChunkSize, const ChunkFunc& func);
+
+	/// 0 for threads outside of the pool, 1 to \ref GetConcurrency - 1 for workers
+	[[nodiscard]] static uint32_t GetCurrentThreadIndex() noexcept;
+	/// One worker per hardware thread, minus the main thread
+	[[nodiscard]] static uint32_t GetDefaultWorkerCount() noexcept;
+
+private:
+	static constexpr size_t k_ChunksPerThread = 4;
+
+	struct QueuedJob
+	{
+		Job job;
+		Counter* counter {nullptr};
+	};
+
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<QueuedJob> jobs;
+	};
+
+	[[nodiscard]] size_t GetChunkSize(size_t count, size_t minChunkSize) const noexcept;
+	bool RunOne(uint32_t threadIndex);
+	void WorkerLoop(uint32_t threadIndex);
+
+	std::vector<std::unique_ptr<Queue>> _queues;
+	std::vector<std::thread> _workers;
+	std::atomic<uint32_t> _queuedJobs {0};
+	std::mutex _sleepMutex;
+	std::condition_variable _jobAvailable;
+	bool _stopping {false};
+};
+
+} // namespace openblack
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "TaskGraph.h"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include "JobSystem.h"
+
+using namespace openblack;
+
+void TaskGraph::AddTask(TaskDesc&& desc)
+{
+	ResourceSet reads;
+	for (const auto resource : desc.reads)
+	{
+		reads.set(static_cast<size_t>(resource));
+	}
+	ResourceSet writes;
+	for (const auto resource : desc.writes)
+	{
+		writes.set(static_cast<size_t>(resource));
+	}
+	_tasks.push_back({reads, writes, desc.affinity, std::move(desc.func)});
+}
+
+void TaskGraph::Execute(JobSystem& jobSystem)
+{
+	// Without workers there is nothing to overlap with
+	if (jobSystem.GetConcurrency() == 1)
+	{
+		std::exception_ptr exception;
+		for (auto& task : _tasks)
+		{
+			try
+			{
+				task.func();
+			}
+			catch (...)
+			{
+				if (!exception)
+				{
+					exception = std::current_exception();
+				}
+			}
+		}
+		_tasks.clear();
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+		return;
+	}
+
+	const auto taskCount = _tasks.size();
+	std::vector<uint32_t> remainingDependencies(taskCount, 0);
+	std::vector<std::vector<uint32_t>> dependents(taskCount);
+	for (uint32_t i = 0; i < taskCount; ++i)
+	{
+		for (uint32_t j = 0; j < i; ++j)
+		{
+			const auto& before = _tasks[j];
+			const auto& after = _tasks[i];
+			if ((before.writes & (after.reads | after.writes)).any() || (before.reads & after.writes).any())
+			{
+				dependents[j].push_back(i);
+				++remainingDependencies[i];
+			}
+		}
+	}
+
+	std::mutex mutex;
+	std::condition_variable changed;
+	// Lowest index first so main thread tasks keep their relative order
+	std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<>> mainThreadReady;
+	size_t completed = 0;
+	std::exception_ptr exception;
+	JobSystem::Counter counter;
+
+	std::function<void(uint32_t)> run;
+	const auto makeReady = [this, &jobSystem, &counter, &mainThreadReady, &run](uint32_t index) {
+		if (_tasks[index].affinity == Affinity::MainThread)
+		{
+			mainThreadReady.push(index);
+		}
+		else
+		{
+			jobSystem.Schedule([&run, index]() { run(index); }, counter);
+		}
+	};
+	run = [this, &mutex, &changed, &completed, &exception, &dependents, &remainingDependencies, &makeReady](uint32_t index) {
+		std::exception_ptr taskException;
+		try
+		{
+			_tasks[index].func();
+		}
+		catch (...)
+		{
+			taskException = std::current_exception();
+		}
+
+		const std::lock_guard<std::mutex> lock(mutex);
+		if (taskException && !exception)
+		{
+			exception = taskException;
+		}
+		for (const auto dependent : dependents[index])
+		{
+			if (--remainingDependencies[dependent] == 0)
+			{
+				makeReady(dependent);
+			}
+		}
+		++completed;
+		changed.notify_all();
+	};
+
+	{
+		const std::lock_guard<std::mutex> lock(mutex);
+		for (uint32_t i = 0; i < taskCount; ++i)
+		{
+			if (remainingDependencies[i] == 0)
+			{
+				makeReady(i);
+			}
+		}
+	}
+
+	// The main thread only runs its own tasks so that jobs it scheduled get picked up by the workers
+	while (true)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		changed.wait(lock, [&] { return completed == taskCount || !mainThreadReady.empty(); });
+		if (mainThreadReady.empty())
+		{
+			break;
+		}
+		const auto index = mainThreadReady.top();
+		mainThreadReady.pop();
+		lock.unlock();
+		run(index);
+	}
+
+	// Jobs release the counter after their task has completed
+	jobSystem.Wait(counter);
+	_tasks.clear();
+	if (exception)
+	{
+		std::rethrow_exception(exception);
+	}
+}
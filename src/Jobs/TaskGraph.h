@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <bitset>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+namespace openblack
+{
+class JobSystem;
+
+/// Tasks declaring the engine state they read and write. A task runs after every previously added task it conflicts
+/// with (one writes what the other reads or writes) while the others may overlap on the \ref JobSystem.
+/// The result is the same as running the tasks one after the other in the order they were added.
+class TaskGraph
+{
+public:
+	/// Physics is the dynamics world along with the bodies of the RigidBody components, a task adding or removing those
+	/// components writes it as well as the Registry.
+	enum class Resource : uint8_t
+	{
+		Registry,
+		Map,
+		Physics,
+		Camera,
+		Input,
+		Config,
+		DebugGui,
+		Vm,
+		Audio,
+		RenderContext,
+		Renderer,
+
+		_count
+	};
+
+	enum class Affinity : uint8_t
+	{
+		Any,
+		MainThread,
+	};
+
+	struct TaskDesc
+	{
+		std::initializer_list<Resource> reads;
+		std::initializer_list<Resource> writes;
+		Affinity affinity {Affinity::Any};
+		std::function<void()> func;
+	};
+
+	void AddTask(TaskDesc&& desc);
+	/// Run all tasks and clear the graph. Must be called from the main thread.
+	/// Rethrows the first exception thrown by a task once all tasks have run.
+	void Execute(JobSystem& jobSystem);
+	void Clear() { _tasks.clear(); }
+
+	[[nodiscard]] size_t Size() const { return _tasks.size(); }
+
+private:
+	using ResourceSet = std::bitset<static_cast<size_t>(Resource::_count)>;
+
+	struct Task
+	{
+		ResourceSet reads;
+		ResourceSet writes;
+		Affinity affinity;
+		std::function<void()> func;
+	};
+
+	std::vector<Task> _tasks;
+};
+
+} // namespace openblack
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "CommandLookup.h"
+
+#include <stdexcept>
+
+using namespace openblack::lhscriptx;
+
+CommandLookup::CommandLookup(std::span<const ScriptCommandSignature> signatures)
+    : _signatures(signatures)
+{
+	if (_signatures.size() >= k_MaxSignatures)
+	{
+		throw std::logic_error("Too many script commands for the lookup");
+	}
+	for (_seed = 0; _seed < k_MaxSeed; ++_seed)
+	{
+		if (TryBuild())
+		{
+			return;
+		}
+	}
+	throw std::logic_error("Could not find a perfect hash for the script commands");
+}
+
+std::optional<uint16_t> CommandLookup::Find(std::string_view name) const noexcept
+{
+	const auto index = _slots[Hash(name, _seed) % _slots.size()];
+	if (index == k_Empty || GetName(index) != name)
+	{
+		return std::nullopt;
+	}
+	return index;
+}
+
+/// 32 bit FNV-1a with the seed folded into the offset basis
+uint32_t CommandLookup::Hash(std::string_view name, uint32_t seed) noexcept
+{
+	uint32_t hash = 0x811c9dc5 ^ (seed * 0x9e3779b9);
+	for (const auto c : name)
+	{
+		hash = (hash ^ static_cast<uint8_t>(c)) * 0x01000193;
+	}
+	return hash ^ (hash >> 16);
+}
+
+bool CommandLookup::TryBuild() noexcept
+{
+	_slots.fill(k_Empty);
+	for (uint16_t i = 0; i < _signatures.size(); ++i)
+	{
+		auto& slot = _slots[Hash(GetName(i), _seed) % _slots.size()];
+		if (slot != k_Empty)
+		{
+			return false;
+		}
+		slot = i;
+	}
+	return true;
+}
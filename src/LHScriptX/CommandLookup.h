@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "CommandSignature.h"
+
+namespace openblack::lhscriptx
+{
+
+/// Collision free table from command names to their index in the signatures.
+/// The seed is searched for once, the table is sparse enough for this to take a handful of tries.
+class CommandLookup
+{
+public:
+	static constexpr uint16_t k_Empty = std::numeric_limits<uint16_t>::max();
+	static constexpr size_t k_MaxSignatures = k_Empty;
+
+	/// Throws std::logic_error if no seed maps every name to its own slot
+	explicit CommandLookup(std::span<const ScriptCommandSignature> signatures);
+
+	/// Index of the signature named \p name, if any
+	[[nodiscard]] std::optional<uint16_t> Find(std::string_view name) const noexcept;
+
+private:
+	static constexpr uint32_t k_MaxSeed = 0x10000;
+
+	[[nodiscard]] static uint32_t Hash(std::string_view name, uint32_t seed) noexcept;
+	[[nodiscard]] std::string_view GetName(uint16_t index) const noexcept { return _signatures[index].name.data(); }
+	bool TryBuild() noexcept;
+
+	std::span<const ScriptCommandSignature> _signatures;
+	std::array<uint16_t, 2048> _slots;
+	uint32_t _seed {0};
+};
+
+} // namespace openblack::lhscriptx
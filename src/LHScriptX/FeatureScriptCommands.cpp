@@ -9,7 +9,10 @@
 
 #include "FeatureScriptCommands.h"
 
+#include <string_view>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include <glm/gtx/euler_angles.hpp>
 #include <glm/gtx/polar_coordinates.hpp>
@@ -112,7 +115,7 @@ const std::array<const ScriptCommandSignature, 106> FeatureScriptCommands::k_Sig
     CREATE_COMMAND_BINDING("SET_TOWN_BELIEF_CAP", SetTownBeliefCap),
     CREATE_COMMAND_BINDING("SET_TOWN_UNINHABITABLE", SetTownUninhabitable),
     CREATE_COMMAND_BINDING("SET_TOWN_CONGREGATION_POS", SetTownCongregationPos),
-    CREATE_COMMAND_BINDING("CREATE_ABODE", CreateAbode),
+    CREATE_BATCH_COMMAND_BINDING("CREATE_ABODE", CreateAbode, CreateAbodes),
     CREATE_COMMAND_BINDING("CREATE_PLANNED_ABODE", CreatePlannedAbode),
     CREATE_COMMAND_BINDING("CREATE_TOWN_CENTRE", CreateTownCentre),
     CREATE_COMMAND_BINDING("CREATE_TOWN_SPELL", CreateTownSpell),
@@ -132,22 +135,22 @@ const std::array<const ScriptCommandSignature, 106> FeatureScriptCommands::k_Sig
     CREATE_COMMAND_BINDING("CREATE_ANIMAL", CreateAnimal),
     CREATE_COMMAND_BINDING("CREATE_NEW_ANIMAL", CreateNewAnimal),
     CREATE_COMMAND_BINDING("CREATE_FOREST", CreateForest),
-    CREATE_COMMAND_BINDING("CREATE_TREE", CreateTree),
-    CREATE_COMMAND_BINDING("CREATE_NEW_TREE", CreateNewTree),
+    CREATE_BATCH_COMMAND_BINDING("CREATE_TREE", CreateTree, CreateTrees),
+    CREATE_BATCH_COMMAND_BINDING("CREATE_NEW_TREE", CreateNewTree, CreateNewTrees),
     CREATE_COMMAND_BINDING("CREATE_FIELD", CreateField),
     CREATE_COMMAND_BINDING("CREATE_TOWN_FIELD", CreateTownField),
     CREATE_COMMAND_BINDING("CREATE_FISH_FARM", CreateFishFarm),
     CREATE_COMMAND_BINDING("CREATE_TOWN_FISH_FARM", CreateTownFishFarm),
-    CREATE_COMMAND_BINDING("CREATE_FEATURE", CreateFeature),
+    CREATE_BATCH_COMMAND_BINDING("CREATE_FEATURE", CreateFeature, CreateFeatures),
     CREATE_COMMAND_BINDING("CREATE_FLOWERS", CreateFlowers),
     CREATE_COMMAND_BINDING("CREATE_WALL_SECTION", CreateWallSection),
     CREATE_COMMAND_BINDING("CREATE_PLANNED_WALL_SECTION", CreatePlannedWallSection),
     CREATE_COMMAND_BINDING("CREATE_PITCH", CreatePitch),
     CREATE_COMMAND_BINDING("CREATE_POT", CreatePot),
     CREATE_COMMAND_BINDING("CREATE_TOWN_TEMPORARY_POTS", CreateTownTemporaryPots),
-    CREATE_COMMAND_BINDING("CREATE_MOBILEOBJECT", CreateMobileObject),
-    CREATE_COMMAND_BINDING("CREATE_MOBILESTATIC", CreateMobileStatic),
-    CREATE_COMMAND_BINDING("CREATE_MOBILE_STATIC", CreateMobileUStatic),
+    CREATE_BATCH_COMMAND_BINDING("CREATE_MOBILEOBJECT", CreateMobileObject, CreateMobileObjects),
+    CREATE_BATCH_COMMAND_BINDING("CREATE_MOBILESTATIC", CreateMobileStatic, CreateMobileStatics),
+    CREATE_BATCH_COMMAND_BINDING("CREATE_MOBILE_STATIC", CreateMobileUStatic, CreateMobileUStatics),
     CREATE_COMMAND_BINDING("CREATE_DEAD_TREE", CreateDeadTree),
     CREATE_COMMAND_BINDING("CREATE_SCAFFOLD", CreateScaffold),
     CREATE_COMMAND_BINDING("COUNTRY_CHANGE", CountryChange),
@@ -162,8 +165,8 @@ const std::array<const ScriptCommandSignature, 106> FeatureScriptCommands::k_Sig
     CREATE_COMMAND_BINDING("FLY_BY_FILE", FlyByFile),
     CREATE_COMMAND_BINDING("TOWN_NEEDS_POS", TownNeedsPos),
     CREATE_COMMAND_BINDING("CREATE_FURNITURE", CreateFurniture),
-    CREATE_COMMAND_BINDING("CREATE_BIG_FOREST", CreateBigForest),
-    CREATE_COMMAND_BINDING("CREATE_NEW_BIG_FOREST", CreateNewBigForest),
+    CREATE_BATCH_COMMAND_BINDING("CREATE_BIG_FOREST", CreateBigForest, CreateBigForests),
+    CREATE_BATCH_COMMAND_BINDING("CREATE_NEW_BIG_FOREST", CreateNewBigForest, CreateNewBigForests),
     CREATE_COMMAND_BINDING("CREATE_INFLUENCE_RING", CreateInfluenceRing),
     CREATE_COMMAND_BINDING("CREATE_WEATHER_CLIMATE", CreateWeatherClimate),
     CREATE_COMMAND_BINDING("CREATE_WEATHER_CLIMATE_RAIN", CreateWeatherClimateRain),
@@ -909,3 +912,111 @@ void FeatureScriptCommands::SetLostTownScale([[maybe_unused]] float scale)
 	// SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "LHScriptX: {}:{}: Function {} not implemented.", __FILE__, __LINE__,
 	// __func__);
 }
+
+void FeatureScriptCommands::CreateAbodes(
+    std::span<const std::tuple<int32_t, glm::vec3, std::string, int32_t, int32_t, int32_t, int32_t>> batch)
+{
+	std::vector<AbodeArchetype::Parameters> abodes;
+	abodes.reserve(batch.size());
+	for (const auto& [townId, position, abodeInfo, rotation, size, foodAmount, woodAmount] : batch)
+	{
+		// Does not use 3d angle to game angle
+		abodes.push_back({static_cast<uint32_t>(townId), position, GAbodeInfo::Find(abodeInfo), rotation * 0.001f,
+		                  size * 0.001f, static_cast<uint32_t>(foodAmount), static_cast<uint32_t>(woodAmount)});
+	}
+	AbodeArchetype::Create(abodes);
+}
+
+void FeatureScriptCommands::CreateTrees(std::span<const std::tuple<int32_t, glm::vec3, TreeInfo, int32_t, int32_t>> batch)
+{
+	std::vector<TreeArchetype::Parameters> trees;
+	trees.reserve(batch.size());
+	for (const auto& [forestId, position, treeType, rotation, scale] : batch)
+	{
+		trees.push_back({static_cast<uint32_t>(forestId), position, treeType, true, rotation * 0.001f, scale * 0.001f,
+		                 scale * 0.001f});
+	}
+	TreeArchetype::Create(trees);
+}
+
+void FeatureScriptCommands::CreateNewTrees(
+    std::span<const std::tuple<int32_t, glm::vec3, TreeInfo, int32_t, float, float, float>> batch)
+{
+	std::vector<TreeArchetype::Parameters> trees;
+	trees.reserve(batch.size());
+	for (const auto& [forestId, position, treeType, isNonScenic, rotation, currentSize, maxSize] : batch)
+	{
+		trees.push_back({static_cast<uint32_t>(forestId), position, treeType, static_cast<bool>(isNonScenic), rotation, maxSize,
+		                 currentSize});
+	}
+	TreeArchetype::Create(trees);
+}
+
+void FeatureScriptCommands::CreateFeatures(std::span<const std::tuple<glm::vec3, FeatureInfo, int32_t, int32_t, int32_t>> batch)
+{
+	std::vector<FeatureArchetype::Parameters> features;
+	features.reserve(batch.size());
+	for (const auto& [position, type, rotation, scale, unused] : batch)
+	{
+		features.push_back({position, type, rotation * 0.001f, scale * 0.001f});
+	}
+	FeatureArchetype::Create(features);
+}
+
+void FeatureScriptCommands::CreateMobileObjects(
+    std::span<const std::tuple<glm::vec3, MobileObjectInfo, int32_t, int32_t>> batch)
+{
+	std::vector<MobileObjectArchetype::Parameters> mobileObjects;
+	mobileObjects.reserve(batch.size());
+	for (const auto& [position, type, rotation, scale] : batch)
+	{
+		mobileObjects.push_back({position, type, rotation * 0.001f, scale * 0.001f});
+	}
+	MobileObjectArchetype::Create(mobileObjects);
+}
+
+void FeatureScriptCommands::CreateMobileStatics(std::span<const std::tuple<glm::vec3, MobileStaticInfo, float, float>> batch)
+{
+	std::vector<MobileStaticArchetype::Parameters> mobileStatics;
+	mobileStatics.reserve(batch.size());
+	for (const auto& [position, type, yRotation, scale] : batch)
+	{
+		mobileStatics.push_back({position, type, 0.0f, 0.0f, yRotation, 0.0f, scale});
+	}
+	MobileStaticArchetype::Create(mobileStatics);
+}
+
+void FeatureScriptCommands::CreateMobileUStatics(
+    std::span<const std::tuple<glm::vec3, MobileStaticInfo, float, float, float, float, float>> batch)
+{
+	std::vector<MobileStaticArchetype::Parameters> mobileStatics;
+	mobileStatics.reserve(batch.size());
+	for (const auto& [position, type, verticalOffset, xRotation, yRotation, zRotation, scale] : batch)
+	{
+		mobileStatics.push_back({position, type, verticalOffset, xRotation, yRotation, zRotation, scale});
+	}
+	MobileStaticArchetype::Create(mobileStatics);
+}
+
+void FeatureScriptCommands::CreateBigForests(std::span<const std::tuple<glm::vec3, BigForestInfo, float, float>> batch)
+{
+	std::vector<BigForestArchetype::Parameters> bigForests;
+	bigForests.reserve(batch.size());
+	for (const auto& [position, type, rotation, scale] : batch)
+	{
+		bigForests.push_back({position, type, 0, rotation, scale});
+	}
+	BigForestArchetype::Create(bigForests);
+}
+
+void FeatureScriptCommands::CreateNewBigForests(
+    std::span<const std::tuple<glm::vec3, BigForestInfo, int32_t, float, float>> batch)
+{
+	std::vector<BigForestArchetype::Parameters> bigForests;
+	bigForests.reserve(batch.size());
+	for (const auto& [position, type, unknown, rotation, scale] : batch)
+	{
+		bigForests.push_back({position, type, static_cast<uint32_t>(unknown), rotation, scale});
+	}
+	BigForestArchetype::Create(bigForests);
+}
@@ -9,7 +9,12 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <array>
+#include <span>
+#include <string>
+#include <tuple>
 
 #include <glm/vec3.hpp>
 
@@ -139,6 +144,20 @@ class FeatureScriptCommands
 	static void SetNighttime(float, float, float);
 	static void MakeLastObjectArtifact(int32_t, const std::string&, float);
 	static void SetLostTownScale(float scale);
+
+	// Batches of consecutive commands, see CREATE_BATCH_COMMAND_BINDING
+	static void CreateAbodes(
+	    std::span<const std::tuple<int32_t, glm::vec3, std::string, int32_t, int32_t, int32_t, int32_t>> batch);
+	static void CreateTrees(std::span<const std::tuple<int32_t, glm::vec3, TreeInfo, int32_t, int32_t>> batch);
+	static void CreateNewTrees(
+	    std::span<const std::tuple<int32_t, glm::vec3, TreeInfo, int32_t, float, float, float>> batch);
+	static void CreateFeatures(std::span<const std::tuple<glm::vec3, FeatureInfo, int32_t, int32_t, int32_t>> batch);
+	static void CreateMobileObjects(std::span<const std::tuple<glm::vec3, MobileObjectInfo, int32_t, int32_t>> batch);
+	static void CreateMobileStatics(std::span<const std::tuple<glm::vec3, MobileStaticInfo, float, float>> batch);
+	static void CreateMobileUStatics(
+	    std::span<const std::tuple<glm::vec3, MobileStaticInfo, float, float, float, float, float>> batch);
+	static void CreateBigForests(std::span<const std::tuple<glm::vec3, BigForestInfo, float, float>> batch);
+	static void CreateNewBigForests(std::span<const std::tuple<glm::vec3, BigForestInfo, int32_t, float, float>> batch);
 };
 
 } // namespace openblack::lhscriptx
@@ -9,23 +9,156 @@
 
 #include "Script.h"
 
+#include <cstdlib>
+#include <cstring>
+
 #include <algorithm>
-#include <ranges>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
 
 #include <glm/vec2.hpp>
 
 #include "3D/LandIslandInterface.h"
+#include "CommandLookup.h"
 #include "FeatureScriptCommands.h"
 #include "Lexer.h"
 #include "Locator.h"
+#include "Resources/AssetCache.h"
+#include "ScriptArguments.h"
 
 using namespace openblack;
 using namespace openblack::lhscriptx;
 
+namespace
+{
+const CommandLookup& GetCommandLookup()
+{
+	static const CommandLookup lookup(FeatureScriptCommands::k_Signatures);
+	return lookup;
+}
+
+/// Compiled scripts store command indices, this identifies the signatures they index
+uint64_t GetSignaturesHash() noexcept
+{
+	static const uint64_t hash = [] {
+		uint64_t result = 0xcbf29ce484222325ULL;
+		const auto add = [&result](uint8_t byte) { result = (result ^ byte) * 0x100000001b3ULL; };
+		for (const auto& signature : FeatureScriptCommands::k_Signatures)
+		{
+			for (const auto c : std::string_view(signature.name.data()))
+			{
+				add(static_cast<uint8_t>(c));
+			}
+			add(0);
+			for (const auto parameter : signature.parameters)
+			{
+				add(static_cast<uint8_t>(parameter));
+			}
+		}
+		return result;
+	}();
+	return hash;
+}
+
+/// Strings of the form "x,z" are positions on the landscape
+std::optional<glm::vec2> ParseVector(const std::string& str)
+{
+	if (std::count_if(str.cbegin(), str.cend(), [](char c) { return c == ','; }) != 1)
+	{
+		return std::nullopt;
+	}
+	const auto delim = str.find(',');
+	char* floatEnd;
+	const auto x = std::strtof(str.c_str(), &floatEnd);
+	if (str.c_str() + delim != floatEnd)
+	{
+		return std::nullopt;
+	}
+	const auto z = std::strtof(floatEnd + 1, &floatEnd);
+	if (static_cast<size_t>(floatEnd - str.c_str()) != static_cast<size_t>(str.length()))
+	{
+		return std::nullopt;
+	}
+	return glm::vec2(x, z);
+}
+
+void CheckArgumentType(ParameterType type, ParameterType expected)
+{
+	if (type != expected)
+	{
+		throw std::runtime_error("Invalid script argument type");
+	}
+}
+
+void WriteArgument(const Token& argument, ParameterType expected, resources::BlobWriter& writer)
+{
+	const auto type = argument.GetType();
+
+	switch (type)
+	{
+	case Token::Type::Invalid:
+		throw std::runtime_error("Invalid token. Unable to proceed");
+	case Token::Type::EndOfFile:
+		throw std::runtime_error("Unexpected EOF in script");
+	case Token::Type::EndOfLine:
+		throw std::runtime_error("Unexpected EOL in script");
+	case Token::Type::Identifier:
+		CheckArgumentType(ParameterType::String, expected);
+		writer.WriteArray(argument.Identifier());
+		break;
+	case Token::Type::String:
+	{
+		const auto& str = argument.StringValue();
+		if (const auto position = ParseVector(str))
+		{
+			CheckArgumentType(ParameterType::Vector, expected);
+			writer.Write(*position);
+		}
+		else
+		{
+			CheckArgumentType(ParameterType::String, expected);
+			writer.WriteArray(str);
+		}
+		break;
+	}
+	case Token::Type::Integer:
+		CheckArgumentType(ParameterType::Number, expected);
+		writer.Write(static_cast<int32_t>(*argument.IntegerValue()));
+		break;
+	case Token::Type::Float:
+		CheckArgumentType(ParameterType::Float, expected);
+		writer.Write(*argument.FloatValue());
+		break;
+	case Token::Type::Operator:
+		throw std::runtime_error("Operator token as an argument is currently not supported");
+	default:
+		throw std::runtime_error("Missing switch case for script token argument");
+	}
+}
+} // namespace
+
+template <>
+glm::vec3 ScriptArguments::Get()
+{
+	const auto position = _reader.Read<glm::vec2>();
+	const auto& island = Locator::terrainSystem::value();
+	return {position.x, island.GetHeightAt(position), position.y};
+}
+
 Script::Script() = default;
 
 void Script::Load(const std::string& source)
 {
+	Run(Compile(source));
+}
+
+std::vector<uint8_t> Script::Compile(const std::string& source)
+{
+	resources::BlobWriter writer;
+	writer.Write(GetSignaturesHash());
+
 	Lexer lexer(source);
 
 	const Token* token = this->PeekToken(lexer);
@@ -37,10 +170,15 @@ void Script::Load(const std::string& source)
 		{
 			const std::string identifier = token->Identifier();
 
-			if (!IsCommand(identifier))
+			const auto index = GetCommandLookup().Find(identifier);
+			if (!index.has_value())
 			{
 				throw std::runtime_error("unknown command: " + identifier);
 			}
+			const auto& parameters = FeatureScriptCommands::k_Signatures[*index].parameters;
+			const auto expectedSize = static_cast<size_t>(
+			    std::distance(parameters.cbegin(), std::find(parameters.cbegin(), parameters.cend(), ParameterType::None)));
+			writer.Write(*index);
 
 			token = this->AdvanceToken(lexer);
 			if (!token->IsOP(Operator::LeftParentheses))
@@ -48,7 +186,7 @@ void Script::Load(const std::string& source)
 				throw std::runtime_error("expected ( after identifier " + identifier);
 			}
 
-			std::vector<Token> args;
+			size_t argumentCount = 0;
 
 			// if it's an immediate right parentheses there are no args
 			token = this->AdvanceToken(lexer);
@@ -56,8 +194,13 @@ void Script::Load(const std::string& source)
 			{
 				while (true)
 				{
+					if (argumentCount == expectedSize)
+					{
+						throw std::runtime_error("Invalid number of script arguments");
+					}
 					const Token* peekToken = this->PeekToken(lexer);
-					args.push_back(*peekToken);
+					WriteArgument(*peekToken, parameters[argumentCount], writer);
+					++argumentCount;
 
 					// consume the ,
 					token = this->AdvanceToken(lexer);
@@ -75,129 +218,51 @@ void Script::Load(const std::string& source)
 				throw std::runtime_error("missing )");
 			}
 
+			if (argumentCount != expectedSize)
+			{
+				throw std::runtime_error("Invalid number of script arguments");
+			}
+
 			// move token to whatever is after ')'
 			this->AdvanceToken(lexer);
-
-			RunCommand(identifier, args);
 		}
 
 		this->AdvanceToken(lexer);
 	}
-}
 
-bool Script::IsCommand(const std::string& identifier) const
-{
-	// TODO(handsomematt): this could be done a lot better
-	return std::any_of(FeatureScriptCommands::k_Signatures.cbegin(), FeatureScriptCommands::k_Signatures.cend(),
-	                   [&identifier](const auto& s) { return s.name.data() == identifier; });
+	return writer.Release();
 }
 
-ScriptCommandParameter GetParameter(Token& argument)
+bool Script::IsCompatible(std::span<const uint8_t> compiled) noexcept
 {
-	const auto type = argument.GetType();
-
-	switch (type)
+	uint64_t hash;
+	if (compiled.size() < sizeof(hash))
 	{
-	case Token::Type::Invalid:
-		throw std::runtime_error("Invalid token. Unable to proceed");
-	case Token::Type::EndOfFile:
-		throw std::runtime_error("Unexpected EOF in script");
-	case Token::Type::EndOfLine:
-		throw std::runtime_error("Unexpected EOL in script");
-	case Token::Type::Identifier:
-		return ScriptCommandParameter(argument.Identifier());
-	case Token::Type::String:
-	{
-		const auto& str = argument.StringValue();
-		// Check if it's a vector
-		if (std::count_if(str.cbegin(), str.cend(), [](char c) { return c == ','; }) == 1)
-		{
-			const auto delim = str.find(',');
-			char* floatEnd;
-			const auto x = std::strtof(str.c_str(), &floatEnd);
-			if (str.c_str() + delim == floatEnd)
-			{
-				const auto z = std::strtof(floatEnd + 1, &floatEnd);
-				if (static_cast<size_t>(floatEnd - str.c_str()) == static_cast<size_t>(str.length()))
-				{
-					const auto& island = Locator::terrainSystem::value();
-
-					return {x, island.GetHeightAt(glm::vec2(x, z)), z};
-				}
-			}
-		}
-		return ScriptCommandParameter(str);
-	}
-	case Token::Type::Integer:
-		return ScriptCommandParameter(*argument.IntegerValue());
-	case Token::Type::Float:
-		return ScriptCommandParameter(*argument.FloatValue());
-	case Token::Type::Operator:
-		throw std::runtime_error("Operator token as an argument is currently not supported");
-	default:
-		throw std::runtime_error("Missing switch case for script token argument");
+		return false;
 	}
+	std::memcpy(&hash, compiled.data(), sizeof(hash));
+	return hash == GetSignaturesHash();
 }
 
-void Script::RunCommand(const std::string& identifier, const std::vector<Token>& args)
+void Script::Run(std::span<const uint8_t> compiled)
 {
-	const ScriptCommandSignature* commandSignature = nullptr;
-
-	for (const auto& signature : FeatureScriptCommands::k_Signatures)
+	if (!IsCompatible(compiled))
 	{
-		if (signature.name.data() != identifier)
-		{
-			continue;
-		}
-
-		commandSignature = &signature;
-		break;
+		throw std::runtime_error("Script was compiled against different commands");
 	}
 
-	if (commandSignature == nullptr)
+	resources::BlobReader reader(compiled);
+	[[maybe_unused]] const auto hash = reader.Read<uint64_t>();
+	ScriptArguments arguments(reader);
+	while (!reader.AtEnd())
 	{
-		throw std::runtime_error("Missing script command signature");
-	}
-
-	// Turn tokens into parameters
-	auto parameters = ScriptCommandParameters();
-
-	for (auto arg : args)
-	{
-		const ScriptCommandParameter param = GetParameter(arg);
-		parameters.push_back(param);
-	}
-
-	const auto expectedParameters = commandSignature->parameters;
-	uint32_t expectedSize;
-	// TODO (#749) use std::views::enumerate
-	for (expectedSize = 0; const auto& p : commandSignature->parameters)
-	{
-		// Looping until None because parameters is a fixed sized array.
-		// Last Argument is the one before the first None or the 9th
-		if (p == ParameterType::None)
+		const auto index = arguments.ReadCommand();
+		if (index >= FeatureScriptCommands::k_Signatures.size())
 		{
-			break;
+			throw std::runtime_error("Invalid command in compiled script");
 		}
-		++expectedSize;
+		FeatureScriptCommands::k_Signatures[index].command(arguments);
 	}
-
-	// Validate the number of given arguments against what is expected
-	if (parameters.size() != expectedSize)
-	{
-		throw std::runtime_error("Invalid number of script arguments");
-	}
-
-	// Validate the typing of the given arguments against what is expected
-	for (const auto& [param, expected] : std::views::zip(parameters, expectedParameters))
-	{
-		if (param.GetType() != expected)
-		{
-			throw std::runtime_error("Invalid script argument type");
-		}
-	}
-
-	commandSignature->command(parameters);
 }
 
 const Token* Script::PeekToken(Lexer& lexer)
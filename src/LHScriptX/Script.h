@@ -9,6 +9,10 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <span>
+#include <string>
 #include <vector>
 
 #include "Lexer.h"
@@ -16,17 +20,23 @@
 namespace openblack::lhscriptx
 {
 
+/// Feature scripts are compiled to records of a command index followed by its arguments packed as described in
+/// \ref ScriptArguments. Records run without any string lookups, so compiled scripts can be cached and run again.
 class Script
 {
 public:
 	Script();
 
+	/// Compile and run the source
 	void Load(const std::string&);
 
-private:
-	[[nodiscard]] bool IsCommand(const std::string& identifier) const;
-	void RunCommand(const std::string& identifier, const std::vector<Token>& args);
+	/// Throws std::runtime_error on syntax errors, unknown commands and arguments not matching the command's signature
+	[[nodiscard]] std::vector<uint8_t> Compile(const std::string& source);
+	/// False if the script was compiled against a different set of commands
+	[[nodiscard]] static bool IsCompatible(std::span<const uint8_t> compiled) noexcept;
+	static void Run(std::span<const uint8_t> compiled);
 
+private:
 	const Token* PeekToken(Lexer&);
 	const Token* AdvanceToken(Lexer&);
 
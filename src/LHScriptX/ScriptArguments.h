@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <string>
+
+#include <glm/vec3.hpp>
+
+#include "Resources/AssetCache.h"
+
+namespace openblack::lhscriptx
+{
+
+/// Arguments of a compiled record, read in the order and with the types of the command's signature.
+/// Numbers and floats are stored as is, strings as an array of chars and vectors as their x and z coordinates.
+class ScriptArguments
+{
+public:
+	explicit ScriptArguments(resources::BlobReader& reader) noexcept
+	    : _reader(reader)
+	{
+	}
+
+	/// Start the next record, returns the index of its command
+	uint16_t ReadCommand()
+	{
+		_command = _reader.Read<uint16_t>();
+		return _command;
+	}
+
+	/// Start the next record if it is for the same command, so that a batched command can read the arguments of a whole
+	/// run of records
+	[[nodiscard]] bool ReadSameCommand()
+	{
+		if (_reader.AtEnd() || _reader.Peek<uint16_t>() != _command)
+		{
+			return false;
+		}
+		ReadCommand();
+		return true;
+	}
+
+	template <typename T>
+	[[nodiscard]] T Get();
+
+private:
+	resources::BlobReader& _reader;
+	uint16_t _command {0};
+};
+
+template <>
+inline int32_t ScriptArguments::Get()
+{
+	return _reader.Read<int32_t>();
+}
+
+template <>
+inline float ScriptArguments::Get()
+{
+	return _reader.Read<float>();
+}
+
+template <>
+inline std::string ScriptArguments::Get()
+{
+	return std::string(_reader.ReadString());
+}
+
+/// The height is sampled from the landscape loaded when the record runs
+template <>
+glm::vec3 ScriptArguments::Get();
+
+} // namespace openblack::lhscriptx
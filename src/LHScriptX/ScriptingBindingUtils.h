@@ -9,10 +9,16 @@
 
 #pragma once
 
-#include <glm/vec2.hpp>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include <glm/vec3.hpp>
 
 #include "CommandSignature.h"
+#include "ScriptArguments.h"
 
 namespace openblack::lhscriptx
 {
@@ -45,100 +51,39 @@ inline ParameterType GetParamType()
 	}
 }
 
-template <class T>
-T GetParamValueRegular(const ScriptCommandParameters& ctx, int index);
-
-template <>
-inline const std::string& GetParamValueRegular(const ScriptCommandParameters& ctx, int index)
-{
-	return ctx[index].GetString();
-}
-
-template <>
-inline float GetParamValueRegular(const ScriptCommandParameters& ctx, int index)
-{
-	return ctx[index].GetFloat();
-}
-
-template <>
-inline int32_t GetParamValueRegular(const ScriptCommandParameters& ctx, int index)
-{
-	return ctx[index].GetNumber();
-}
-
-template <>
-inline glm::vec3 GetParamValueRegular(const ScriptCommandParameters& ctx, int index)
-{
-	glm::vec3 result;
-	ctx[index].GetVector(result.x, result.y, result.z);
-	return result;
-}
-
 template <typename T>
-inline T GetParamValue(const ScriptCommandParameters& ctx, int index)
+inline T GetArgument(ScriptArguments& args)
 {
 	if constexpr (std::is_enum_v<T>)
 	{
-		return static_cast<T>(GetParamValueRegular<std::underlying_type_t<T>>(ctx, index));
+		return static_cast<T>(args.Get<std::underlying_type_t<T>>());
 	}
 	else
 	{
-		return GetParamValueRegular<T>(ctx, index);
+		return args.Get<T>();
 	}
 }
 
-/// Base case which is triggered when RemainingTypes is void (see remaining non-parsed params case)
-template <typename... ParsedParamTypes, typename... ArgTypes>
-void InvokeCallableFromContext([[maybe_unused]] const ScriptCommandParameters& ctx, [[maybe_unused]] int paramIndex,
-                               /// This case is why the original function is passed along
-                               [[maybe_unused]] std::function<void(ArgTypes...)> originalFunction,
-                               /// Empty working function type which means all the parameter types have been extracted
-                               const std::function<void()>&,
-                               /// All the parameter types extracted at compile time with all the parameter values at runtime
-                               [[maybe_unused]] ParsedParamTypes... params)
-{
-	originalFunction(std::forward<ParsedParamTypes>(params)...);
-}
-
-/// Remaining non-parsed params case
-template <typename PoppedArgType, typename... ArgTypes, typename... RemainingTypes, typename... ParsedParamTypes>
-    requires(!std::is_array_v<PoppedArgType>)
-void InvokeCallableFromContext(
-    /// Pass along the script context which contains runtime parameter values
-    const ScriptCommandParameters& ctx,
-    /// Keep track of which runtime parameter to fetch from context
-    int paramIndex,
-    /// Keep track of the original function for later call
-    std::function<void(ArgTypes...)> originalFunction,
-    /// Template declaration of function extracts from RemainingTypes a PoppedArgType from the left
-    /// RemainingTypes will have one value taken at every recursive template call to InvokeCallableFromContext
-    /// PoppedArgType is used with paramIndex to get the runtime value from the context parameter list
-    std::function<void(PoppedArgType, RemainingTypes...)>,
-    /// Growing list of parameters whose types have been extracted by the template and whose values have been extracted from ctx
-    /// In the end, all types from RemainingTypes will be transferred to ParsedParamTypes, at which point the recursion ends
-    ParsedParamTypes... params)
+/// Read the arguments in the order of the function's parameters and call it
+template <typename... ArgTypes>
+void InvokeWithArguments([[maybe_unused]] ScriptArguments& args, void (&fn)(ArgTypes...))
 {
-	std::function<void(RemainingTypes...)> remainingTypesFunction;
-	InvokeCallableFromContext(ctx,
-	                          // Increment the parameter index for the next call to this function to fetch the right index
-	                          paramIndex + 1,
-	                          // Keep track of the original function for later call
-	                          originalFunction,
-	                          // List of remaining parameter types (popped from the left)
-	                          remainingTypesFunction,
-	                          // Growing list of parameter values taken from previous template-calls
-	                          std::forward<ParsedParamTypes>(params)...,
-	                          // Get parameter from the scripting context and append it to template-parsed parameters for call
-	                          // above If the template fails, it could be that the template
-	                          // ScriptCommandParameters::GetParameter is undefined for that particular type
-	                          GetParamValue<PoppedArgType>(ctx, paramIndex));
+	// Braced initialization is evaluated from left to right, unlike the arguments of a function call
+	std::tuple<std::remove_cvref_t<ArgTypes>...> values {GetArgument<std::remove_cvref_t<ArgTypes>>(args)...};
+	std::apply(fn, std::move(values));
 }
 
-/// Helper entry point to extract the parameter types and values
-template <typename... ArgTypes>
-void InvokeCallableFromContext(const ScriptCommandParameters& ctx, std::function<void(ArgTypes...)> fn)
+/// Read the arguments of a run of records of the same command and call the batch function once for all of them
+template <typename... ArgTypes, typename Batch>
+void InvokeBatchWithArguments(ScriptArguments& args, [[maybe_unused]] void (&fn)(ArgTypes...), Batch& batch)
 {
-	InvokeCallableFromContext(ctx, 0, fn, fn);
+	using Arguments = std::tuple<std::remove_cvref_t<ArgTypes>...>;
+	std::vector<Arguments> batchArguments;
+	do
+	{
+		batchArguments.emplace_back(Arguments {GetArgument<std::remove_cvref_t<ArgTypes>>(args)...});
+	} while (args.ReadSameCommand());
+	batch(std::span<const Arguments>(batchArguments));
 }
 
 /// Base case
@@ -165,7 +110,14 @@ constexpr std::array<ParameterType, 9> GetScriptCommandParameters(void (&fn)(Arg
 
 #define CREATE_COMMAND_BINDING(NAME, FUNCTION)                                                                       \
 	{                                                                                                                \
-		{NAME}, [](const ScriptCommandParameters& ctx) { InvokeCallableFromContext(ctx, std::function(FUNCTION)); }, \
+		{NAME}, [](ScriptArguments& args) { InvokeWithArguments(args, FUNCTION); },                                  \
+		    GetScriptCommandParameters(FUNCTION)                                                                     \
+	}
+
+/// Consecutive calls are passed to BATCH_FUNCTION at once, it takes a span of tuples of FUNCTION's arguments
+#define CREATE_BATCH_COMMAND_BINDING(NAME, FUNCTION, BATCH_FUNCTION)                                                 \
+	{                                                                                                                \
+		{NAME}, [](ScriptArguments& args) { InvokeBatchWithArguments(args, FUNCTION, BATCH_FUNCTION); },             \
 		    GetScriptCommandParameters(FUNCTION)                                                                     \
 	}
 
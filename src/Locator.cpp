@@ -37,8 +37,10 @@
 #include "ECS/Systems/Implementations/TownSystem.h"
 #include "Graphics/RendererInterface.h"
 #include "Input/GameActionMap.h"
+#include "Jobs/JobSystem.h"
 #include "LHVM.h"
 #include "Profiler.h"
+#include "Resources/AssetCache.h"
 #include "Resources/Resources.h"
 #include "Windowing/Sdl2WindowingSystem.h"
 #if __ANDROID__
@@ -83,6 +85,8 @@ bool openblack::InitializeEngine(uint8_t rendererType, bool vsync) noexcept
 	SPDLOG_LOGGER_INFO(spdlog::get("game"), GLM_VERSION_MESSAGE);
 
 	Locator::profiler::emplace();
+	Locator::jobSystem::emplace();
+	SPDLOG_LOGGER_INFO(spdlog::get("game"), "Job system running on {} threads", Locator::jobSystem::value().GetConcurrency());
 
 	Locator::rendererInterface::reset(
 	    RendererInterface::Create(static_cast<bgfx::RendererType::Enum>(rendererType), vsync).release());
@@ -97,7 +101,7 @@ bool openblack::InitializeEngine(uint8_t rendererType, bool vsync) noexcept
 #if __ANDROID__
 	Locator::filesystem::emplace<AndroidFileSystem>();
 #else
-	Locator::filesystem::emplace<DefaultFileSystem>();
+	Locator::filesystem::emplace<DefaultFileSystem>(Locator::config::has_value() && Locator::config::value().watchGameFiles);
 #endif
 	Locator::rng::emplace<RandomNumberManagerProduction>();
 	try
@@ -117,6 +121,11 @@ bool openblack::InitializeEngine(uint8_t rendererType, bool vsync) noexcept
 
 bool openblack::InitializeGame() noexcept
 {
+	if (Locator::config::has_value() && !Locator::config::value().assetCacheDirectory.empty())
+	{
+		const auto& config = Locator::config::value();
+		Locator::assetCache::emplace(config.assetCacheDirectory, config.rebuildAssetCache);
+	}
 	Locator::terrainSystem::emplace<UnloadedIsland>();
 	Locator::resources::emplace<Resources>();
 	Locator::playerSystem::emplace<PlayerSystem>();
@@ -174,6 +183,7 @@ void openblack::ShutDownServices()
 	Locator::handSystem::reset();
 	Locator::pathfindingSystem::reset();
 	Locator::terrainSystem::reset();
+	Locator::assetCache::reset();
 	Locator::filesystem::reset();
 	Locator::gameActionSystem::reset();
 
@@ -190,4 +200,5 @@ void openblack::ShutDownServices()
 	Locator::profiler::reset();
 
 	Locator::vm::reset();
+	Locator::jobSystem::reset();
 }
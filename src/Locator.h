@@ -21,6 +21,7 @@ namespace openblack
 struct EngineConfig;
 class Camera;
 class EventManager;
+class JobSystem;
 class LandIslandInterface;
 class OceanInterface;
 class Profiler;
@@ -71,6 +72,7 @@ class LHVM;
 
 namespace resources
 {
+class AssetCache;
 class ResourcesInterface;
 }
 
@@ -109,10 +111,12 @@ struct Locator
 	using config = entt::locator<EngineConfig>;
 	using infoConstants = entt::locator<const InfoConstants>;
 	using profiler = entt::locator<Profiler>;
+	using jobSystem = entt::locator<JobSystem>;
 	using events = entt::locator<EventManager>;
 	using windowing = entt::locator<windowing::WindowingInterface>;
 	using debugGui = entt::locator<debug::gui::DebugGuiInterface>;
 	using filesystem = entt::locator<filesystem::FileSystemInterface>;
+	using assetCache = entt::locator<openblack::resources::AssetCache>;
 	using resources = entt::locator<resources::ResourcesInterface>;
 	using rng = entt::locator<RandomNumberManagerInterface>;
 	using terrainSystem = entt::locator<LandIslandInterface>;
@@ -11,23 +11,32 @@
 
 #include <cassert>
 
+#include "Jobs/JobSystem.h"
+
+namespace
+{
+// Stages can run on any thread of the job system, nesting is tracked per thread
+thread_local uint8_t currentLevel = 0;
+} // namespace
+
 void openblack::Profiler::Begin(Stage stage)
 {
-	assert(_currentLevel < 255);
+	assert(currentLevel < 255);
 	auto& entry = _entries.at(_currentEntry).stages.at(static_cast<uint8_t>(stage));
-	entry.level = _currentLevel;
-	_currentLevel++;
+	entry.lane = JobSystem::GetCurrentThreadIndex();
+	entry.level = currentLevel;
+	currentLevel++;
 	entry.start = std::chrono::system_clock::now();
 	entry.finalized = false;
 }
 
 void openblack::Profiler::End(Stage stage)
 {
-	assert(_currentLevel > 0);
+	assert(currentLevel > 0);
 	auto& entry = _entries.at(_currentEntry).stages.at(static_cast<uint8_t>(stage));
 	assert(!entry.finalized);
-	_currentLevel--;
-	assert(entry.level == _currentLevel);
+	currentLevel--;
+	assert(entry.level == currentLevel);
 	entry.end = std::chrono::system_clock::now();
 	entry.finalized = true;
 }
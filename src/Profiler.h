@@ -25,9 +25,11 @@ class Profiler
 	enum class Stage : uint8_t
 	{
 		PhysicsUpdate,
+		PhysicsTransforms,
 		PathfindingUpdate,
 		LivingActionUpdate,
 		SdlInput,
+		CameraUpdate,
 		UpdateUniforms,
 		UpdateEntities,
 		UpdateAudio,
@@ -57,9 +59,11 @@ class Profiler
 
 	constexpr static std::array<std::string_view, static_cast<uint8_t>(Stage::_count)> k_StageNames = {
 	    "Physics Update",       //
+	    "Physics Transforms",   //
 	    "Pathfinding Update",   //
 	    "Living Action Update", //
 	    "SDL Input",            //
+	    "Camera Update",        //
 	    "Update Uniforms",      //
 	    "Entities",             //
 	    "Audio",                //
@@ -103,6 +107,8 @@ class Profiler
 public:
 	struct Scope
 	{
+		/// Thread the stage ran on, see \ref JobSystem::GetCurrentThreadIndex
+		uint32_t lane;
 		uint8_t level;
 		std::chrono::system_clock::time_point start;
 		std::chrono::system_clock::time_point end;
@@ -130,7 +136,6 @@ class Profiler
 private:
 	std::array<Entry, k_BufferSize> _entries;
 	uint8_t _currentEntry = k_BufferSize - 1;
-	uint8_t _currentLevel = 0;
 };
 
 } // namespace openblack
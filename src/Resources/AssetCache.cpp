@@ -0,0 +1,283 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "AssetCache.h"
+
+#include <array>
+#include <exception>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "FileSystem/FileSystemInterface.h"
+#include "Locator.h"
+
+#ifndef OPENBLACK_VERSION
+#define OPENBLACK_VERSION "unknown"
+#endif
+
+using namespace openblack;
+using namespace openblack::resources;
+
+namespace
+{
+constexpr std::array<char, 8> k_EntryMagic = {'O', 'B', 'B', 'A', 'K', 'E', 'D', '\0'};
+
+/// Its size keeps the data as aligned as the page it is mapped to
+struct EntryHeader
+{
+	std::array<char, 8> magic;
+	uint32_t formatVersion;
+	uint32_t reserved;
+	uint64_t stamp;
+	uint64_t size;
+};
+static_assert(sizeof(EntryHeader) % 16 == 0);
+
+/// 64 bit FNV-1a, only needs to be stable between runs
+class Hasher
+{
+public:
+	void Add(std::span<const uint8_t> bytes)
+	{
+		for (const auto byte : bytes)
+		{
+			_hash = (_hash ^ byte) * 0x100000001b3ULL;
+		}
+	}
+
+	void Add(std::string_view string) { Add(std::span(reinterpret_cast<const uint8_t*>(string.data()), string.size())); }
+
+	template <typename T>
+	void Add(const T& value)
+	{
+		Add(std::span(reinterpret_cast<const uint8_t*>(&value), sizeof(T)));
+	}
+
+	[[nodiscard]] uint64_t Get() const { return _hash; }
+
+private:
+	uint64_t _hash {0xcbf29ce484222325ULL};
+};
+} // namespace
+
+BakedBlob::BakedBlob(std::vector<uint8_t>&& data) noexcept
+    : _owned(std::move(data))
+    , _view(_owned)
+{
+}
+
+#ifdef _WIN32
+std::unique_ptr<BakedBlob> BakedBlob::Map(const std::filesystem::path& path) noexcept
+{
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+	                          nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return nullptr;
+	}
+	LARGE_INTEGER size;
+	HANDLE mapping = nullptr;
+	if (GetFileSizeEx(file, &size) != 0 && size.QuadPart > 0)
+	{
+		mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	}
+	// The view keeps its own reference to the file and the mapping
+	CloseHandle(file);
+	if (mapping == nullptr)
+	{
+		return nullptr;
+	}
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (data == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto blob = std::unique_ptr<BakedBlob>(new BakedBlob);
+	blob->_mapping = data;
+	blob->_mappingSize = static_cast<size_t>(size.QuadPart);
+	blob->_view = {static_cast<const uint8_t*>(data), blob->_mappingSize};
+	return blob;
+}
+
+BakedBlob::~BakedBlob() noexcept
+{
+	if (_mapping != nullptr)
+	{
+		UnmapViewOfFile(_mapping);
+	}
+}
+#else
+std::unique_ptr<BakedBlob> BakedBlob::Map(const std::filesystem::path& path) noexcept
+{
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return nullptr;
+	}
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+	{
+		close(fd);
+		return nullptr;
+	}
+	const auto size = static_cast<size_t>(fileStat.st_size);
+	void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps its own reference to the file
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	auto blob = std::unique_ptr<BakedBlob>(new BakedBlob);
+	blob->_mapping = data;
+	blob->_mappingSize = size;
+	blob->_view = {static_cast<const uint8_t*>(data), size};
+	return blob;
+}
+
+BakedBlob::~BakedBlob() noexcept
+{
+	if (_mapping != nullptr)
+	{
+		munmap(_mapping, _mappingSize);
+	}
+}
+#endif
+
+AssetCache::AssetCache(std::filesystem::path directory, bool rebuild)
+    : _directory(std::move(directory))
+    , _rebuild(rebuild)
+{
+}
+
+std::unique_ptr<BakedBlob> AssetCache::Find(std::string_view kind, std::span<const std::filesystem::path> sources) const
+{
+	if (_rebuild)
+	{
+		return nullptr;
+	}
+	const auto stamp = GetStamp(kind, sources);
+	if (!stamp)
+	{
+		return nullptr;
+	}
+
+	auto blob = BakedBlob::Map(GetEntryPath(kind, sources));
+	if (blob == nullptr || blob->GetData().size() < sizeof(EntryHeader))
+	{
+		return nullptr;
+	}
+	EntryHeader header;
+	std::memcpy(&header, blob->GetData().data(), sizeof(header));
+	if (header.magic != k_EntryMagic || header.formatVersion != k_FormatVersion || header.stamp != *stamp ||
+	    header.size != blob->GetData().size() - sizeof(header))
+	{
+		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Baked {} of {} is out of date", kind, sources.front().generic_string());
+		return nullptr;
+	}
+	blob->Skip(sizeof(header));
+	return blob;
+}
+
+void AssetCache::Store(std::string_view kind, std::span<const std::filesystem::path> sources,
+                       std::span<const uint8_t> data) const
+{
+	const auto stamp = GetStamp(kind, sources);
+	if (!stamp)
+	{
+		return;
+	}
+
+	const auto path = GetEntryPath(kind, sources);
+	// Written aside then renamed so that a concurrent or interrupted store never leaves a partial entry behind
+	auto temporaryPath = path;
+	temporaryPath += fmt::format(".{}.tmp", _temporaryCount.fetch_add(1, std::memory_order_relaxed));
+
+	std::error_code error;
+	std::filesystem::create_directories(_directory, error);
+	{
+		const EntryHeader header {k_EntryMagic, k_FormatVersion, 0, *stamp, data.size()};
+		std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		if (!stream)
+		{
+			error = std::make_error_code(std::errc::io_error);
+		}
+	}
+	if (!error)
+	{
+		std::filesystem::rename(temporaryPath, path, error);
+	}
+	if (error)
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Failed to store baked {} to {}: {}", kind, path.generic_string(),
+		                   error.message());
+		std::filesystem::remove(temporaryPath, error);
+	}
+}
+
+std::filesystem::path AssetCache::GetEntryPath(std::string_view kind, std::span<const std::filesystem::path> sources) const
+{
+	Hasher hasher;
+	for (const auto& source : sources)
+	{
+		hasher.Add(std::string_view(source.generic_string()));
+	}
+	return _directory / fmt::format("{}-{:016x}.bin", kind, hasher.Get());
+}
+
+std::optional<uint64_t> AssetCache::GetStamp(std::string_view kind, std::span<const std::filesystem::path> sources)
+{
+	Hasher hasher;
+	hasher.Add(std::string_view(OPENBLACK_VERSION));
+	hasher.Add(k_FormatVersion);
+	hasher.Add(kind);
+	for (const auto& source : sources)
+	{
+		std::filesystem::path path;
+		try
+		{
+			path = Locator::filesystem::value().FindPath(source);
+		}
+		catch (const std::exception&)
+		{
+			return std::nullopt;
+		}
+
+		std::error_code sizeError;
+		std::error_code timeError;
+		const auto size = std::filesystem::file_size(path, sizeError);
+		const auto time = std::filesystem::last_write_time(path, timeError);
+		if (sizeError || timeError)
+		{
+			return std::nullopt;
+		}
+		hasher.Add(std::string_view(path.generic_string()));
+		hasher.Add(static_cast<uint64_t>(size));
+		hasher.Add(static_cast<int64_t>(time.time_since_epoch().count()));
+	}
+	return hasher.Get();
+}
@@ -0,0 +1,189 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace openblack::resources
+{
+
+/// Post-processed asset, either mapped from the \ref AssetCache or baked in memory
+class BakedBlob
+{
+public:
+	explicit BakedBlob(std::vector<uint8_t>&& data) noexcept;
+	BakedBlob(const BakedBlob&) = delete;
+	BakedBlob& operator=(const BakedBlob&) = delete;
+	~BakedBlob() noexcept;
+
+	/// Returns nullptr if the file can not be opened or mapped
+	static std::unique_ptr<BakedBlob> Map(const std::filesystem::path& path) noexcept;
+
+	[[nodiscard]] std::span<const uint8_t> GetData() const noexcept { return _view; }
+	/// Drop the first bytes, e.g. the header of a cache entry
+	void Skip(size_t size) noexcept { _view = _view.subspan(size); }
+
+private:
+	BakedBlob() noexcept = default;
+
+	std::vector<uint8_t> _owned;
+	std::span<const uint8_t> _view;
+	void* _mapping {nullptr};
+	size_t _mappingSize {0};
+};
+
+/// Appends trivially copyable values and arrays, arrays are aligned for \ref BlobReader to view them in place
+class BlobWriter
+{
+public:
+	template <typename T>
+	void Write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		Append(&value, sizeof(T), alignof(T));
+	}
+
+	/// Any contiguous range, e.g. a std::vector, std::span or std::string_view
+	template <std::ranges::contiguous_range Range>
+	void WriteArray(const Range& values)
+	{
+		using T = std::ranges::range_value_t<Range>;
+		static_assert(std::is_trivially_copyable_v<T>);
+		Write(static_cast<uint32_t>(std::ranges::size(values)));
+		Append(std::ranges::data(values), sizeof(T) * std::ranges::size(values), alignof(T));
+	}
+
+	[[nodiscard]] std::vector<uint8_t> Release() noexcept { return std::move(_data); }
+
+private:
+	void Append(const void* data, size_t size, size_t alignment)
+	{
+		_data.resize((_data.size() + alignment - 1) / alignment * alignment);
+		const auto* bytes = static_cast<const uint8_t*>(data);
+		_data.insert(_data.end(), bytes, bytes + size);
+	}
+
+	std::vector<uint8_t> _data;
+};
+
+/// Reads back what \ref BlobWriter wrote, throws std::runtime_error if the blob is too short
+class BlobReader
+{
+public:
+	explicit BlobReader(std::span<const uint8_t> data) noexcept
+	    : _data(data)
+	{
+	}
+
+	template <typename T>
+	[[nodiscard]] T Read()
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		T value;
+		std::memcpy(&value, Consume(sizeof(T), alignof(T)), sizeof(T));
+		return value;
+	}
+
+	/// Read a value without consuming it
+	template <typename T>
+	[[nodiscard]] T Peek()
+	{
+		const auto offset = _offset;
+		const auto value = Read<T>();
+		_offset = offset;
+		return value;
+	}
+
+	/// The returned span points into the blob which must outlive it
+	template <typename T>
+	[[nodiscard]] std::span<const T> ReadArray()
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		const auto count = Read<uint32_t>();
+		const auto* data = Consume(sizeof(T) * count, alignof(T));
+		if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0)
+		{
+			throw std::runtime_error("Misaligned baked array");
+		}
+		return {reinterpret_cast<const T*>(data), count};
+	}
+
+	[[nodiscard]] std::string_view ReadString()
+	{
+		const auto chars = ReadArray<char>();
+		return {chars.data(), chars.size()};
+	}
+
+	[[nodiscard]] bool AtEnd() const noexcept { return _offset >= _data.size(); }
+
+private:
+	const uint8_t* Consume(size_t size, size_t alignment)
+	{
+		const auto offset = (_offset + alignment - 1) / alignment * alignment;
+		if (offset > _data.size() || size > _data.size() - offset)
+		{
+			throw std::runtime_error("Baked asset is truncated");
+		}
+		_offset = offset + size;
+		return _data.data() + offset;
+	}
+
+	std::span<const uint8_t> _data;
+	size_t _offset {0};
+};
+
+/// Directory of post-processed assets so that warm starts skip inflating, parsing and building vertex lists.
+/// An entry is named after its kind and source paths. Its header holds a stamp of the size and modification time of
+/// the sources and of the engine version, entries whose stamp does not match are baked again and overwritten.
+class AssetCache
+{
+public:
+	/// Bump whenever the layout of a baked asset changes
+	static constexpr uint32_t k_FormatVersion = 1;
+
+	/// With rebuild set every lookup misses so that all entries used get baked again
+	AssetCache(std::filesystem::path directory, bool rebuild);
+
+	/// Sources are game paths resolved through the file system, e.g. the .zzz file a mesh was baked from.
+	/// Returns nullptr if there is no up to date entry.
+	[[nodiscard]] std::unique_ptr<BakedBlob> Find(std::string_view kind,
+	                                              std::span<const std::filesystem::path> sources) const;
+	/// Failures are only logged, the asset is then baked again on the next start
+	void Store(std::string_view kind, std::span<const std::filesystem::path> sources, std::span<const uint8_t> data) const;
+
+	[[nodiscard]] const std::filesystem::path& GetDirectory() const { return _directory; }
+	[[nodiscard]] bool IsRebuilding() const { return _rebuild; }
+
+private:
+	[[nodiscard]] std::filesystem::path GetEntryPath(std::string_view kind,
+	                                                 std::span<const std::filesystem::path> sources) const;
+	/// Empty if a source can not be found on disk, e.g. an Android asset
+	[[nodiscard]] static std::optional<uint64_t> GetStamp(std::string_view kind,
+	                                                      std::span<const std::filesystem::path> sources);
+
+	std::filesystem::path _directory;
+	bool _rebuild;
+	mutable std::atomic<uint32_t> _temporaryCount {0};
+};
+
+} // namespace openblack::resources
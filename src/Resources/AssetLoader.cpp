@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "AssetLoader.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+using namespace openblack;
+using namespace openblack::resources;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/// Run func and log whatever it throws, returns false if it threw
+template <typename Func>
+bool RunLogged(std::string_view category, Func&& func)
+{
+	try
+	{
+		func();
+		return true;
+	}
+	catch (const std::exception& err)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to load {}: {}", category, err.what());
+	}
+	catch (...)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to load {}: unknown error", category);
+	}
+	return false;
+}
+} // namespace
+
+AssetLoader::AssetLoader(JobSystem& jobSystem)
+    : _jobSystem(jobSystem)
+    , _start(Clock::now())
+{
+}
+
+AssetLoader::~AssetLoader()
+{
+	// Scheduled jobs reference their task, they have to be done before it goes away
+	for (auto& task : _tasks)
+	{
+		try
+		{
+			_jobSystem.Wait(task->counter);
+		}
+		catch (...)
+		{
+			// Run was never called, nothing left to report to
+		}
+	}
+}
+
+void AssetLoader::Add(std::string_view category, Parse parse, bool required)
+{
+	auto categoryIt = std::ranges::find(_categories, category, &Category::name);
+	if (categoryIt == _categories.end())
+	{
+		_categories.push_back({std::string(category)});
+		categoryIt = std::prev(_categories.end());
+	}
+
+	auto& task = *_tasks.emplace_back(std::make_unique<Task>());
+	task.category = static_cast<size_t>(std::distance(_categories.begin(), categoryIt));
+	task.required = required;
+	task.parse = std::move(parse);
+	_jobSystem.Schedule(
+	    [&task]() {
+		    const auto start = Clock::now();
+		    task.finish = task.parse();
+		    task.parseDuration = Clock::now() - start;
+	    },
+	    task.counter);
+}
+
+bool AssetLoader::Run()
+{
+	bool result = true;
+
+	// Finish steps may add tasks, so no iterators
+	for (size_t i = 0; i < _tasks.size(); ++i)
+	{
+		auto& task = *_tasks[i];
+		// Finish steps may also add categories, so no references either
+		const auto categoryName = _categories[task.category].name;
+
+		auto succeeded = RunLogged(categoryName, [this, &task]() { _jobSystem.Wait(task.counter); });
+		const bool hasFinish = succeeded && task.finish;
+		Duration finishDuration {};
+		if (hasFinish)
+		{
+			const auto finishStart = Clock::now();
+			succeeded = RunLogged(categoryName, task.finish);
+			finishDuration = Clock::now() - finishStart;
+		}
+
+		auto& category = _categories[task.category];
+		category.parseDuration += task.parseDuration;
+		category.finishDuration += finishDuration;
+		if (!succeeded)
+		{
+			++category.failedCount;
+			result = result && !task.required;
+		}
+		else if (hasFinish)
+		{
+			++category.loadedCount;
+		}
+		task.parse = nullptr;
+		task.finish = nullptr;
+	}
+
+	for (const auto& category : _categories)
+	{
+		SPDLOG_LOGGER_INFO(spdlog::get("game"),
+		                   "Loaded {} {} ({} failed): {:.1f} ms reading and parsing, {:.1f} ms creating resources",
+		                   category.loadedCount, category.name, category.failedCount,
+		                   category.parseDuration.count(), category.finishDuration.count());
+	}
+	SPDLOG_LOGGER_INFO(spdlog::get("game"), "Loaded assets in {:.1f} ms on {} threads",
+	                   Duration(Clock::now() - _start).count(), _jobSystem.GetConcurrency());
+
+	_tasks.clear();
+	_categories.clear();
+	return result;
+}
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Jobs/JobSystem.h"
+
+namespace openblack::resources
+{
+
+/// Loads assets in two steps. Reading and parsing runs on the \ref JobSystem as soon as a task is added and returns a
+/// finish step which creates the bgfx resources and fills the resource caches. Finish steps run on the main thread in
+/// the order their tasks were added so the result does not depend on which parse step completes first.
+class AssetLoader
+{
+public:
+	/// Runs on the main thread, may add more tasks which then run after all the ones already added
+	using Finish = std::function<void()>;
+	/// Runs on any thread so it must not create graphics resources nor touch the resource caches.
+	/// Returns an empty function when there is nothing to load.
+	using Parse = std::function<Finish()>;
+
+	explicit AssetLoader(JobSystem& jobSystem);
+	AssetLoader(const AssetLoader&) = delete;
+	AssetLoader& operator=(const AssetLoader&) = delete;
+	AssetLoader(AssetLoader&&) = delete;
+	AssetLoader& operator=(AssetLoader&&) = delete;
+	~AssetLoader();
+
+	/// Schedule the parse step of a task. Timings are logged per category.
+	/// When a required task fails \ref Run returns false, other failures are only logged.
+	void Add(std::string_view category, Parse parse, bool required = false);
+
+	/// Wait for every task and run their finish steps, then log the timings. Must be called from the main thread.
+	bool Run();
+
+private:
+	using Duration = std::chrono::duration<double, std::milli>;
+
+	struct Task
+	{
+		size_t category;
+		bool required;
+		Parse parse;
+		Finish finish;
+		Duration parseDuration {};
+		JobSystem::Counter counter;
+	};
+
+	struct Category
+	{
+		std::string name;
+		size_t loadedCount {0};
+		size_t failedCount {0};
+		Duration parseDuration {};
+		Duration finishDuration {};
+	};
+
+	JobSystem& _jobSystem;
+	std::chrono::steady_clock::time_point _start;
+	std::vector<std::unique_ptr<Task>> _tasks;
+	std::vector<Category> _categories;
+};
+
+} // namespace openblack::resources
@@ -9,29 +9,36 @@
 
 #include "Resources/Loaders.h"
 
+#include <array>
 #include <iostream>
 #include <ranges>
 #include <utility>
 
 #include <GLWFile.h>
+#include <L3DFile.h>
 #include <PackFile.h>
 #include <spdlog/spdlog.h>
 
 #include "3D/L3DMesh.h"
+#include "3D/L3DSubMesh.h"
 #include "3D/Light.h"
 #include "Audio/AudioManagerInterface.h"
 #include "Common/StringUtils.h"
 #include "Common/Zip.h"
 #include "FileSystem/FileSystemInterface.h"
+#include "Graphics/IndexBuffer.h"
+#include "Graphics/Mesh.h"
 #include "Graphics/Texture2D.h"
+#include "Graphics/VertexBuffer.h"
 #include "Locator.h"
+#include "Resources/AssetCache.h"
 
 using namespace openblack;
 using namespace openblack::filesystem;
 using namespace openblack::resources;
 
 L3DLoader::result_type L3DLoader::operator()(FromBufferTag, const std::string& debugName,
-                                             const std::vector<uint8_t>& data) const
+                                             std::span<const uint8_t> data) const
 {
 	auto mesh = std::make_shared<graphics::L3DMesh>(debugName);
 	if (!mesh->LoadFromBuffer(data))
@@ -42,17 +49,21 @@ L3DLoader::result_type L3DLoader::operator()(FromBufferTag, const std::string& d
 	return mesh;
 }
 
-L3DLoader::result_type L3DLoader::operator()(FromDiskTag, const std::filesystem::path& path) const
+L3DLoader::result_type L3DLoader::operator()(FromPackTag, const std::string& debugName,
+                                             const std::shared_ptr<const pack::PackFile>& pack, size_t index) const
+{
+	return (*this)(FromBufferTag {}, debugName, pack->GetMeshes().at(index));
+}
+
+std::unique_ptr<l3d::L3DFile> L3DLoader::Parse(const std::filesystem::path& path)
 {
-	auto mesh = std::make_shared<graphics::L3DMesh>(path.stem().string());
+	auto l3d = std::make_unique<l3d::L3DFile>();
 	auto pathExt = string_utils::LowerCase(path.extension().string());
+	l3d::L3DResult result;
 
 	if (pathExt == ".l3d")
 	{
-		if (!mesh->LoadFromFilesystem(path))
-		{
-			throw std::runtime_error("Unable to load mesh");
-		}
+		result = l3d->Open(Locator::filesystem::value().ReadAll(path));
 	}
 	else if (pathExt == ".zzz")
 	{
@@ -61,16 +72,96 @@ L3DLoader::result_type L3DLoader::operator()(FromDiskTag, const std::filesystem:
 		stream->Read(&decompressedSize);
 		auto buffer = std::vector<uint8_t>(stream->Size() - sizeof(decompressedSize));
 		stream->Read(buffer.data(), buffer.size());
-		auto decompressedBuffer = zip::Inflate(buffer, decompressedSize);
-		if (!mesh->LoadFromBuffer(decompressedBuffer))
-		{
-			throw std::runtime_error("Unable to load decompressed mesh");
-		}
+		result = l3d->Open(zip::Inflate(buffer, decompressedSize));
+	}
+	else
+	{
+		throw std::runtime_error("Unsupported mesh extension: " + path.generic_string());
+	}
+
+	if (result != l3d::L3DResult::Success)
+	{
+		throw std::runtime_error(fmt::format("Unable to load mesh {}: {}", path.generic_string(), l3d::ResultToStr(result)));
+	}
+
+	return l3d;
+}
+
+std::unique_ptr<BakedBlob> L3DLoader::FindBaked(const std::filesystem::path& path)
+{
+	if (!Locator::assetCache::has_value())
+	{
+		return nullptr;
+	}
+	const std::array sources {path};
+	return Locator::assetCache::value().Find("mesh", sources);
+}
+
+void L3DLoader::StoreBaked(const std::filesystem::path& path, const l3d::L3DFile& l3d)
+{
+	if (!Locator::assetCache::has_value())
+	{
+		return;
+	}
+	const std::array sources {path};
+	Locator::assetCache::value().Store("mesh", sources, graphics::L3DMesh::Bake(l3d));
+}
+
+L3DLoader::result_type L3DLoader::operator()(FromParsedTag, const std::string& debugName, const l3d::L3DFile& l3d) const
+{
+	auto mesh = std::make_shared<graphics::L3DMesh>(debugName);
+	if (!mesh->Load(l3d))
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Some issues were seen while loading l3d mesh {}.", debugName);
 	}
 
 	return mesh;
 }
 
+L3DLoader::result_type L3DLoader::operator()(FromBakedTag, const std::string& debugName, const BakedBlob& baked) const
+{
+	auto mesh = std::make_shared<graphics::L3DMesh>(debugName);
+	if (!mesh->LoadBaked(baked.GetData()))
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Some issues were seen while loading l3d mesh {}.", debugName);
+	}
+
+	return mesh;
+}
+
+L3DLoader::result_type L3DLoader::operator()(FromDiskTag, const std::filesystem::path& path) const
+{
+	if (const auto baked = FindBaked(path))
+	{
+		return (*this)(FromBakedTag {}, path.stem().string(), *baked);
+	}
+	const auto l3d = Parse(path);
+	StoreBaked(path, *l3d);
+	return (*this)(FromParsedTag {}, path.stem().string(), *l3d);
+}
+
+size_t L3DLoader::GetSizeInBytes(const graphics::L3DMesh& mesh)
+{
+	const auto meshSize = [](const graphics::Mesh& gpuMesh) -> size_t {
+		return gpuMesh.GetVertexBuffer().GetSizeInBytes() + (gpuMesh.IsIndexed() ? gpuMesh.GetIndexBuffer().GetSize() : 0);
+	};
+
+	size_t size = sizeof(mesh);
+	for (const auto& subMesh : mesh.GetSubMeshes())
+	{
+		size += meshSize(subMesh->GetMesh());
+	}
+	for (const auto& [id, skin] : mesh.GetSkins())
+	{
+		size += skin->GetSizeInBytes();
+	}
+	for (const auto& footprint : mesh.GetFootprints())
+	{
+		size += footprint.texture->GetSizeInBytes() + meshSize(*footprint.mesh);
+	}
+	return size;
+}
+
 Texture2DLoader::result_type Texture2DLoader::operator()(FromPackTag, const std::string& name,
                                                          const pack::G3DTexture& g3dTexture) const
 {
@@ -104,12 +195,18 @@ Texture2DLoader::result_type Texture2DLoader::operator()(FromPackTag, const std:
 	return texture2D;
 }
 
-Texture2DLoader::result_type Texture2DLoader::operator()(FromDiskTag, const std::filesystem::path& rawTexturePath) const
+Texture2DLoader::result_type Texture2DLoader::operator()(FromPackTag, const std::shared_ptr<const pack::PackFile>& pack,
+                                                         const std::string& name) const
+{
+	return (*this)(FromPackTag {}, name, pack->GetTextures().at(name));
+}
+
+Texture2DLoader::result_type Texture2DLoader::operator()(FromBufferTag, const std::string& name,
+                                                         const std::vector<uint8_t>& data) const
 {
 	bool found = false;
 	const std::array<uint16_t, 12> resolutions = {{1024, 512, 256, 128, 64, 40, 32, 14, 12, 6}};
 
-	const auto data = Locator::filesystem::value().ReadAll(rawTexturePath);
 	graphics::Format format = graphics::Format::R8;
 	uint16_t width = 0;
 	uint16_t height = 0;
@@ -141,20 +238,37 @@ Texture2DLoader::result_type Texture2DLoader::operator()(FromDiskTag, const std:
 		throw std::runtime_error("Unable to load texture: Ambiguous size and format: " + std::to_string(data.size()));
 	}
 
-	auto texture = std::make_shared<graphics::Texture2D>(("raw" / rawTexturePath.stem()).string());
+	auto texture = std::make_shared<graphics::Texture2D>(name);
 	texture->Create(width, height, 1, format, graphics::Wrapping::Repeat, graphics::Filter::Linear, data.data(),
 	                static_cast<uint32_t>(data.size()));
 
 	return texture;
 }
 
-L3DAnimLoader::result_type L3DAnimLoader::operator()(FromBufferTag, const std::vector<uint8_t>& data) const
+Texture2DLoader::result_type Texture2DLoader::operator()(FromDiskTag, const std::filesystem::path& rawTexturePath) const
+{
+	return (*this)(FromBufferTag {}, ("raw" / rawTexturePath.stem()).string(),
+	               Locator::filesystem::value().ReadAll(rawTexturePath));
+}
+
+size_t Texture2DLoader::GetSizeInBytes(const graphics::Texture2D& texture)
+{
+	return sizeof(texture) + texture.GetSizeInBytes();
+}
+
+L3DAnimLoader::result_type L3DAnimLoader::operator()(FromBufferTag, std::span<const uint8_t> data) const
 {
 	auto animation = std::make_shared<L3DAnim>();
 	animation->LoadFromBuffer(data);
 	return animation;
 }
 
+L3DAnimLoader::result_type L3DAnimLoader::operator()(FromPackTag, const std::shared_ptr<const pack::PackFile>& pack,
+                                                     size_t index) const
+{
+	return (*this)(FromBufferTag {}, pack->GetAnimations().at(index));
+}
+
 L3DAnimLoader::result_type L3DAnimLoader::operator()(FromDiskTag, const std::filesystem::path& path) const
 {
 	auto animation = std::make_shared<L3DAnim>();
@@ -167,6 +281,11 @@ L3DAnimLoader::result_type L3DAnimLoader::operator()(FromDiskTag, const std::fil
 	return animation;
 }
 
+size_t L3DAnimLoader::GetSizeInBytes(const L3DAnim& animation)
+{
+	return animation.GetSizeInBytes();
+}
+
 LevelLoader::result_type LevelLoader::operator()(FromDiskTag, const std::filesystem::path& path, Level::LandType landType) const
 {
 	return std::make_shared<Level>(Level::ParseLevel(path, landType));
@@ -179,7 +298,7 @@ CreatureMindLoader::result_type CreatureMindLoader::operator()(FromDiskTag, cons
 
 SoundLoader::result_type SoundLoader::operator()(BaseLoader<audio::Sound>::FromBufferTag,
                                                  const pack::AudioBankSampleHeader& header,
-                                                 const std::vector<std::vector<uint8_t>>& buffer) const
+                                                 std::span<const std::span<const uint8_t>> buffer) const
 {
 	auto sound = std::make_shared<audio::Sound>();
 	// Let's clean up the names as they're very difficult to read from the debug GUI
@@ -192,10 +311,35 @@ SoundLoader::result_type SoundLoader::operator()(BaseLoader<audio::Sound>::FromB
 	sound->pitch = header.pitch;
 	sound->pitchDeviation = header.pitchDeviation;
 	sound->playType = static_cast<audio::PlayType>(header.loopType);
-	sound->buffer = buffer;
+	// Decoded into an OpenAL buffer on first use, see AudioManager::CreateEmitter
+	sound->bufferId = 0;
+	sound->duration = 0.0f;
+	sound->sizeInBytes = 0;
+	sound->buffer.reserve(buffer.size());
+	for (const auto& chunk : buffer)
+	{
+		sound->buffer.emplace_back(chunk.begin(), chunk.end());
+	}
 	return sound;
 }
 
+SoundLoader::result_type SoundLoader::operator()(BaseLoader<audio::Sound>::FromPackTag,
+                                                 const std::shared_ptr<const pack::PackFile>& pack, size_t index) const
+{
+	const std::array<std::span<const uint8_t>, 1> buffer = {pack->GetAudioSamplesData().at(index)};
+	return (*this)(FromBufferTag {}, pack->GetAudioSampleHeaders().at(index), buffer);
+}
+
+size_t SoundLoader::GetSizeInBytes(const audio::Sound& sound)
+{
+	size_t size = sizeof(sound);
+	for (const auto& buffer : sound.buffer)
+	{
+		size += buffer.size();
+	}
+	return size;
+}
+
 LightLoader::result_type LightLoader::operator()(BaseLoader<Lights>::FromDiskTag, const std::filesystem::path& path) const
 {
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading lights from file: {}", path.string());
@@ -9,7 +9,9 @@
 
 #pragma once
 
+#include <memory>
 #include <queue>
+#include <span>
 
 #include <PackFile.h>
 
@@ -25,6 +27,11 @@ class L3DMesh;
 class Texture2D;
 } // namespace openblack::graphics
 
+namespace openblack::l3d
+{
+class L3DFile;
+} // namespace openblack::l3d
+
 namespace openblack::pack
 {
 struct AudioBankSampleHeader;
@@ -33,60 +40,121 @@ struct G3DTexture;
 
 namespace openblack::resources
 {
+class BakedBlob;
 
 template <typename Resource>
 struct BaseLoader
 {
 	using result_type = std::shared_ptr<Resource>;
 	using ResourceType = Resource;
+	/// Loaders which do not create graphics resources can run on any thread
+	static constexpr bool k_ThreadSafe = false;
+
 	struct FromBufferTag
 	{
 	};
 	struct FromDiskTag
 	{
 	};
+	struct FromPackTag
+	{
+	};
+	/// For resources created ahead of time, e.g. on a worker thread
+	struct FromResourceTag
+	{
+	};
+
+	[[nodiscard]] result_type operator()(FromResourceTag, result_type resource) const { return resource; }
+
+	/// Memory kept by a loaded resource, counted against the budget of its \ref ResourceManager
+	[[nodiscard]] static size_t GetSizeInBytes(const Resource& /*unused*/) { return sizeof(Resource); }
 };
 
 struct L3DLoader final: BaseLoader<graphics::L3DMesh>
 {
-	[[nodiscard]] result_type operator()(FromBufferTag, const std::string& debugName, const std::vector<uint8_t>& data) const;
+	using BaseLoader::operator();
+
+	struct FromParsedTag
+	{
+	};
+	struct FromBakedTag
+	{
+	};
+
+	/// Read a .l3d or .zzz file without creating any graphics resources so it can run on any thread
+	[[nodiscard]] static std::unique_ptr<l3d::L3DFile> Parse(const std::filesystem::path& path);
+	/// Returns nullptr if there is no \ref AssetCache or no up to date entry of the mesh in it
+	[[nodiscard]] static std::unique_ptr<BakedBlob> FindBaked(const std::filesystem::path& path);
+	/// Bake a parsed mesh into the \ref AssetCache for the next start, does nothing if there is no cache
+	static void StoreBaked(const std::filesystem::path& path, const l3d::L3DFile& l3d);
+	[[nodiscard]] static size_t GetSizeInBytes(const graphics::L3DMesh& mesh);
+
+	[[nodiscard]] result_type operator()(FromParsedTag, const std::string& debugName, const l3d::L3DFile& l3d) const;
+	[[nodiscard]] result_type operator()(FromBakedTag, const std::string& debugName, const BakedBlob& baked) const;
+	[[nodiscard]] result_type operator()(FromBufferTag, const std::string& debugName, std::span<const uint8_t> data) const;
+	[[nodiscard]] result_type operator()(FromPackTag, const std::string& debugName,
+	                                     const std::shared_ptr<const pack::PackFile>& pack, size_t index) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& path) const;
 };
 
 struct Texture2DLoader final: BaseLoader<graphics::Texture2D>
 {
-	struct FromPackTag
-	{
-	};
+	using BaseLoader::operator();
+
+	[[nodiscard]] static size_t GetSizeInBytes(const graphics::Texture2D& texture);
 
 	[[nodiscard]] result_type operator()(FromPackTag, const std::string& name, const pack::G3DTexture& g3dTexture) const;
+	[[nodiscard]] result_type operator()(FromPackTag, const std::shared_ptr<const pack::PackFile>& pack,
+	                                     const std::string& name) const;
+	[[nodiscard]] result_type operator()(FromBufferTag, const std::string& name, const std::vector<uint8_t>& rawData) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& rawTexturePath) const;
 };
 
 struct L3DAnimLoader final: BaseLoader<L3DAnim>
 {
-	[[nodiscard]] result_type operator()(FromBufferTag, const std::vector<uint8_t>& data) const;
+	using BaseLoader::operator();
+	static constexpr bool k_ThreadSafe = true;
+
+	[[nodiscard]] static size_t GetSizeInBytes(const L3DAnim& animation);
+
+	[[nodiscard]] result_type operator()(FromBufferTag, std::span<const uint8_t> data) const;
+	[[nodiscard]] result_type operator()(FromPackTag, const std::shared_ptr<const pack::PackFile>& pack, size_t index) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& path) const;
 };
 
 struct LevelLoader final: BaseLoader<Level>
 {
+	using BaseLoader::operator();
+	static constexpr bool k_ThreadSafe = true;
+
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& path, Level::LandType landType) const;
 };
 
 struct CreatureMindLoader final: BaseLoader<creature::CreatureMind>
 {
+	using BaseLoader::operator();
+	static constexpr bool k_ThreadSafe = true;
+
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& creatureMindPath) const;
 };
 
 struct SoundLoader final: BaseLoader<audio::Sound>
 {
+	using BaseLoader::operator();
+	static constexpr bool k_ThreadSafe = true;
+
+	[[nodiscard]] static size_t GetSizeInBytes(const audio::Sound& sound);
+
 	[[nodiscard]] result_type operator()(FromBufferTag, const pack::AudioBankSampleHeader& header,
-	                                     const std::vector<std::vector<uint8_t>>& buffer) const;
+	                                     std::span<const std::span<const uint8_t>> buffer) const;
+	[[nodiscard]] result_type operator()(FromPackTag, const std::shared_ptr<const pack::PackFile>& pack, size_t index) const;
 };
 
 struct LightLoader final: BaseLoader<Lights>
 {
+	using BaseLoader::operator();
+	static constexpr bool k_ThreadSafe = true;
+
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& path) const;
 };
 } // namespace openblack::resources
@@ -31,4 +31,10 @@ inline entt::id_type MeshIdToResourceId(openblack::MeshId id)
 	return entt::hashed_string(fmt::format("{}", id).c_str());
 }
 
+/// Animations of AllAnims.anm are registered by their index in the pack
+inline entt::id_type AnimIdToResourceId(openblack::AnimId id)
+{
+	return entt::hashed_string(fmt::format("{}", static_cast<int>(id)).c_str());
+}
+
 } // namespace openblack::resources
@@ -9,30 +9,89 @@
 
 #pragma once
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <entt/core/hashed_string.hpp>
 #include <entt/fwd.hpp>
 #include <entt/resource/cache.hpp>
 #include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "Jobs/JobSystem.h"
+#include "Locator.h"
 
 namespace openblack::resources
 {
 
+/// Resources are either loaded right away with \ref Load or registered with \ref Register and loaded on their first
+/// \ref Handle. Registered resources which were not used recently are evicted by \ref Update once the resident bytes go
+/// over the memory budget, they are loaded again on their next use.
 template <typename ResourceLoader>
 class ResourceManager
 {
 public:
 	using ResourceType = typename ResourceLoader::ResourceType;
+	using ResultType = typename ResourceLoader::result_type;
+
+	ResourceManager() = default;
+	ResourceManager(const ResourceManager&) = delete;
+	ResourceManager& operator=(const ResourceManager&) = delete;
+	ResourceManager(ResourceManager&&) = delete;
+	ResourceManager& operator=(ResourceManager&&) = delete;
+	~ResourceManager() { Clear(); }
 
 	template <typename... Args>
 	[[maybe_unused]] decltype(auto) Load(entt::id_type identifier, Args&&... args)
 	{
-		return _resourceCache.load(identifier, std::forward<Args>(args)...);
+		const std::unique_lock<std::shared_mutex> lock(_mutex);
+		auto result = _resourceCache.load(identifier, std::forward<Args>(args)...);
+		if (result.second)
+		{
+			Track(_entries[identifier], *_resourceCache[identifier]);
+		}
+		return result;
 	}
 
+	/// Remember how to load a resource without loading it, arguments are the same as for \ref Load
 	template <typename... Args>
-	[[maybe_unused]] decltype(auto) Erase(entt::id_type identifier, Args&&... args)
+	void Register(entt::id_type identifier, Args&&... args)
+	{
+		AddSource(identifier, false, MakeSource(std::forward<Args>(args)...));
+	}
+
+	/// Like \ref Register but the resource is loaded on the \ref JobSystem.
+	/// Until it is ready \ref Handle returns the placeholder, see \ref SetPlaceholder.
+	template <typename... Args>
+	void RegisterAsync(entt::id_type identifier, Args&&... args)
+	{
+		static_assert(ResourceLoader::k_ThreadSafe, "Resources creating graphics resources can only be loaded synchronously");
+		AddSource(identifier, true, MakeSource(std::forward<Args>(args)...));
+	}
+
+	void Erase(entt::id_type identifier)
 	{
-		return _resourceCache.erase(identifier, std::forward<Args>(args)...);
+		const std::unique_lock<std::shared_mutex> lock(_mutex);
+		const auto entry = _entries.find(identifier);
+		if (entry != _entries.end())
+		{
+			WaitPending(entry->second);
+			Evict(identifier, entry->second);
+			_entries.erase(entry);
+		}
 	}
 
 	template <typename T, typename... Args>
@@ -43,17 +102,40 @@ class ResourceManager
 	}
 
 	template <typename T, typename... Args>
-	[[maybe_unused]] decltype(auto) Erase(T identifier, Args&&... args)
+	void Register(T identifier, Args&&... args)
 	{
 		entt::id_type id = entt::hashed_string(fmt::format("{}", identifier).c_str());
-		return Erase(id, std::forward<Args>(args)...);
+		Register(id, std::forward<Args>(args)...);
 	}
 
-	[[nodiscard]] decltype(auto) Handle(entt::id_type identifier) { return _resourceCache[identifier]; }
+	template <typename T, typename... Args>
+	void RegisterAsync(T identifier, Args&&... args)
+	{
+		entt::id_type id = entt::hashed_string(fmt::format("{}", identifier).c_str());
+		RegisterAsync(id, std::forward<Args>(args)...);
+	}
 
-	[[nodiscard]] decltype(auto) Handle(entt::id_type identifier) const { return _resourceCache[identifier]; }
+	template <typename T>
+	void Erase(T identifier)
+	{
+		entt::id_type id = entt::hashed_string(fmt::format("{}", identifier).c_str());
+		Erase(id);
+	}
+
+	/// Loads registered resources which are not resident. Returns an empty handle for unknown resources.
+	[[nodiscard]] entt::resource<ResourceType> Handle(entt::id_type identifier) { return Materialise(identifier); }
+
+	[[nodiscard]] entt::resource<const ResourceType> Handle(entt::id_type identifier) const
+	{
+		return Materialise(identifier);
+	}
 
-	[[nodiscard]] bool Contains(entt::id_type identifier) const { return _resourceCache.contains(identifier); }
+	/// True for resident and registered resources
+	[[nodiscard]] bool Contains(entt::id_type identifier) const
+	{
+		const std::shared_lock<std::shared_mutex> lock(_mutex);
+		return _entries.contains(identifier);
+	}
 
 	template <typename T>
 	[[nodiscard]] bool Contains(T identifier) const
@@ -62,10 +144,17 @@ class ResourceManager
 		return Contains(id);
 	}
 
+	[[nodiscard]] bool IsResident(entt::id_type identifier) const
+	{
+		const std::shared_lock<std::shared_mutex> lock(_mutex);
+		return _resourceCache.contains(identifier);
+	}
+
+	/// Only visits resident resources
 	template <typename Func>
 	void Each(Func func) const
 	{
-		for (const auto [i, r] : _resourceCache)
+		for (const auto [i, r] : std::as_const(_resourceCache))
 		{
 			func(i, r);
 		}
@@ -76,11 +165,231 @@ class ResourceManager
 		return static_cast<entt::resource_cache<ResourceType>&>(_resourceCache);
 	}
 
+	/// Number of resident resources
 	[[nodiscard]] decltype(auto) Size() const { return _resourceCache.size(); }
+	/// Number of resident and registered resources
+	[[nodiscard]] size_t GetRegisteredCount() const { return _entries.size(); }
+	[[nodiscard]] size_t GetResidentBytes() const { return _residentBytes; }
+
+	[[nodiscard]] size_t GetMemoryBudget() const { return _memoryBudget; }
+	/// 0 to never evict
+	void SetMemoryBudget(size_t bytes) { _memoryBudget = bytes; }
+
+	/// Returned by \ref Handle while an asynchronous load is in flight or after it failed
+	void SetPlaceholder(ResultType placeholder) { _placeholder = std::move(placeholder); }
+
+	/// Called once per frame from the main thread. Inserts finished asynchronous loads then evicts the least recently used
+	/// registered resources until the resident bytes fit in the budget. Resources used in the last frame are kept, and so
+	/// are resources still referenced by a handle, such as components keeping their mesh or texture alive.
+	void Update(uint32_t frame)
+	{
+		const std::unique_lock<std::shared_mutex> lock(_mutex);
+		_frame.store(frame, std::memory_order_relaxed);
+
+		for (auto& [id, entry] : _entries)
+		{
+			if (entry.pending && entry.pending->Done())
+			{
+				FinishPending(id, entry);
+			}
+		}
 
-	void Clear() { _resourceCache.clear(); }
+		if (_memoryBudget == 0 || _residentBytes <= _memoryBudget)
+		{
+			return;
+		}
+
+		std::vector<std::pair<uint32_t, entt::id_type>> candidates;
+		for (const auto& [id, entry] : _entries)
+		{
+			const auto lastUsedFrame = entry.lastUsedFrame.load(std::memory_order_relaxed);
+			if (entry.source && lastUsedFrame + 1 < frame && _resourceCache.contains(id) && !IsReferenced(id))
+			{
+				candidates.emplace_back(lastUsedFrame, id);
+			}
+		}
+		std::ranges::sort(candidates);
+		for (const auto& [lastUsedFrame, id] : candidates)
+		{
+			if (_residentBytes <= _memoryBudget)
+			{
+				break;
+			}
+			Evict(id, _entries.at(id));
+		}
+	}
+
+	void Clear()
+	{
+		const std::unique_lock<std::shared_mutex> lock(_mutex);
+		for (auto& [id, entry] : _entries)
+		{
+			WaitPending(entry);
+		}
+		_entries.clear();
+		_resourceCache.clear();
+		_residentBytes = 0;
+	}
 
 private:
-	entt::resource_cache<ResourceType, ResourceLoader> _resourceCache;
+	using Source = std::function<ResultType()>;
+
+	struct Entry
+	{
+		/// Empty for resources which can not be loaded again
+		Source source;
+		bool async {false};
+		size_t sizeInBytes {0};
+		std::atomic<uint32_t> lastUsedFrame {0};
+		std::unique_ptr<JobSystem::Counter> pending;
+		std::shared_ptr<ResultType> pendingResult;
+	};
+
+	template <typename... Args>
+	static Source MakeSource(Args&&... args)
+	{
+		return [arguments = std::make_tuple(std::forward<Args>(args)...)]() {
+			return std::apply(ResourceLoader {}, arguments);
+		};
+	}
+
+	void AddSource(entt::id_type identifier, bool async, Source&& source)
+	{
+		const std::unique_lock<std::shared_mutex> lock(_mutex);
+		auto& entry = _entries[identifier];
+		WaitPending(entry);
+		entry.source = std::move(source);
+		entry.async = async;
+	}
+
+	entt::resource<ResourceType> Materialise(entt::id_type identifier) const
+	{
+		{
+			const std::shared_lock<std::shared_mutex> lock(_mutex);
+			const auto entry = _entries.find(identifier);
+			if (entry == _entries.end())
+			{
+				return {};
+			}
+			entry->second.lastUsedFrame.store(_frame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			if (_resourceCache.contains(identifier))
+			{
+				return _resourceCache[identifier];
+			}
+		}
+
+		std::unique_lock<std::shared_mutex> lock(_mutex);
+		const auto found = _entries.find(identifier);
+		if (found == _entries.end())
+		{
+			return {};
+		}
+		auto& entry = found->second;
+		if (_resourceCache.contains(identifier))
+		{
+			return _resourceCache[identifier];
+		}
+		if (entry.async || !entry.source)
+		{
+			if (entry.source && !entry.pending)
+			{
+				entry.pending = std::make_unique<JobSystem::Counter>();
+				entry.pendingResult = std::make_shared<ResultType>();
+				Locator::jobSystem::value().Schedule(
+				    [source = entry.source, result = entry.pendingResult]() { *result = source(); }, *entry.pending);
+			}
+			return entt::resource<ResourceType>(_placeholder);
+		}
+
+		assert((ResourceLoader::k_ThreadSafe || JobSystem::GetCurrentThreadIndex() == 0) &&
+		       "Graphics resources can only be loaded from the main thread");
+		auto source = entry.source;
+		lock.unlock();
+
+		// Loading can take long, other resources stay available meanwhile. If two threads load the same resource the
+		// first one to finish is kept.
+		auto resource = source();
+
+		lock.lock();
+		const auto loaded = _entries.find(identifier);
+		if (loaded == _entries.end())
+		{
+			return {};
+		}
+		if (!_resourceCache.contains(identifier))
+		{
+			_resourceCache.load(identifier, typename ResourceLoader::FromResourceTag {}, std::move(resource));
+			Track(loaded->second, *_resourceCache[identifier]);
+		}
+		return _resourceCache[identifier];
+	}
+
+	void Track(Entry& entry, const ResourceType& resource) const
+	{
+		entry.sizeInBytes = ResourceLoader::GetSizeInBytes(resource);
+		entry.lastUsedFrame.store(_frame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		_residentBytes += entry.sizeInBytes;
+	}
+
+	/// True if a handle outside of the cache still points to the resource
+	[[nodiscard]] bool IsReferenced(entt::id_type identifier) const
+	{
+		// Held by the cache and by this copy
+		const auto resource = _resourceCache[identifier];
+		return resource.handle().use_count() > 2;
+	}
+
+	void Evict(entt::id_type identifier, Entry& entry)
+	{
+		if (_resourceCache.erase(identifier) != 0)
+		{
+			_residentBytes -= entry.sizeInBytes;
+			entry.sizeInBytes = 0;
+		}
+	}
+
+	void FinishPending(entt::id_type identifier, Entry& entry)
+	{
+		try
+		{
+			Locator::jobSystem::value().Wait(*entry.pending);
+			_resourceCache.load(identifier, typename ResourceLoader::FromResourceTag {}, std::move(*entry.pendingResult));
+			Track(entry, *_resourceCache[identifier]);
+		}
+		catch (const std::exception& err)
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to load resource {}: {}", identifier, err.what());
+			// Keep returning the placeholder instead of failing every frame
+			entry.source = nullptr;
+		}
+		entry.pending.reset();
+		entry.pendingResult.reset();
+	}
+
+	void WaitPending(Entry& entry)
+	{
+		if (entry.pending && Locator::jobSystem::has_value())
+		{
+			try
+			{
+				Locator::jobSystem::value().Wait(*entry.pending);
+			}
+			catch (...)
+			{
+				// Dropped with the entry
+			}
+		}
+		entry.pending.reset();
+		entry.pendingResult.reset();
+	}
+
+	// Loading on first use is logically const
+	mutable std::shared_mutex _mutex;
+	mutable entt::resource_cache<ResourceType, ResourceLoader> _resourceCache;
+	mutable std::unordered_map<entt::id_type, Entry> _entries;
+	mutable size_t _residentBytes {0};
+	size_t _memoryBudget {0};
+	std::atomic<uint32_t> _frame {0};
+	ResultType _placeholder;
 };
 } // namespace openblack::resources
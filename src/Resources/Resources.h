@@ -28,6 +28,17 @@ class Resources final: public ResourcesInterface
 	SoundManager& GetSounds() override { return _sounds; }
 	GlowManager& GetGlows() override { return _glows; }
 
+	void Update(uint32_t frame) override
+	{
+		_meshes.Update(frame);
+		_textures.Update(frame);
+		_animations.Update(frame);
+		_levels.Update(frame);
+		_creatureMinds.Update(frame);
+		_sounds.Update(frame);
+		_glows.Update(frame);
+	}
+
 private:
 	MeshManager _meshes;
 	TextureManager _textures;
@@ -32,6 +32,9 @@ class ResourcesInterface
 	virtual CreatureMindManager& GetCreatureMinds() = 0;
 	virtual SoundManager& GetSounds() = 0;
 	virtual GlowManager& GetGlows() = 0;
+
+	/// Called once per frame, see \ref ResourceManager::Update
+	virtual void Update(uint32_t frame) = 0;
 };
 
 } // namespace openblack::resources
@@ -53,6 +53,10 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 		("m,window-mode", "Which mode to run window.", cxxopts::value<std::string>()->default_value("windowed"))
 		("b,backend-type", "Which backend to use for rendering.", cxxopts::value<std::string>())
 		("n,num-frames-to-simulate", "Number of frames to simulate before quitting.", cxxopts::value<uint32_t>()->default_value("0"))
+		("resource-budget", "Megabytes of meshes, textures and animations kept loaded, 0 for no limit.", cxxopts::value<uint32_t>()->default_value("0"))
+		("asset-cache", "Directory where meshes, terrain and sky are kept ready for the GPU between runs, none if empty.", cxxopts::value<std::filesystem::path>()->default_value(""))
+		("rebuild-cache", "Bake all assets into the asset cache again, with -n 1 it prebakes the cache and quits.")
+		("watch-files", "Find game files added, removed or renamed while running (Linux only).")
 		("l,log-file", "Output file for logs, 'stdout'/'logcat' for terminal output.", cxxopts::value<std::string>()->default_value(defaultLogFile))
 		("L,log-level", "Level (trace, debug, info, warning, error, critical, off) of logging per subsystem (" + loggingSubsystems + ").",
 		    cxxopts::value<std::vector<std::string>>()->default_value("all=debug"))
@@ -190,6 +194,10 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 		args.displayMode = displayMode;
 		args.rendererType = rendererType;
 		args.numFramesToSimulate = result["num-frames-to-simulate"].as<uint32_t>();
+		args.resourceBudgetMiB = result["resource-budget"].as<uint32_t>();
+		args.assetCachePath = result["asset-cache"].as<std::filesystem::path>();
+		args.rebuildAssetCache = result["rebuild-cache"].as<bool>();
+		args.watchGameFiles = result["watch-files"].as<bool>();
 		args.logFile = result["log-file"].as<std::string>();
 		args.logLevels = logLevels;
 		args.startLevel = result["start-level"].as<std::string>();
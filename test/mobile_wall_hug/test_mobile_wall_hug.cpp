@@ -9,8 +9,12 @@
 
 #include <filesystem>
 #include <fstream>
+#include <string>
 #include <tuple>
+#include <vector>
 
+#include <3D/L3DAnim.h>
+#include <ECS/Components/Fixed.h>
 #include <ECS/Components/Transform.h>
 #include <ECS/Components/Villager.h>
 #include <ECS/Components/WallHug.h>
@@ -18,8 +22,10 @@
 #include <ECS/Registry.h>
 #include <ECS/Systems/PathfindingSystemInterface.h>
 #include <Game.h>
+#include <Jobs/JobSystem.h>
 #include <LHScriptX/Script.h>
 #include <Locator.h>
+#include <Resources/ResourcesInterface.h>
 #include <gtest/gtest.h>
 #include <json_helpers.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -347,3 +353,175 @@ TEST_F(MobileWallHugWalks, DISABLED_footpath2)
 {
 	MobileWallHugScenarioAssert();
 }
+
+/// Obstacles of the linear state are found with a ray along the step, away from any other object of the map
+class MobileWallHugLinearScan: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+	}
+
+	void TearDown() override { _game.reset(); }
+
+	static entt::entity CreateObstacle(const glm::vec2& center, float radius)
+	{
+		auto& registry = Locator::entitiesRegistry::value();
+		const auto entity = registry.Create();
+		registry.Assign<ecs::components::Transform>(entity, glm::vec3(center.x, 0.0f, center.y), glm::mat3(1.0f),
+		                                            glm::vec3(1.0f));
+		registry.Assign<ecs::components::Fixed>(entity, center, radius);
+		return entity;
+	}
+
+	/// Start walking east from k_Start with a step of k_Speed and return the obstacle found on the first turn
+	static std::optional<ecs::components::WallHugObjectReference> Scan()
+	{
+		using namespace openblack::ecs::components;
+		auto& registry = Locator::entitiesRegistry::value();
+		Locator::entitiesMap::value().Rebuild();
+
+		const auto entity = registry.Create();
+		registry.Assign<Transform>(entity, glm::vec3(k_Start.x, 0.0f, k_Start.y), glm::mat3(1.0f), glm::vec3(1.0f));
+		registry.Assign<WallHug>(entity, k_Start + glm::vec2(200.0f, 0.0f), glm::vec2(0.0f), 0.0f, k_Speed);
+		registry.Assign<MoveStateLinearTag>(entity);
+		Locator::pathfindingSystem::value().Update();
+
+		EXPECT_EQ(registry.Get<const WallHug>(entity).step, glm::vec2(k_Speed, 0.0f));
+		const auto* reference = registry.TryGet<const WallHugObjectReference>(entity);
+		return reference != nullptr ? std::make_optional(*reference) : std::nullopt;
+	}
+
+	static constexpr glm::vec2 k_Start = {1000.0f, 1000.0f};
+	static constexpr float k_Speed = 0.5f;
+	std::unique_ptr<openblack::Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(MobileWallHugLinearScan, closestObstacleAlongStep)
+{
+	CreateObstacle({985.0f, 1000.0f}, 2.0f);  // Behind
+	CreateObstacle({1005.0f, 1010.0f}, 2.0f); // Beside the path
+	CreateObstacle({1020.0f, 1000.0f}, 2.0f); // Entered after 18 units
+	// Entered after 10 - sqrt(1.25) units
+	const auto closest = CreateObstacle({1010.0f, 1001.0f}, 1.5f);
+
+	const auto reference = Scan();
+	ASSERT_TRUE(reference.has_value());
+	ASSERT_EQ(reference->entity, closest);
+	ASSERT_EQ(reference->stepsAway, 17);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(MobileWallHugLinearScan, obstacleWithinLastStep)
+{
+	const auto obstacle = CreateObstacle({1129.0f, 1000.0f}, 2.0f); // Entered after 127 units
+
+	const auto reference = Scan();
+	ASSERT_TRUE(reference.has_value());
+	ASSERT_EQ(reference->entity, obstacle);
+	ASSERT_EQ(reference->stepsAway, 254);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(MobileWallHugLinearScan, obstacleTooFar)
+{
+	CreateObstacle({1130.0f, 1000.0f}, 2.0f); // Entered after 256 steps, past the 255 a reference can count
+
+	ASSERT_FALSE(Scan().has_value());
+}
+
+/// The same walkers are moved with different worker counts, splitting the entities into a different number of chunks
+class MobileWallHugWorkers: public ::testing::Test
+{
+protected:
+	static std::vector<glm::vec3> Walk(uint32_t workerCount)
+	{
+		using namespace openblack::ecs::components;
+
+		json results;
+		std::ifstream(std::filesystem::path(k_ScenarioPath) / "mobilewallhug1.json") >> results;
+		const uint32_t turnCount = results["last_turn"].get<uint32_t>() - results["start_turn"].get<uint32_t>();
+		const auto& first = results["villager_states"][0];
+		const auto start = glm::vec2(first["pos"][0].get<float>(), first["pos"][1].get<float>());
+		const auto goal = glm::vec2(first["goal"][0].get<float>(), first["goal"][1].get<float>());
+		const auto speed = first["speed"].get<float>();
+
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		auto game = std::make_unique<openblack::Game>(std::move(args));
+		EXPECT_TRUE(game->Initialize());
+		{
+			std::ifstream ifs(std::filesystem::path(k_ScenarioPath) / results["map_file"].get<std::string>());
+			openblack::lhscriptx::Script script;
+			script.Load(std::string(std::istreambuf_iterator<char> {ifs}, {}));
+		}
+
+		// Animations still loading wait on the job system they were scheduled on
+		Locator::resources::value().GetAnimations().Clear();
+		Locator::jobSystem::reset();
+		Locator::jobSystem::emplace(workerCount);
+
+		auto& registry = Locator::entitiesRegistry::value();
+		Locator::entitiesMap::value().Rebuild();
+		std::vector<entt::entity> walkers(k_WalkerCount);
+		for (uint32_t i = 0; i < k_WalkerCount; ++i)
+		{
+			// Slightly apart so that mixing up two walkers changes the result
+			const auto position = start + glm::vec2(static_cast<float>(i) * 1e-4f, 0.0f);
+			walkers[i] = registry.Create();
+			registry.Assign<Transform>(walkers[i], glm::vec3(position.x, 0.0f, position.y), glm::mat3(1.0f), glm::vec3(1.0f));
+			registry.Assign<WallHug>(walkers[i], goal, glm::vec2(0.0f), 0.0f, speed);
+			registry.Assign<MoveStateLinearTag>(walkers[i]);
+		}
+
+		for (uint32_t turn = 0; turn < turnCount; ++turn)
+		{
+			EXPECT_NO_THROW(Locator::pathfindingSystem::value().Update()) << "on turn " << turn;
+		}
+
+		std::vector<glm::vec3> positions;
+		positions.reserve(walkers.size());
+		for (const auto entity : walkers)
+		{
+			positions.push_back(registry.Get<const Transform>(entity).position);
+		}
+		return positions;
+	}
+
+	static constexpr std::string_view k_ScenarioPath = TEST_BINARY_DIR "/mobile_wall_hug/scenarios";
+	static constexpr uint32_t k_WalkerCount = 512;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(MobileWallHugWorkers, resultsDoNotDependOnTheWorkerCount)
+{
+	const auto mainThreadOnly = Walk(0);
+	ASSERT_FALSE(HasFailure());
+	for (const uint32_t workerCount : {1u, 3u, 7u})
+	{
+		const auto positions = Walk(workerCount);
+		ASSERT_EQ(positions.size(), mainThreadOnly.size());
+		for (size_t i = 0; i < positions.size(); ++i)
+		{
+			// Exactly the same operations on each walker, whichever thread ran them
+			ASSERT_EQ(positions[i], mainThreadOnly[i]) << "walker " << i << " with " << workerCount << " workers";
+		}
+	}
+}
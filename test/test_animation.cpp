@@ -0,0 +1,202 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <array>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include <3D/AllMeshes.h>
+#include <3D/L3DAnim.h>
+#include <ANMFile.h>
+#include <ECS/Archetypes/VillagerArchetype.h>
+#include <ECS/Components/Animation.h>
+#include <ECS/Components/Mesh.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Registry.h>
+#include <ECS/Systems/RenderingSystemInterface.h>
+#include <Game.h>
+#include <Locator.h>
+#include <Resources/MeshId.h>
+#include <glm/common.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+
+using namespace openblack::ecs::archetypes;
+using namespace openblack::ecs::components;
+using namespace openblack;
+
+namespace
+{
+/// Animation built in memory rather than read from a file
+class TestANMFile: public anm::ANMFile
+{
+public:
+	TestANMFile(uint32_t duration, std::vector<anm::ANMFrame> keyframes)
+	{
+		_header = {};
+		_header.frameCount = static_cast<uint32_t>(keyframes.size());
+		_header.animationDuration = duration;
+		_keyframes = std::move(keyframes);
+		_isLoaded = true;
+	}
+};
+
+anm::ANMBone CreateBone(float degrees, const glm::vec3& axis, const glm::vec3& scale, const glm::vec3& translation)
+{
+	const auto axes = glm::mat3(glm::rotate(glm::mat4(1.0f), glm::radians(degrees), glm::normalize(axis))) *
+	                  glm::mat3(glm::scale(glm::mat4(1.0f), scale));
+	return {{
+	    axes[0].x, axes[0].y, axes[0].z, //
+	    axes[1].x, axes[1].y, axes[1].z, //
+	    axes[2].x, axes[2].y, axes[2].z, //
+	    translation.x, translation.y, translation.z,
+	}};
+}
+
+glm::mat4 GetMatrix(const anm::ANMBone& bone)
+{
+	const auto& m = bone.matrix;
+	return {m[0], m[1], m[2], 0.0f, m[3], m[4], m[5], 0.0f, m[6], m[7], m[8], 0.0f, m[9], m[10], m[11], 1.0f};
+}
+
+/// How the bones were evaluated before the clips were quantized: the full matrices are blended element-wise
+std::vector<glm::mat4> BlendMatrices(const anm::ANMFile& file, uint32_t time)
+{
+	const auto& keyframes = file.GetKeyframes();
+	const uint32_t animationTime = time % file.GetHeader().animationDuration;
+	size_t index = 0;
+	while (index < keyframes.size() && keyframes[index].time < animationTime)
+	{
+		++index;
+	}
+
+	std::vector<glm::mat4> bones;
+	if (index == 0 || index == keyframes.size())
+	{
+		// The pose is held before the first and after the last keyframe
+		for (const auto& bone : keyframes[index == 0 ? 0 : index - 1].bones)
+		{
+			bones.push_back(GetMatrix(bone));
+		}
+		return bones;
+	}
+
+	const auto& from = keyframes[index - 1];
+	const auto& to = keyframes[index];
+	const float t = static_cast<float>(animationTime - from.time) / static_cast<float>(to.time - from.time);
+	for (size_t i = 0; i < to.bones.size(); ++i)
+	{
+		const auto a = GetMatrix(from.bones[i]);
+		const auto b = GetMatrix(to.bones[i]);
+		bones.emplace_back(glm::mix(a[0], b[0], t), glm::mix(a[1], b[1], t), glm::mix(a[2], b[2], t), glm::mix(a[3], b[3], t));
+	}
+	return bones;
+}
+} // namespace
+
+class TestAnimation: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+	}
+	void TearDown() override { _game.reset(); }
+	std::unique_ptr<Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestAnimation, villagerStandsIdle)
+{
+	const auto entity = VillagerArchetype::Create({}, {}, VillagerInfo::CelticHousewifeFemale, 20);
+	const auto* animation = Locator::entitiesRegistry::value().TryGet<const Animation>(entity);
+	ASSERT_NE(animation, nullptr);
+	ASSERT_EQ(animation->id, resources::AnimIdToResourceId(AnimId::PStand));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestAnimation, playingAnimationsKeepTheInstances)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& renderingSystem = Locator::rendereringSystem::value();
+
+	const auto entity = registry.Create();
+	registry.Assign<Transform>(entity, glm::vec3(0.0f), glm::mat3(1.0f), glm::vec3(1.0f));
+	registry.Assign<Mesh>(entity, entt::hashed_string("coffre"), static_cast<int8_t>(0), static_cast<int8_t>(0));
+	registry.Assign<Animation>(entity, entt::hashed_string("coffre"));
+	registry.SetDirty(entity);
+
+	renderingSystem.PrepareDraw(false, false, false, false);
+	const auto generation = renderingSystem.GetContext().generation;
+
+	// Only the palettes move as the animation plays, the instances the views were built from stay valid
+	for (int frame = 0; frame < 4; ++frame)
+	{
+		renderingSystem.UpdateAnimations(std::chrono::milliseconds(16));
+		renderingSystem.PrepareDraw(false, false, false, false);
+		ASSERT_EQ(renderingSystem.GetContext().generation, generation);
+	}
+
+	// The mock mesh has no bones, it is drawn in its bind pose
+	ASSERT_TRUE(renderingSystem.GetContext().bonePalettes.empty());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestL3DAnim, evaluateBonesMatchesMatrixBlend)
+{
+	// A rotating bone, a scaled one and a mirrored one, turning a few degrees per keyframe
+	std::vector<anm::ANMFrame> keyframes;
+	for (uint32_t frame = 0; frame < 3; ++frame)
+	{
+		const auto f = static_cast<float>(frame);
+		keyframes.push_back({
+		    frame * 100,
+		    {
+		        CreateBone(4.0f * f, {0.0f, 1.0f, 0.0f}, glm::vec3(1.0f), {f, 2.0f, 3.0f}),
+		        CreateBone(30.0f + 3.0f * f, {1.0f, 1.0f, 0.0f}, {1.0f + 0.05f * f, 1.0f, 0.5f}, {0.0f, 0.5f * f, 0.0f}),
+		        CreateBone(90.0f - 2.0f * f, {0.0f, 0.0f, 1.0f}, {-1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, -f}),
+		    },
+		});
+	}
+	const TestANMFile file(300, std::move(keyframes));
+	L3DAnim animation;
+	animation.Load(file);
+	ASSERT_EQ(animation.GetBoneCount(), 3);
+
+	// Quantizing the rotations and blending them as quaternions instead of matrices stays within this for keyframes a
+	// few degrees apart
+	constexpr float k_Tolerance = 1e-3f;
+	std::array<glm::mat4, 3> bones;
+	for (uint32_t time = 0; time < 600; time += 5)
+	{
+		ASSERT_EQ(animation.EvaluateBones(time, bones), bones.size());
+		const auto expected = BlendMatrices(file, time);
+		for (size_t i = 0; i < bones.size(); ++i)
+		{
+			for (glm::length_t column = 0; column < 4; ++column)
+			{
+				for (glm::length_t row = 0; row < 4; ++row)
+				{
+					ASSERT_NEAR(bones[i][column][row], expected[i][column][row], k_Tolerance)
+					    << "time " << time << " bone " << i << " [" << column << "][" << row << "]";
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <array>
+#include <vector>
+
+#include <ECS/Archetypes/AbodeArchetype.h>
+#include <ECS/Archetypes/FeatureArchetype.h>
+#include <ECS/Archetypes/MobileStaticArchetype.h>
+#include <ECS/Archetypes/TownArchetype.h>
+#include <ECS/Archetypes/TreeArchetype.h>
+#include <ECS/Components/Abode.h>
+#include <ECS/Components/Feature.h>
+#include <ECS/Components/Fixed.h>
+#include <ECS/Components/Mesh.h>
+#include <ECS/Components/Mobile.h>
+#include <ECS/Components/MorphWithTerrain.h>
+#include <ECS/Components/RigidBody.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Components/Tree.h>
+#include <ECS/Registry.h>
+#include <Game.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::ecs::archetypes;
+using namespace openblack::ecs::components;
+using namespace openblack;
+
+class TestArchetypeBatch: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+	}
+	void TearDown() override { _game.reset(); }
+
+	/// The components every archetype creates
+	static void ExpectSameCommonComponents(entt::entity batched, entt::entity single)
+	{
+		const auto& registry = Locator::entitiesRegistry::value();
+		const auto& batchedTransform = registry.Get<const Transform>(batched);
+		const auto& singleTransform = registry.Get<const Transform>(single);
+		ASSERT_EQ(batchedTransform.position, singleTransform.position);
+		ASSERT_EQ(batchedTransform.rotation, singleTransform.rotation);
+		ASSERT_EQ(batchedTransform.scale, singleTransform.scale);
+		const auto& batchedMesh = registry.Get<const Mesh>(batched);
+		const auto& singleMesh = registry.Get<const Mesh>(single);
+		ASSERT_EQ(batchedMesh.id, singleMesh.id);
+		ASSERT_EQ(batchedMesh.submeshId, singleMesh.submeshId);
+		ASSERT_EQ(batchedMesh.bbSubmeshId, singleMesh.bbSubmeshId);
+		ASSERT_EQ(registry.AllOf<Fixed>(batched), registry.AllOf<Fixed>(single));
+		if (registry.AllOf<Fixed>(single))
+		{
+			ASSERT_EQ(registry.Get<const Fixed>(batched).boundingCenter, registry.Get<const Fixed>(single).boundingCenter);
+			ASSERT_EQ(registry.Get<const Fixed>(batched).boundingRadius, registry.Get<const Fixed>(single).boundingRadius);
+		}
+		ASSERT_EQ(registry.AllOf<MorphWithTerrain>(batched), registry.AllOf<MorphWithTerrain>(single));
+	}
+
+	std::unique_ptr<Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestArchetypeBatch, treesMatchSingleCreations)
+{
+	const std::array<TreeArchetype::Parameters, 3> trees = {{
+	    {0, {100.0f, 0.0f, 200.0f}, TreeInfo::Beech, true, 0.5f, 1.5f, 1.0f},
+	    {0, {110.0f, 0.0f, 210.0f}, TreeInfo::Birch, false, 1.0f, 2.0f, 1.2f},
+	    {1, {120.0f, 0.0f, 220.0f}, TreeInfo::Burnt, true, 2.0f, 1.0f, 0.8f},
+	}};
+	const auto batched = TreeArchetype::Create(trees);
+	ASSERT_EQ(batched.size(), trees.size());
+
+	const auto& registry = Locator::entitiesRegistry::value();
+	for (size_t i = 0; i < trees.size(); ++i)
+	{
+		const auto& p = trees.at(i);
+		const auto single = TreeArchetype::Create(p.forestId, p.position, p.type, p.isNonScenic, p.yAngleRadians, p.maxSize,
+		                                          p.scale);
+		ExpectSameCommonComponents(batched[i], single);
+		ASSERT_EQ(registry.Get<const Tree>(batched[i]).type, registry.Get<const Tree>(single).type);
+		ASSERT_EQ(registry.Get<const Tree>(batched[i]).maxSize, registry.Get<const Tree>(single).maxSize);
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestArchetypeBatch, featuresMatchSingleCreations)
+{
+	const std::array<FeatureArchetype::Parameters, 2> features = {{
+	    {{100.0f, 0.0f, 200.0f}, FeatureInfo::Ark, 0.5f, 1.0f},
+	    {{150.0f, 0.0f, 250.0f}, FeatureInfo::Toadstool, 1.5f, 2.0f},
+	}};
+	const auto batched = FeatureArchetype::Create(features);
+	ASSERT_EQ(batched.size(), features.size());
+
+	const auto& registry = Locator::entitiesRegistry::value();
+	for (size_t i = 0; i < features.size(); ++i)
+	{
+		const auto& p = features.at(i);
+		const auto single = FeatureArchetype::Create(p.position, p.type, p.yAngleRadians, p.scale);
+		ExpectSameCommonComponents(batched[i], single);
+		ASSERT_EQ(registry.Get<const Feature>(batched[i]).type, registry.Get<const Feature>(single).type);
+		ASSERT_EQ(registry.AllOf<RigidBody>(batched[i]), registry.AllOf<RigidBody>(single));
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestArchetypeBatch, mobileStaticsMatchSingleCreations)
+{
+	const std::array<MobileStaticArchetype::Parameters, 2> mobileStatics = {{
+	    {{100.0f, 0.0f, 200.0f}, MobileStaticInfo::CeltFenceShort, 1.0f, 0.1f, 0.2f, 0.3f, 1.0f},
+	    {{150.0f, 0.0f, 250.0f}, MobileStaticInfo::Rock, 0.0f, 0.0f, 1.5f, 0.0f, 2.0f},
+	}};
+	const auto batched = MobileStaticArchetype::Create(mobileStatics);
+	ASSERT_EQ(batched.size(), mobileStatics.size());
+
+	const auto& registry = Locator::entitiesRegistry::value();
+	for (size_t i = 0; i < mobileStatics.size(); ++i)
+	{
+		const auto& p = mobileStatics.at(i);
+		const auto single = MobileStaticArchetype::Create(p.position, p.type, p.altitude, p.xAngleRadians, p.yAngleRadians,
+		                                                  p.zAngleRadians, p.scale);
+		ExpectSameCommonComponents(batched[i], single);
+		ASSERT_TRUE(registry.AllOf<Mobile>(batched[i]));
+		ASSERT_EQ(registry.Get<const MobileStatic>(batched[i]).type, registry.Get<const MobileStatic>(single).type);
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestArchetypeBatch, abodesMatchSingleCreations)
+{
+	TownArchetype::Create(0, glm::vec3(2185.72f, 0.0f, 2315.78f), PlayerNames::PLAYER_ONE, Tribe::CELTIC);
+	// The town centre morphs with the terrain, the unknown town falls back to the closest one
+	const std::array<AbodeArchetype::Parameters, 3> abodes = {{
+	    {0, {2188.23f, 0.0f, 2317.47f}, AbodeInfo::CelticTownCentre, 2.932f, 1.0f, 0, 0},
+	    {0, {2224.63f, 0.0f, 2372.52f}, AbodeInfo::CelticTempleY, 2.932f, 1.095f, 10, 20},
+	    {42, {2230.0f, 0.0f, 2380.0f}, AbodeInfo::CelticTempleY, 1.0f, 1.0f, 0, 0},
+	}};
+	const auto batched = AbodeArchetype::Create(abodes);
+	ASSERT_EQ(batched.size(), abodes.size());
+
+	const auto& registry = Locator::entitiesRegistry::value();
+	for (size_t i = 0; i < abodes.size(); ++i)
+	{
+		const auto& p = abodes.at(i);
+		const auto single =
+		    AbodeArchetype::Create(p.townId, p.position, p.type, p.yAngleRadians, p.scale, p.foodAmount, p.woodAmount);
+		ASSERT_NE(batched[i], entt::null);
+		ExpectSameCommonComponents(batched[i], single);
+		const auto& batchedAbode = registry.Get<const Abode>(batched[i]);
+		const auto& singleAbode = registry.Get<const Abode>(single);
+		ASSERT_EQ(batchedAbode.type, singleAbode.type);
+		ASSERT_EQ(batchedAbode.townId, singleAbode.townId);
+		ASSERT_EQ(batchedAbode.foodAmount, singleAbode.foodAmount);
+		ASSERT_EQ(batchedAbode.woodAmount, singleAbode.woodAmount);
+	}
+	ASSERT_EQ(registry.Get<const Abode>(batched[2]).townId, 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestArchetypeBatch, abodesWithoutTownAreSkipped)
+{
+	const std::array<AbodeArchetype::Parameters, 1> abodes = {{
+	    {0, {2224.63f, 0.0f, 2372.52f}, AbodeInfo::CelticTempleY, 2.932f, 1.0f, 0, 0},
+	}};
+	const auto batched = AbodeArchetype::Create(abodes);
+	ASSERT_EQ(batched.size(), abodes.size());
+	ASSERT_EQ(batched[0], entt::null);
+}
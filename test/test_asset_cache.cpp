@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <FileSystem/DefaultFileSystem.h>
+#include <Locator.h>
+#include <Resources/AssetCache.h>
+#include <gtest/gtest.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+using namespace openblack;
+
+class TestAssetCache: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		std::filesystem::remove_all(k_Directory);
+		std::filesystem::create_directories(k_Directory);
+		WriteSource("source");
+		Locator::filesystem::emplace<filesystem::DefaultFileSystem>();
+		// The cache logs without a game to set up the loggers
+		if (spdlog::get("game") == nullptr)
+		{
+			spdlog::stdout_color_mt("game");
+		}
+	}
+
+	void TearDown() override
+	{
+		Locator::filesystem::reset();
+		spdlog::drop("game");
+		std::filesystem::remove_all(k_Directory);
+	}
+
+	static void WriteSource(std::string_view contents)
+	{
+		std::ofstream(k_Source, std::ios::binary | std::ios::trunc) << contents;
+	}
+
+	static std::vector<uint8_t> Find(const resources::AssetCache& cache)
+	{
+		const auto blob = cache.Find("test", k_Sources);
+		if (blob == nullptr)
+		{
+			return {};
+		}
+		return {blob->GetData().begin(), blob->GetData().end()};
+	}
+
+	static inline const auto k_Directory = std::filesystem::path(TEST_BINARY_DIR) / "asset_cache";
+	static inline const auto k_Source = k_Directory / "source.l3d";
+	static inline const std::array k_Sources {k_Source};
+	static inline const std::vector<uint8_t> k_Data {1, 2, 3, 4, 5};
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestBlob, readsBackWhatWasWritten)
+{
+	resources::BlobWriter writer;
+	writer.Write(static_cast<uint8_t>(7));
+	writer.WriteArray(std::vector<uint32_t> {1, 2, 3});
+	writer.WriteArray(std::string_view("mesh"));
+	writer.Write(0.5);
+	const auto data = writer.Release();
+
+	resources::BlobReader reader(data);
+	ASSERT_EQ(reader.Peek<uint8_t>(), 7);
+	ASSERT_EQ(reader.Read<uint8_t>(), 7);
+	const auto values = reader.ReadArray<uint32_t>();
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(values.data()) % alignof(uint32_t), 0);
+	ASSERT_EQ(std::vector<uint32_t>(values.begin(), values.end()), (std::vector<uint32_t> {1, 2, 3}));
+	ASSERT_EQ(reader.ReadString(), "mesh");
+	ASSERT_EQ(reader.Read<double>(), 0.5);
+	ASSERT_TRUE(reader.AtEnd());
+
+	resources::BlobReader truncated(std::span(data).first(data.size() - 1));
+	ASSERT_EQ(truncated.Read<uint8_t>(), 7);
+	ASSERT_EQ(truncated.ReadArray<uint32_t>().size(), 3);
+	ASSERT_EQ(truncated.ReadString(), "mesh");
+	ASSERT_THROW((void)truncated.Read<double>(), std::runtime_error);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestAssetCache, findsStoredEntry)
+{
+	const resources::AssetCache cache(k_Directory / "cache", false);
+	ASSERT_TRUE(Find(cache).empty());
+
+	cache.Store("test", k_Sources, k_Data);
+	ASSERT_EQ(Find(cache), k_Data);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestAssetCache, changedSourceInvalidatesEntry)
+{
+	const resources::AssetCache cache(k_Directory / "cache", false);
+	cache.Store("test", k_Sources, k_Data);
+	ASSERT_EQ(Find(cache), k_Data);
+
+	// A different size changes the stamp even if the modification time is too coarse to tell
+	WriteSource("changed source");
+	ASSERT_TRUE(Find(cache).empty());
+
+	// Stored again over the stale entry
+	cache.Store("test", k_Sources, k_Data);
+	ASSERT_EQ(Find(cache), k_Data);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestAssetCache, rebuildIgnoresEntries)
+{
+	resources::AssetCache(k_Directory / "cache", false).Store("test", k_Sources, k_Data);
+
+	const resources::AssetCache cache(k_Directory / "cache", true);
+	ASSERT_TRUE(Find(cache).empty());
+	ASSERT_EQ(Find(resources::AssetCache(k_Directory / "cache", false)), k_Data);
+}
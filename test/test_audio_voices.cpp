@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include <ECS/Components/AudioEmitter.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Registry.h>
+#include <Game.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+// Enable this define because the implementation is used directly
+#define LOCATOR_IMPLEMENTATIONS
+#include <Audio/AudioManager.h>
+
+using namespace openblack;
+using namespace openblack::audio;
+using namespace openblack::ecs::components;
+
+namespace
+{
+/// Hands out sources without playing anything and counts the ones alive
+class FakeAudioPlayer final: public AudioPlayerInterface
+{
+public:
+	explicit FakeAudioPlayer(size_t& sourceCount)
+	    : _sourceCount(sourceCount)
+	{
+	}
+
+	void Initialize() override {}
+	void UpdateListener(glm::vec3, glm::vec3, glm::vec3, glm::vec3) const override {}
+	[[nodiscard]] BufferId CreateBuffer(ChannelLayout, const std::vector<int16_t>&, int) override { return 0; }
+	void UpdateBuffer(BufferId, ChannelLayout, std::span<const int16_t>, int) override {}
+	void QueueBuffer(SourceId /*unused*/, BufferId /*unused*/) override {}
+	[[nodiscard]] BufferId UnqueueBuffer(SourceId /*unused*/) override { return 0; }
+	[[nodiscard]] int GetProcessedBufferCount(SourceId /*unused*/) const override { return 0; }
+	void DeleteBuffer(BufferId /*unused*/) override {}
+	[[nodiscard]] SourceId CreateSource(float /*unused*/, bool /*unused*/) override
+	{
+		++_sourceCount;
+		return ++_lastSource;
+	}
+	void DeleteSource(SourceId /*unused*/) override { --_sourceCount; }
+	void UpdateSource(SourceId, glm::vec3, float, bool) override {}
+	void UpdateSource(SourceId, float, bool) override {}
+	[[nodiscard]] float GetDuration(BufferId /*unused*/) override { return 0.0f; }
+	void PlaySource(SourceId, glm::vec3, float, bool) override {}
+	void PlaySource(SourceId, float, bool) override {}
+	void PauseSource(SourceId /*unused*/) const override {}
+	void StopSource(SourceId /*unused*/) const override {}
+	void SetPlaybackOffset(SourceId /*unused*/, float /*unused*/) override {}
+	[[nodiscard]] float GetPlaybackOffset(SourceId /*unused*/) const override { return 0.0f; }
+	void SetVolume(SourceId /*unused*/, float /*unused*/) override {}
+	[[nodiscard]] float GetVolume() const override { return 1.0f; }
+	[[nodiscard]] AudioStatus GetStatus(SourceId /*unused*/) const override { return AudioStatus::Playing; }
+	[[nodiscard]] float GetProgress(size_t /*unused*/, SourceId /*unused*/) const override { return 0.0f; }
+
+private:
+	size_t& _sourceCount;
+	SourceId _lastSource {0};
+};
+} // namespace
+
+class TestAudioVoices: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+	}
+	void TearDown() override { _game.reset(); }
+
+	/// Relative to the listener, heard up to 100 units away
+	static entt::entity CreateEmitter(int priority, const glm::vec3& position, AudioStatus status)
+	{
+		auto& registry = Locator::entitiesRegistry::value();
+		const auto entity = registry.Create();
+		registry.Assign<AudioEmitter>(entity, AudioEmitter::k_VirtualSource, entt::id_type {0}, priority, position,
+		                              glm::vec3(0.0f), glm::vec2(1.0f, 100.0f), 1.0f, PlayType::Repeat, status, true, 1.0f,
+		                              BufferId {0}, 10.0f);
+		registry.Assign<Transform>(entity, position, glm::mat3(1.0f), glm::vec3(1.0f));
+		return entity;
+	}
+
+	std::unique_ptr<Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestAudioVoices, inaudibleEmittersDontTakeVoices)
+{
+	size_t sourceCount = 0;
+	{
+		AudioManager audioManager(std::make_unique<FakeAudioPlayer>(sourceCount));
+		const auto& registry = Locator::entitiesRegistry::value();
+
+		std::vector<entt::entity> inaudible;
+		for (size_t i = 0; i < AudioManager::k_MaxVoices + 8; ++i)
+		{
+			// Out of range or paused
+			inaudible.push_back(CreateEmitter(10, glm::vec3(1000.0f, 0.0f, 0.0f), AudioStatus::Playing));
+			inaudible.push_back(CreateEmitter(10, glm::vec3(0.0f), AudioStatus::Paused));
+		}
+		const auto audible = CreateEmitter(0, glm::vec3(1.0f, 0.0f, 0.0f), AudioStatus::Playing);
+		audioManager.Update();
+
+		ASSERT_NE(registry.Get<const AudioEmitter>(audible).sourceId, AudioEmitter::k_VirtualSource);
+		for (const auto entity : inaudible)
+		{
+			ASSERT_EQ(registry.Get<const AudioEmitter>(entity).sourceId, AudioEmitter::k_VirtualSource);
+		}
+		ASSERT_EQ(sourceCount, 1);
+	}
+	// The emitters are destroyed with their manager
+	ASSERT_EQ(sourceCount, 0);
+}
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <ECS/CommandBuffer.h>
+#include <ECS/Components/Fixed.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Registry.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::ecs;
+using namespace openblack::ecs::components;
+
+namespace
+{
+Transform MakeTransform(float x)
+{
+	return {{x, 1.0f, 2.0f}, glm::mat3(x), {3.0f, 4.0f, x}};
+}
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestCommandBuffer, largeArgumentsAreStoredOutsideOfTheCommand)
+{
+	static_assert(sizeof(Transform) > CommandBuffer::k_MaxArgumentsSize);
+
+	Registry registry;
+	const auto entity = registry.Create();
+	CommandBuffer commands;
+	commands.Create<Transform, Fixed>(MakeTransform(5.0f), Fixed({6.0f, 7.0f}, 8.0f));
+	commands.Assign<Transform>(entity, MakeTransform(9.0f));
+	registry.Playback(commands);
+	ASSERT_TRUE(commands.Empty());
+
+	ASSERT_EQ(registry.Size<Transform>(), 2);
+	ASSERT_EQ(registry.Size<Fixed>(), 1);
+	registry.Each<const Transform, const Fixed>([](entt::entity, const Transform& transform, const Fixed& fixed) {
+		ASSERT_EQ(transform.position, MakeTransform(5.0f).position);
+		ASSERT_EQ(transform.rotation, MakeTransform(5.0f).rotation);
+		ASSERT_EQ(transform.scale, MakeTransform(5.0f).scale);
+		ASSERT_EQ(fixed.boundingCenter, glm::vec2(6.0f, 7.0f));
+		ASSERT_EQ(fixed.boundingRadius, 8.0f);
+	});
+	ASSERT_EQ(registry.Get<const Transform>(entity).rotation, MakeTransform(9.0f).rotation);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestCommandBuffer, appendKeepsLargeArgumentsOfBothBuffers)
+{
+	Registry registry;
+	const auto first = registry.Create();
+	const auto second = registry.Create();
+	CommandBuffer commands;
+	CommandBuffer other;
+	commands.Assign<Transform>(first, MakeTransform(1.0f));
+	other.Assign<Transform>(second, MakeTransform(2.0f));
+	commands.Append(std::move(other));
+	// NOLINTNEXTLINE(bugprone-use-after-move): Append leaves other empty
+	ASSERT_TRUE(other.Empty());
+	ASSERT_EQ(commands.Size(), 2);
+	registry.Playback(commands);
+
+	ASSERT_EQ(registry.Get<const Transform>(first).scale, MakeTransform(1.0f).scale);
+	ASSERT_EQ(registry.Get<const Transform>(second).scale, MakeTransform(2.0f).scale);
+}
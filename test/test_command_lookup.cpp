@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <LHScriptX/CommandLookup.h>
+#include <LHScriptX/FeatureScriptCommands.h>
+#include <LHScriptX/MapScriptCommands.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::lhscriptx;
+
+namespace
+{
+void ExpectFindsEverySignature(std::span<const ScriptCommandSignature> signatures)
+{
+	const CommandLookup lookup(signatures);
+	for (uint16_t i = 0; i < signatures.size(); ++i)
+	{
+		const auto name = std::string_view(signatures[i].name.data());
+		EXPECT_EQ(lookup.Find(name), i) << name;
+		// Names which only share a prefix with a command are not commands
+		EXPECT_FALSE(lookup.Find(name.substr(0, name.size() - 1)).has_value()) << name;
+		EXPECT_FALSE(lookup.Find(std::string(name) + "_").has_value()) << name;
+	}
+	EXPECT_FALSE(lookup.Find("").has_value());
+	EXPECT_FALSE(lookup.Find("NOT_A_COMMAND").has_value());
+}
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestCommandLookup, findsEveryFeatureScriptCommand)
+{
+	ExpectFindsEverySignature(FeatureScriptCommands::k_Signatures);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestCommandLookup, findsEveryMapScriptCommand)
+{
+	ExpectFindsEverySignature(MapScriptCommands::k_Signatures);
+}
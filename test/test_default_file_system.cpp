@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+// Enable this define because the implementation is used directly
+#define LOCATOR_IMPLEMENTATIONS
+#include <FileSystem/DefaultFileSystem.h>
+
+using namespace openblack::filesystem;
+
+class TestDefaultFileSystem: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		const auto* test = ::testing::UnitTest::GetInstance()->current_test_info();
+		_root = std::filesystem::path(TEST_BINARY_DIR) / "default_file_system" / test->name();
+		std::filesystem::remove_all(_root);
+		std::filesystem::create_directories(_root / "Game" / "Data" / "Landscape");
+		std::filesystem::create_directories(_root / "Other");
+		Touch(_root / "Game" / "Data" / "Landscape" / "Land1.lnd");
+	}
+	void TearDown() override { std::filesystem::remove_all(_root); }
+
+	static void Touch(const std::filesystem::path& path) { std::ofstream(path).put('\0'); }
+
+	std::filesystem::path _root;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestDefaultFileSystem, resolvesRelativePathsInAnyCase)
+{
+	DefaultFileSystem fileSystem;
+	fileSystem.SetGamePath(_root / "Game");
+
+	const auto expected = _root / "Game" / "Data" / "Landscape" / "Land1.lnd";
+	ASSERT_EQ(fileSystem.FindPath("Data/Landscape/Land1.lnd"), expected);
+	ASSERT_EQ(fileSystem.FindPath("data/LANDSCAPE/land1.LND"), expected);
+	// Served from the cache the second time
+	ASSERT_EQ(fileSystem.FindPath("data/LANDSCAPE/land1.LND"), expected);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestDefaultFileSystem, prefersTheExactCase)
+{
+	const auto directory = _root / "Game" / "Data";
+	Touch(directory / "Text.txt");
+	Touch(directory / "text.txt");
+	// Landscape and both files
+	if (std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()) < 3)
+	{
+		GTEST_SKIP() << "The file system is not case sensitive";
+	}
+
+	DefaultFileSystem fileSystem;
+	fileSystem.SetGamePath(_root / "Game");
+	ASSERT_EQ(fileSystem.FindPath("Data/text.txt"), directory / "text.txt");
+	ASSERT_EQ(fileSystem.FindPath("Data/Text.txt"), directory / "Text.txt");
+	// Otherwise the first in order, whatever the order of the listing
+	ASSERT_EQ(fileSystem.FindPath("Data/TEXT.txt"), directory / "Text.txt");
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestDefaultFileSystem, missingPathsAreNotFound)
+{
+	DefaultFileSystem fileSystem;
+	fileSystem.SetGamePath(_root / "Game");
+
+	ASSERT_FALSE(fileSystem.Exists("Data/Landscape/Land2.lnd"));
+	ASSERT_FALSE(fileSystem.Exists("Missing/Land1.lnd"));
+	// A file is not a directory
+	ASSERT_FALSE(fileSystem.Exists("Data/Landscape/Land1.lnd/Land1.lnd"));
+	ASSERT_THROW(static_cast<void>(fileSystem.FindPath("Data/Landscape/Land2.lnd")), std::runtime_error);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestDefaultFileSystem, additionalPathsAreSearchedAfterTheGamePath)
+{
+	Touch(_root / "Other" / "Save.sav");
+	Touch(_root / "Other" / "Land1.lnd");
+
+	DefaultFileSystem fileSystem;
+	fileSystem.SetGamePath(_root / "Game");
+	ASSERT_FALSE(fileSystem.Exists("save.sav"));
+
+	// Missing paths are looked up again once the additional path is added
+	fileSystem.AddAdditionalPath(_root / "Other");
+	ASSERT_EQ(fileSystem.FindPath("save.sav"), _root / "Other" / "Save.sav");
+	ASSERT_EQ(fileSystem.FindPath("Data/Landscape/Land1.lnd"), _root / "Game" / "Data" / "Landscape" / "Land1.lnd");
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestDefaultFileSystem, settingTheGamePathInvalidatesTheIndex)
+{
+	std::filesystem::create_directories(_root / "Other" / "DATA" / "Landscape");
+	Touch(_root / "Other" / "DATA" / "Landscape" / "LAND1.LND");
+
+	DefaultFileSystem fileSystem;
+	fileSystem.SetGamePath(_root / "Game");
+	ASSERT_EQ(fileSystem.FindPath("data/landscape/land1.lnd"), _root / "Game" / "Data" / "Landscape" / "Land1.lnd");
+
+	fileSystem.SetGamePath(_root / "Other");
+	ASSERT_EQ(fileSystem.FindPath("data/landscape/land1.lnd"), _root / "Other" / "DATA" / "Landscape" / "LAND1.LND");
+}
+
+#ifdef __linux__
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestDefaultFileSystem, watchedDirectoriesAreIndexedAgainAfterAChange)
+{
+	DefaultFileSystem fileSystem(true);
+	fileSystem.SetGamePath(_root / "Game");
+	ASSERT_FALSE(fileSystem.Exists("Data/Landscape/Land2.lnd"));
+
+	Touch(_root / "Game" / "Data" / "Landscape" / "Land2.lnd");
+	// The change is picked up by the watcher thread
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (!fileSystem.Exists("data/landscape/land2.lnd") && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	ASSERT_EQ(fileSystem.FindPath("data/landscape/land2.lnd"), _root / "Game" / "Data" / "Landscape" / "Land2.lnd");
+
+	std::filesystem::remove(_root / "Game" / "Data" / "Landscape" / "Land2.lnd");
+	deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (fileSystem.Exists("data/landscape/land2.lnd") && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	ASSERT_FALSE(fileSystem.Exists("data/landscape/land2.lnd"));
+}
+#endif
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <Jobs/JobSystem.h>
+#include <Jobs/TaskGraph.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+
+TEST(TestJobSystem, parallelForCoversEveryItemOnce)
+{
+	JobSystem jobSystem(3);
+	std::vector<std::atomic<uint32_t>> hits(10000);
+	jobSystem.ParallelFor(hits.size(), 16, [&hits](size_t, size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			hits[i].fetch_add(1, std::memory_order_relaxed);
+		}
+	});
+	for (const auto& hit : hits)
+	{
+		ASSERT_EQ(hit.load(), 1);
+	}
+}
+
+TEST(TestJobSystem, waitRethrowsAfterAllJobsRan)
+{
+	JobSystem jobSystem(2);
+	JobSystem::Counter counter;
+	std::atomic<uint32_t> ran {0};
+	for (int i = 0; i < 64; ++i)
+	{
+		jobSystem.Schedule(
+		    [&ran, i]() {
+			    ran.fetch_add(1);
+			    if (i == 7)
+			    {
+				    throw std::runtime_error("job failed");
+			    }
+		    },
+		    counter);
+	}
+	ASSERT_THROW(jobSystem.Wait(counter), std::runtime_error);
+	ASSERT_TRUE(counter.Done());
+	ASSERT_EQ(ran.load(), 64);
+}
+
+TEST(TestJobSystem, waitWithoutWorkersRunsJobsOnCaller)
+{
+	JobSystem jobSystem(0);
+	JobSystem::Counter counter;
+	uint32_t ran = 0;
+	for (int i = 0; i < 8; ++i)
+	{
+		jobSystem.Schedule([&ran]() { ++ran; }, counter);
+	}
+	jobSystem.Wait(counter);
+	ASSERT_EQ(ran, 8);
+}
+
+TEST(TestTaskGraph, conflictingTasksKeepTheirOrder)
+{
+	using Resource = TaskGraph::Resource;
+	using Affinity = TaskGraph::Affinity;
+
+	JobSystem jobSystem(3);
+	for (int repeat = 0; repeat < 50; ++repeat)
+	{
+		TaskGraph graph;
+		std::vector<int> order;
+		std::atomic<uint32_t> mainThreadTasksOffMain {0};
+		for (int i = 0; i < 16; ++i)
+		{
+			const auto affinity = i % 3 == 0 ? Affinity::MainThread : Affinity::Any;
+			graph.AddTask({
+			    .reads = {},
+			    .writes = {Resource::Registry},
+			    .affinity = affinity,
+			    .func =
+			        [&order, &mainThreadTasksOffMain, affinity, i]() {
+				        if (affinity == Affinity::MainThread && JobSystem::GetCurrentThreadIndex() != 0)
+				        {
+					        mainThreadTasksOffMain.fetch_add(1);
+				        }
+				        order.push_back(i);
+			        },
+			});
+		}
+		graph.Execute(jobSystem);
+
+		std::vector<int> expected(16);
+		std::iota(expected.begin(), expected.end(), 0);
+		ASSERT_EQ(order, expected);
+		ASSERT_EQ(mainThreadTasksOffMain.load(), 0);
+		ASSERT_EQ(graph.Size(), 0);
+	}
+}
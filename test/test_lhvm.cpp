@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <CHLApi.h>
+#include <LHVM.h>
+#include <LHVMFile.h>
+#include <LHVMNativeSignatures.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::lhvm;
+
+namespace
+{
+struct Tick
+{
+	size_t tasks;
+	uint32_t executedInstructions;
+	float counter;
+	float total;
+	float result;
+	uint32_t errors;
+
+	bool operator==(const Tick&) const = default;
+};
+
+std::ostream& operator<<(std::ostream& stream, const Tick& tick)
+{
+	return stream << "{" << tick.tasks << ", " << tick.executedInstructions << ", " << tick.counter << ", " << tick.total
+	              << ", " << tick.result << ", " << tick.errors << "}";
+}
+
+/// Counts to 5 then calls a stub and a missing function, goes through exception handling instructions and runs a script
+/// that doubles the total until it reaches 100
+LHVMFile CreateFile()
+{
+	using enum Opcode;
+	const auto immediate = VMMode::Immediate;
+	const auto reference = VMMode::Reference;
+
+	std::vector<VMInstruction> code;
+	const auto add = [&code](Opcode opcode, VMMode mode, DataType type, VMValue data) {
+		code.emplace_back(opcode, mode, type, data, static_cast<uint32_t>(code.size()));
+	};
+	// Main
+	add(Except, immediate, DataType::None, VMValue(28u));
+	add(Push, reference, DataType::Float, VMValue(1u)); // 1: counter += 1
+	add(Push, immediate, DataType::Float, VMValue(1.0f));
+	add(Add, immediate, DataType::Float, VMValue());
+	add(Pop, reference, DataType::Float, VMValue(1u));
+	add(Push, reference, DataType::Float, VMValue(2u)); // total += counter
+	add(Push, reference, DataType::Float, VMValue(1u));
+	add(Add, immediate, DataType::Float, VMValue());
+	add(Pop, reference, DataType::Float, VMValue(2u));
+	add(Push, reference, DataType::Float, VMValue(1u)); // while counter < 5
+	add(Push, immediate, DataType::Float, VMValue(5.0f));
+	add(Lt, immediate, DataType::Float, VMValue());
+	add(Wait, VMMode::Forward, DataType::Int, VMValue(16u));
+	add(Push, immediate, DataType::Float, VMValue(7.0f));
+	add(Pop, immediate, DataType::Float, VMValue());
+	add(Jmp, VMMode::Backward, DataType::Int, VMValue(1u));
+	add(Push, immediate, DataType::Float, VMValue(1.0f)); // 16: result = STUB(1, 2)
+	add(Push, immediate, DataType::Float, VMValue(2.0f));
+	add(Sys, immediate, DataType::None, VMValue(1u));
+	add(Pop, reference, DataType::Float, VMValue(3u));
+	add(EndExcept, VMMode::EndExcept, DataType::None, VMValue());
+	add(Except, immediate, DataType::None, VMValue(28u));
+	add(EndExcept, VMMode::Yield, DataType::None, VMValue());
+	add(BrkExcept, immediate, DataType::None, VMValue()); // Skips the next instruction
+	add(Line, immediate, DataType::None, VMValue());
+	add(Sys, immediate, DataType::None, VMValue(99u));
+	add(Run, VMMode::Sync, DataType::None, VMValue(2u));
+	add(Jmp, VMMode::Forward, DataType::Int, VMValue(30u));
+	add(FailExcept, immediate, DataType::None, VMValue()); // 28: exception handler
+	add(RetExcept, immediate, DataType::None, VMValue());
+	add(End, immediate, DataType::None, VMValue());
+	// Child
+	add(Push, reference, DataType::Float, VMValue(2u)); // 31: total *= 2 until total >= 100
+	add(Push, immediate, DataType::Float, VMValue(2.0f));
+	add(Mul, immediate, DataType::Float, VMValue());
+	add(Pop, reference, DataType::Float, VMValue(2u));
+	add(Push, reference, DataType::Float, VMValue(2u));
+	add(Push, immediate, DataType::Float, VMValue(100.0f));
+	add(Ge, immediate, DataType::Float, VMValue());
+	add(Wait, VMMode::Backward, DataType::Int, VMValue(31u));
+	add(End, immediate, DataType::None, VMValue());
+
+	const std::vector<VMScript> scripts {
+	    VMScript("Main", "test.txt", ScriptType::Script, 3, {}, 0, 0, 1),
+	    VMScript("Child", "test.txt", ScriptType::Script, 3, {}, 31, 0, 2),
+	};
+	return {LHVMVersion::BlackAndWhite, {"counter", "total", "result"}, code, {1}, scripts, {}};
+}
+
+std::vector<Tick> RunTicks(bool threadedDispatch)
+{
+	const std::vector<NativeFunction> functions {
+	    NativeFunction(nullptr, 0, 0, "NONE"),
+	    NativeFunction(nullptr, 2, 1, "STUB"),
+	};
+	uint32_t errors = 0;
+
+	LHVM vm;
+	vm.SetThreadedDispatch(threadedDispatch);
+	vm.Initialise(
+	    &functions, [](uint32_t) {}, [](uint32_t) {}, [](uint32_t) {},
+	    [&errors](ErrorCode, const std::string&, uint32_t) { ++errors; }, [](uint32_t) {}, [](uint32_t) {});
+	vm.LoadBinary(CreateFile());
+
+	std::vector<Tick> ticks;
+	for (int i = 0; i < 10; ++i)
+	{
+		vm.LookIn(ScriptType::All);
+		const auto& variables = vm.GetVariables();
+		ticks.push_back({vm.GetTasks().size(), vm.GetExecutedInstructions(), variables[1].value.floatVal,
+		                 variables[2].value.floatVal, variables[3].value.floatVal, errors});
+	}
+	return ticks;
+}
+
+// Recorded with the interpreter that ran the instructions without decoding them
+const std::vector<Tick> k_Baseline {
+    {1, 16, 1, 1, 0, 0},   {1, 31, 2, 3, 0, 0},   {1, 46, 3, 6, 0, 0},    {1, 61, 4, 10, 0, 0},   {1, 80, 5, 15, 0, 0},
+    {2, 91, 5, 30, 0, 1},  {2, 99, 5, 60, 0, 1},  {1, 108, 5, 120, 0, 1}, {0, 110, 5, 120, 0, 1}, {0, 110, 5, 120, 0, 1},
+};
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestLHVM, threadedDispatchMatchesBaseline)
+{
+	ASSERT_EQ(RunTicks(true), k_Baseline);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestLHVM, switchDispatchMatchesBaseline)
+{
+	ASSERT_EQ(RunTicks(false), k_Baseline);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestLHVM, nativeSignaturesMatchFunctionsTable)
+{
+	chlapi::CHLApi api;
+	const auto& functions = api.GetFunctionsTable();
+	ASSERT_EQ(functions.size(), k_NativeFunctionSignatures.size());
+	for (size_t i = 0; i < functions.size(); ++i)
+	{
+		EXPECT_EQ(functions[i].name, k_NativeFunctionSignatures[i].name) << i;
+		EXPECT_EQ(functions[i].stackIn, k_NativeFunctionSignatures[i].stackIn) << functions[i].name;
+		EXPECT_EQ(functions[i].stackOut, k_NativeFunctionSignatures[i].stackOut) << functions[i].name;
+	}
+}
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <ECS/Components/Fixed.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Map.h>
+#include <ECS/Registry.h>
+#include <Game.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::ecs::components;
+using namespace openblack;
+
+class TestMapQueries: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+	}
+	void TearDown() override { _game.reset(); }
+
+	static entt::entity CreateFixed(const glm::vec2& center, float radius)
+	{
+		auto& registry = Locator::entitiesRegistry::value();
+		const auto entity = registry.Create();
+		registry.Assign<Transform>(entity, glm::vec3(center.x, 0.0f, center.y), glm::mat3(1.0f), glm::vec3(1.0f));
+		registry.Assign<Fixed>(entity, center, radius);
+		return entity;
+	}
+
+	static bool Contains(const std::vector<entt::entity>& entities, entt::entity entity)
+	{
+		return std::find(entities.cbegin(), entities.cend(), entity) != entities.cend();
+	}
+
+	std::unique_ptr<Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestMapQueries, fixedInRadiusOverlapsBoundingCircles)
+{
+	const auto inside = CreateFixed({1000.0f, 1000.0f}, 5.0f);
+	const auto overlapping = CreateFixed({1030.0f, 1000.0f}, 5.0f);
+	const auto outside = CreateFixed({1100.0f, 1000.0f}, 5.0f);
+	// Spans many cells but is only returned once
+	const auto large = CreateFixed({1000.0f, 1060.0f}, 40.0f);
+	auto& map = Locator::entitiesMap::value();
+	map.Rebuild();
+
+	const auto result = map.GetFixedInRadius({1000.0f, 1000.0f}, 30.0f);
+	ASSERT_TRUE(std::is_sorted(result.cbegin(), result.cend()));
+	ASSERT_TRUE(Contains(result, inside));
+	ASSERT_TRUE(Contains(result, overlapping));
+	ASSERT_FALSE(Contains(result, outside));
+	ASSERT_EQ(std::count(result.cbegin(), result.cend(), large), 1);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestMapQueries, unboundedRadiusCoversTheGrid)
+{
+	const auto nearCorner = CreateFixed({5.0f, 5.0f}, 1.0f);
+	const auto farCorner = CreateFixed({5110.0f, 5110.0f}, 1.0f);
+	auto& map = Locator::entitiesMap::value();
+	map.Rebuild();
+
+	const auto all = map.GetFixedInRadius({2560.0f, 2560.0f}, std::numeric_limits<float>::infinity());
+	ASSERT_TRUE(Contains(all, nearCorner));
+	ASSERT_TRUE(Contains(all, farCorner));
+
+	// The center is far outside of the grid
+	const auto huge = map.GetFixedInRadius({-1.0e30f, 1.0e30f}, std::numeric_limits<float>::max());
+	ASSERT_TRUE(Contains(huge, nearCorner));
+	ASSERT_TRUE(Contains(huge, farCorner));
+}
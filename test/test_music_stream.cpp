@@ -0,0 +1,195 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <Audio/AudioDecoderInterface.h>
+#include <Audio/AudioPlayerInterface.h>
+#include <Audio/MusicStream.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::audio;
+
+namespace
+{
+int16_t GetSample(size_t frame)
+{
+	return static_cast<int16_t>(frame % 0x7FFF);
+}
+
+/// Mono stream where each sample is its frame number
+class CountingDecoder final: public AudioDecoderInterface
+{
+public:
+	explicit CountingDecoder(size_t frameCount)
+	    : _frameCount(frameCount)
+	{
+	}
+
+	bool Open(std::span<const uint8_t> /*unused*/) override { return true; }
+	void Read(std::vector<int16_t>& buffer) override
+	{
+		buffer.resize(_frameCount - _position);
+		ReadFrames(buffer);
+	}
+	size_t ReadFrames(std::span<int16_t> buffer) override
+	{
+		const auto frames = std::min(buffer.size(), _frameCount - _position);
+		for (size_t i = 0; i < frames; ++i)
+		{
+			buffer[i] = GetSample(_position + i);
+		}
+		_position += frames;
+		return frames;
+	}
+	bool Rewind() override
+	{
+		_position = 0;
+		return true;
+	}
+	[[nodiscard]] size_t GetFrameCount() override { return _frameCount; }
+	[[nodiscard]] int GetSampleRate() override { return 22050; }
+	[[nodiscard]] ChannelLayout GetChannelLayout() override { return ChannelLayout::Mono; }
+
+private:
+	size_t _frameCount;
+	size_t _position {0};
+};
+
+/// Keeps the samples of the buffers and plays the queued ones in order when told to
+class FakeAudioPlayer final: public AudioPlayerInterface
+{
+public:
+	void Initialize() override {}
+	void UpdateListener(glm::vec3, glm::vec3, glm::vec3, glm::vec3) const override {}
+	[[nodiscard]] BufferId CreateBuffer(ChannelLayout /*unused*/, const std::vector<int16_t>& buffer, int /*unused*/) override
+	{
+		_buffers[++_lastBuffer] = buffer;
+		return _lastBuffer;
+	}
+	void UpdateBuffer(BufferId id, ChannelLayout /*unused*/, std::span<const int16_t> buffer, int /*unused*/) override
+	{
+		_buffers.at(id).assign(buffer.begin(), buffer.end());
+	}
+	void QueueBuffer(SourceId /*unused*/, BufferId buffer) override { _queue.push_back(buffer); }
+	[[nodiscard]] BufferId UnqueueBuffer(SourceId /*unused*/) override
+	{
+		const auto buffer = _queue.front();
+		_queue.pop_front();
+		--_processed;
+		return buffer;
+	}
+	[[nodiscard]] int GetProcessedBufferCount(SourceId /*unused*/) const override { return static_cast<int>(_processed); }
+	void DeleteBuffer(BufferId id) override { _buffers.erase(id); }
+	[[nodiscard]] SourceId CreateSource(float /*unused*/, bool /*unused*/) override { return 1; }
+	void DeleteSource(SourceId /*unused*/) override {}
+	void UpdateSource(SourceId, glm::vec3, float, bool) override {}
+	void UpdateSource(SourceId, float, bool) override {}
+	[[nodiscard]] float GetDuration(BufferId /*unused*/) override { return 0.0f; }
+	void PlaySource(SourceId, glm::vec3, float, bool) override {}
+	void PlaySource(SourceId, float, bool) override {}
+	void PauseSource(SourceId /*unused*/) const override {}
+	void StopSource(SourceId /*unused*/) const override {}
+	void SetPlaybackOffset(SourceId /*unused*/, float /*unused*/) override {}
+	[[nodiscard]] float GetPlaybackOffset(SourceId /*unused*/) const override { return 0.0f; }
+	void SetVolume(SourceId /*unused*/, float /*unused*/) override {}
+	[[nodiscard]] float GetVolume() const override { return 1.0f; }
+	[[nodiscard]] AudioStatus GetStatus(SourceId /*unused*/) const override { return AudioStatus::Playing; }
+	[[nodiscard]] float GetProgress(size_t /*unused*/, SourceId /*unused*/) const override { return 0.0f; }
+
+	/// Finish playing every queued buffer, their samples are appended to played
+	void PlayQueued()
+	{
+		for (auto i = _processed; i < _queue.size(); ++i)
+		{
+			const auto& samples = _buffers.at(_queue[i]);
+			played.insert(played.end(), samples.begin(), samples.end());
+		}
+		_processed = _queue.size();
+	}
+
+	[[nodiscard]] size_t GetQueuedCount() const { return _queue.size(); }
+	[[nodiscard]] size_t GetBufferCount() const { return _buffers.size(); }
+
+	std::vector<int16_t> played;
+
+private:
+	std::map<BufferId, std::vector<int16_t>> _buffers;
+	BufferId _lastBuffer {0};
+	std::deque<BufferId> _queue;
+	size_t _processed {0};
+};
+
+/// Update and play the stream until it ends or \p frames were played, the worker decodes in the background
+bool PlayUntil(MusicStream& stream, FakeAudioPlayer& player, size_t frames)
+{
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (player.played.size() < frames && std::chrono::steady_clock::now() < deadline)
+	{
+		if (!stream.Update(1))
+		{
+			return false;
+		}
+		player.PlayQueued();
+		std::this_thread::yield();
+	}
+	return true;
+}
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMusicStream, refillsBuffersInOrder)
+{
+	constexpr size_t k_FrameCount = MusicStream::k_ChunkFrames * 3 + MusicStream::k_ChunkFrames / 2;
+	FakeAudioPlayer player;
+	{
+		MusicStream stream(player, std::make_unique<CountingDecoder>(k_FrameCount), false);
+		ASSERT_EQ(player.GetBufferCount(), MusicStream::k_BufferCount);
+
+		// Never more buffers queued than the ring holds
+		while (player.GetQueuedCount() < MusicStream::k_BufferCount)
+		{
+			ASSERT_TRUE(stream.Update(1));
+			std::this_thread::yield();
+		}
+		ASSERT_EQ(player.GetQueuedCount(), MusicStream::k_BufferCount);
+
+		// Ends once every frame was played
+		ASSERT_FALSE(PlayUntil(stream, player, k_FrameCount + 1));
+		ASSERT_FALSE(stream.HasQueuedBuffers());
+	}
+	ASSERT_EQ(player.GetBufferCount(), 0);
+
+	ASSERT_EQ(player.played.size(), k_FrameCount);
+	for (size_t i = 0; i < k_FrameCount; ++i)
+	{
+		ASSERT_EQ(player.played[i], GetSample(i)) << "at frame " << i;
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMusicStream, loopRewindsToFirstFrame)
+{
+	constexpr size_t k_FrameCount = MusicStream::k_ChunkFrames + 100;
+	constexpr size_t k_PlayedFrames = k_FrameCount * 3;
+	FakeAudioPlayer player;
+	MusicStream stream(player, std::make_unique<CountingDecoder>(k_FrameCount), true);
+
+	ASSERT_TRUE(PlayUntil(stream, player, k_PlayedFrames));
+	ASSERT_GE(player.played.size(), k_PlayedFrames);
+	for (size_t i = 0; i < k_PlayedFrames; ++i)
+	{
+		ASSERT_EQ(player.played[i], GetSample(i % k_FrameCount)) << "at frame " << i;
+	}
+}
@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include <Jobs/JobSystem.h>
+#include <Locator.h>
+#include <Resources/Loaders.h>
+#include <Resources/ResourceManager.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+
+namespace
+{
+struct Value
+{
+	int value;
+};
+
+struct ValueLoader final: resources::BaseLoader<Value>
+{
+	using BaseLoader::operator();
+	static constexpr bool k_ThreadSafe = true;
+
+	[[nodiscard]] result_type operator()(FromBufferTag, const std::function<int()>& make) const
+	{
+		return std::make_shared<Value>(Value {make()});
+	}
+};
+} // namespace
+
+class TestResourceManager: public ::testing::Test
+{
+protected:
+	void SetUp() override { Locator::jobSystem::emplace(2u); }
+	void TearDown() override { Locator::jobSystem::reset(); }
+
+	resources::ResourceManager<ValueLoader> _manager;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestResourceManager, asyncLoadReturnsPlaceholderUntilUpdate)
+{
+	_manager.SetPlaceholder(std::make_shared<Value>(Value {-1}));
+	_manager.RegisterAsync("value", ValueLoader::FromBufferTag {}, std::function<int()>([]() { return 42; }));
+	const entt::id_type id = entt::hashed_string("value");
+
+	ASSERT_TRUE(_manager.Contains(id));
+	ASSERT_EQ(_manager.Handle(id)->value, -1);
+	ASSERT_FALSE(_manager.IsResident(id));
+
+	// Inserts the load once the worker is done with it
+	for (uint32_t frame = 1; !_manager.IsResident(id); ++frame)
+	{
+		ASSERT_EQ(_manager.Handle(id)->value, -1);
+		std::this_thread::yield();
+		_manager.Update(frame);
+	}
+	ASSERT_EQ(_manager.Handle(id)->value, 42);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestResourceManager, synchronousLoadDoesNotHoldTheLock)
+{
+	const entt::id_type otherId = entt::hashed_string("other");
+	const entt::id_type id = entt::hashed_string("value");
+	_manager.Register(otherId, ValueLoader::FromBufferTag {}, std::function<int()>([]() { return 1; }));
+	// The loader uses the manager, it would deadlock if the lock was held while loading
+	const auto loadOther = [this, otherId]() { return _manager.Handle(otherId)->value + 1; };
+	_manager.Register(id, ValueLoader::FromBufferTag {}, std::function<int()>(loadOther));
+
+	ASSERT_EQ(_manager.Handle(id)->value, 2);
+	ASSERT_TRUE(_manager.IsResident(otherId));
+	ASSERT_TRUE(_manager.IsResident(id));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestResourceManager, evictsLeastRecentlyUsedOverBudget)
+{
+	const std::array<entt::id_type, 3> ids = {entt::hashed_string("a"), entt::hashed_string("b"), entt::hashed_string("c")};
+	for (const auto id : ids)
+	{
+		_manager.Register(id, ValueLoader::FromBufferTag {}, std::function<int()>([]() { return 0; }));
+	}
+	// a is used on frame 1, b on frame 2 and c on frame 3
+	for (uint32_t frame = 1; const auto id : ids)
+	{
+		_manager.Update(frame++);
+		ASSERT_TRUE(_manager.Handle(id));
+	}
+	ASSERT_EQ(_manager.GetResidentBytes(), 3 * sizeof(Value));
+
+	_manager.SetMemoryBudget(2 * sizeof(Value));
+	_manager.Update(5);
+	ASSERT_FALSE(_manager.IsResident(ids[0]));
+	ASSERT_TRUE(_manager.IsResident(ids[1]));
+	ASSERT_TRUE(_manager.IsResident(ids[2]));
+	ASSERT_EQ(_manager.GetResidentBytes(), 2 * sizeof(Value));
+
+	// Evicted resources are loaded again on their next use
+	ASSERT_TRUE(_manager.Handle(ids[0]));
+	ASSERT_TRUE(_manager.IsResident(ids[0]));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestResourceManager, keepsResourcesUsedLastFrame)
+{
+	const entt::id_type oldId = entt::hashed_string("old");
+	const entt::id_type recentId = entt::hashed_string("recent");
+	_manager.Register(oldId, ValueLoader::FromBufferTag {}, std::function<int()>([]() { return 0; }));
+	_manager.Register(recentId, ValueLoader::FromBufferTag {}, std::function<int()>([]() { return 0; }));
+	_manager.Update(1);
+	ASSERT_TRUE(_manager.Handle(oldId));
+	_manager.Update(2);
+	ASSERT_TRUE(_manager.Handle(recentId));
+
+	// Still over budget afterwards but the resource used last frame stays
+	_manager.SetMemoryBudget(1);
+	_manager.Update(3);
+	ASSERT_FALSE(_manager.IsResident(oldId));
+	ASSERT_TRUE(_manager.IsResident(recentId));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestResourceManager, keepsReferencedResources)
+{
+	const entt::id_type heldId = entt::hashed_string("held");
+	const entt::id_type droppedId = entt::hashed_string("dropped");
+	_manager.Register(heldId, ValueLoader::FromBufferTag {}, std::function<int()>([]() { return 0; }));
+	_manager.Register(droppedId, ValueLoader::FromBufferTag {}, std::function<int()>([]() { return 0; }));
+	_manager.Update(1);
+	const auto held = _manager.Handle(heldId);
+	ASSERT_TRUE(_manager.Handle(droppedId));
+
+	_manager.SetMemoryBudget(1);
+	_manager.Update(5);
+	ASSERT_TRUE(_manager.IsResident(heldId));
+	ASSERT_FALSE(_manager.IsResident(droppedId));
+}